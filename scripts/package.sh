@@ -116,6 +116,16 @@ copy_application() {
         chmod +x "$PACKAGE_PATH/bin/DesktopTerminal-CEF"
     fi
     
+    # CEF子进程程序（可选，缺失时子进程使用主程序自身）
+    if [[ "$PLATFORM" == "windows" ]]; then
+        if [[ -f "$BUILD_SUBDIR/bin/DesktopTerminal-CEF-Helper.exe" ]]; then
+            cp "$BUILD_SUBDIR/bin/DesktopTerminal-CEF-Helper.exe" "$PACKAGE_PATH/bin/"
+        fi
+    elif [[ -f "$BUILD_SUBDIR/bin/DesktopTerminal-CEF-Helper" ]]; then
+        cp "$BUILD_SUBDIR/bin/DesktopTerminal-CEF-Helper" "$PACKAGE_PATH/bin/"
+        chmod +x "$PACKAGE_PATH/bin/DesktopTerminal-CEF-Helper"
+    fi
+    
     log_success "主程序文件复制完成"
 }
 
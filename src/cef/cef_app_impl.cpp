@@ -1,10 +1,10 @@
 #include "cef_app_impl.h"
+#include "chromium_switches.h"
 #include "../logging/logger.h"
 #include "../core/application.h"
 
 #include "include/cef_browser.h"
 #include "include/cef_command_line.h"
-#include "include/cef_v8.h"
 #include "include/wrapper/cef_helpers.h"
 
 #include <QGuiApplication>
@@ -21,8 +21,14 @@ CEFApp::CEFApp()
     , m_strictSecurityMode(true)
     , m_windows7CompatibilityMode(false)
     , m_reduceLogging(false)
-    , m_browserCount(0)
+    , m_runtimeProfile()
+    , m_hasRuntimeProfile(false)
+    , m_hostResolverRules()
+    , m_proxyServer()
+    , m_proxyBypassList()
+    , m_proxyPacUrl()
     , m_renderProcessCount(0)
+    , m_renderHandler(new CEFRenderProcessHandler(&CEFApp::forwardRenderLog))
 {
     // 根据系统特性自动配置
     if (Application::is32BitSystem()) {
@@ -51,25 +57,27 @@ void CEFApp::OnBeforeCommandLineProcessing(const CefString& process_type, CefRef
         m_logger->appEvent(QString("处理命令行参数，进程类型: %1").arg(QString::fromStdString(processTypeStr)));
     }
     
-    // 应用安全标志
-    applySecurityFlags(command_line);
-    
-    // 应用性能标志
-    applyPerformanceFlags(command_line);
+    // 静态开关统一来自声明表，按当前运行条件筛选
+    const uint32_t conditions = switchConditions();
+    const int applied = ChromiumSwitches::apply(command_line, conditions);
+    if (!m_reduceLogging) {
+        m_logger->appEvent(QString("应用Chromium开关表：条件0x%1，共%2项")
+            .arg(conditions, 0, 16).arg(applied));
+    }
     
-    // 应用兼容性标志
-    applyCompatibilityFlags(command_line);
+    // 依赖运行时数据的开关
+    applyJavaScriptFlags(command_line);
+    applyDeviceScaleFactor(command_line);
     
-    // 32位或Windows 7系统继续采用兼容模式
-    if (Application::is32BitSystem() || Application::isWindows7SP1()) {
-        apply32BitOptimizations(command_line);
-    } else if (!m_reduceLogging) {
-        m_logger->appEvent("64位系统：启用多进程模式");
+    // 最后应用CEFManager选择的运行配置档（需要知道是否已是单进程模式）
+    if (m_hasRuntimeProfile) {
+        applyRuntimeProfile(command_line);
     }
 
-    // Windows 7特殊标志
-    if (m_windows7CompatibilityMode) {
-        applyWindows7Flags(command_line);
+    // 网络服务在浏览器进程内运行，解析规则和代理只需加在浏览器进程
+    if (process_type.empty()) {
+        applyHostResolverRules(command_line);
+        applyProxyConfig(command_line);
     }
 }
 
@@ -103,17 +111,8 @@ void CEFApp::OnContextInitialized()
 
 void CEFApp::OnBeforeChildProcessLaunch(CefRefPtr<CefCommandLine> command_line)
 {
-    // 子进程启动前的配置
-    if (m_lowMemoryMode) {
-        command_line->AppendSwitch("--max-old-space-size=128");
-        command_line->AppendSwitch("--memory-pressure-off");
-    }
-    
-    if (m_strictSecurityMode) {
-        command_line->AppendSwitch("--disable-web-security");
-        command_line->AppendSwitch("--disable-features=VizDisplayCompositor");
-    }
-    
+    // 子进程所需开关（js-flags、disable-web-security、disable-features）
+    // 由浏览器进程命令行自动传递，不再重复追加
     m_logger->appEvent("子进程启动配置完成");
 }
 
@@ -121,141 +120,12 @@ void CEFApp::OnRenderProcessThreadCreated(CefRefPtr<CefListValue> extra_info)
 {
     m_renderProcessCount++;
     
-    if (!m_reduceLogging) {
-        m_logger->appEvent(QString("渲染进程线程创建，总数: %1").arg(m_renderProcessCount));
-    }
-}
-
-// ==================== CefRenderProcessHandler接口实现 ====================
-
-void CEFApp::OnRenderThreadCreated(CefRefPtr<CefListValue> extra_info)
-{
-    CEF_REQUIRE_RENDERER_THREAD();
-    
-    if (!m_reduceLogging) {
-        m_logger->appEvent("渲染线程创建");
-    }
-}
-
-void CEFApp::OnWebKitInitialized()
-{
-    CEF_REQUIRE_RENDERER_THREAD();
-    
-    m_logger->appEvent("WebKit初始化完成");
-    
-    // 在这里可以注册自定义的JavaScript扩展
-    // 但在安全模式下，我们通常不需要额外的扩展
-}
-
-// 注意：CEF 75中此方法可能不存在，暂时注释掉
-/*
-void CEFApp::OnBrowserCreated(CefRefPtr<CefBrowser> browser, CefRefPtr<CefDictionaryValue> extra_info)
-{
-    CEF_REQUIRE_RENDERER_THREAD();
-    
-    m_browserCount++;
-    
-    if (!m_reduceLogging) {
-        m_logger->appEvent(QString("渲染进程中浏览器创建，ID: %1，总数: %2")
-            .arg(browser->GetIdentifier()).arg(m_browserCount));
-    }
-}
-*/
-
-void CEFApp::OnBrowserDestroyed(CefRefPtr<CefBrowser> browser)
-{
-    CEF_REQUIRE_RENDERER_THREAD();
-    
-    m_browserCount--;
-    
-    if (!m_reduceLogging) {
-        m_logger->appEvent(QString("渲染进程中浏览器销毁，ID: %1，剩余: %2")
-            .arg(browser->GetIdentifier()).arg(m_browserCount));
-    }
-}
-
-CefRefPtr<CefLoadHandler> CEFApp::GetLoadHandler()
-{
-    // 返回nullptr使用默认处理，或者返回自定义的LoadHandler
-    return nullptr;
-}
-
-// 注意：CEF 75中此方法可能不存在，暂时注释掉
-/*
-bool CEFApp::OnBeforeNavigation(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefRefPtr<CefRequest> request, NavigationType navigation_type, bool is_redirect)
-{
-    CEF_REQUIRE_RENDERER_THREAD();
-    
-    // 在渲染进程中进行额外的导航检查
-    std::string url = request->GetURL().ToString();
-    
-    if (!m_reduceLogging) {
-        m_logger->appEvent(QString("渲染进程导航检查: %1").arg(QString::fromStdString(url)));
-    }
-    
-    // 这里可以添加渲染进程级别的安全检查
-    // 返回true阻止导航，false允许导航
-    return false;
-}
-*/
-
-void CEFApp::OnContextCreated(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefRefPtr<CefV8Context> context)
-{
-    CEF_REQUIRE_RENDERER_THREAD();
-    
-    if (frame->IsMain()) {
-        if (!m_reduceLogging) {
-            m_logger->appEvent(QString("V8上下文创建，浏览器ID: %1").arg(browser->GetIdentifier()));
-        }
-        
-        // 注入安全脚本
-        if (m_strictSecurityMode) {
-            injectSecurityScript(browser, frame, context);
-        }
-    }
-}
-
-void CEFApp::OnContextReleased(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefRefPtr<CefV8Context> context)
-{
-    CEF_REQUIRE_RENDERER_THREAD();
-    
-    if (frame->IsMain() && !m_reduceLogging) {
-        m_logger->appEvent(QString("V8上下文释放，浏览器ID: %1").arg(browser->GetIdentifier()));
-    }
-}
-
-void CEFApp::OnUncaughtException(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefRefPtr<CefV8Context> context, CefRefPtr<CefV8Exception> exception, CefRefPtr<CefV8StackTrace> stackTrace)
-{
-    CEF_REQUIRE_RENDERER_THREAD();
-    
-    // 记录JavaScript异常
-    logV8Exception(exception, stackTrace);
-    
-    // 在严格安全模式下，JavaScript异常可能表示安全问题
-    if (m_strictSecurityMode) {
-        std::string url = frame->GetURL().ToString();
-        m_logger->logEvent("安全警告", 
-            QString("检测到JavaScript异常，URL: %1").arg(QString::fromStdString(url)), 
-            "security.log", L_WARNING);
-    }
-}
-
-bool CEFApp::OnProcessMessageReceived(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefProcessId source_process, CefRefPtr<CefProcessMessage> message)
-{
-    CEF_REQUIRE_RENDERER_THREAD();
-    
-    std::string messageName = message->GetName().ToString();
+    // 渲染进程（含独立子进程程序）不探测系统环境，配置由此下发
+    CEFRenderProcessHandler::writeStartupInfo(extra_info, m_strictSecurityMode, m_reduceLogging);
     
     if (!m_reduceLogging) {
-        m_logger->appEvent(QString("收到进程消息: %1").arg(QString::fromStdString(messageName)));
-    }
-    
-    // 处理安全相关消息
-    if (messageName.find("security") == 0) {
-        return handleSecurityMessage(browser, message);
+        m_logger->appEvent(QString("渲染进程线程创建，总数: %1").arg(m_renderProcessCount));
     }
-    
-    return false; // 未处理的消息
 }
 
 // ==================== 配置方法 ====================
@@ -284,42 +154,52 @@ void CEFApp::enableWindows7Compatibility(bool enable)
     m_logger->appEvent(QString("CEFApp Windows 7兼容模式: %1").arg(enable ? "启用" : "禁用"));
 }
 
+void CEFApp::setRuntimeProfile(const CEFRuntimeProfile& profile)
+{
+    m_runtimeProfile = profile;
+    m_hasRuntimeProfile = true;
+}
+
 // ==================== 私有方法实现 ====================
 
-void CEFApp::applySecurityFlags(CefRefPtr<CefCommandLine> command_line)
+uint32_t CEFApp::switchConditions() const
 {
+    uint32_t conditions = ChromiumSwitches::COND_ALWAYS;
     if (m_strictSecurityMode) {
-        command_line->AppendSwitch("--disable-web-security");
-        command_line->AppendSwitch("--disable-extensions");
-        command_line->AppendSwitch("--disable-plugins");
-        command_line->AppendSwitch("--disable-default-apps");
-        command_line->AppendSwitch("--disable-sync");
-        command_line->AppendSwitch("--disable-translate");
-        command_line->AppendSwitch("--disable-background-networking");
+        conditions |= ChromiumSwitches::COND_STRICT_SECURITY;
+    }
+    if (m_lowMemoryMode) {
+        conditions |= ChromiumSwitches::COND_LOW_MEMORY;
+    }
+    const bool legacySystem = Application::is32BitSystem() || Application::isWindows7SP1();
+    if (legacySystem) {
+        conditions |= ChromiumSwitches::COND_LEGACY_SYSTEM;
     }
+    if (m_windows7CompatibilityMode) {
+        conditions |= ChromiumSwitches::COND_WINDOWS7;
+    }
+    // 进程模式由CEFManager选定后随运行配置档传入；未设置时旧系统保持单进程
+    if (m_hasRuntimeProfile ? m_runtimeProfile.singleProcess : legacySystem) {
+        conditions |= ChromiumSwitches::COND_SINGLE_PROCESS;
+    }
+    return conditions;
 }
 
-void CEFApp::applyPerformanceFlags(CefRefPtr<CefCommandLine> command_line)
+void CEFApp::applyJavaScriptFlags(CefRefPtr<CefCommandLine> command_line)
 {
-    // 基础性能优化
-    command_line->AppendSwitch("--disable-background-timer-throttling");
-    command_line->AppendSwitch("--disable-renderer-backgrounding");
-    command_line->AppendSwitch("--disable-backgrounding-occluded-windows");
-    
-    if (m_lowMemoryMode) {
-        command_line->AppendSwitch("--memory-pressure-off");
-        command_line->AppendSwitch("--max-old-space-size=256");
-        command_line->AppendSwitch("--disable-dev-shm-usage");
+    // V8参数必须经js-flags传入，直接追加--max-old-space-size对渲染进程无效。
+    // 不使用--expose-gc：它会在所有框架、iframe和Worker中暴露gc，无法逐一移除
+    int maxOldSpaceMB = Application::is32BitSystem() ? 128 : (m_lowMemoryMode ? 256 : 0);
+    if (m_hasRuntimeProfile) {
+        maxOldSpaceMB = m_runtimeProfile.jsHeapLimitMB;
+    }
+    if (maxOldSpaceMB > 0) {
+        command_line->AppendSwitchWithValue("js-flags", "--max-old-space-size=" + std::to_string(maxOldSpaceMB));
     }
 }
 
-void CEFApp::applyCompatibilityFlags(CefRefPtr<CefCommandLine> command_line)
+void CEFApp::applyDeviceScaleFactor(CefRefPtr<CefCommandLine> command_line)
 {
-    // 通用兼容性标志
-    command_line->AppendSwitch("--no-sandbox");
-    command_line->AppendSwitch("--disable-features=VizDisplayCompositor");
-    command_line->AppendSwitch("--disable-ipc-flooding-protection");
-
     // ==== 关键：device-scale-factor 必须跟随系统 DPR，而不是写死为 1 ====
     // 进程已在 main.cpp 三重硬声明 PerMonitorV2，CEF 子 HWND 也在
     // cef_client_impl.cpp 里用 PerMonitorV2 物理像素 MoveWindow。
@@ -368,165 +248,116 @@ void CEFApp::applyCompatibilityFlags(CefRefPtr<CefCommandLine> command_line)
         deviceScaleFactor = 1.0;
     }
 
-    command_line->AppendSwitchWithValue("--force-device-scale-factor",
+    command_line->AppendSwitchWithValue("force-device-scale-factor",
         QString::number(deviceScaleFactor, 'f', 2).toStdString());
-    command_line->AppendSwitch("--disable-gpu-driver-bug-workarounds");
 
     m_logger->appEvent(QString("应用DPI缩放参数：force-device-scale-factor=%1 (主显示器DPI=%2)")
         .arg(deviceScaleFactor, 0, 'f', 2)
         .arg(monitorDpi));
 }
 
-void CEFApp::apply32BitOptimizations(CefRefPtr<CefCommandLine> command_line)
+void CEFApp::applyRuntimeProfile(CefRefPtr<CefCommandLine> command_line)
 {
-    // 32位系统特殊优化
-    command_line->AppendSwitch("--single-process");
-    command_line->AppendSwitch("--disable-gpu");
-    command_line->AppendSwitch("--disable-gpu-compositing");
-    command_line->AppendSwitch("--disable-gpu-rasterization");
-    command_line->AppendSwitch("--disable-software-rasterizer");
-    command_line->AppendSwitch("--disable-accelerated-2d-canvas");
-    command_line->AppendSwitch("--disable-accelerated-jpeg-decoding");
-    command_line->AppendSwitch("--disable-accelerated-mjpeg-decode");
-    command_line->AppendSwitch("--disable-accelerated-video-decode");
-    command_line->AppendSwitch("--max-old-space-size=128");
+    const CEFRuntimeProfile& profile = m_runtimeProfile;
     
-    m_logger->appEvent("应用32位系统CEF优化参数");
-}
-
-void CEFApp::applyWindows7Flags(CefRefPtr<CefCommandLine> command_line)
-{
-    // Windows 7特殊兼容性标志
-    command_line->AppendSwitch("--disable-d3d11");
-    command_line->AppendSwitch("--disable-gpu-sandbox");
-    command_line->AppendSwitch("--disable-features=AudioServiceOutOfProcess");
-    command_line->AppendSwitch("--disable-features=AudioServiceSandbox");
-    command_line->AppendSwitch("--disable-win32k-lockdown");
-    command_line->AppendSwitch("--no-zygote");
-    command_line->AppendSwitch("--disable-renderer-accessibility");
-    
-    m_logger->appEvent("应用Windows 7 CEF兼容性参数");
-}
-
-void CEFApp::injectSecurityScript(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefRefPtr<CefV8Context> context)
-{
-    // 禁用危险的API
-    disableDangerousAPIs(context);
+    // CEF 75的CefSettings没有缓存大小字段，只能通过命令行限制
+    command_line->AppendSwitchWithValue("disk-cache-size",
+        std::to_string(static_cast<qint64>(profile.diskCacheMB) * 1024 * 1024));
+    command_line->AppendSwitchWithValue("num-raster-threads", std::to_string(profile.rasterThreads));
     
-    // 设置安全监控
-    setupSecurityMonitoring(context);
-}
-
-void CEFApp::disableDangerousAPIs(CefRefPtr<CefV8Context> context)
-{
-    CefRefPtr<CefV8Value> global = context->GetGlobal();
-    
-    // 禁用一些可能被滥用的API
-    if (global->HasValue("eval")) {
-        global->SetValue("eval", CefV8Value::CreateUndefined(), V8_PROPERTY_ATTRIBUTE_READONLY);
+    if (!command_line->HasSwitch("single-process")) {
+        command_line->AppendSwitchWithValue("renderer-process-limit",
+                                            std::to_string(profile.rendererProcessLimit));
     }
     
-    // 禁用Function构造器
-    if (global->HasValue("Function")) {
-        CefRefPtr<CefV8Value> function = global->GetValue("Function");
-        if (function->IsFunction()) {
-            // 可以选择完全禁用或者替换为安全版本
-        }
+    if (!profile.networkPrediction) {
+        command_line->AppendSwitch("dns-prefetch-disable");
     }
     
-    // 限制window.open
-    if (global->HasValue("open")) {
-        global->SetValue("open", CefV8Value::CreateUndefined(), V8_PROPERTY_ATTRIBUTE_READONLY);
+    if (!profile.gpuEnabled) {
+        command_line->AppendSwitch("disable-gpu");
+        command_line->AppendSwitch("disable-gpu-compositing");
     }
+    
+    m_logger->appEvent(QString("应用运行配置档：磁盘缓存%1MB，渲染进程上限%2，光栅线程%3，JS堆上限%4MB，预连接%5，GPU%6")
+        .arg(profile.diskCacheMB)
+        .arg(profile.rendererProcessLimit)
+        .arg(profile.rasterThreads)
+        .arg(profile.jsHeapLimitMB)
+        .arg(profile.networkPrediction ? "开" : "关")
+        .arg(profile.gpuEnabled ? "开" : "关"));
 }
 
-void CEFApp::setupSecurityMonitoring(CefRefPtr<CefV8Context> context)
+void CEFApp::setHostResolverRules(const QString& rules)
 {
-    // 设置JavaScript安全监控
-    // 可以在这里注入监控脚本，检测可疑行为
-    
-    std::string monitoringScript = R"(
-        (function() {
-            // 监控可疑的DOM操作
-            var originalCreateElement = document.createElement;
-            document.createElement = function(tag) {
-                if (tag === 'script' || tag === 'iframe') {
-                    console.warn('Suspicious element creation attempt: ' + tag);
-                }
-                return originalCreateElement.call(this, tag);
-            };
-            
-            // 监控XHR请求
-            var originalXHR = window.XMLHttpRequest;
-            window.XMLHttpRequest = function() {
-                var xhr = new originalXHR();
-                var originalOpen = xhr.open;
-                xhr.open = function(method, url) {
-                    console.log('XHR request: ' + method + ' ' + url);
-                    return originalOpen.apply(this, arguments);
-                };
-                return xhr;
-            };
-        })();
-    )";
-    
-    CefRefPtr<CefV8Value> result;
-    CefRefPtr<CefV8Exception> exception;
-    context->Eval(monitoringScript, "", 0, result, exception);
-    
-    if (exception) {
-        m_logger->errorEvent("安全监控脚本注入失败");
+    m_hostResolverRules = rules;
+}
+
+void CEFApp::applyHostResolverRules(CefRefPtr<CefCommandLine> command_line)
+{
+    if (m_hostResolverRules.isEmpty()) {
+        return;
     }
+
+    // 命令行已有规则（如外部调试传入）时合并，而不是覆盖
+    std::string rules = m_hostResolverRules.toStdString();
+    if (command_line->HasSwitch("host-resolver-rules")) {
+        rules = command_line->GetSwitchValue("host-resolver-rules").ToString() + "," + rules;
+    }
+    command_line->AppendSwitchWithValue("host-resolver-rules", rules);
+    m_logger->appEvent(QString("应用主机解析规则: %1").arg(QString::fromStdString(rules)));
 }
 
-void CEFApp::setupMessageHandlers()
+void CEFApp::setProxyConfig(const QString& proxyServer, const QString& bypassList, const QString& pacUrl)
 {
-    // 设置进程间消息处理器
-    // 用于浏览器进程和渲染进程之间的安全通信
+    m_proxyServer = proxyServer;
+    m_proxyBypassList = bypassList;
+    m_proxyPacUrl = pacUrl;
 }
 
-bool CEFApp::handleSecurityMessage(CefRefPtr<CefBrowser> browser, CefRefPtr<CefProcessMessage> message)
+void CEFApp::applyProxyConfig(CefRefPtr<CefCommandLine> command_line)
 {
-    std::string messageName = message->GetName().ToString();
-    
-    if (messageName == "security.violation") {
-        // 处理安全违规报告
-        CefRefPtr<CefListValue> args = message->GetArgumentList();
-        if (args->GetSize() > 0) {
-            std::string violation = args->GetString(0).ToString();
-            m_logger->logEvent("安全违规", QString::fromStdString(violation), "security.log", L_ERROR);
-        }
-        return true;
+    if (m_proxyServer.isEmpty()) {
+        return;
     }
-    
-    return false;
+
+    // 命令行已指定代理（如外部调试传入）时以其为准
+    if (command_line->HasSwitch("proxy-server") || command_line->HasSwitch("no-proxy-server") ||
+        command_line->HasSwitch("proxy-pac-url") || command_line->HasSwitch("proxy-auto-detect")) {
+        m_logger->appEvent("命令行已指定代理，忽略启动时解析的代理");
+        return;
+    }
+
+    // PAC可能为不同主机给出不同代理，整体交给Chromium执行，只省去WPAD发现
+    if (!m_proxyPacUrl.isEmpty()) {
+        command_line->AppendSwitchWithValue("proxy-pac-url", m_proxyPacUrl.toStdString());
+        m_logger->appEvent(QString("应用代理配置: PAC %1").arg(m_proxyPacUrl));
+        return;
+    }
+
+    if (m_proxyServer == "direct") {
+        command_line->AppendSwitch("no-proxy-server");
+        m_logger->appEvent("应用代理配置: 直连");
+        return;
+    }
+
+    command_line->AppendSwitchWithValue("proxy-server", m_proxyServer.toStdString());
+    if (!m_proxyBypassList.isEmpty()) {
+        command_line->AppendSwitchWithValue("proxy-bypass-list", m_proxyBypassList.toStdString());
+    }
+    m_logger->appEvent(QString("应用代理配置: %1，例外: %2")
+        .arg(m_proxyServer, m_proxyBypassList.isEmpty() ? QString("无") : m_proxyBypassList));
 }
 
-void CEFApp::handleRenderProcessError(const QString& error, CefRefPtr<CefBrowser> browser)
+void CEFApp::setupMessageHandlers()
 {
-    m_logger->errorEvent(QString("渲染进程错误: %1").arg(error));
-    
-    if (browser) {
-        // 可以在这里实施错误恢复策略
-        // 例如重新加载页面或显示错误页面
-    }
+    // 设置进程间消息处理器
+    // 用于浏览器进程和渲染进程之间的安全通信
 }
 
-void CEFApp::logV8Exception(CefRefPtr<CefV8Exception> exception, CefRefPtr<CefV8StackTrace> stackTrace)
+void CEFApp::forwardRenderLog(const char* category, const std::string& message, const char* filename,
+                              CEFRenderProcessHandler::LogLevel level)
 {
-    QString errorMessage = QString("JavaScript异常: %1").arg(QString::fromStdString(exception->GetMessage().ToString()));
-    
-    if (stackTrace) {
-        int frameCount = stackTrace->GetFrameCount();
-        for (int i = 0; i < frameCount && i < 5; ++i) { // 只记录前5帧
-            CefRefPtr<CefV8StackFrame> frame = stackTrace->GetFrame(i);
-            errorMessage += QString("\n  在 %1:%2:%3 (%4)")
-                .arg(QString::fromStdString(frame->GetScriptName().ToString()))
-                .arg(frame->GetLineNumber())
-                .arg(frame->GetColumn())
-                .arg(QString::fromStdString(frame->GetFunctionName().ToString()));
-        }
-    }
-    
-    m_logger->errorEvent(errorMessage);
+    Logger::instance().logEvent(QString::fromUtf8(category), QString::fromStdString(message),
+                                QString::fromUtf8(filename), static_cast<LogLevel>(level));
 }
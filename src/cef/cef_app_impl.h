@@ -10,17 +10,32 @@
 
 #include <QString>
 
+#include "render_process_handler.h"
+
 class Logger;
 
+/**
+ * @brief CEF运行配置档（CEFManager按内存配置选择，命令行处理时统一应用）
+ */
+struct CEFRuntimeProfile {
+    int diskCacheMB;            // 磁盘缓存上限 (MB)
+    int rendererProcessLimit;   // 渲染进程数上限（单进程模式下忽略）
+    int rasterThreads;          // 光栅化线程数
+    int jsHeapLimitMB;          // V8老生代上限 (MB)，0表示使用V8默认值
+    bool networkPrediction;     // 是否允许DNS预取和预连接
+    bool gpuEnabled;            // 是否启用硬件加速
+    bool singleProcess;         // 单进程模式（由CEFManager按选定的进程模式设置，不随配置档变化）
+};
+
 /**
  * @brief CEF应用程序实现类
  * 
- * 实现CEF应用程序接口，处理浏览器进程和渲染进程的初始化
+ * 实现CEF应用程序接口，处理浏览器进程的初始化；渲染进程逻辑委托给CEFRenderProcessHandler
+ * （同一处理器也用于独立子进程程序DesktopTerminal-CEF-Helper）
  * 针对32位系统和Windows 7 SP1进行了特殊优化
  */
 class CEFApp : public CefApp,
-               public CefBrowserProcessHandler,
-               public CefRenderProcessHandler
+               public CefBrowserProcessHandler
 {
 public:
     CEFApp();
@@ -28,7 +43,7 @@ public:
 
     // CefApp接口
     virtual CefRefPtr<CefBrowserProcessHandler> GetBrowserProcessHandler() override { return this; }
-    virtual CefRefPtr<CefRenderProcessHandler> GetRenderProcessHandler() override { return this; }
+    virtual CefRefPtr<CefRenderProcessHandler> GetRenderProcessHandler() override { return m_renderHandler; }
     virtual void OnBeforeCommandLineProcessing(const CefString& process_type, CefRefPtr<CefCommandLine> command_line) override;
     // 注意：CEF 75中OnRegisterCustomSchemes签名可能不同，暂时完全移除
     // virtual void OnRegisterCustomSchemes(CefRefPtr<CefSchemeRegistrar> registrar);
@@ -38,44 +53,50 @@ public:
     virtual void OnBeforeChildProcessLaunch(CefRefPtr<CefCommandLine> command_line) override;
     virtual void OnRenderProcessThreadCreated(CefRefPtr<CefListValue> extra_info) override;
 
-    // CefRenderProcessHandler接口
-    virtual void OnRenderThreadCreated(CefRefPtr<CefListValue> extra_info) override;
-    virtual void OnWebKitInitialized() override;
-    // 注意：CEF 75中某些RenderProcessHandler方法可能不存在，暂时移除
-    // virtual void OnBrowserCreated(CefRefPtr<CefBrowser> browser, CefRefPtr<CefDictionaryValue> extra_info);
-    virtual void OnBrowserDestroyed(CefRefPtr<CefBrowser> browser) override;
-    virtual CefRefPtr<CefLoadHandler> GetLoadHandler() override;
-    // virtual bool OnBeforeNavigation(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefRefPtr<CefRequest> request, NavigationType navigation_type, bool is_redirect);
-    virtual void OnContextCreated(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefRefPtr<CefV8Context> context) override;
-    virtual void OnContextReleased(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefRefPtr<CefV8Context> context) override;
-    virtual void OnUncaughtException(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefRefPtr<CefV8Context> context, CefRefPtr<CefV8Exception> exception, CefRefPtr<CefV8StackTrace> stackTrace) override;
-    virtual bool OnProcessMessageReceived(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefProcessId source_process, CefRefPtr<CefProcessMessage> message) override;
-
     // 配置方法
     void setLowMemoryMode(bool enable);
     void setStrictSecurityMode(bool enable);
     void enableWindows7Compatibility(bool enable);
 
+    /**
+     * @brief 设置运行配置档（须在CefInitialize之前调用，仅浏览器进程）
+     */
+    void setRuntimeProfile(const CEFRuntimeProfile& profile);
+
+    /**
+     * @brief 设置浏览器进程的主机解析规则（--host-resolver-rules，须在CefInitialize之前调用）
+     * 启动时已解析过的目标主机直接交给Chromium，首个请求不再重复DNS查询
+     */
+    void setHostResolverRules(const QString& rules);
+
+    /**
+     * @brief 设置浏览器进程的代理（须在CefInitialize之前调用）
+     * @param proxyServer "direct"表示直连（--no-proxy-server），否则为回退列表，如"http://10.0.0.1:3128,direct://"
+     * @param bypassList 不走代理的主机（--proxy-bypass-list），可为空
+     * @param pacUrl 系统配置的PAC地址，非空时以--proxy-pac-url传入，proxyServer不再使用
+     * 代理已由ProxyResolver按系统配置/PAC解析，Chromium不再自行做WPAD发现
+     */
+    void setProxyConfig(const QString& proxyServer, const QString& bypassList, const QString& pacUrl = QString());
+
+    /**
+     * @brief 当前运行条件（ChromiumSwitches::Condition组合），决定开关表中哪些开关生效
+     */
+    uint32_t switchConditions() const;
+
 private:
-    // 命令行参数处理
-    void applySecurityFlags(CefRefPtr<CefCommandLine> command_line);
-    void applyPerformanceFlags(CefRefPtr<CefCommandLine> command_line);
-    void applyCompatibilityFlags(CefRefPtr<CefCommandLine> command_line);
-    void apply32BitOptimizations(CefRefPtr<CefCommandLine> command_line);
-    void applyWindows7Flags(CefRefPtr<CefCommandLine> command_line);
-
-    // JavaScript安全控制
-    void injectSecurityScript(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefRefPtr<CefV8Context> context);
-    void disableDangerousAPIs(CefRefPtr<CefV8Context> context);
-    void setupSecurityMonitoring(CefRefPtr<CefV8Context> context);
+    // 命令行参数处理（静态开关见ChromiumSwitches声明表）
+    void applyJavaScriptFlags(CefRefPtr<CefCommandLine> command_line);
+    void applyDeviceScaleFactor(CefRefPtr<CefCommandLine> command_line);
+    void applyRuntimeProfile(CefRefPtr<CefCommandLine> command_line);
+    void applyHostResolverRules(CefRefPtr<CefCommandLine> command_line);
+    void applyProxyConfig(CefRefPtr<CefCommandLine> command_line);
 
     // 进程间通信
     void setupMessageHandlers();
-    bool handleSecurityMessage(CefRefPtr<CefBrowser> browser, CefRefPtr<CefProcessMessage> message);
 
-    // 错误处理
-    void handleRenderProcessError(const QString& error, CefRefPtr<CefBrowser> browser = nullptr);
-    void logV8Exception(CefRefPtr<CefV8Exception> exception, CefRefPtr<CefV8StackTrace> stackTrace);
+    // 渲染进程日志转发到Logger
+    static void forwardRenderLog(const char* category, const std::string& message, const char* filename,
+                                 CEFRenderProcessHandler::LogLevel level);
 
 private:
     Logger* m_logger;
@@ -86,10 +107,24 @@ private:
     bool m_windows7CompatibilityMode;
     bool m_reduceLogging;
 
+    // 运行配置档（浏览器进程由CEFManager设置）
+    CEFRuntimeProfile m_runtimeProfile;
+    bool m_hasRuntimeProfile;
+
+    // 主机解析规则（浏览器进程由Application设置）
+    QString m_hostResolverRules;
+
+    // 代理配置（浏览器进程由Application设置，空表示由Chromium自行发现）
+    QString m_proxyServer;
+    QString m_proxyBypassList;
+    QString m_proxyPacUrl;
+
     // 统计信息
-    int m_browserCount;
     int m_renderProcessCount;
 
+    // 渲染进程处理器（单进程模式及未部署子进程程序时在本进程内运行）
+    CefRefPtr<CEFRenderProcessHandler> m_renderHandler;
+
     IMPLEMENT_REFCOUNTING(CEFApp);
 };
 
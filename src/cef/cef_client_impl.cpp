@@ -3,8 +3,11 @@
 #include "../config/config_manager.h"
 #include "../core/application.h"
 #include "../core/cef_manager.h"
+#include "../security/key_policy.h"
+#include "telemetry_channel.h"
 
 #include <algorithm>
+#include <QElapsedTimer>
 #include <QUrl>
 #include "include/base/cef_bind.h"
 #include "include/wrapper/cef_closure_task.h"
@@ -13,6 +16,90 @@
 #include <windows.h>
 #endif
 
+namespace {
+
+// 计划性重载前保存页面状态：表单输入与滚动位置写入sessionStorage（重载后仍保留）
+const char kSnapshotAndReloadScript[] = R"(
+    (function() {
+        try {
+            var fields = [];
+            var elements = document.querySelectorAll('input, textarea, select');
+            for (var i = 0; i < elements.length; i++) {
+                var el = elements[i];
+                if (el.type === 'password' || el.type === 'file') {
+                    continue;
+                }
+                fields.push({
+                    index: i,
+                    key: el.id || el.name || '',
+                    value: el.value,
+                    checked: !!el.checked
+                });
+            }
+            sessionStorage.setItem('__dtMemoryRestore', JSON.stringify({
+                url: location.href,
+                scrollX: window.scrollX,
+                scrollY: window.scrollY,
+                fields: fields
+            }));
+        } catch (e) {}
+        location.reload();
+    })();
+)";
+
+// 重载完成后恢复状态；只在同一URL上恢复一次
+const char kRestoreStateScript[] = R"(
+    (function() {
+        var raw = sessionStorage.getItem('__dtMemoryRestore');
+        if (!raw) {
+            return;
+        }
+        sessionStorage.removeItem('__dtMemoryRestore');
+        try {
+            var state = JSON.parse(raw);
+            if (state.url !== location.href) {
+                return;
+            }
+            var elements = document.querySelectorAll('input, textarea, select');
+            state.fields.forEach(function(field) {
+                var el = elements[field.index];
+                if (!el || (field.key && el.id !== field.key && el.name !== field.key)) {
+                    el = field.key ? (document.getElementById(field.key) ||
+                                      document.getElementsByName(field.key)[0]) : null;
+                }
+                if (!el) {
+                    return;
+                }
+                if (el.type === 'checkbox' || el.type === 'radio') {
+                    el.checked = field.checked;
+                } else {
+                    el.value = field.value;
+                }
+                el.dispatchEvent(new Event('input', { bubbles: true }));
+                el.dispatchEvent(new Event('change', { bubbles: true }));
+            });
+            window.scrollTo(state.scrollX, state.scrollY);
+        } catch (e) {}
+    })();
+)";
+
+qint64 monotonicMs()
+{
+    static QElapsedTimer timer;
+    if (!timer.isValid()) {
+        timer.start();
+    }
+    return timer.elapsed();
+}
+
+} // namespace
+
+// 统一按键策略中的CEF修饰键取值必须与当前CEF版本一致
+static_assert(KeyPolicy::kCefShiftDown == EVENTFLAG_SHIFT_DOWN, "EVENTFLAG_SHIFT_DOWN取值变化");
+static_assert(KeyPolicy::kCefControlDown == EVENTFLAG_CONTROL_DOWN, "EVENTFLAG_CONTROL_DOWN取值变化");
+static_assert(KeyPolicy::kCefAltDown == EVENTFLAG_ALT_DOWN, "EVENTFLAG_ALT_DOWN取值变化");
+static_assert(KeyPolicy::kCefCommandDown == EVENTFLAG_COMMAND_DOWN, "EVENTFLAG_COMMAND_DOWN取值变化");
+
 CEFClient::CEFClient(CEFManager* cefManager)
     : m_logger(&Logger::instance())
     , m_configManager(&ConfigManager::instance())
@@ -27,7 +114,13 @@ CEFClient::CEFClient(CEFManager* cefManager)
     , m_browserCount(0)
     , m_reduceLogging(false)
     , m_disableAnimations(false)
+    , m_developerModeEnabled(false)
+    , m_memoryWatchdog(m_configManager->getMaxMemoryMB())
+    , m_pendingStateRestore(false)
+    , m_loadStartMs(-1)
 {
+    m_developerModeEnabled = m_configManager->isDeveloperModeEnabled();
+
     // 检测Windows 7兼容性模式
     if (Application::isWindows7SP1()) {
         enableWindows7Compatibility(true);
@@ -46,6 +139,18 @@ CEFClient::~CEFClient()
     m_logger->appEvent("CEFClient销毁");
 }
 
+// ==================== CefClient接口实现 ====================
+
+bool CEFClient::OnProcessMessageReceived(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefProcessId source_process, CefRefPtr<CefProcessMessage> message)
+{
+    if (source_process == PID_RENDERER && message->GetName().ToString() == kTelemetryMessageName) {
+        handleTelemetryBatch(message);
+        return true;
+    }
+    
+    return false;
+}
+
 // ==================== CefDisplayHandler接口实现 ====================
 
 void CEFClient::OnTitleChange(CefRefPtr<CefBrowser> browser, const CefString& title)
@@ -137,6 +242,7 @@ void CEFClient::OnLoadStart(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> f
     if (frame->IsMain()) {
         QString url = QString::fromStdString(frame->GetURL().ToString());
         m_logger->appEvent(QString("开始加载页面: %1").arg(url));
+        m_loadStartMs = monotonicMs();
     }
 }
 
@@ -145,6 +251,18 @@ void CEFClient::OnLoadEnd(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> fra
     if (frame->IsMain()) {
         QString url = QString::fromStdString(frame->GetURL().ToString());
         m_logger->appEvent(QString("页面加载完成: %1 (状态码: %2)").arg(url).arg(httpStatusCode));
+        logProfileLoadSample();
+
+        // 收到服务器响应（非错误页）：Application据此清零连接失败后的重试退避
+        if (httpStatusCode > 0 && m_cefManager) {
+            m_cefManager->notifyMainFrameLoaded(url);
+        }
+        
+        // 内存看门狗计划重载后恢复页面状态
+        if (m_pendingStateRestore) {
+            m_pendingStateRestore = false;
+            frame->ExecuteJavaScript(kRestoreStateScript, frame->GetURL(), 0);
+        }
         
         // 在低内存模式下，加载完成后清理不必要的资源
         if (m_lowMemoryMode) {
@@ -161,6 +279,21 @@ void CEFClient::OnLoadError(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> f
         
         m_logger->errorEvent(QString("页面加载失败: %1 - 错误: %2 (代码: %3)")
             .arg(url).arg(error).arg(static_cast<int>(errorCode)));
+
+        // 连接层错误：交由Application在会话内退避重试，并核实固定地址是否仍有效。
+        // 多数情况只是断网或服务器暂时不可用，不在这里删除DNS缓存
+        switch (errorCode) {
+        case ERR_CONNECTION_REFUSED:
+        case ERR_CONNECTION_TIMED_OUT:
+        case ERR_CONNECTION_FAILED:
+        case ERR_ADDRESS_UNREACHABLE:
+            if (m_cefManager) {
+                m_cefManager->notifyHostUnreachable(QUrl(url).host().toLower(), url);
+            }
+            break;
+        default:
+            break;
+        }
     }
 }
 
@@ -213,13 +346,8 @@ bool CEFClient::OnPreKeyEvent(CefRefPtr<CefBrowser> browser, const CefKeyEvent&
         return false;
     }
     
-    // Windows 7特殊处理
-    if (m_windows7CompatibilityMode) {
-        return handleWindows7KeyEvent(event);
-    }
-    
     // 临时调试：记录所有键盘事件
-    if (event.modifiers & EVENTFLAG_IS_KEY_PAD) {
+    if (!m_reduceLogging && (event.modifiers & EVENTFLAG_IS_KEY_PAD)) {
         QString debugInfo = QString("小键盘事件 - keycode:%1, modifiers:0x%2, type:%3")
             .arg(event.windows_key_code)
             .arg(event.modifiers, 0, 16)
@@ -383,85 +511,175 @@ void CEFClient::setLowMemoryMode(bool enable)
 
 bool CEFClient::isKeyEventAllowed(const CefKeyEvent& event)
 {
-    // 允许的快捷键：Ctrl+R（刷新）
-    if (event.modifiers == EVENTFLAG_CONTROL_DOWN && event.windows_key_code == 'R') {
-        return true;
-    }
+    // 查询统一按键策略表（与KeyboardFilter、WindowsKeyBlocker共用）
+    // 修饰键归一化时自动忽略NumLock、CapsLock、小键盘、左右侧等标志
+    const unsigned mods = KeyPolicy::fromCefModifiers(event.modifiers);
 
-    // 优先检查小键盘按键（在移除修饰符之前）
-    // 小键盘数字键 (VK_NUMPAD0=96 到 VK_NUMPAD9=105)
-    if (event.windows_key_code >= 96 && event.windows_key_code <= 105) {
-        // 只允许无修饰符或仅Shift的小键盘数字输入
-        uint32 mods = event.modifiers & ~(EVENTFLAG_NUM_LOCK_ON | EVENTFLAG_CAPS_LOCK_ON | EVENTFLAG_IS_KEY_PAD | EVENTFLAG_IS_LEFT | EVENTFLAG_IS_RIGHT);
-        if (mods == 0 || mods == EVENTFLAG_SHIFT_DOWN) {
-            return true;
-        }
-    }
+    // 浏览器路径沿用原白名单语义：不带Ctrl/Alt/Meta的F1、F5、F11等交给页面处理
+    return KeyPolicy::isAllowedInBrowser(event.windows_key_code, mods, m_developerModeEnabled);
+}
 
-    // 小键盘运算符 (VK_MULTIPLY=106 到 VK_DIVIDE=111)
-    if (event.windows_key_code >= 106 && event.windows_key_code <= 111) {
-        uint32 mods = event.modifiers & ~(EVENTFLAG_NUM_LOCK_ON | EVENTFLAG_CAPS_LOCK_ON | EVENTFLAG_IS_KEY_PAD | EVENTFLAG_IS_LEFT | EVENTFLAG_IS_RIGHT);
-        if (mods == 0 || mods == EVENTFLAG_SHIFT_DOWN) {
-            return true;
+void CEFClient::handleTelemetryBatch(CefRefPtr<CefProcessMessage> message)
+{
+    TelemetryBatchReader reader(message);
+    RendererTelemetry delta;
+    PagePerformanceMetrics page;
+    bool hasPageSummary = false;
+    
+    if (!reader.isValid()) {
+        delta.droppedBatches = 1;
+        m_logger->rendererTelemetryEvent(delta);
+        return;
+    }
+    
+    delta.batches = 1;
+    delta.bytes = reader.byteSize();
+    
+    // 逐条解码只做计数；安全事件和JS错误的详情原样写入日志，不做逐条格式化。
+    // 日志级别在循环外判断一次，级别不够时不做UTF-8解码
+    const LogLevel logLevel = m_logger->getLogLevel();
+    const bool logSecurityDetail = logLevel <= L_DEBUG;
+    const bool logJsErrorDetail = logLevel <= L_WARNING;
+    
+    TelemetryRecord record;
+    while (reader.next(&record)) {
+        switch (record.type) {
+            case TELEMETRY_SECURITY:
+                delta.securityEvents++;
+                if (logSecurityDetail) {
+                    m_logger->logEvent("页面安全监控", QString::fromUtf8(record.detail, record.detailLength),
+                                       "security.log", L_DEBUG);
+                }
+                break;
+            case TELEMETRY_JS_ERROR:
+                delta.jsErrors++;
+                if (logJsErrorDetail) {
+                    m_logger->logEvent("页面脚本错误", QString::fromUtf8(record.detail, record.detailLength),
+                                       "app.log", L_WARNING);
+                }
+                break;
+            case TELEMETRY_PERF_ENTRY:
+                delta.perfEntries++;
+                if (record.code == PERF_RENDERER_STARTUP_MS) {
+                    logRendererStartupSample(record.value);
+                } else {
+                    hasPageSummary = applyPagePerformanceRecord(record, &page) || hasPageSummary;
+                }
+                break;
+            default:
+                break;
         }
     }
-
-    // 移除所有非安全相关的修饰符（NumLock、CapsLock、小键盘标志等）
-    uint32 modifiersWithoutLocks = event.modifiers & ~(
-        EVENTFLAG_NUM_LOCK_ON |
-        EVENTFLAG_CAPS_LOCK_ON |
-        EVENTFLAG_IS_KEY_PAD |
-        EVENTFLAG_IS_LEFT |
-        EVENTFLAG_IS_RIGHT
-    );
-
-    // 允许普通字符输入
-    if (modifiersWithoutLocks == 0 || modifiersWithoutLocks == EVENTFLAG_SHIFT_DOWN) {
-        return true;
+    
+    m_logger->rendererTelemetryEvent(delta);
+    if (hasPageSummary) {
+        m_logger->pagePerformanceEvent(page);
+        applyMemoryWatchdog(page);
     }
+}
 
-    // 允许方向键、回车、退格等基本导航键
-    if (event.windows_key_code >= 37 && event.windows_key_code <= 40) {
-        return true;
+bool CEFClient::applyPagePerformanceRecord(const TelemetryRecord& record, PagePerformanceMetrics* page)
+{
+    const double bytesPerMB = 1024.0 * 1024.0;
+    
+    switch (record.code) {
+        case PERF_LONG_TASK_COUNT:
+            page->longTaskCount += static_cast<int>(record.value);
+            return true;
+        case PERF_LONG_TASK_TOTAL_MS:
+            page->longTaskTotalMs += record.value;
+            return true;
+        case PERF_LONG_TASK_MAX_MS:
+            page->longTaskMaxMs = qMax(page->longTaskMaxMs, record.value);
+            return true;
+        case PERF_LCP_MS:
+            page->lcpMs = record.value;
+            return true;
+        case PERF_CLS:
+            page->cls = record.value;
+            return true;
+        case PERF_JS_HEAP_USED_BYTES:
+            page->jsHeapUsedMB = record.value / bytesPerMB;
+            return true;
+        case PERF_JS_HEAP_LIMIT_BYTES:
+            page->jsHeapLimitMB = record.value / bytesPerMB;
+            return true;
+        case PERF_RENDERER_RSS_BYTES:
+            page->rendererRssMB = record.value / bytesPerMB;
+            return true;
+        case PERF_RESOURCE_COUNT:
+            page->resourceCount += static_cast<int>(record.value);
+            return true;
+        case PERF_RESOURCE_CACHED_COUNT:
+            page->resourceCachedCount += static_cast<int>(record.value);
+            return true;
+        default:
+            return false;
     }
+}
 
-    if (event.windows_key_code == 13 || event.windows_key_code == 8 ||
-        event.windows_key_code == 9 || event.windows_key_code == 27) {
-        return true;
+void CEFClient::logProfileLoadSample()
+{
+    if (m_loadStartMs < 0 || !m_cefManager) {
+        return;
     }
+    
+    // 按内存配置档记录加载耗时与内存，用于对比各配置档的实测效果
+    const qint64 loadMs = monotonicMs() - m_loadStartMs;
+    m_loadStartMs = -1;
+    
+    const PerformanceMetrics metrics = m_logger->collectPerformanceMetrics();
+    m_logger->logEvent("配置档实测", QString("配置档: %1 | 页面加载: %2ms | 主进程内存: %3MB | 渲染进程内存: %4MB | 子进程入口: %5")
+        .arg(CEFManager::memoryProfileName(m_cefManager->getMemoryProfile()))
+        .arg(loadMs)
+        .arg(metrics.memoryProcessUsed)
+        .arg(metrics.page.rendererRssMB, 0, 'f', 1)
+        .arg(subprocessEntryName()),
+        "performance.log", L_INFO);
+}
 
-    // 允许Delete键 (VK_DELETE=46)
-    if (event.windows_key_code == 46) {
-        return true;
-    }
+void CEFClient::logRendererStartupSample(double startupMs)
+{
+    m_logger->logEvent("子进程实测", QString("渲染进程启动: %1ms | 子进程入口: %2")
+        .arg(startupMs, 0, 'f', 0)
+        .arg(subprocessEntryName()),
+        "performance.log", L_INFO);
+}
 
-    return false;
+QString CEFClient::subprocessEntryName() const
+{
+    if (!m_cefManager) {
+        return "未知";
+    }
+    return m_cefManager->usesSubprocessHelper() ? "Helper" : "主程序";
 }
 
-bool CEFClient::isSystemShortcut(const CefKeyEvent& event)
+void CEFClient::applyMemoryWatchdog(const PagePerformanceMetrics& page)
 {
-    // 检测系统快捷键
-    // CEF 75兼容性：使用数值而不是VK_常量
-    if (event.modifiers & EVENTFLAG_ALT_DOWN) {
-        if (event.windows_key_code == 9 || event.windows_key_code == 115) { // VK_TAB, VK_F4
-            return true;
-        }
+    if (!m_browser) {
+        return;
     }
     
-    if (event.modifiers & EVENTFLAG_CONTROL_DOWN) {
-        if (event.windows_key_code == 'W' || event.windows_key_code == 'T' || 
-            event.windows_key_code == 'N' || event.windows_key_code == 115) { // VK_F4
-            return true;
-        }
+    CefRefPtr<CefFrame> frame = m_browser->GetMainFrame();
+    if (!frame || !frame->IsValid()) {
+        return;
     }
     
-    return false;
-}
-
-bool CEFClient::isAllowedShortcut(const CefKeyEvent& event)
-{
-    // 只允许Ctrl+R
-    return (event.modifiers == EVENTFLAG_CONTROL_DOWN && event.windows_key_code == 'R');
+    switch (m_memoryWatchdog.evaluate(page, monotonicMs())) {
+        case MemoryWatchdog::ACTION_PRESSURE:
+            m_logger->logEvent("内存看门狗", QString("超过软阈值，发送内存压力通知。%1")
+                               .arg(m_memoryWatchdog.lastReason()), "performance.log", L_INFO);
+            frame->SendProcessMessage(PID_RENDERER, CefProcessMessage::Create(kMemoryPressureMessageName));
+            break;
+        case MemoryWatchdog::ACTION_RELOAD:
+            m_logger->logEvent("内存看门狗", QString("持续超过硬阈值，保存页面状态后重新加载。%1")
+                               .arg(m_memoryWatchdog.lastReason()), "performance.log", L_WARNING);
+            m_pendingStateRestore = true;
+            frame->ExecuteJavaScript(kSnapshotAndReloadScript, frame->GetURL(), 0);
+            break;
+        default:
+            break;
+    }
 }
 
 void CEFClient::logSecurityEvent(const QString& event, const QString& details)
@@ -699,31 +917,3 @@ void CEFClient::setBrowserZoomLevelOnUIThread(double zoomLevel)
 
     host->SetZoomLevel(zoomLevel);
 }
-
-bool CEFClient::handleWindows7KeyEvent(const CefKeyEvent& event)
-{
-    // Windows 7特殊键盘事件处理
-    // 更严格的过滤以避免兼容性问题
-
-    // 允许的快捷键：Ctrl+R（刷新）
-    if (isAllowedShortcut(event)) {
-        return false; // 允许
-    }
-
-    // 移除所有非安全相关的修饰符（NumLock、CapsLock、小键盘标志等）
-    uint32 modifiersWithoutLocks = event.modifiers & ~(
-        EVENTFLAG_NUM_LOCK_ON |
-        EVENTFLAG_CAPS_LOCK_ON |
-        EVENTFLAG_IS_KEY_PAD |
-        EVENTFLAG_IS_LEFT |
-        EVENTFLAG_IS_RIGHT
-    );
-
-    // 基本输入键（包括小键盘）
-    if (modifiersWithoutLocks == 0 || modifiersWithoutLocks == EVENTFLAG_SHIFT_DOWN) {
-        return false; // 允许
-    }
-
-    // 其他都阻止
-    return true;
-}
@@ -13,10 +13,14 @@
 #include "include/cef_download_handler.h"
 #include "include/cef_browser.h"
 
+#include "memory_watchdog.h"
+
 #include <QString>
 #include <QStringList>
 
 class Logger;
+struct TelemetryRecord;
+struct PagePerformanceMetrics;
 class ConfigManager;
 class CEFManager;
 
@@ -49,6 +53,7 @@ public:
     virtual CefRefPtr<CefContextMenuHandler> GetContextMenuHandler() override { return this; }
     virtual CefRefPtr<CefJSDialogHandler> GetJSDialogHandler() override { return this; }
     virtual CefRefPtr<CefDownloadHandler> GetDownloadHandler() override { return this; }
+    virtual bool OnProcessMessageReceived(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefProcessId source_process, CefRefPtr<CefProcessMessage> message) override;
 
     // CefDisplayHandler接口 - 显示处理
     virtual void OnTitleChange(CefRefPtr<CefBrowser> browser, const CefString& title) override;
@@ -102,8 +107,20 @@ public:
 private:
     // 键盘事件过滤
     bool isKeyEventAllowed(const CefKeyEvent& event);
-    bool isSystemShortcut(const CefKeyEvent& event);
-    bool isAllowedShortcut(const CefKeyEvent& event);
+
+    // 渲染进程遥测批次解码
+    void handleTelemetryBatch(CefRefPtr<CefProcessMessage> message);
+    bool applyPagePerformanceRecord(const TelemetryRecord& record, PagePerformanceMetrics* page);
+
+    // 渲染进程内存看门狗：软阈值发送压力通知，硬阈值保留状态重载
+    void applyMemoryWatchdog(const PagePerformanceMetrics& page);
+
+    // 按内存配置档记录页面加载耗时与内存占用
+    void logProfileLoadSample();
+
+    // 记录渲染进程启动耗时（区分子进程入口，用于对比独立子进程程序的效果）
+    void logRendererStartupSample(double startupMs);
+    QString subprocessEntryName() const;
 
     // 安全日志记录
     void logSecurityEvent(const QString& event, const QString& details);
@@ -124,7 +141,6 @@ private:
 
     // Windows 7兼容性处理
     void applyWindows7Optimizations();
-    bool handleWindows7KeyEvent(const CefKeyEvent& event);
 
 private:
     Logger* m_logger;
@@ -149,6 +165,14 @@ private:
     bool m_reduceLogging;
     bool m_disableAnimations;
 
+    // 开发者模式（放行开发者工具相关按键）
+    bool m_developerModeEnabled;
+
+    // 渲染进程内存看门狗
+    MemoryWatchdog m_memoryWatchdog;
+    bool m_pendingStateRestore;
+    qint64 m_loadStartMs;
+
     IMPLEMENT_REFCOUNTING(CEFClient);
 };
 
@@ -0,0 +1,130 @@
+#include "chromium_switches.h"
+
+namespace ChromiumSwitches {
+
+namespace {
+
+const Entry kSwitches[] = {
+    // 基础：关闭沙箱，后台页面不降频，IPC不限流
+    { "no-sandbox",                              nullptr, COND_ALWAYS },
+    { "disable-background-timer-throttling",     nullptr, COND_ALWAYS },
+    { "disable-renderer-backgrounding",          nullptr, COND_ALWAYS },
+    { "disable-backgrounding-occluded-windows",  nullptr, COND_ALWAYS },
+    { "disable-ipc-flooding-protection",         nullptr, COND_ALWAYS },
+    { "disable-gpu-driver-bug-workarounds",      nullptr, COND_ALWAYS },
+
+    // 严格安全模式：关闭扩展、插件和所有后台网络服务
+    { "disable-web-security",                    nullptr, COND_STRICT_SECURITY },
+    { "disable-extensions",                      nullptr, COND_STRICT_SECURITY },
+    { "disable-plugins",                         nullptr, COND_STRICT_SECURITY },
+    { "disable-default-apps",                    nullptr, COND_STRICT_SECURITY },
+    { "disable-sync",                            nullptr, COND_STRICT_SECURITY },
+    { "disable-translate",                       nullptr, COND_STRICT_SECURITY },
+    { "disable-spell-checking",                  nullptr, COND_STRICT_SECURITY },
+    { "disable-background-networking",           nullptr, COND_STRICT_SECURITY },
+
+    // 低内存：单站点考试页面无需按站点拆分进程
+    { "disable-dev-shm-usage",                   nullptr, COND_LOW_MEMORY | COND_WINDOWS7 },
+    { "disable-site-isolation-trials",           nullptr, COND_LOW_MEMORY | COND_LEGACY_SYSTEM },
+
+    // 进程模式由硬件标定决定
+    { "single-process",                          nullptr, COND_SINGLE_PROCESS },
+
+    // 32位/Windows 7：关闭全部GPU路径
+    { "disable-gpu",                             nullptr, COND_LEGACY_SYSTEM },
+    { "disable-gpu-compositing",                 nullptr, COND_LEGACY_SYSTEM },
+    { "disable-gpu-rasterization",               nullptr, COND_LEGACY_SYSTEM },
+    { "disable-software-rasterizer",             nullptr, COND_LEGACY_SYSTEM },
+    { "disable-accelerated-2d-canvas",           nullptr, COND_LEGACY_SYSTEM },
+    { "disable-accelerated-jpeg-decoding",       nullptr, COND_LEGACY_SYSTEM },
+    { "disable-accelerated-mjpeg-decode",        nullptr, COND_LEGACY_SYSTEM },
+    { "disable-accelerated-video-decode",        nullptr, COND_LEGACY_SYSTEM },
+
+    // Windows 7兼容性
+    { "disable-d3d11",                           nullptr, COND_WINDOWS7 },
+    { "disable-gpu-sandbox",                     nullptr, COND_WINDOWS7 },
+    { "disable-win32k-lockdown",                 nullptr, COND_WINDOWS7 },
+    { "no-zygote",                               nullptr, COND_WINDOWS7 },
+    { "disable-renderer-accessibility",          nullptr, COND_WINDOWS7 },
+};
+
+const Feature kDisabledFeatures[] = {
+    { "VizDisplayCompositor",       COND_ALWAYS },
+    { "AudioServiceOutOfProcess",   COND_WINDOWS7 },
+    { "AudioServiceSandbox",        COND_WINDOWS7 },
+};
+
+bool matches(uint32_t entryConditions, uint32_t conditions)
+{
+    return entryConditions == COND_ALWAYS || (entryConditions & conditions) != 0;
+}
+
+std::string disabledFeatures(uint32_t conditions)
+{
+    std::string features;
+    for (const Feature& feature : kDisabledFeatures) {
+        if (!matches(feature.conditions, conditions)) {
+            continue;
+        }
+        if (!features.empty()) {
+            features += ',';
+        }
+        features += feature.name;
+    }
+    return features;
+}
+
+} // namespace
+
+int apply(CefRefPtr<CefCommandLine> commandLine, uint32_t conditions)
+{
+    int applied = 0;
+
+    for (const Entry& entry : kSwitches) {
+        if (!matches(entry.conditions, conditions) || commandLine->HasSwitch(entry.name)) {
+            continue;
+        }
+        if (entry.value) {
+            commandLine->AppendSwitchWithValue(entry.name, entry.value);
+        } else {
+            commandLine->AppendSwitch(entry.name);
+        }
+        applied++;
+    }
+
+    const std::string features = disabledFeatures(conditions);
+    if (!features.empty()) {
+        // 与命令行上已有的禁用特性合并，而不是覆盖
+        std::string existing = commandLine->GetSwitchValue("disable-features").ToString();
+        commandLine->AppendSwitchWithValue("disable-features",
+                                           existing.empty() ? features : existing + "," + features);
+        applied++;
+    }
+
+    return applied;
+}
+
+std::vector<std::string> describe(uint32_t conditions)
+{
+    std::vector<std::string> switches;
+
+    for (const Entry& entry : kSwitches) {
+        if (!matches(entry.conditions, conditions)) {
+            continue;
+        }
+        std::string item = std::string("--") + entry.name;
+        if (entry.value) {
+            item += std::string("=") + entry.value;
+        }
+        switches.push_back(item);
+    }
+
+    const std::string features = disabledFeatures(conditions);
+    if (!features.empty()) {
+        switches.push_back("--disable-features=" + features);
+    }
+
+    return switches;
+}
+
+} // namespace ChromiumSwitches
@@ -0,0 +1,61 @@
+#ifndef CHROMIUM_SWITCHES_H
+#define CHROMIUM_SWITCHES_H
+
+#include "include/cef_command_line.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Chromium命令行开关声明表
+ *
+ * 所有静态开关集中在一张表里，按运行条件筛选后统一应用；
+ * 被禁用的Chromium特性合并为一个 --disable-features 值（重复追加该开关会互相覆盖）。
+ * 依赖运行时数据的开关（DPI缩放、js-flags、运行配置档）仍由CEFApp单独追加。
+ */
+namespace ChromiumSwitches {
+
+/**
+ * @brief 开关生效条件（表项条件为0表示始终生效，否则满足任一条件即生效）
+ */
+enum Condition : uint32_t {
+    COND_ALWAYS = 0,
+    COND_STRICT_SECURITY = 1u << 0, // 严格安全模式
+    COND_LOW_MEMORY = 1u << 1,      // 低内存模式
+    COND_LEGACY_SYSTEM = 1u << 2,   // 32位或Windows 7：纯软件渲染
+    COND_WINDOWS7 = 1u << 3,        // Windows 7兼容模式
+    COND_SINGLE_PROCESS = 1u << 4   // 单进程模式（CEFManager按硬件标定选择，32位/Windows 7必然单进程）
+};
+
+/**
+ * @brief 开关表项
+ */
+struct Entry {
+    const char* name;       // 不带前缀的开关名
+    const char* value;      // 开关值，nullptr表示无值
+    uint32_t conditions;    // Condition组合
+};
+
+/**
+ * @brief 禁用特性表项
+ */
+struct Feature {
+    const char* name;
+    uint32_t conditions;
+};
+
+/**
+ * @brief 把满足条件的开关和禁用特性应用到命令行
+ * @return 实际追加的开关数（含--disable-features）
+ */
+int apply(CefRefPtr<CefCommandLine> commandLine, uint32_t conditions);
+
+/**
+ * @brief 生成满足条件的开关列表（"--name" 或 "--name=value"），用于日志和诊断
+ */
+std::vector<std::string> describe(uint32_t conditions);
+
+} // namespace ChromiumSwitches
+
+#endif // CHROMIUM_SWITCHES_H
@@ -0,0 +1,53 @@
+#include "memory_watchdog.h"
+#include "../logging/logger.h"
+
+MemoryWatchdog::MemoryWatchdog(int maxMemoryMB)
+    : m_budgetMB(qMax(maxMemoryMB, 64))
+    , m_softRssMB(m_budgetMB * kSoftPercent / 100.0)
+    , m_hardRssMB(m_budgetMB * kHardPercent / 100.0)
+    , m_hardSamples(0)
+    , m_pressureSinceReload(false)
+    , m_lastPressureMs(-1)
+    , m_lastReloadMs(-1)
+{
+}
+
+MemoryWatchdog::Action MemoryWatchdog::evaluate(const PagePerformanceMetrics &page, qint64 nowMs)
+{
+    // JS堆上限取V8报告值与内存预算中的较小者；未上报时按预算一半估算
+    const double heapLimitMB = page.jsHeapLimitMB > 0.0
+        ? qMin(page.jsHeapLimitMB, m_budgetMB)
+        : m_budgetMB / 2.0;
+    const double softHeapMB = heapLimitMB * kSoftPercent / 100.0;
+    const double hardHeapMB = heapLimitMB * kHardPercent / 100.0;
+
+    const bool rssHard = page.rendererRssMB >= m_hardRssMB;
+    const bool heapHard = page.jsHeapUsedMB >= hardHeapMB;
+    const bool overHard = rssHard || heapHard;
+    const bool overSoft = overHard || page.rendererRssMB >= m_softRssMB || page.jsHeapUsedMB >= softHeapMB;
+
+    m_hardSamples = overHard ? m_hardSamples + 1 : 0;
+    m_lastReason = QString("渲染进程内存: %1/%2MB，JS堆: %3/%4MB")
+        .arg(page.rendererRssMB, 0, 'f', 1)
+        .arg(m_budgetMB, 0, 'f', 0)
+        .arg(page.jsHeapUsedMB, 0, 'f', 1)
+        .arg(heapLimitMB, 0, 'f', 0);
+
+    // 重载前至少发过一次内存压力通知，且连续超限，避免瞬时峰值触发重载
+    const bool reloadCooledDown = m_lastReloadMs < 0 || nowMs - m_lastReloadMs >= kReloadCooldownMs;
+    if (overHard && m_hardSamples >= kHardSamplesBeforeReload && m_pressureSinceReload && reloadCooledDown) {
+        m_hardSamples = 0;
+        m_pressureSinceReload = false;
+        m_lastReloadMs = nowMs;
+        return ACTION_RELOAD;
+    }
+
+    const bool pressureCooledDown = m_lastPressureMs < 0 || nowMs - m_lastPressureMs >= kPressureCooldownMs;
+    if (overSoft && pressureCooledDown) {
+        m_pressureSinceReload = true;
+        m_lastPressureMs = nowMs;
+        return ACTION_PRESSURE;
+    }
+
+    return ACTION_NONE;
+}
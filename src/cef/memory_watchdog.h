@@ -0,0 +1,62 @@
+#ifndef MEMORY_WATCHDOG_H
+#define MEMORY_WATCHDOG_H
+
+#include <QtGlobal>
+#include <QString>
+
+struct PagePerformanceMetrics;
+
+/**
+ * @brief 渲染进程内存看门狗（浏览器进程使用）
+ *
+ * 以渲染进程周期上报的JS堆和进程常驻内存为样本，阈值由配置maxMemoryMB推导：
+ *   - 超过软阈值：通知渲染进程内存压力，释放页面性能缓冲（有冷却时间）
+ *   - 连续多次超过硬阈值：执行保留页面状态的计划性重新加载，而不是等到OOM崩溃
+ */
+class MemoryWatchdog
+{
+public:
+    enum Action {
+        ACTION_NONE = 0,
+        ACTION_PRESSURE,   // 发送内存压力通知
+        ACTION_RELOAD      // 保留状态后重新加载页面
+    };
+
+    static constexpr int kSoftPercent = 70;                 // 软阈值占预算百分比
+    static constexpr int kHardPercent = 90;                 // 硬阈值占预算百分比
+    static constexpr int kHardSamplesBeforeReload = 2;      // 连续超硬阈值样本数
+    static constexpr qint64 kPressureCooldownMs = 30000;    // 两次压力通知最小间隔
+    static constexpr qint64 kReloadCooldownMs = 300000;     // 两次计划重载最小间隔
+
+    /**
+     * @param maxMemoryMB 渲染进程内存预算（ConfigManager::getMaxMemoryMB）
+     */
+    explicit MemoryWatchdog(int maxMemoryMB);
+
+    /**
+     * @brief 评估一次样本
+     * @param page 页面性能汇总（使用jsHeapUsedMB/jsHeapLimitMB/rendererRssMB）
+     * @param nowMs 单调时钟毫秒数
+     */
+    Action evaluate(const PagePerformanceMetrics &page, qint64 nowMs);
+
+    /**
+     * @brief 最近一次判定的说明（用于日志）
+     */
+    QString lastReason() const { return m_lastReason; }
+
+    double softRssMB() const { return m_softRssMB; }
+    double hardRssMB() const { return m_hardRssMB; }
+
+private:
+    double m_budgetMB;
+    double m_softRssMB;
+    double m_hardRssMB;
+    int m_hardSamples;
+    bool m_pressureSinceReload;
+    qint64 m_lastPressureMs;
+    qint64 m_lastReloadMs;
+    QString m_lastReason;
+};
+
+#endif // MEMORY_WATCHDOG_H
@@ -0,0 +1,284 @@
+#include "page_performance_bridge.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace {
+
+// 期望观测的条目类型；Chromium 75 不一定支持全部类型，按supportedEntryTypes取交集
+const char* const kObservedEntryTypes[] = {
+    "longtask",
+    "largest-contentful-paint",
+    "layout-shift",
+    "resource"
+};
+
+double numberProperty(CefRefPtr<CefV8Value> object, const char* name)
+{
+    if (!object || !object->IsObject()) {
+        return 0.0;
+    }
+    CefRefPtr<CefV8Value> value = object->GetValue(name);
+    return (value && value->IsDouble()) ? value->GetDoubleValue() : 0.0;
+}
+
+bool isTypeSupported(CefRefPtr<CefV8Value> supportedTypes, const std::string& type)
+{
+    // 旧版本没有supportedEntryTypes时全部尝试，由浏览器忽略不支持的类型
+    if (!supportedTypes || !supportedTypes->IsArray()) {
+        return true;
+    }
+    for (int i = 0; i < supportedTypes->GetArrayLength(); ++i) {
+        CefRefPtr<CefV8Value> item = supportedTypes->GetValue(i);
+        if (item && item->IsString() && item->GetStringValue().ToString() == type) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+PagePerformanceBridge::PagePerformanceBridge()
+{
+}
+
+bool PagePerformanceBridge::install(CefRefPtr<CefV8Context> context)
+{
+    detach();
+    m_current = PagePerformanceSummary();
+
+    if (!context || !context->IsValid()) {
+        return false;
+    }
+
+    // 即使不支持PerformanceObserver，也保持关联以上报JS堆和进程内存
+    m_context = context;
+    CefRefPtr<CefV8Value> global = context->GetGlobal();
+
+    CefRefPtr<CefV8Value> observerClass = global->GetValue("PerformanceObserver");
+    CefRefPtr<CefV8Value> reflect = global->GetValue("Reflect");
+    if (!observerClass || !observerClass->IsFunction() || !reflect || !reflect->IsObject()) {
+        return false;
+    }
+
+    // new PerformanceObserver(callback) —— CEF没有构造调用接口，借助Reflect.construct
+    CefRefPtr<CefV8Value> construct = reflect->GetValue("construct");
+    if (!construct || !construct->IsFunction()) {
+        return false;
+    }
+
+    CefRefPtr<CefV8Value> ctorArgs = CefV8Value::CreateArray(1);
+    ctorArgs->SetValue(0, CefV8Value::CreateFunction("onPerformanceEntries", this));
+
+    CefV8ValueList constructArgs;
+    constructArgs.push_back(observerClass);
+    constructArgs.push_back(ctorArgs);
+    CefRefPtr<CefV8Value> observer = construct->ExecuteFunctionWithContext(context, reflect, constructArgs);
+    if (!observer || !observer->IsObject()) {
+        return false;
+    }
+
+    // observer.observe({ entryTypes: [...] })
+    CefRefPtr<CefV8Value> supportedTypes = observerClass->GetValue("supportedEntryTypes");
+    CefRefPtr<CefV8Value> entryTypes = CefV8Value::CreateArray(0);
+    int typeCount = 0;
+    for (const char* type : kObservedEntryTypes) {
+        if (isTypeSupported(supportedTypes, type)) {
+            entryTypes->SetValue(typeCount++, CefV8Value::CreateString(type));
+        }
+    }
+    if (typeCount == 0) {
+        return false;
+    }
+
+    CefRefPtr<CefV8Value> options = CefV8Value::CreateObject(nullptr, nullptr);
+    options->SetValue("entryTypes", entryTypes, V8_PROPERTY_ATTRIBUTE_NONE);
+
+    CefRefPtr<CefV8Value> observe = observer->GetValue("observe");
+    if (!observe || !observe->IsFunction()) {
+        return false;
+    }
+
+    CefV8ValueList observeArgs;
+    observeArgs.push_back(options);
+    CefRefPtr<CefV8Value> result = observe->ExecuteFunctionWithContext(context, observer, observeArgs);
+    if (!result) {
+        return false;
+    }
+
+    m_observer = observer;
+    return true;
+}
+
+bool PagePerformanceBridge::releaseMemory()
+{
+    if (!m_context || !m_context->IsValid()) {
+        return false;
+    }
+
+    // performance.clearResourceTimings()：资源计时缓冲随页面请求数增长，已汇总的条目不再需要
+    CefRefPtr<CefV8Value> performance = m_context->GetGlobal()->GetValue("performance");
+    if (performance && performance->IsObject()) {
+        CefRefPtr<CefV8Value> clear = performance->GetValue("clearResourceTimings");
+        if (clear && clear->IsFunction()) {
+            clear->ExecuteFunctionWithContext(m_context, performance, CefV8ValueList());
+        }
+    }
+
+    // observer.takeRecords()：取走尚未回调的条目并计入当前汇总
+    if (m_observer) {
+        CefRefPtr<CefV8Value> takeRecords = m_observer->GetValue("takeRecords");
+        if (takeRecords && takeRecords->IsFunction()) {
+            CefRefPtr<CefV8Value> records =
+                takeRecords->ExecuteFunctionWithContext(m_context, m_observer, CefV8ValueList());
+            if (records && records->IsArray()) {
+                for (int i = 0; i < records->GetArrayLength(); ++i) {
+                    handleEntry(records->GetValue(i));
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void PagePerformanceBridge::detach()
+{
+    if (m_context && m_observer && m_context->IsValid()) {
+        CefRefPtr<CefV8Value> disconnect = m_observer->GetValue("disconnect");
+        if (disconnect && disconnect->IsFunction()) {
+            disconnect->ExecuteFunctionWithContext(m_context, m_observer, CefV8ValueList());
+        }
+    }
+
+    m_observer = nullptr;
+    m_context = nullptr;
+}
+
+PagePerformanceSummary PagePerformanceBridge::takeSummary()
+{
+    PagePerformanceSummary summary = m_current;
+    readHeapUsage(&summary);
+    summary.rendererRssBytes = readResidentBytes();
+
+    // 长任务、资源请求按周期统计；LCP、CLS是页面级指标，保留到页面卸载
+    m_current.longTaskCount = 0;
+    m_current.longTaskTotalMs = 0.0;
+    m_current.longTaskMaxMs = 0.0;
+    m_current.resourceCount = 0;
+    m_current.resourceCachedCount = 0;
+    return summary;
+}
+
+bool PagePerformanceBridge::Execute(const CefString& name, CefRefPtr<CefV8Value> object,
+                                    const CefV8ValueList& arguments, CefRefPtr<CefV8Value>& retval,
+                                    CefString& exception)
+{
+    // 回调参数：(PerformanceObserverEntryList list, PerformanceObserver observer)
+    if (arguments.empty() || !arguments[0]->IsObject()) {
+        return true;
+    }
+
+    CefRefPtr<CefV8Value> list = arguments[0];
+    CefRefPtr<CefV8Value> getEntries = list->GetValue("getEntries");
+    if (!getEntries || !getEntries->IsFunction()) {
+        return true;
+    }
+
+    CefRefPtr<CefV8Value> entries = getEntries->ExecuteFunction(list, CefV8ValueList());
+    if (!entries || !entries->IsArray()) {
+        return true;
+    }
+
+    for (int i = 0; i < entries->GetArrayLength(); ++i) {
+        handleEntry(entries->GetValue(i));
+    }
+    return true;
+}
+
+void PagePerformanceBridge::handleEntry(CefRefPtr<CefV8Value> entry)
+{
+    if (!entry || !entry->IsObject()) {
+        return;
+    }
+
+    CefRefPtr<CefV8Value> typeValue = entry->GetValue("entryType");
+    if (!typeValue || !typeValue->IsString()) {
+        return;
+    }
+
+    const std::string type = typeValue->GetStringValue().ToString();
+    if (type == "longtask") {
+        const double duration = numberProperty(entry, "duration");
+        m_current.longTaskCount++;
+        m_current.longTaskTotalMs += duration;
+        m_current.longTaskMaxMs = std::max(m_current.longTaskMaxMs, duration);
+    } else if (type == "largest-contentful-paint") {
+        // 每个新候选都会替换旧值，最后一个即为页面LCP
+        m_current.largestContentfulPaintMs = numberProperty(entry, "startTime");
+    } else if (type == "layout-shift") {
+        CefRefPtr<CefV8Value> hadRecentInput = entry->GetValue("hadRecentInput");
+        if (!hadRecentInput || !hadRecentInput->IsBool() || !hadRecentInput->GetBoolValue()) {
+            m_current.cumulativeLayoutShift += numberProperty(entry, "value");
+        }
+    } else if (type == "resource") {
+        // 跨域且无Timing-Allow-Origin的资源各项大小均为0，无法判断来源，不计入。
+        // 有响应体但传输字节为0即由内存或磁盘缓存提供（含304以外的全部缓存命中）
+        const double decodedSize = numberProperty(entry, "decodedBodySize");
+        if (decodedSize <= 0.0) {
+            return;
+        }
+        m_current.resourceCount++;
+        if (numberProperty(entry, "transferSize") <= 0.0) {
+            m_current.resourceCachedCount++;
+        }
+    }
+}
+
+void PagePerformanceBridge::readHeapUsage(PagePerformanceSummary* summary)
+{
+    if (!m_context || !m_context->IsValid() || !m_context->Enter()) {
+        return;
+    }
+
+    // performance.memory 为Chromium扩展，未开启精确内存信息时数值会被量化
+    CefRefPtr<CefV8Value> performance = m_context->GetGlobal()->GetValue("performance");
+    CefRefPtr<CefV8Value> memory = (performance && performance->IsObject())
+        ? performance->GetValue("memory") : nullptr;
+    summary->jsHeapUsedBytes = numberProperty(memory, "usedJSHeapSize");
+    summary->jsHeapLimitBytes = numberProperty(memory, "jsHeapSizeLimit");
+
+    m_context->Exit();
+}
+
+double PagePerformanceBridge::readResidentBytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<double>(counters.WorkingSetSize);
+    }
+    return 0.0;
+#elif defined(__linux__)
+    // /proc/self/statm 第二列为常驻页数
+    FILE* file = std::fopen("/proc/self/statm", "r");
+    if (!file) {
+        return 0.0;
+    }
+    unsigned long totalPages = 0;
+    unsigned long residentPages = 0;
+    const int fields = std::fscanf(file, "%lu %lu", &totalPages, &residentPages);
+    std::fclose(file);
+    return fields == 2 ? static_cast<double>(residentPages) * sysconf(_SC_PAGESIZE) : 0.0;
+#else
+    return 0.0;
+#endif
+}
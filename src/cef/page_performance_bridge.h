@@ -0,0 +1,87 @@
+#ifndef PAGE_PERFORMANCE_BRIDGE_H
+#define PAGE_PERFORMANCE_BRIDGE_H
+
+#include "include/cef_v8.h"
+
+/**
+ * @brief 页面性能周期汇总
+ */
+struct PagePerformanceSummary {
+    int longTaskCount;          // 本周期长任务数
+    double longTaskTotalMs;     // 本周期长任务总时长
+    double longTaskMaxMs;       // 本周期最长任务时长
+    double largestContentfulPaintMs; // 当前页面LCP（未观测到为0）
+    double cumulativeLayoutShift;    // 当前页面CLS
+    double jsHeapUsedBytes;     // JS堆已用（performance.memory，不可用为0）
+    double jsHeapLimitBytes;    // JS堆上限
+    double rendererRssBytes;    // 渲染进程常驻内存（单进程模式下即主进程）
+    int resourceCount;          // 本周期可判断来源的资源请求数
+    int resourceCachedCount;    // 其中由缓存提供的请求数
+
+    PagePerformanceSummary()
+        : longTaskCount(0), longTaskTotalMs(0.0), longTaskMaxMs(0.0)
+        , largestContentfulPaintMs(0.0), cumulativeLayoutShift(0.0)
+        , jsHeapUsedBytes(0.0), jsHeapLimitBytes(0.0), rendererRssBytes(0.0)
+        , resourceCount(0), resourceCachedCount(0) {}
+};
+
+/**
+ * @brief 渲染进程页面性能观察桥
+ *
+ * 在主框架V8上下文中用原生API构造PerformanceObserver（Reflect.construct + 原生回调），
+ * 不注入任何Eval脚本。回调中的长任务、LCP、布局偏移、资源加载条目在渲染进程内聚合，
+ * 由CEFApp周期性取出汇总并经遥测通道发送到浏览器进程。
+ * 浏览器进程内存看门狗发出内存压力通知时，清理页面中由浏览器缓冲的性能条目。
+ *
+ * 只在渲染线程使用。
+ */
+class PagePerformanceBridge : public CefV8Handler
+{
+public:
+    static constexpr int kSummaryIntervalMs = 10000; // 汇总上报周期
+
+    PagePerformanceBridge();
+
+    /**
+     * @brief 关联V8上下文并安装观察器
+     * 无论观察器是否可用都会关联上下文，之后可取JS堆与进程内存汇总
+     * @return 当前页面支持PerformanceObserver时返回true
+     */
+    bool install(CefRefPtr<CefV8Context> context);
+
+    /**
+     * @brief 上下文释放时解除关联
+     */
+    void detach();
+
+    bool isAttached() const { return m_context != nullptr; }
+
+    /**
+     * @brief 取出当前汇总并重置周期计数（LCP/CLS按页面累计，不重置）
+     */
+    PagePerformanceSummary takeSummary();
+
+    /**
+     * @brief 内存压力时释放可由原生代码释放的页面缓冲
+     * 清空资源计时缓冲并取走观察器中待处理的条目；JS堆由V8在空闲时自行回收
+     * @return 上下文不可用时返回false
+     */
+    bool releaseMemory();
+
+    // CefV8Handler接口：PerformanceObserver回调
+    bool Execute(const CefString& name, CefRefPtr<CefV8Value> object, const CefV8ValueList& arguments,
+                 CefRefPtr<CefV8Value>& retval, CefString& exception) override;
+
+private:
+    void handleEntry(CefRefPtr<CefV8Value> entry);
+    void readHeapUsage(PagePerformanceSummary* summary);
+    static double readResidentBytes();
+
+    CefRefPtr<CefV8Context> m_context;
+    CefRefPtr<CefV8Value> m_observer;
+    PagePerformanceSummary m_current;
+
+    IMPLEMENT_REFCOUNTING(PagePerformanceBridge);
+};
+
+#endif // PAGE_PERFORMANCE_BRIDGE_H
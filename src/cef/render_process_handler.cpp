@@ -0,0 +1,449 @@
+#include "render_process_handler.h"
+
+#include "include/cef_command_line.h"
+#include "include/base/cef_bind.h"
+#include "include/base/cef_logging.h"
+#include "include/wrapper/cef_closure_task.h"
+#include "include/wrapper/cef_helpers.h"
+
+#include "../core/process_info.h"
+
+#include <string>
+
+namespace {
+
+// extra_info中的启动参数位置
+enum StartupInfoIndex {
+    STARTUP_STRICT_SECURITY = 0,
+    STARTUP_REDUCE_LOGGING = 1
+};
+
+/**
+ * @brief 默认日志输出：写入CEF日志文件
+ */
+void writeCefLog(const char* category, const std::string& message, const char* filename,
+                 CEFRenderProcessHandler::LogLevel level)
+{
+    switch (level) {
+        case CEFRenderProcessHandler::LOG_ERROR:
+            LOG(ERROR) << "[" << category << "] " << message;
+            break;
+        case CEFRenderProcessHandler::LOG_WARNING:
+            LOG(WARNING) << "[" << category << "] " << message;
+            break;
+        default:
+            LOG(INFO) << "[" << category << "] " << message;
+            break;
+    }
+}
+
+/**
+ * @brief 页面脚本上报遥测事件的原生函数 __dtReport(type, code, value, detail)
+ * 页面只能上报安全钩子事件，其余类型由原生代码直接写入
+ */
+class TelemetryV8Handler : public CefV8Handler
+{
+public:
+    explicit TelemetryV8Handler(CEFRenderProcessHandler* handler) : m_handler(handler) {}
+
+    bool Execute(const CefString& name, CefRefPtr<CefV8Value> object, const CefV8ValueList& arguments,
+                 CefRefPtr<CefV8Value>& retval, CefString& exception) override
+    {
+        if (arguments.size() < 2 || !arguments[0]->IsInt() || !arguments[1]->IsInt()) {
+            return true;
+        }
+        if (arguments[0]->GetIntValue() != TELEMETRY_SECURITY) {
+            return true;
+        }
+
+        const double value = (arguments.size() > 2 && arguments[2]->IsDouble()) ? arguments[2]->GetDoubleValue() : 0.0;
+        const std::string detail = (arguments.size() > 3 && arguments[3]->IsString())
+            ? arguments[3]->GetStringValue().ToString() : std::string();
+        m_handler->recordTelemetry(TELEMETRY_SECURITY, static_cast<uint8_t>(arguments[1]->GetIntValue()), value, detail);
+        return true;
+    }
+
+private:
+    CEFRenderProcessHandler* m_handler;
+
+    IMPLEMENT_REFCOUNTING(TelemetryV8Handler);
+};
+
+} // namespace
+
+CEFRenderProcessHandler::CEFRenderProcessHandler(LogSink sink)
+    : m_sink(sink ? sink : &writeCefLog)
+    , m_strictSecurityMode(true)
+    , m_reduceLogging(false)
+    , m_browserCount(0)
+    , m_telemetryFlushScheduled(false)
+    , m_pagePerformance(new PagePerformanceBridge())
+    , m_perfSummaryScheduled(false)
+{
+}
+
+void CEFRenderProcessHandler::writeStartupInfo(CefRefPtr<CefListValue> extraInfo, bool strictSecurity, bool reduceLogging)
+{
+    extraInfo->SetBool(STARTUP_STRICT_SECURITY, strictSecurity);
+    extraInfo->SetBool(STARTUP_REDUCE_LOGGING, reduceLogging);
+}
+
+// ==================== CefRenderProcessHandler接口实现 ====================
+
+void CEFRenderProcessHandler::OnRenderThreadCreated(CefRefPtr<CefListValue> extra_info)
+{
+    CEF_REQUIRE_RENDERER_THREAD();
+
+    if (extra_info && extra_info->GetSize() > STARTUP_REDUCE_LOGGING) {
+        m_strictSecurityMode = extra_info->GetBool(STARTUP_STRICT_SECURITY);
+        m_reduceLogging = extra_info->GetBool(STARTUP_REDUCE_LOGGING);
+    }
+
+    if (!m_reduceLogging) {
+        appEvent("渲染线程创建");
+    }
+
+    // 独立渲染进程记录从进程创建到渲染线程就绪的耗时；单进程模式下没有type开关，跳过。
+    // 此时还没有主框架，记录留在批次缓冲中，随第一个上下文创建后发送
+    CefRefPtr<CefCommandLine> commandLine = CefCommandLine::GetGlobalCommandLine();
+    if (commandLine && commandLine->GetSwitchValue("type").ToString() == "renderer") {
+        const double startupMs = ProcessInfo::ageMs();
+        if (startupMs >= 0.0) {
+            recordTelemetry(TELEMETRY_PERF_ENTRY, PERF_RENDERER_STARTUP_MS, startupMs);
+        }
+    }
+}
+
+void CEFRenderProcessHandler::OnWebKitInitialized()
+{
+    CEF_REQUIRE_RENDERER_THREAD();
+
+    appEvent("WebKit初始化完成");
+
+    // 在这里可以注册自定义的JavaScript扩展
+    // 但在安全模式下，我们通常不需要额外的扩展
+}
+
+void CEFRenderProcessHandler::OnBrowserDestroyed(CefRefPtr<CefBrowser> browser)
+{
+    CEF_REQUIRE_RENDERER_THREAD();
+
+    m_browserCount--;
+
+    if (!m_reduceLogging) {
+        appEvent("渲染进程中浏览器销毁，ID: " + std::to_string(browser->GetIdentifier()) +
+                 "，剩余: " + std::to_string(m_browserCount));
+    }
+}
+
+CefRefPtr<CefLoadHandler> CEFRenderProcessHandler::GetLoadHandler()
+{
+    // 返回nullptr使用默认处理，或者返回自定义的LoadHandler
+    return nullptr;
+}
+
+void CEFRenderProcessHandler::OnContextCreated(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefRefPtr<CefV8Context> context)
+{
+    CEF_REQUIRE_RENDERER_THREAD();
+
+    if (frame->IsMain()) {
+        if (!m_reduceLogging) {
+            appEvent("V8上下文创建，浏览器ID: " + std::to_string(browser->GetIdentifier()));
+        }
+
+        // 遥测发送使用主框架，上报函数需在安全脚本之前安装
+        m_telemetryFrame = frame;
+        installTelemetryBridge(context);
+
+        // 页面性能观察：长任务/LCP/CLS在渲染进程聚合，连同内存占用周期性汇总上报
+        if (!m_pagePerformance->install(context) && !m_reduceLogging) {
+            appEvent("页面不支持PerformanceObserver，仅上报内存占用");
+        }
+        schedulePagePerformanceSummary();
+
+        // 注入安全脚本
+        if (m_strictSecurityMode) {
+            injectSecurityScript(context);
+        }
+    }
+}
+
+void CEFRenderProcessHandler::OnContextReleased(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefRefPtr<CefV8Context> context)
+{
+    CEF_REQUIRE_RENDERER_THREAD();
+
+    if (frame->IsMain()) {
+        // 上下文释放前发送最后一次页面性能汇总，并把缓冲中的遥测发送出去
+        if (m_pagePerformance->isAttached()) {
+            sendPagePerformanceSummary();
+            m_pagePerformance->detach();
+        }
+        flushTelemetry();
+        m_telemetryFrame = nullptr;
+
+        if (!m_reduceLogging) {
+            appEvent("V8上下文释放，浏览器ID: " + std::to_string(browser->GetIdentifier()));
+        }
+    }
+}
+
+void CEFRenderProcessHandler::OnUncaughtException(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefRefPtr<CefV8Context> context, CefRefPtr<CefV8Exception> exception, CefRefPtr<CefV8StackTrace> stackTrace)
+{
+    CEF_REQUIRE_RENDERER_THREAD();
+
+    // 记录JavaScript异常
+    logV8Exception(exception, stackTrace);
+
+    // 同时通过遥测通道汇报到浏览器进程
+    std::string detail = exception->GetMessage().ToString();
+    detail += " @ ";
+    detail += exception->GetScriptResourceName().ToString();
+    recordTelemetry(TELEMETRY_JS_ERROR, 0, exception->GetLineNumber(), detail);
+
+    // 在严格安全模式下，JavaScript异常可能表示安全问题
+    if (m_strictSecurityMode) {
+        log("安全警告", "检测到JavaScript异常，URL: " + frame->GetURL().ToString(), "security.log", LOG_WARNING);
+    }
+}
+
+bool CEFRenderProcessHandler::OnProcessMessageReceived(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefProcessId source_process, CefRefPtr<CefProcessMessage> message)
+{
+    CEF_REQUIRE_RENDERER_THREAD();
+
+    std::string messageName = message->GetName().ToString();
+
+    if (!m_reduceLogging) {
+        appEvent("收到进程消息: " + messageName);
+    }
+
+    // 处理安全相关消息
+    if (messageName.find("security") == 0) {
+        return handleSecurityMessage(message);
+    }
+
+    // 浏览器进程内存看门狗的压力通知：释放页面缓冲后立即上报一次新样本
+    if (messageName == kMemoryPressureMessageName) {
+        const bool released = m_pagePerformance->releaseMemory();
+        log("内存看门狗", released ? "收到内存压力通知，已清理页面性能缓冲" : "收到内存压力通知，页面上下文不可用",
+            "performance.log", LOG_INFO);
+        sendPagePerformanceSummary();
+        return true;
+    }
+
+    return false; // 未处理的消息
+}
+
+// ==================== 遥测 ====================
+
+void CEFRenderProcessHandler::recordTelemetry(TelemetryRecordType type, uint8_t code, double value, const std::string& detail)
+{
+    m_telemetryWriter.append(type, code, value, detail.data(), detail.size());
+
+    if (m_telemetryWriter.isFull()) {
+        flushTelemetry();
+    } else {
+        scheduleTelemetryFlush();
+    }
+}
+
+void CEFRenderProcessHandler::installTelemetryBridge(CefRefPtr<CefV8Context> context)
+{
+    CefRefPtr<CefV8Value> global = context->GetGlobal();
+    CefRefPtr<CefV8Handler> handler = new TelemetryV8Handler(this);
+    global->SetValue("__dtReport", CefV8Value::CreateFunction("__dtReport", handler),
+        static_cast<CefV8Value::PropertyAttribute>(
+            V8_PROPERTY_ATTRIBUTE_READONLY | V8_PROPERTY_ATTRIBUTE_DONTENUM | V8_PROPERTY_ATTRIBUTE_DONTDELETE));
+}
+
+void CEFRenderProcessHandler::scheduleTelemetryFlush()
+{
+    if (m_telemetryFlushScheduled) {
+        return;
+    }
+
+    m_telemetryFlushScheduled = true;
+    CefPostDelayedTask(TID_RENDERER, base::Bind(&CEFRenderProcessHandler::flushTelemetry, this),
+                       TelemetryBatchWriter::kFlushIntervalMs);
+}
+
+void CEFRenderProcessHandler::flushTelemetry()
+{
+    m_telemetryFlushScheduled = false;
+
+    // 没有可用主框架时保留缓冲，等待下一个上下文创建后发送
+    if (m_telemetryWriter.isEmpty() || !m_telemetryFrame || !m_telemetryFrame->IsValid()) {
+        return;
+    }
+
+    m_telemetryFrame->SendProcessMessage(PID_BROWSER, m_telemetryWriter.takeMessage());
+}
+
+void CEFRenderProcessHandler::schedulePagePerformanceSummary()
+{
+    if (m_perfSummaryScheduled) {
+        return;
+    }
+
+    m_perfSummaryScheduled = true;
+    CefPostDelayedTask(TID_RENDERER, base::Bind(&CEFRenderProcessHandler::onPagePerformanceTimer, this),
+                       PagePerformanceBridge::kSummaryIntervalMs);
+}
+
+void CEFRenderProcessHandler::onPagePerformanceTimer()
+{
+    m_perfSummaryScheduled = false;
+
+    if (m_pagePerformance->isAttached()) {
+        sendPagePerformanceSummary();
+        schedulePagePerformanceSummary();
+    }
+}
+
+void CEFRenderProcessHandler::sendPagePerformanceSummary()
+{
+    if (!m_pagePerformance->isAttached()) {
+        return;
+    }
+
+    const PagePerformanceSummary summary = m_pagePerformance->takeSummary();
+    recordTelemetry(TELEMETRY_PERF_ENTRY, PERF_LONG_TASK_COUNT, summary.longTaskCount);
+    recordTelemetry(TELEMETRY_PERF_ENTRY, PERF_LONG_TASK_TOTAL_MS, summary.longTaskTotalMs);
+    recordTelemetry(TELEMETRY_PERF_ENTRY, PERF_LONG_TASK_MAX_MS, summary.longTaskMaxMs);
+    recordTelemetry(TELEMETRY_PERF_ENTRY, PERF_LCP_MS, summary.largestContentfulPaintMs);
+    recordTelemetry(TELEMETRY_PERF_ENTRY, PERF_CLS, summary.cumulativeLayoutShift);
+    recordTelemetry(TELEMETRY_PERF_ENTRY, PERF_JS_HEAP_USED_BYTES, summary.jsHeapUsedBytes);
+    recordTelemetry(TELEMETRY_PERF_ENTRY, PERF_JS_HEAP_LIMIT_BYTES, summary.jsHeapLimitBytes);
+    recordTelemetry(TELEMETRY_PERF_ENTRY, PERF_RENDERER_RSS_BYTES, summary.rendererRssBytes);
+    recordTelemetry(TELEMETRY_PERF_ENTRY, PERF_RESOURCE_COUNT, summary.resourceCount);
+    recordTelemetry(TELEMETRY_PERF_ENTRY, PERF_RESOURCE_CACHED_COUNT, summary.resourceCachedCount);
+
+    // 汇总本身已是周期性的，不再额外等待批次刷新间隔
+    flushTelemetry();
+}
+
+// ==================== JavaScript安全控制 ====================
+
+void CEFRenderProcessHandler::injectSecurityScript(CefRefPtr<CefV8Context> context)
+{
+    // 禁用危险的API
+    disableDangerousAPIs(context);
+
+    // 设置安全监控
+    setupSecurityMonitoring(context);
+}
+
+void CEFRenderProcessHandler::disableDangerousAPIs(CefRefPtr<CefV8Context> context)
+{
+    CefRefPtr<CefV8Value> global = context->GetGlobal();
+
+    // 禁用一些可能被滥用的API
+    if (global->HasValue("eval")) {
+        global->SetValue("eval", CefV8Value::CreateUndefined(), V8_PROPERTY_ATTRIBUTE_READONLY);
+    }
+
+    // 禁用Function构造器
+    if (global->HasValue("Function")) {
+        CefRefPtr<CefV8Value> function = global->GetValue("Function");
+        if (function->IsFunction()) {
+            // 可以选择完全禁用或者替换为安全版本
+        }
+    }
+
+    // 限制window.open
+    if (global->HasValue("open")) {
+        global->SetValue("open", CefV8Value::CreateUndefined(), V8_PROPERTY_ATTRIBUTE_READONLY);
+    }
+}
+
+void CEFRenderProcessHandler::setupSecurityMonitoring(CefRefPtr<CefV8Context> context)
+{
+    // 设置JavaScript安全监控
+    // 可以在这里注入监控脚本，检测可疑行为
+
+    std::string monitoringScript = R"(
+        (function() {
+            // 通过原生遥测通道上报（类型1=安全事件，代码见TelemetrySecurityCode）
+            var report = window.__dtReport || function() {};
+
+            // 监控可疑的DOM操作
+            var originalCreateElement = document.createElement;
+            document.createElement = function(tag) {
+                if (tag === 'script' || tag === 'iframe') {
+                    report(1, 1, 0, String(tag));
+                }
+                return originalCreateElement.apply(this, arguments);
+            };
+
+            // 监控XHR请求
+            var originalXHR = window.XMLHttpRequest;
+            window.XMLHttpRequest = function() {
+                var xhr = new originalXHR();
+                var originalOpen = xhr.open;
+                xhr.open = function(method, url) {
+                    report(1, 2, 0, method + ' ' + url);
+                    return originalOpen.apply(this, arguments);
+                };
+                return xhr;
+            };
+        })();
+    )";
+
+    CefRefPtr<CefV8Value> result;
+    CefRefPtr<CefV8Exception> exception;
+    context->Eval(monitoringScript, "", 0, result, exception);
+
+    if (exception) {
+        errorEvent("安全监控脚本注入失败");
+    }
+}
+
+bool CEFRenderProcessHandler::handleSecurityMessage(CefRefPtr<CefProcessMessage> message)
+{
+    std::string messageName = message->GetName().ToString();
+
+    if (messageName == "security.violation") {
+        // 处理安全违规报告
+        CefRefPtr<CefListValue> args = message->GetArgumentList();
+        if (args->GetSize() > 0) {
+            log("安全违规", args->GetString(0).ToString(), "security.log", LOG_ERROR);
+        }
+        return true;
+    }
+
+    return false;
+}
+
+// ==================== 日志 ====================
+
+void CEFRenderProcessHandler::log(const char* category, const std::string& message, const char* filename, LogLevel level)
+{
+    m_sink(category, message, filename, level);
+}
+
+void CEFRenderProcessHandler::appEvent(const std::string& message)
+{
+    log("应用程序", message, "app.log", LOG_INFO);
+}
+
+void CEFRenderProcessHandler::errorEvent(const std::string& message)
+{
+    log("错误", message, "error.log", LOG_ERROR);
+}
+
+void CEFRenderProcessHandler::logV8Exception(CefRefPtr<CefV8Exception> exception, CefRefPtr<CefV8StackTrace> stackTrace)
+{
+    std::string errorMessage = "JavaScript异常: " + exception->GetMessage().ToString();
+
+    if (stackTrace) {
+        int frameCount = stackTrace->GetFrameCount();
+        for (int i = 0; i < frameCount && i < 5; ++i) { // 只记录前5帧
+            CefRefPtr<CefV8StackFrame> frame = stackTrace->GetFrame(i);
+            errorMessage += "\n  在 " + frame->GetScriptName().ToString() +
+                            ":" + std::to_string(frame->GetLineNumber()) +
+                            ":" + std::to_string(frame->GetColumn()) +
+                            " (" + frame->GetFunctionName().ToString() + ")";
+        }
+    }
+
+    errorEvent(errorMessage);
+}
@@ -0,0 +1,107 @@
+#ifndef RENDER_PROCESS_HANDLER_H
+#define RENDER_PROCESS_HANDLER_H
+
+#include "include/cef_render_process_handler.h"
+#include "include/cef_v8.h"
+
+#include <string>
+
+#include "telemetry_channel.h"
+#include "page_performance_bridge.h"
+
+/**
+ * @brief 渲染进程处理器
+ *
+ * 渲染进程侧的全部逻辑（安全脚本注入、遥测批次、页面性能观察、内存压力响应）。
+ * 只依赖CEF和标准库，不依赖Qt，因此既可由主程序的CEFApp使用（单进程模式及
+ * 未部署子进程程序时），也可链接进轻量子进程程序DesktopTerminal-CEF-Helper。
+ *
+ * 严格安全模式、精简日志等配置由浏览器进程在OnRenderProcessThreadCreated中
+ * 经extra_info传入（见writeStartupInfo），渲染进程不再自行探测系统环境。
+ */
+class CEFRenderProcessHandler : public CefRenderProcessHandler
+{
+public:
+    /**
+     * @brief 日志级别（取值与Logger的LogLevel一致）
+     */
+    enum LogLevel {
+        LOG_DEBUG = 0,
+        LOG_INFO = 1,
+        LOG_WARNING = 2,
+        LOG_ERROR = 3
+    };
+
+    /**
+     * @brief 日志输出函数：分类、消息、日志文件名、级别
+     * 未设置时写入CEF自身日志（settings.log_file，子进程同样生效）
+     */
+    typedef void (*LogSink)(const char* category, const std::string& message, const char* filename, LogLevel level);
+
+    explicit CEFRenderProcessHandler(LogSink sink = nullptr);
+
+    /**
+     * @brief 浏览器进程写入渲染进程启动参数（在OnRenderProcessThreadCreated中调用）
+     */
+    static void writeStartupInfo(CefRefPtr<CefListValue> extraInfo, bool strictSecurity, bool reduceLogging);
+
+    // CefRenderProcessHandler接口
+    virtual void OnRenderThreadCreated(CefRefPtr<CefListValue> extra_info) override;
+    virtual void OnWebKitInitialized() override;
+    virtual void OnBrowserDestroyed(CefRefPtr<CefBrowser> browser) override;
+    virtual CefRefPtr<CefLoadHandler> GetLoadHandler() override;
+    virtual void OnContextCreated(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefRefPtr<CefV8Context> context) override;
+    virtual void OnContextReleased(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefRefPtr<CefV8Context> context) override;
+    virtual void OnUncaughtException(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefRefPtr<CefV8Context> context, CefRefPtr<CefV8Exception> exception, CefRefPtr<CefV8StackTrace> stackTrace) override;
+    virtual bool OnProcessMessageReceived(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame, CefProcessId source_process, CefRefPtr<CefProcessMessage> message) override;
+
+    /**
+     * @brief 记录一条渲染进程遥测事件（仅渲染线程调用）
+     * 事件先写入批次缓冲，缓冲满或超过刷新间隔后合并发送到浏览器进程
+     */
+    void recordTelemetry(TelemetryRecordType type, uint8_t code, double value,
+                         const std::string& detail = std::string());
+
+private:
+    // JavaScript安全控制
+    void injectSecurityScript(CefRefPtr<CefV8Context> context);
+    void disableDangerousAPIs(CefRefPtr<CefV8Context> context);
+    void setupSecurityMonitoring(CefRefPtr<CefV8Context> context);
+
+    // 进程间通信
+    bool handleSecurityMessage(CefRefPtr<CefProcessMessage> message);
+    void installTelemetryBridge(CefRefPtr<CefV8Context> context);
+    void scheduleTelemetryFlush();
+    void flushTelemetry();
+    void schedulePagePerformanceSummary();
+    void onPagePerformanceTimer();
+    void sendPagePerformanceSummary();
+
+    // 日志
+    void log(const char* category, const std::string& message, const char* filename, LogLevel level);
+    void appEvent(const std::string& message);
+    void errorEvent(const std::string& message);
+    void logV8Exception(CefRefPtr<CefV8Exception> exception, CefRefPtr<CefV8StackTrace> stackTrace);
+
+private:
+    LogSink m_sink;
+
+    // 配置标志（由浏览器进程经extra_info下发）
+    bool m_strictSecurityMode;
+    bool m_reduceLogging;
+
+    int m_browserCount;
+
+    // 渲染进程遥测批次（仅渲染线程访问）
+    TelemetryBatchWriter m_telemetryWriter;
+    CefRefPtr<CefFrame> m_telemetryFrame;
+    bool m_telemetryFlushScheduled;
+
+    // 主框架页面性能观察（仅渲染线程访问）
+    CefRefPtr<PagePerformanceBridge> m_pagePerformance;
+    bool m_perfSummaryScheduled;
+
+    IMPLEMENT_REFCOUNTING(CEFRenderProcessHandler);
+};
+
+#endif // RENDER_PROCESS_HANDLER_H
@@ -0,0 +1,55 @@
+// DesktopTerminal-CEF-Helper：CEF子进程（渲染、GPU、工具进程）专用入口
+//
+// 主程序启动子进程时默认重新执行自身，每个子进程都要加载Qt等与子进程无关的依赖。
+// 本程序只链接libcef和cef_dll_wrapper，渲染进程逻辑与主程序共用CEFRenderProcessHandler，
+// 由CEFManager通过settings.browser_subprocess_path指定；未部署时回退为主程序自身。
+
+#include "include/cef_app.h"
+
+#include "render_process_handler.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace {
+
+/**
+ * @brief 子进程CefApp：只提供渲染进程处理器
+ * 命令行开关由浏览器进程在启动子进程时传入，这里不再处理
+ */
+class SubprocessApp : public CefApp
+{
+public:
+    SubprocessApp() : m_renderHandler(new CEFRenderProcessHandler()) {}
+
+    CefRefPtr<CefRenderProcessHandler> GetRenderProcessHandler() override { return m_renderHandler; }
+
+private:
+    CefRefPtr<CEFRenderProcessHandler> m_renderHandler;
+
+    IMPLEMENT_REFCOUNTING(SubprocessApp);
+};
+
+} // namespace
+
+#ifdef _WIN32
+int APIENTRY wWinMain(HINSTANCE hInstance, HINSTANCE, LPWSTR, int)
+{
+    // 与主程序保持一致的DPI感知，GPU进程依赖它计算缩放
+    CefEnableHighDPISupport();
+
+    CefMainArgs mainArgs(hInstance);
+#else
+int main(int argc, char* argv[])
+{
+    CefMainArgs mainArgs(argc, argv);
+#endif
+
+    CefRefPtr<SubprocessApp> app(new SubprocessApp());
+
+    // 子进程一定带有--type开关，CefExecuteProcess返回其退出码；
+    // 被误当作浏览器进程直接启动时返回-1，此处按失败退出
+    const int exitCode = CefExecuteProcess(mainArgs, app.get(), nullptr);
+    return exitCode >= 0 ? exitCode : 1;
+}
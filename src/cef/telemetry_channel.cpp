@@ -0,0 +1,165 @@
+#include "telemetry_channel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+const char kTelemetryMessageName[] = "telemetry.batch";
+const char kMemoryPressureMessageName[] = "memory.pressure";
+
+namespace {
+
+const size_t kBatchHeaderSize = 8;   // version + reserved + recordCount + sequence
+const size_t kRecordHeaderSize = 16; // type + code + detailLength + timestampMs + value
+
+template <typename T>
+void writeValue(std::vector<uint8_t>& buffer, size_t offset, T value)
+{
+    std::memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+void appendValue(std::vector<uint8_t>& buffer, T value)
+{
+    const size_t offset = buffer.size();
+    buffer.resize(offset + sizeof(T));
+    writeValue(buffer, offset, value);
+}
+
+template <typename T>
+T readValue(const std::vector<uint8_t>& buffer, size_t offset)
+{
+    T value;
+    std::memcpy(&value, buffer.data() + offset, sizeof(T));
+    return value;
+}
+
+uint32_t monotonicMs()
+{
+    using namespace std::chrono;
+    return static_cast<uint32_t>(
+        duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+// ==================== TelemetryBatchWriter ====================
+
+TelemetryBatchWriter::TelemetryBatchWriter()
+    : m_recordCount(0)
+    , m_sequence(0)
+{
+    m_buffer.reserve(kFlushBytes + kRecordHeaderSize + kMaxDetailBytes);
+    resetBuffer();
+}
+
+void TelemetryBatchWriter::append(TelemetryRecordType type, uint8_t code, double value,
+                                  const char* detail, size_t detailLength)
+{
+    if (m_recordCount >= kMaxRecordsPerBatch) {
+        return; // 调用方应在isFull()后及时发送，这里只做保护
+    }
+
+    const uint16_t length = static_cast<uint16_t>(
+        detail ? std::min(detailLength, kMaxDetailBytes) : 0);
+
+    appendValue<uint8_t>(m_buffer, type);
+    appendValue<uint8_t>(m_buffer, code);
+    appendValue<uint16_t>(m_buffer, length);
+    appendValue<uint32_t>(m_buffer, monotonicMs());
+    appendValue<double>(m_buffer, value);
+    if (length > 0) {
+        m_buffer.insert(m_buffer.end(), detail, detail + length);
+    }
+
+    m_recordCount++;
+    writeValue<uint16_t>(m_buffer, 2, m_recordCount);
+}
+
+bool TelemetryBatchWriter::isFull() const
+{
+    return m_buffer.size() >= kFlushBytes || m_recordCount >= kMaxRecordsPerBatch;
+}
+
+CefRefPtr<CefProcessMessage> TelemetryBatchWriter::takeMessage()
+{
+    CefRefPtr<CefProcessMessage> message = CefProcessMessage::Create(kTelemetryMessageName);
+    message->GetArgumentList()->SetBinary(0, CefBinaryValue::Create(m_buffer.data(), m_buffer.size()));
+
+    m_sequence++;
+    resetBuffer();
+    return message;
+}
+
+void TelemetryBatchWriter::resetBuffer()
+{
+    m_buffer.clear();
+    m_recordCount = 0;
+    appendValue<uint8_t>(m_buffer, kWireVersion);
+    appendValue<uint8_t>(m_buffer, 0);
+    appendValue<uint16_t>(m_buffer, 0);
+    appendValue<uint32_t>(m_buffer, m_sequence);
+}
+
+// ==================== TelemetryBatchReader ====================
+
+TelemetryBatchReader::TelemetryBatchReader(CefRefPtr<CefProcessMessage> message)
+    : m_offset(kBatchHeaderSize)
+    , m_valid(false)
+    , m_recordCount(0)
+    , m_recordsRead(0)
+    , m_sequence(0)
+{
+    if (!message) {
+        return;
+    }
+
+    CefRefPtr<CefListValue> args = message->GetArgumentList();
+    if (!args || args->GetSize() < 1 || args->GetType(0) != VTYPE_BINARY) {
+        return;
+    }
+
+    CefRefPtr<CefBinaryValue> binary = args->GetBinary(0);
+    const size_t size = binary ? binary->GetSize() : 0;
+    if (size < kBatchHeaderSize) {
+        return;
+    }
+
+    m_buffer.resize(size);
+    binary->GetData(m_buffer.data(), size, 0);
+
+    if (readValue<uint8_t>(m_buffer, 0) != TelemetryBatchWriter::kWireVersion) {
+        return;
+    }
+
+    m_recordCount = readValue<uint16_t>(m_buffer, 2);
+    m_sequence = readValue<uint32_t>(m_buffer, 4);
+    m_valid = true;
+}
+
+bool TelemetryBatchReader::next(TelemetryRecord* record)
+{
+    if (!m_valid || m_recordsRead >= m_recordCount ||
+        m_offset + kRecordHeaderSize > m_buffer.size()) {
+        return false;
+    }
+
+    const uint16_t detailLength = readValue<uint16_t>(m_buffer, m_offset + 2);
+    if (m_offset + kRecordHeaderSize + detailLength > m_buffer.size()) {
+        m_valid = false; // 数据截断，丢弃剩余记录
+        return false;
+    }
+
+    record->type = static_cast<TelemetryRecordType>(readValue<uint8_t>(m_buffer, m_offset));
+    record->code = readValue<uint8_t>(m_buffer, m_offset + 1);
+    record->detailLength = detailLength;
+    record->timestampMs = readValue<uint32_t>(m_buffer, m_offset + 4);
+    record->value = readValue<double>(m_buffer, m_offset + 8);
+    record->detail = detailLength > 0
+        ? reinterpret_cast<const char*>(m_buffer.data() + m_offset + kRecordHeaderSize)
+        : nullptr;
+
+    m_offset += kRecordHeaderSize + detailLength;
+    m_recordsRead++;
+    return true;
+}
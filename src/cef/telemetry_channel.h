@@ -0,0 +1,151 @@
+#ifndef TELEMETRY_CHANNEL_H
+#define TELEMETRY_CHANNEL_H
+
+#include "include/cef_process_message.h"
+#include "include/cef_values.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 渲染进程 -> 浏览器进程遥测IPC通道
+ *
+ * 渲染进程把安全钩子、性能条目、JS错误等事件写入批次缓冲，按大小或时间合并发送；
+ * 浏览器进程按记录逐条解码，不做逐条字符串格式化。
+ *
+ * 消息名为 kTelemetryMessageName，参数0为CefBinaryValue，二进制格式（小端）：
+ *   批次头：uint8 version | uint8 reserved | uint16 recordCount | uint32 sequence
+ *   记录头：uint8 type | uint8 code | uint16 detailLength | uint32 timestampMs | double value
+ *   记录体：detailLength 字节 UTF-8 详情（可为空）
+ *
+ * 本模块只依赖CEF与标准库，可同时用于主程序和独立子进程。
+ */
+
+extern const char kTelemetryMessageName[];
+
+// 浏览器进程 -> 渲染进程：内存看门狗压力通知（无参数）
+extern const char kMemoryPressureMessageName[];
+
+/**
+ * @brief 遥测记录类型
+ */
+enum TelemetryRecordType : uint8_t {
+    TELEMETRY_SECURITY = 1,   // 页面安全钩子触发（code见TelemetrySecurityCode）
+    TELEMETRY_PERF_ENTRY = 2, // 页面性能条目（code见TelemetryPerfCode，value为数值）
+    TELEMETRY_JS_ERROR = 3    // 未捕获的JavaScript异常（value为行号）
+};
+
+/**
+ * @brief 安全钩子事件代码
+ */
+enum TelemetrySecurityCode : uint8_t {
+    SECURITY_SUSPICIOUS_ELEMENT = 1, // 动态创建script/iframe
+    SECURITY_XHR_REQUEST = 2,        // 页面发起XHR请求
+    SECURITY_BLOCKED_API = 3         // 调用已禁用的API
+};
+
+/**
+ * @brief 页面性能汇总代码（渲染进程周期性上报，value为对应数值）
+ */
+enum TelemetryPerfCode : uint8_t {
+    PERF_LONG_TASK_COUNT = 1,      // 本周期长任务数
+    PERF_LONG_TASK_TOTAL_MS = 2,   // 本周期长任务总时长
+    PERF_LONG_TASK_MAX_MS = 3,     // 本周期最长任务时长
+    PERF_LCP_MS = 4,               // 当前页面最大内容绘制时间
+    PERF_CLS = 5,                  // 当前页面累计布局偏移
+    PERF_JS_HEAP_USED_BYTES = 6,   // JS堆已用字节数
+    PERF_JS_HEAP_LIMIT_BYTES = 7,  // JS堆上限字节数
+    PERF_RENDERER_RSS_BYTES = 8,   // 渲染进程常驻内存字节数
+    PERF_RENDERER_STARTUP_MS = 9,  // 渲染进程从创建到渲染线程就绪的耗时（每个进程一次）
+    PERF_RESOURCE_COUNT = 10,      // 本周期可判断来源的资源请求数
+    PERF_RESOURCE_CACHED_COUNT = 11 // 其中由缓存提供的请求数
+};
+
+/**
+ * @brief 解码后的单条遥测记录（detail指向批次缓冲区，仅在读取期间有效）
+ */
+struct TelemetryRecord {
+    TelemetryRecordType type;
+    uint8_t code;
+    uint32_t timestampMs;
+    double value;
+    const char* detail;
+    uint16_t detailLength;
+};
+
+/**
+ * @brief 遥测批次写入器（渲染进程使用）
+ */
+class TelemetryBatchWriter
+{
+public:
+    static constexpr uint8_t kWireVersion = 1;
+    static constexpr size_t kFlushBytes = 4096;       // 缓冲达到该大小立即发送
+    static constexpr int kFlushIntervalMs = 1000;     // 否则最多延迟该时间发送
+    static constexpr size_t kMaxDetailBytes = 512;    // 单条详情截断长度
+    static constexpr uint16_t kMaxRecordsPerBatch = 512;
+
+    TelemetryBatchWriter();
+
+    /**
+     * @brief 追加一条记录
+     */
+    void append(TelemetryRecordType type, uint8_t code, double value,
+                const char* detail = nullptr, size_t detailLength = 0);
+
+    /**
+     * @brief 是否已达到按大小发送的阈值
+     */
+    bool isFull() const;
+
+    bool isEmpty() const { return m_recordCount == 0; }
+    uint16_t recordCount() const { return m_recordCount; }
+
+    /**
+     * @brief 生成进程消息并清空缓冲
+     */
+    CefRefPtr<CefProcessMessage> takeMessage();
+
+private:
+    void resetBuffer();
+
+    std::vector<uint8_t> m_buffer;
+    uint16_t m_recordCount;
+    uint32_t m_sequence;
+};
+
+/**
+ * @brief 遥测批次读取器（浏览器进程使用）
+ */
+class TelemetryBatchReader
+{
+public:
+    explicit TelemetryBatchReader(CefRefPtr<CefProcessMessage> message);
+
+    /**
+     * @brief 批次头是否有效且版本匹配
+     */
+    bool isValid() const { return m_valid; }
+
+    uint32_t sequence() const { return m_sequence; }
+    uint16_t recordCount() const { return m_recordCount; }
+    size_t byteSize() const { return m_buffer.size(); }
+
+    /**
+     * @brief 读取下一条记录
+     * @return 没有更多记录或数据截断时返回false
+     */
+    bool next(TelemetryRecord* record);
+
+private:
+    std::vector<uint8_t> m_buffer;
+    size_t m_offset;
+    bool m_valid;
+    uint16_t m_recordCount;
+    uint16_t m_recordsRead;
+    uint32_t m_sequence;
+};
+
+#endif // TELEMETRY_CHANNEL_H
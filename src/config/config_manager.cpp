@@ -212,6 +212,25 @@ QString ConfigManager::getProcessModel() const
     return config.value("processModel").toString("process-per-site");
 }
 
+QString ConfigManager::getMemoryProfileOverride() const
+{
+    // minimal / balanced / performance，为空表示按系统自动选择
+    return config.value("memoryProfile").toString().trimmed().toLower();
+}
+
+QStringList ConfigManager::getWarmCacheUrls() const
+{
+    // 缓存预热模式（--warm-cache）在主URL之外额外访问的页面
+    QStringList urls;
+    for (const QJsonValue& value : config.value("warmCacheUrls").toArray()) {
+        const QString url = value.toString().trimmed();
+        if (!url.isEmpty()) {
+            urls << url;
+        }
+    }
+    return urls;
+}
+
 // CEF特定配置
 QString ConfigManager::getCEFLogLevel() const
 {
@@ -228,6 +247,12 @@ int ConfigManager::getCEFCacheSizeMB() const
     return config.value("cefCacheSizeMB").toInt(128);
 }
 
+int ConfigManager::getCEFCacheSizeOverrideMB() const
+{
+    // 配置文件显式给出时返回其值，未配置返回0表示沿用内存配置档
+    return config.value("cefCacheSizeMB").toInt(0);
+}
+
 bool ConfigManager::isCEFWebSecurityEnabled() const
 {
     return config.value("cefWebSecurityEnabled").toBool(true);
@@ -342,4 +367,124 @@ QStringList ConfigManager::getBackupCheckUrls() const
 int ConfigManager::getNetworkCheckTimeout() const
 {
     return config.value("networkCheckTimeout").toInt(5000);
-}
\ No newline at end of file
+}
+
+QString ConfigManager::getNetworkProbeMethod() const
+{
+    // head：只取响应头；range：GET bytes=0-0；get：完整GET（收到响应头即中止）
+    return config.value("networkProbeMethod").toString("head").trimmed().toLower();
+}
+
+bool ConfigManager::isDnsPreresolveEnabled() const
+{
+    return config.value("dnsPreresolveEnabled").toBool(true);
+}
+
+int ConfigManager::getConnectivityCacheTtlMs() const
+{
+    // 连通结论的复用时长，启动期间的多次检测共享一次探测
+    return config.value("connectivityCacheTtlMs").toInt(30000);
+}
+
+int ConfigManager::getRetryBaseDelayMs() const
+{
+    // 网络重试退避的起始等待时间
+    return config.value("retryBaseDelayMs").toInt(1000);
+}
+
+int ConfigManager::getRetryMaxDelayMs() const
+{
+    return config.value("retryMaxDelayMs").toInt(30000);
+}
+
+bool ConfigManager::isNetworkMonitorEnabled() const
+{
+    return config.value("networkMonitorEnabled").toBool(true);
+}
+
+int ConfigManager::getNetworkMonitorMinIntervalMs() const
+{
+    // 网络变差时的探测间隔
+    return config.value("networkMonitorMinIntervalMs").toInt(5000);
+}
+
+int ConfigManager::getNetworkMonitorMaxIntervalMs() const
+{
+    // 网络良好时间隔逐步拉长到此上限
+    return config.value("networkMonitorMaxIntervalMs").toInt(60000);
+}
+
+int ConfigManager::getDnsCacheTtlSeconds() const
+{
+    // 预解析结果在磁盘上的有效期，过期后须等待实时解析
+    return config.value("dnsCacheTtlSeconds").toInt(3600);
+}
+
+bool ConfigManager::isProxyCacheEnabled() const
+{
+    // 关闭后Qt保持直连，CEF自行发现代理（旧行为）
+    return config.value("proxyCacheEnabled").toBool(true);
+}
+
+int ConfigManager::getProxyCacheTtlSeconds() const
+{
+    return config.value("proxyCacheTtlSeconds").toInt(86400);
+}
+
+QString ConfigManager::getProxyBypassList() const
+{
+    // Chromium --proxy-bypass-list格式，分号分隔
+    return config.value("proxyBypassList").toString("<local>");
+}
+
+bool ConfigManager::isNetworkBenchmarkEnabled() const
+{
+    return config.value("networkBenchmarkEnabled").toBool(true);
+}
+
+QString ConfigManager::getNetworkBenchmarkUrl() const
+{
+    const QString url = config.value("networkBenchmarkUrl").toString().trimmed();
+    return url.isEmpty() ? getUrl() : url;
+}
+
+QString ConfigManager::getNetworkBenchmarkDownloadUrl() const
+{
+    // 最好指向考试页面实际加载的较大静态资源（如脚本包），考试页面本身往往太小
+    const QString url = config.value("networkBenchmarkDownloadUrl").toString().trimmed();
+    return url.isEmpty() ? getNetworkBenchmarkUrl() : url;
+}
+
+qint64 ConfigManager::getNetworkBenchmarkDownloadBytes() const
+{
+    return static_cast<qint64>(config.value("networkBenchmarkDownloadBytes").toDouble(512 * 1024));
+}
+
+int ConfigManager::getNetworkBenchmarkSamples() const
+{
+    return config.value("networkBenchmarkSamples").toInt(5);
+}
+
+int ConfigManager::getNetworkBenchmarkBudgetMs() const
+{
+    // 测量总时长上限，超出后用已得到的样本评估
+    return config.value("networkBenchmarkBudgetMs").toInt(3000);
+}
+
+int ConfigManager::getNetworkBenchmarkJitterMs() const
+{
+    // 同一考场的终端几乎同时启动，错开测量请求，避免同一时刻集中打到考试服务器
+    return qMax(0, config.value("networkBenchmarkJitterMs").toInt(2000));
+}
+
+int ConfigManager::getNetworkRttWarningMs() const
+{
+    // RTT p90超过该值时警告
+    return config.value("networkRttWarningMs").toInt(300);
+}
+
+int ConfigManager::getNetworkThroughputWarningKbps() const
+{
+    // 吞吐量低于该值时警告
+    return config.value("networkThroughputWarningKbps").toInt(2000);
+}
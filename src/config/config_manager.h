@@ -59,11 +59,14 @@ public:
     int getMaxMemoryMB() const;
     bool isLowMemoryMode() const;
     QString getProcessModel() const;
+    QString getMemoryProfileOverride() const;
+    QStringList getWarmCacheUrls() const;
 
     // CEF特定配置（新增）
     QString getCEFLogLevel() const;
     bool isCEFSingleProcessMode() const;
     int getCEFCacheSizeMB() const;
+    int getCEFCacheSizeOverrideMB() const;
     bool isCEFWebSecurityEnabled() const;
     QString getCEFUserAgent() const;
 
@@ -88,6 +91,29 @@ public:
     QString getCheckUrl() const;
     QStringList getBackupCheckUrls() const;
     int getNetworkCheckTimeout() const;
+    QString getNetworkProbeMethod() const;   // head / range / get
+    bool isDnsPreresolveEnabled() const;
+    int getDnsCacheTtlSeconds() const;
+    bool isProxyCacheEnabled() const;
+    int getProxyCacheTtlSeconds() const;
+    QString getProxyBypassList() const;
+    int getConnectivityCacheTtlMs() const;
+    int getRetryBaseDelayMs() const;
+    int getRetryMaxDelayMs() const;
+
+    // 考试期间网络质量监控配置
+    bool isNetworkMonitorEnabled() const;
+    int getNetworkMonitorMinIntervalMs() const;
+    int getNetworkMonitorMaxIntervalMs() const;
+    bool isNetworkBenchmarkEnabled() const;
+    QString getNetworkBenchmarkUrl() const;          // 为空时使用考试URL
+    QString getNetworkBenchmarkDownloadUrl() const;  // 为空时使用测量URL
+    qint64 getNetworkBenchmarkDownloadBytes() const;
+    int getNetworkBenchmarkSamples() const;
+    int getNetworkBenchmarkBudgetMs() const;
+    int getNetworkBenchmarkJitterMs() const;         // 开始前的随机等待上限，不计入预算
+    int getNetworkRttWarningMs() const;
+    int getNetworkThroughputWarningKbps() const;
 
     // 架构和兼容性配置（新增）
     bool isAutoArchDetectionEnabled() const;
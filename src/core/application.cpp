@@ -1,9 +1,18 @@
 #include "application.h"
 #include "cef_manager.h"
 #include "secure_browser.h"
+#include "cache_warmer.h"
+#include "single_instance.h"
+#include "startup_task_graph.h"
+#include "hardware_calibration.h"
 #include "../logging/logger.h"
 #include "../config/config_manager.h"
 #include "../network/network_checker.h"
+#include "../network/connectivity_service.h"
+#include "../network/link_state_monitor.h"
+#include "../network/network_quality_monitor.h"
+#include "../network/dns_preresolver.h"
+#include "../network/proxy_resolver.h"
 
 #include <QDir>
 #include <QStandardPaths>
@@ -12,7 +21,9 @@
 #include <QVersionNumber>
 #include <QTimer>
 #include <QElapsedTimer>
-#include <QEventLoop>
+#include <QUrl>
+#include <QSharedPointer>
+#include <QHostInfo>
 
 #ifdef Q_OS_WIN
 #include <windows.h>
@@ -20,6 +31,28 @@
 #include "../security/windows_key_blocker.h"
 #endif
 
+namespace {
+
+/**
+ * @brief 启动任务对应的加载对话框状态文字
+ */
+QString startupTaskDescription(const QString& name)
+{
+    if (name == "logging") return "正在初始化日志系统...";
+    if (name == "systemRequirements") return "正在检查系统兼容性...";
+    if (name == "hardwareCalibration") return "正在评估硬件性能...";
+    if (name == "compatibility") return "正在应用兼容性设置...";
+    if (name == "configuration") return "正在加载配置文件...";
+    if (name == "networkCheck") return "正在检查网络连接...";
+    if (name == "targetResolve") return "正在预解析目标主机...";
+    if (name == "proxyResolve") return "正在解析代理配置...";
+    if (name == "cef") return "正在加载CEF浏览器引擎...";
+    if (name == "securityControls") return "正在启用系统级安全控制...";
+    return QString("正在执行%1...").arg(name);
+}
+
+} // namespace
+
 // 静态成员初始化
 Application::ArchType Application::s_architecture = Application::ArchType::Unknown;
 Application::PlatformType Application::s_platform = Application::PlatformType::Unknown;
@@ -33,15 +66,20 @@ Application::Application(int &argc, char **argv, int originalArgc, char **origin
     , m_mainWindow(nullptr)
     , m_logger(nullptr)
     , m_configManager(nullptr)
-    , m_networkChecker(nullptr)
+    , m_networkMonitor(nullptr)
+    , m_startupGraph(nullptr)
+    , m_pageRetryTimer(nullptr)
+    , m_pageRetryWaitingForLink(false)
     , m_keyboardFilter(nullptr) // 初始化
 #ifdef Q_OS_WIN
     , m_windowsKeyBlocker(nullptr) // 初始化Windows键拦截器
 #endif
     , m_lockFile(nullptr)
     , m_lockAcquired(false)
+    , m_instanceServer(nullptr)
     , m_initialized(false)
     , m_shutdownRequested(false)
+    , m_warmCacheMode(CacheWarmer::isRequested(originalArgc, originalArgv))
     , m_sharedCEFApp(nullptr)
     , m_originalArgc(originalArgc)
     , m_originalArgv(originalArgv)
@@ -63,6 +101,12 @@ Application::Application(int &argc, char **argv, int originalArgc, char **origin
     m_lockFile->setStaleLockTime(0);
 
     if (!m_lockFile->tryLock(100)) {
+        if (m_warmCacheMode) {
+            // 预热模式无界面，只能写日志：终端实例运行中时缓存目录被占用，预热没有意义
+            Logger::instance().errorEvent("缓存预热: 应用程序已经在运行中，无法预热缓存");
+            QTimer::singleShot(0, this, [this]() { exit(1); });
+            return;
+        }
         QMessageBox::warning(
             nullptr,
             "程序已运行",
@@ -74,6 +118,14 @@ Application::Application(int &argc, char **argv, int originalArgc, char **origin
 
     m_lockAcquired = true;
 
+    // 重复启动的进程经本地套接字把参数转交过来后立即退出（见main中的forwardToRunningInstance）
+    if (!m_warmCacheMode) {
+        m_instanceServer = new SingleInstanceServer(this);
+        connect(m_instanceServer, &SingleInstanceServer::instanceLaunched,
+                this, &Application::onInstanceLaunched);
+        m_instanceServer->listen();
+    }
+
     // 检测系统信息
     detectSystemInfo();
 
@@ -98,75 +150,165 @@ void Application::setSharedCEFApp(CefRefPtr<CEFApp> cefApp)
     m_sharedCEFApp = cefApp;
 }
 
-bool Application::initialize()
+void Application::startInitialization()
 {
     if (m_initialized) {
-        return true;
+        emit initializationCompleted();
+        return;
     }
 
     // 检查单实例锁是否成功获取
     if (!m_lockAcquired) {
-        return false;
+        emit initializationError("应用程序已经在运行中");
+        return;
     }
 
-    // 1. 初始化日志系统
-    emit initializationProgress("正在初始化日志系统...");
-    if (!initializeLogging()) {
-        emit initializationError("日志系统初始化失败");
-        return false;
+    if (m_startupGraph && m_startupGraph->isRunning()) {
+        return;
     }
 
-    m_logger->appEvent("应用程序开始初始化...");
-    logSystemInfo();
+    delete m_startupGraph;
+    m_startupGraph = new StartupTaskGraph(this);
+    connect(m_startupGraph, &StartupTaskGraph::taskStarted, this, [this](const QString& name) {
+        emit initializationProgress(startupTaskDescription(name));
+    });
+    connect(m_startupGraph, &StartupTaskGraph::finished, this, &Application::onStartupGraphFinished);
 
-    // 2. 检查系统要求
-    emit initializationProgress("正在检查系统兼容性...");
-    if (!checkSystemRequirements()) {
-        m_logger->errorEvent("系统要求检查失败");
+    typedef StartupTaskGraph::Affinity Affinity;
+
+    m_startupGraph->addTask("logging", QStringList(), Affinity::UiThread, [this]() {
+        if (!initializeLogging()) {
+            return false;
+        }
+        m_logger->appEvent("应用程序开始初始化...");
+        logSystemInfo();
+        return true;
+    });
+
+    // 系统要求只读取构造时检测好的系统信息，不触碰界面对象
+    m_startupGraph->addTask("systemRequirements", QStringList(), Affinity::AnyThread, []() {
+        return checkSystemRequirements();
+    });
+
+    // 首次运行的硬件标定耗时较长，放到工作线程，CEFManager构造时直接读取结果
+    m_startupGraph->addTask("hardwareCalibration", QStringList() << "logging", Affinity::AnyThread, []() {
+        HardwareCalibration::instance().result();
+        return true;
+    });
+
+    m_startupGraph->addTask("compatibility", QStringList() << "logging", Affinity::UiThread, [this]() {
+        applyCompatibilitySettings();
+        return true;
+    });
+
+    m_startupGraph->addTask("configuration", QStringList() << "logging", Affinity::UiThread, [this]() {
+        return initializeConfiguration();
+    });
+
+    // 代理须在网络检测和CefInitialize之前确定，Qt与CEF走同一代理
+    m_startupGraph->addAsyncTask("proxyResolve", QStringList() << "configuration",
+                                 [this](StartupTaskGraph::Completion done) {
+        startProxyResolve(done);
+    });
+
+    // 网络检测与CEF初始化并行：检测期间主线程空闲，可以先完成CEF初始化
+    m_startupGraph->addAsyncTask("networkCheck", QStringList() << "configuration" << "proxyResolve",
+                                 [this](StartupTaskGraph::Completion done) {
+        startNetworkCheck(done);
+    });
+
+    // 目标主机预解析与代理解析并行，解析结果通过命令行交给CEF
+    m_startupGraph->addAsyncTask("targetResolve", QStringList() << "configuration",
+                                 [this](StartupTaskGraph::Completion done) {
+        startTargetResolve(done);
+    });
+
+    // CEF初始化顺序：
+    // - 代理是硬前提（CefInitialize之后无法更改），等待proxyResolve；
+    // - 主机固定只是优化，不等待targetResolve的超时上限：CEF就绪时预解析提前结束，
+    //   已验证的主机照常固定，其余交由CEF实时解析（同一次事件处理内同步写入规则）
+    m_startupGraph->addTask("cef",
+        QStringList() << "systemRequirements" << "hardwareCalibration" << "compatibility" << "configuration"
+                      << "proxyResolve",
+        Affinity::UiThread, [this]() {
+        if (m_targetResolver) {
+            m_targetResolver->finishNow();
+        }
+        return initializeCEF();
+    });
+
+#ifdef Q_OS_WIN
+    m_startupGraph->addTask("securityControls", QStringList() << "logging", Affinity::UiThread, [this]() {
+        return initializeWindowsSecurityControls();
+    });
+#endif
+
+    m_startupGraph->start();
+}
+
+void Application::onStartupGraphFinished(bool success, const QString& failedTask)
+{
+    if (success) {
+        m_initialized = true;
+        m_logger->appEvent("应用程序初始化完成");
+        emit initializationCompleted();
+        return;
+    }
+
+    Logger& logger = Logger::instance();
+    if (failedTask == "systemRequirements") {
+        logger.errorEvent("系统要求检查失败");
         emit initializationError("系统兼容性检查失败\n" + getCompatibilityReport());
-        QMessageBox::critical(nullptr, "系统要求不满足", 
+        QMessageBox::critical(nullptr, "系统要求不满足",
             getCompatibilityReport() + "\n\n应用程序将退出。");
+    } else if (failedTask == "networkCheck") {
+        logger.errorEvent("网络检查失败");
+        emit initializationError("网络连接失败，请检查网络设置");
+        QMessageBox::critical(nullptr, "网络错误", "无法连接到指定服务器，请检查您的网络连接。");
+    } else if (failedTask == "configuration") {
+        logger.errorEvent("配置初始化失败");
+        emit initializationError("配置文件加载失败");
+    } else if (failedTask == "cef") {
+        logger.errorEvent("CEF初始化失败");
+        emit initializationError("CEF浏览器引擎初始化失败");
+    } else if (failedTask == "logging") {
+        emit initializationError("日志系统初始化失败");
+    } else {
+        logger.errorEvent(QString("应用程序初始化失败: %1").arg(failedTask));
+        emit initializationError("应用程序初始化失败\n请查看日志文件");
+    }
+}
+
+bool Application::initializeForCacheWarmup()
+{
+    if (m_initialized) {
+        return true;
+    }
+
+    if (!m_lockAcquired) {
+        return false;
+    }
+
+    if (!initializeLogging()) {
         return false;
     }
 
-    // 3. 应用兼容性设置
-    emit initializationProgress("正在应用兼容性设置...");
+    m_logger->appEvent("应用程序以缓存预热模式初始化...");
+    logSystemInfo();
     applyCompatibilitySettings();
 
-    // 4. 初始化配置管理
-    emit initializationProgress("正在加载配置文件...");
     if (!initializeConfiguration()) {
         m_logger->errorEvent("配置初始化失败");
-        emit initializationError("配置文件加载失败");
-        return false;
-    }
-
-    // 5. 网络连接检查
-    emit initializationProgress("正在检查网络连接...");
-    if (!checkNetworkConnection()) {
-        m_logger->errorEvent("网络检查失败");
-        emit initializationError("网络连接失败，请检查网络设置");
-        QMessageBox::critical(nullptr, "网络错误", "无法连接到指定服务器，请检查您的网络连接。");
         return false;
     }
 
-    // 6. 初始化CEF
-    emit initializationProgress("正在加载CEF浏览器引擎...");
     if (!initializeCEF()) {
         m_logger->errorEvent("CEF初始化失败");
-        emit initializationError("CEF浏览器引擎初始化失败");
         return false;
     }
 
-#ifdef Q_OS_WIN
-    // 7. 安装Windows键拦截器
-    emit initializationProgress("正在启用系统级安全控制...");
-    initializeWindowsSecurityControls();
-#endif
-
     m_initialized = true;
-    m_logger->appEvent("应用程序初始化完成");
-    emit initializationCompleted();
+    m_logger->appEvent("缓存预热模式初始化完成");
     return true;
 }
 
@@ -182,6 +324,7 @@ bool Application::startMainWindow()
     }
 
     m_logger->appEvent("主窗口启动成功");
+    startNetworkMonitor();
     return true;
 }
 
@@ -202,11 +345,23 @@ void Application::shutdown()
         m_logger->appEvent("应用程序开始关闭...");
     }
 
+    // 启动任务图析构时只等待自己仍在运行的工作线程任务，避免回调到已销毁的对象；
+    // 代理解析等使用独立线程池，退出时不等待
+    if (m_startupGraph) {
+        delete m_startupGraph;
+        m_startupGraph = nullptr;
+    }
+
+    // 停止网络质量监控
+    if (m_networkMonitor) {
+        m_networkMonitor->stop();
+        delete m_networkMonitor;
+        m_networkMonitor = nullptr;
+    }
+
     // 停止网络检测
-    if (m_networkChecker) {
-        m_networkChecker->stopCheck();
-        delete m_networkChecker;
-        m_networkChecker = nullptr;
+    if (ConnectivityService::hasInstance()) {
+        ConnectivityService::instance().cancel();
     }
 
     // 销毁键盘过滤器
@@ -425,6 +580,130 @@ void Application::onAboutToQuit()
     shutdown();
 }
 
+void Application::onHostUnreachable(const QString& host, const QString& failedUrl)
+{
+    if (m_shutdownRequested || !m_mainWindow) {
+        return;
+    }
+
+    // 考试中不重启进程（会丢失页面状态）：多数情况只是断网或服务器暂时不可用，按退避在会话内重新加载，
+    // 各终端的重试时间相互错开
+    m_pageRetryUrl = failedUrl;
+    m_pageRetryWaitingForLink = false;
+    const int delay = m_pageRetry.recordFailure();
+    m_pageRetryTimer->start(delay);
+    m_logger->logEvent("页面恢复", QString("%1 连接失败，%2ms后重新加载（连续失败%3次）")
+        .arg(host).arg(delay).arg(m_pageRetry.failures()), "network.log", L_WARNING);
+
+    if (m_pinnedAddresses.contains(host)) {
+        verifyPinnedHost(host);
+    }
+}
+
+void Application::retryFailedPage()
+{
+    if (m_shutdownRequested || !m_mainWindow || m_pageRetryUrl.isEmpty()) {
+        return;
+    }
+
+    // 断网期间重新加载只会再失败一次，等链路恢复后再试
+    if (!LinkStateMonitor::instance().hasUsableLink()) {
+        m_pageRetryWaitingForLink = true;
+        m_logger->logEvent("页面恢复", "网络链路不可用，链路恢复后重新加载", "network.log", L_INFO);
+        return;
+    }
+
+    m_pageRetryWaitingForLink = false;
+    m_logger->logEvent("页面恢复", QString("重新加载: %1").arg(m_pageRetryUrl), "network.log", L_INFO);
+    m_mainWindow->load(QUrl(m_pageRetryUrl));
+}
+
+void Application::verifyPinnedHost(const QString& host)
+{
+    if (m_pinChecksInFlight.contains(host)) {
+        return;
+    }
+
+    // 只有网络确实正常时实时解析的结果才可信：断网、DNS不可用时的连接错误不说明固定地址失效
+    if (!LinkStateMonitor::instance().hasUsableLink()) {
+        m_logger->logEvent("目标预解析", QString("%1 连接失败时网络链路不可用，保留固定地址").arg(host),
+                           "network.log", L_INFO);
+        return;
+    }
+
+    m_pinChecksInFlight.insert(host);
+    ConnectivityService::instance().requestCheck(this, [this, host](NetworkChecker::NetworkStatus status, const QString&) {
+        if (status != NetworkChecker::Connected || !LinkStateMonitor::instance().hasUsableLink()) {
+            m_pinChecksInFlight.remove(host);
+            m_logger->logEvent("目标预解析", QString("%1 连接失败时网络未连通，保留固定地址").arg(host),
+                               "network.log", L_INFO);
+            return;
+        }
+
+        QHostInfo::lookupHost(host, this, [this, host](const QHostInfo& info) {
+            m_pinChecksInFlight.remove(host);
+            const QHostAddress pinned = m_pinnedAddresses.value(host);
+            if (info.error() != QHostInfo::NoError || info.addresses().isEmpty()) {
+                m_logger->logEvent("目标预解析", QString("%1 实时解析失败，保留固定地址: %2")
+                    .arg(host).arg(info.errorString()), "network.log", L_WARNING);
+                return;
+            }
+            if (info.addresses().contains(pinned)) {
+                m_logger->logEvent("目标预解析", QString("%1 固定地址%2与实时解析一致，仅在会话内重试")
+                    .arg(host).arg(pinned.toString()), "network.log", L_INFO);
+                return;
+            }
+
+            // 地址确已变化：删除缓存，下次正常启动按实时解析固定；本次运行的规则无法修改，也不重启
+            DnsPreresolver::forgetHost(host);
+            m_pinnedAddresses.remove(host);
+            QStringList live;
+            for (const QHostAddress& address : info.addresses()) {
+                live << address.toString();
+            }
+            m_logger->errorEvent(QString("%1 固定地址%2已失效（实时解析: %3），已删除DNS缓存，下次启动不再使用该地址")
+                .arg(host).arg(pinned.toString()).arg(live.join(',')));
+        });
+    });
+}
+
+void Application::onInstanceLaunched(const QStringList& arguments, double launchMs)
+{
+    Logger& logger = Logger::instance();
+    logger.appEvent(QString("检测到重复启动，参数已转交: %1").arg(arguments.join(' ')));
+    if (launchMs >= 0) {
+        logger.logEvent("单实例", QString("重复启动转交耗时: %1ms").arg(launchMs, 0, 'f', 1),
+                        "performance.log", L_INFO);
+    }
+
+    if (!m_mainWindow) {
+        logger.appEvent("主窗口尚未创建，忽略重复启动请求");
+        return;
+    }
+
+    // 只接受与配置目标同源的URL，其他进程不能借此把考试窗口导航到任意站点
+    const QString urlPrefix = "--url=";
+    for (const QString& argument : arguments) {
+        if (!argument.startsWith(urlPrefix)) {
+            continue;
+        }
+        const QUrl requested(argument.mid(urlPrefix.length()));
+        const QUrl configured(m_configManager ? m_configManager->getUrl() : QString());
+        if (requested.isValid() && requested.scheme() == configured.scheme()
+            && requested.host() == configured.host() && requested.port() == configured.port()) {
+            logger.appEvent(QString("按重复启动请求切换页面: %1").arg(requested.toString()));
+            m_mainWindow->load(requested);
+        } else {
+            logger.errorEvent(QString("拒绝重复启动请求的非同源URL: %1").arg(requested.toString()));
+        }
+        break;
+    }
+
+    m_mainWindow->show();
+    m_mainWindow->raise();
+    m_mainWindow->activateWindow();
+}
+
 bool Application::initializeLogging()
 {
     try {
@@ -476,7 +755,30 @@ bool Application::initializeConfiguration()
 bool Application::initializeCEF()
 {
     try {
-        m_cefManager = new CEFManager(this, m_sharedCEFApp);
+        // 重试时复用已创建的管理器，CefInitialize每个进程只能调用一次
+        if (!m_cefManager) {
+            m_cefManager = new CEFManager(this, m_sharedCEFApp);
+            m_cefManager->setWindowlessRenderingEnabled(m_warmCacheMode);
+            connect(m_cefManager, &CEFManager::hostUnreachable, this, &Application::onHostUnreachable);
+            connect(m_cefManager, &CEFManager::mainFrameLoaded, this, [this]() {
+                m_pageRetry.recordSuccess();
+                m_pageRetryTimer->stop();
+                m_pageRetryUrl.clear();
+                m_pageRetryWaitingForLink = false;
+            });
+
+            m_pageRetryTimer = new QTimer(this);
+            m_pageRetryTimer->setSingleShot(true);
+            connect(m_pageRetryTimer, &QTimer::timeout, this, &Application::retryFailedPage);
+            m_pageRetry.setDelays(m_configManager->getRetryBaseDelayMs(), m_configManager->getRetryMaxDelayMs());
+
+            // 链路恢复时立即补上断网期间推迟的重新加载
+            connect(&LinkStateMonitor::instance(), &LinkStateMonitor::usableLinkChanged, this, [this](bool usable, const QString&) {
+                if (usable && m_pageRetryWaitingForLink && !m_pageRetryTimer->isActive()) {
+                    m_pageRetryTimer->start(static_cast<int>(m_pageRetry.remainingMs()));
+                }
+            });
+        }
         return m_cefManager->initialize();
     } catch (...) {
         if (m_logger) {
@@ -486,33 +788,170 @@ bool Application::initializeCEF()
     }
 }
 
-#include <QEventLoop>
-bool Application::checkNetworkConnection()
+void Application::startNetworkCheck(std::function<void(bool)> done)
 {
-    m_networkChecker = new NetworkChecker(this);
+    // 加载对话框的系统检测已提前发起探测，这里复用同一结果
+    ConnectivityService& connectivity = ConnectivityService::instance();
+    connectivity.requestCheck(this, [this, done](NetworkChecker::NetworkStatus status, const QString&) {
+        if (status != NetworkChecker::Connected) {
+            m_logger->errorEvent(QString("网络检查失败: %1").arg(ConnectivityService::instance().statusDescription()));
+            done(false);
+            return;
+        }
 
-    // 从配置中获取检测URL
-    QString checkUrl = m_configManager->getCheckUrl();
-    QStringList backupUrls = m_configManager->getBackupCheckUrls();
-    int timeout = m_configManager->getNetworkCheckTimeout();
+        m_logger->appEvent("网络连接正常");
+        done(true);
+    });
+}
 
-    m_networkChecker->setCheckUrls(backupUrls);
+void Application::startTargetResolve(std::function<void(bool)> done)
+{
+    // 预解析失败不影响启动，任何情况下都报告成功，未固定的主机由CEF自行解析
+    if (!m_configManager->isDnsPreresolveEnabled() || !m_sharedCEFApp) {
+        done(true);
+        return;
+    }
+    if (arguments().contains(QString(DnsPreresolver::kNoPinSwitch))) {
+        m_logger->logEvent("目标预解析", "已指定--no-dns-pin，本次不固定主机", "performance.log", L_WARNING);
+        done(true);
+        return;
+    }
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    // 解析器挂在Application下：超时后实时解析仍在后台完成并刷新磁盘缓存
+    DnsPreresolver* resolver = new DnsPreresolver(this);
+    resolver->setCacheTtlSeconds(m_configManager->getDnsCacheTtlSeconds());
+    m_targetResolver = resolver;
+    connect(resolver, &DnsPreresolver::finished, this, [this, resolver, done, elapsed](const QString& rules) {
+        m_targetResolver = nullptr;
+        if (m_cefManager) {
+            // CEF已开始初始化，规则不再生效；结果只用于刷新磁盘缓存
+            m_logger->logEvent("目标预解析", QString("CEF已初始化，本次不固定主机（%1ms）").arg(elapsed.elapsed()),
+                               "performance.log", L_INFO);
+            done(true);
+            return;
+        }
+        if (!rules.isEmpty()) {
+            m_sharedCEFApp->setHostResolverRules(rules);
+            for (const QString& host : resolver->pinnedHosts()) {
+                m_pinnedAddresses.insert(host, resolver->pinnedAddress(host));
+            }
+        }
+        m_logger->logEvent("目标预解析",
+            rules.isEmpty()
+                ? QString("未固定任何主机，交由CEF自行解析（%1ms）").arg(elapsed.elapsed())
+                : QString("%1（%2ms）").arg(rules).arg(elapsed.elapsed()),
+            "performance.log", rules.isEmpty() ? L_WARNING : L_INFO);
+        done(true);
+    });
+
+    resolver->start(QList<QUrl>() << QUrl(m_configManager->getUrl()) << QUrl(m_configManager->getCheckUrl()),
+                    kTargetResolveTimeoutMs);
+}
+
+void Application::prepareProxy(std::function<void()> ready)
+{
+    ConfigManager& config = ConfigManager::instance();
+    if (!config.isProxyCacheEnabled()) {
+        ready();
+        return;
+    }
 
-    QEventLoop loop;
-    connect(m_networkChecker, &NetworkChecker::checkCompleted, &loop, &QEventLoop::quit);
+    ProxyResolver& resolver = ProxyResolver::instance();
+    resolver.setCacheTtlSeconds(config.getProxyCacheTtlSeconds());
 
-    m_networkChecker->startCheck(checkUrl, timeout);
-    loop.exec(); // 等待网络检测完成
+    QSharedPointer<QMetaObject::Connection> connection(new QMetaObject::Connection);
+    *connection = connect(&resolver, &ProxyResolver::ready, this, [ready, connection](bool) {
+        disconnect(*connection);
+        ready();
+    });
 
-    NetworkChecker::NetworkStatus status = m_networkChecker->getNetworkStatus();
-    
-    if (status != NetworkChecker::Connected) {
-        m_logger->errorEvent(QString("网络检查失败: %1").arg(m_networkChecker->getStatusDescription()));
-        return false;
+    resolver.resolve(QUrl(config.getUrl()), kProxyResolveTimeoutMs);
+}
+
+void Application::onProxyChanged(const QString& description)
+{
+    if (m_cefManager || !m_sharedCEFApp) {
+        m_logger->logEvent("代理解析", QString("代理已变化: %1，CEF沿用启动时的代理直到下次启动").arg(description),
+                           "network.log", L_WARNING);
+        return;
     }
 
-    m_logger->appEvent("网络连接正常");
-    return true;
+    // CefInitialize之前到达的实时结果替换缓存结论
+    ProxyResolver& resolver = ProxyResolver::instance();
+    m_sharedCEFApp->setProxyConfig(resolver.chromiumProxyServer(), m_configManager->getProxyBypassList(),
+                                   resolver.pacUrl());
+    m_logger->logEvent("代理解析", QString("CEF初始化前代理已更新: %1").arg(description), "network.log", L_INFO);
+}
+
+void Application::startProxyResolve(std::function<void(bool)> done)
+{
+    // 代理解析失败或超时不影响启动：Qt保持原代理，CEF自行发现代理
+    if (!m_configManager->isProxyCacheEnabled() || !m_sharedCEFApp) {
+        done(true);
+        return;
+    }
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    ProxyResolver& resolver = ProxyResolver::instance();
+    resolver.setCacheTtlSeconds(m_configManager->getProxyCacheTtlSeconds());
+
+    QSharedPointer<QMetaObject::Connection> connection(new QMetaObject::Connection);
+    *connection = connect(&resolver, &ProxyResolver::ready, this, [this, done, elapsed, connection](bool resolved) {
+        disconnect(*connection);
+        ProxyResolver& resolver = ProxyResolver::instance();
+        if (resolved) {
+            m_sharedCEFApp->setProxyConfig(resolver.chromiumProxyServer(), m_configManager->getProxyBypassList(),
+                                           resolver.pacUrl());
+            connect(&resolver, &ProxyResolver::proxyChanged, this, &Application::onProxyChanged, Qt::UniqueConnection);
+        }
+        m_logger->logEvent("代理解析",
+            QString("%1（%2ms）").arg(resolved ? resolver.description() : QString("超时，交由CEF自行发现"))
+                .arg(elapsed.elapsed()),
+            "performance.log", resolved ? L_INFO : L_WARNING);
+        done(true);
+    });
+
+    resolver.resolve(QUrl(m_configManager->getUrl()), kProxyResolveTimeoutMs);
+}
+
+void Application::startNetworkMonitor()
+{
+    if (m_networkMonitor || !m_configManager->isNetworkMonitorEnabled()) {
+        return;
+    }
+
+    m_networkMonitor = new NetworkQualityMonitor(this);
+    m_networkMonitor->setTarget(m_configManager->getUrl());
+    m_networkMonitor->setIntervals(m_configManager->getNetworkMonitorMinIntervalMs(),
+                                   m_configManager->getNetworkMonitorMaxIntervalMs());
+
+    connect(m_networkMonitor, &NetworkQualityMonitor::qualityChanged, this,
+            [this](NetworkQualityMonitor::Quality quality, NetworkQualityMonitor::Quality) {
+        if (quality == NetworkQualityMonitor::QualityDegraded || quality == NetworkQualityMonitor::QualityOffline) {
+            const NetworkQualityMonitor::Metrics metrics = m_networkMonitor->metrics();
+            m_logger->errorEvent(QString("考试期间网络质量%1: SRTT=%2ms 抖动=%3ms 丢包率=%4%")
+                .arg(NetworkQualityMonitor::qualityName(quality))
+                .arg(metrics.srttMs, 0, 'f', 0)
+                .arg(metrics.jitterMs, 0, 'f', 0)
+                .arg(metrics.lossRate * 100.0, 0, 'f', 1));
+        }
+    });
+
+    connect(&LinkStateMonitor::instance(), &LinkStateMonitor::usableLinkChanged, this,
+            [this](bool usable, const QString& summary) {
+        if (usable) {
+            m_logger->appEvent(QString("考试期间网络链路恢复: %1").arg(summary));
+        } else {
+            m_logger->errorEvent(QString("考试期间网络链路断开: %1").arg(summary));
+        }
+    });
+
+    m_networkMonitor->start();
 }
 
 bool Application::createMainWindow()
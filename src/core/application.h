@@ -6,15 +6,26 @@
 #include <QVersionNumber>
 #include <QThread>
 #include <QLockFile>
+#include <QPointer>
+#include <QHash>
+#include <QSet>
+#include <QHostAddress>
+
+#include <functional>
 
 #include "../security/keyboard_filter.h"
 #include "../cef/cef_app_impl.h"
+#include "../network/retry_scheduler.h"
 
 class CEFManager;
 class SecureBrowser;
 class Logger;
 class ConfigManager;
-class NetworkChecker;
+class NetworkQualityMonitor;
+class SingleInstanceServer;
+class StartupTaskGraph;
+class DnsPreresolver;
+class QTimer;
 #ifdef Q_OS_WIN
 class WindowsKeyBlocker;
 #endif
@@ -64,10 +75,20 @@ public:
     ~Application();
 
     /**
-     * @brief 初始化应用程序（同步版本）
-     * @return 成功返回true，失败返回false
+     * @brief 开始初始化应用程序（异步）
+     *
+     * 初始化步骤按依赖关系组成任务图执行，互不依赖的步骤并行，
+     * 结束后发出initializationCompleted或initializationError。
+     */
+    void startInitialization();
+
+    /**
+     * @brief 在系统检测之前解析系统代理，确定后（缓存命中、解析完成或超时）调用ready
+     *
+     * 系统检测的网络探测与CEF须走同一代理；未启用代理缓存时立即调用ready。
+     * 启动任务图中的proxyResolve复用这次解析，不会重复发起。
      */
-    bool initialize();
+    void prepareProxy(std::function<void()> ready);
 
 
     /**
@@ -87,6 +108,22 @@ public:
      */
     SecureBrowser* getMainWindow() const;
 
+    /**
+     * @brief 缓存预热模式的初始化：日志、配置和离屏CEF，跳过网络检测、主窗口和系统安全控制
+     * @return 成功返回true，失败返回false
+     */
+    bool initializeForCacheWarmup();
+
+    /**
+     * @brief 是否以缓存预热模式（--warm-cache）运行
+     */
+    bool isWarmCacheMode() const { return m_warmCacheMode; }
+
+    /**
+     * @brief 获取CEF管理器，初始化之前返回nullptr
+     */
+    CEFManager* getCEFManager() const { return m_cefManager; }
+
     // 系统信息获取
     static ArchType getSystemArchitecture();
     static PlatformType getSystemPlatform();
@@ -114,15 +151,51 @@ signals:
 
 private slots:
     void onAboutToQuit();
+
+    /**
+     * @brief 处理重复启动进程转交的参数：提到前台，或按--url=切换到同源页面
+     */
+    void onInstanceLaunched(const QStringList& arguments, double launchMs);
+
+    /**
+     * @brief 主框架连接失败：按退避在会话内重新加载；主机固定了地址时核实地址是否仍有效
+     */
+    void onHostUnreachable(const QString& host, const QString& failedUrl);
+
+    /**
+     * @brief 退避到期：链路可用时重新加载失败的页面，否则等链路恢复
+     */
+    void retryFailedPage();
+
+    /**
+     * @brief 系统代理结论变化：CEF尚未初始化时改用新结论，否则CEF沿用启动时的代理
+     */
+    void onProxyChanged(const QString& description);
+
+    /**
+     * @brief 启动任务图结束
+     */
+    void onStartupGraphFinished(bool success, const QString& failedTask);
     
 
 private:
+    // 目标主机预解析（含地址验证）最长等待时间，超时后交由CEF自行解析；
+    // CEF初始化先于此时间开始时提前结束，见startInitialization中的任务顺序说明
+    static constexpr int kTargetResolveTimeoutMs = 1000;
+
+    // 无缓存时等待系统代理/PAC解析的上限，超时后CEF自行发现代理
+    static constexpr int kProxyResolveTimeoutMs = 1500;
+
     // 初始化步骤
     bool initializeLogging();
     bool initializeConfiguration();
     bool initializeCEF();
-    bool checkNetworkConnection();
+    void startNetworkCheck(std::function<void(bool)> done);
+    void startTargetResolve(std::function<void(bool)> done);
+    void startProxyResolve(std::function<void(bool)> done);
     bool createMainWindow();
+    void startNetworkMonitor();
+    void verifyPinnedHost(const QString& host);
     
 
     // 系统检测
@@ -164,8 +237,24 @@ private:
     Logger* m_logger;
     ConfigManager* m_configManager;
     
-    // 网络检测器
-    NetworkChecker* m_networkChecker;
+    // 考试期间网络质量监控（主窗口启动后运行）
+    NetworkQualityMonitor* m_networkMonitor;
+
+    // 启动任务图（初始化期间存在）
+    StartupTaskGraph* m_startupGraph;
+
+    // 进行中的目标主机预解析（CEF初始化开始时提前结束）
+    QPointer<DnsPreresolver> m_targetResolver;
+
+    // 本次交给CEF固定的主机及地址；连接失败时以实时解析核实，不一致时只影响下次启动
+    QHash<QString, QHostAddress> m_pinnedAddresses;
+    QSet<QString> m_pinChecksInFlight;
+
+    // 主框架连接失败后的会话内重试
+    RetryScheduler m_pageRetry;
+    QTimer* m_pageRetryTimer;
+    QString m_pageRetryUrl;
+    bool m_pageRetryWaitingForLink;
 
     // 键盘过滤器
     KeyboardFilter* m_keyboardFilter;
@@ -174,6 +263,9 @@ private:
     QLockFile* m_lockFile;
     bool m_lockAcquired;
 
+    // 单实例转交监听（接收重复启动进程的参数）
+    SingleInstanceServer* m_instanceServer;
+
 #ifdef Q_OS_WIN
     // Windows键拦截器
     WindowsKeyBlocker* m_windowsKeyBlocker;
@@ -188,6 +280,7 @@ private:
 
     bool m_initialized;
     bool m_shutdownRequested;
+    bool m_warmCacheMode;
     CefRefPtr<CEFApp> m_sharedCEFApp;
     int m_originalArgc;
     char** m_originalArgv;
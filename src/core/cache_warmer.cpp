@@ -0,0 +1,483 @@
+#include "cache_warmer.h"
+#include "application.h"
+#include "cef_manager.h"
+#include "../logging/logger.h"
+#include "process_info.h"
+#include "../config/config_manager.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
+#include <QUrl>
+
+#include "include/cef_client.h"
+#include "include/cef_life_span_handler.h"
+#include "include/cef_load_handler.h"
+#include "include/cef_render_handler.h"
+
+namespace {
+const char kWarmCacheSwitch[] = "--warm-cache";
+const char kWarmCacheUrlPrefix[] = "--warm-cache-url=";
+const char kWarmCacheUrlsOnlySwitch[] = "--warm-cache-urls-only";
+const char kWarmCacheReportPrefix[] = "--warm-cache-report=";
+const int kViewWidth = 1280;
+const int kViewHeight = 800;
+}
+
+/**
+ * @brief 预热专用的离屏浏览器客户端
+ *
+ * 只关心主框架加载结果和浏览器生命周期，绘制结果直接丢弃，弹出窗口一律拦截。
+ * multi_threaded_message_loop=false时回调都在Qt主线程的CefDoMessageLoopWork内执行，
+ * 因此经QTimer::singleShot排队后再交给CacheWarmer，避免在CEF回调中重入消息循环。
+ */
+class WarmupClient : public CefClient,
+                     public CefLifeSpanHandler,
+                     public CefLoadHandler,
+                     public CefRenderHandler
+{
+public:
+    explicit WarmupClient(CacheWarmer* owner) : m_owner(owner) {}
+
+    void detach() { m_owner = nullptr; }
+
+    // CefClient接口
+    CefRefPtr<CefLifeSpanHandler> GetLifeSpanHandler() override { return this; }
+    CefRefPtr<CefLoadHandler> GetLoadHandler() override { return this; }
+    CefRefPtr<CefRenderHandler> GetRenderHandler() override { return this; }
+
+    // CefLifeSpanHandler接口
+    bool OnBeforePopup(CefRefPtr<CefBrowser>, CefRefPtr<CefFrame>, const CefString&, const CefString&,
+                       CefLifeSpanHandler::WindowOpenDisposition, bool, const CefPopupFeatures&,
+                       CefWindowInfo&, CefRefPtr<CefClient>&, CefBrowserSettings&,
+                       CefRefPtr<CefDictionaryValue>&, bool*) override
+    {
+        return true;
+    }
+
+    void OnAfterCreated(CefRefPtr<CefBrowser> browser) override
+    {
+        CacheWarmer* owner = m_owner;
+        if (owner) {
+            QTimer::singleShot(0, owner, [owner, browser]() { owner->onBrowserCreated(browser); });
+        }
+    }
+
+    void OnBeforeClose(CefRefPtr<CefBrowser>) override
+    {
+        CacheWarmer* owner = m_owner;
+        if (owner) {
+            QTimer::singleShot(0, owner, [owner]() { owner->onBrowserClosed(); });
+        }
+    }
+
+    // CefLoadHandler接口
+    void OnLoadEnd(CefRefPtr<CefBrowser>, CefRefPtr<CefFrame> frame, int httpStatusCode) override
+    {
+        CacheWarmer* owner = m_owner;
+        if (owner && frame && frame->IsMain()) {
+            QTimer::singleShot(0, owner, [owner, httpStatusCode]() { owner->onMainFrameLoaded(httpStatusCode); });
+        }
+    }
+
+    void OnLoadError(CefRefPtr<CefBrowser>, CefRefPtr<CefFrame> frame, ErrorCode errorCode,
+                     const CefString& errorText, const CefString&) override
+    {
+        // 重新加载或跳转时前一次导航会以ERR_ABORTED结束，不算失败
+        if (errorCode == ERR_ABORTED) {
+            return;
+        }
+        CacheWarmer* owner = m_owner;
+        if (owner && frame && frame->IsMain()) {
+            const QString text = QString::fromStdString(errorText.ToString());
+            const int code = static_cast<int>(errorCode);
+            QTimer::singleShot(0, owner, [owner, code, text]() { owner->onMainFrameLoadError(code, text); });
+        }
+    }
+
+    // CefRenderHandler接口：固定视口，丢弃绘制结果
+    void GetViewRect(CefRefPtr<CefBrowser>, CefRect& rect) override
+    {
+        rect = CefRect(0, 0, kViewWidth, kViewHeight);
+    }
+
+    void OnPaint(CefRefPtr<CefBrowser>, PaintElementType, const RectList&, const void*, int, int) override {}
+
+private:
+    CacheWarmer* m_owner;
+
+    IMPLEMENT_REFCOUNTING(WarmupClient);
+};
+
+CacheWarmer::CacheWarmer(Application* app, QObject* parent)
+    : QObject(parent)
+    , m_application(app)
+    , m_logger(&Logger::instance())
+    , m_cefManager(nullptr)
+    , m_client(nullptr)
+    , m_browser(nullptr)
+    , m_browserCreationPending(false)
+    , m_messageLoopTimer(new QTimer(this))
+    , m_pageTimer(new QTimer(this))
+    , m_settleTimer(new QTimer(this))
+    , m_currentIndex(0)
+    , m_stage(Stage::Idle)
+    , m_reloaded(false)
+    , m_succeeded(0)
+    , m_failed(0)
+    , m_browserCreateMs(-1)
+{
+    m_messageLoopTimer->setInterval(kMessageLoopIntervalMs);
+    m_pageTimer->setSingleShot(true);
+    m_settleTimer->setSingleShot(true);
+    m_settleTimer->setInterval(kSettleDelayMs);
+
+    connect(m_messageLoopTimer, &QTimer::timeout, this, &CacheWarmer::pumpMessageLoop);
+    connect(m_pageTimer, &QTimer::timeout, this, &CacheWarmer::onPageTimeout);
+    connect(m_settleTimer, &QTimer::timeout, this, &CacheWarmer::onSettled);
+}
+
+CacheWarmer::~CacheWarmer()
+{
+    if (m_client) {
+        m_client->detach();
+    }
+}
+
+bool CacheWarmer::isRequested(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (argv[i] && qstrcmp(argv[i], kWarmCacheSwitch) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QStringList CacheWarmer::urlsFromArguments(const QStringList& arguments)
+{
+    QStringList urls;
+    const QString prefix = QString::fromLatin1(kWarmCacheUrlPrefix);
+    for (const QString& argument : arguments) {
+        if (argument.startsWith(prefix)) {
+            urls << argument.mid(prefix.length()).trimmed();
+        }
+    }
+    return urls;
+}
+
+QString CacheWarmer::reportPathFromArguments(const QStringList& arguments)
+{
+    const QString prefix = QString::fromLatin1(kWarmCacheReportPrefix);
+    for (const QString& argument : arguments) {
+        if (argument.startsWith(prefix)) {
+            return argument.mid(prefix.length()).trimmed();
+        }
+    }
+    return QString();
+}
+
+void CacheWarmer::start()
+{
+    m_totalElapsed.start();
+    m_logger->appEvent("=== 缓存预热模式 ===");
+
+    ConfigManager& config = ConfigManager::instance();
+    const QStringList arguments = QCoreApplication::arguments();
+    QStringList candidates;
+    if (!arguments.contains(QString::fromLatin1(kWarmCacheUrlsOnlySwitch))) {
+        candidates << config.getUrl();
+        candidates << config.getWarmCacheUrls();
+    }
+    candidates << urlsFromArguments(arguments);
+
+    for (const QString& candidate : candidates) {
+        const QUrl url(candidate);
+        if (!url.isValid() || url.scheme().isEmpty()) {
+            if (!candidate.isEmpty()) {
+                m_logger->errorEvent(QString("缓存预热: 忽略无效URL: %1").arg(candidate));
+            }
+            continue;
+        }
+        if (!m_urls.contains(candidate)) {
+            m_urls << candidate;
+        }
+    }
+
+    if (m_urls.isEmpty()) {
+        m_logger->errorEvent("缓存预热: 没有可访问的URL");
+        QCoreApplication::exit(1);
+        return;
+    }
+
+    if (!m_application->initializeForCacheWarmup()) {
+        m_logger->errorEvent("缓存预热: CEF初始化失败");
+        QCoreApplication::exit(1);
+        return;
+    }
+
+    m_cefManager = m_application->getCEFManager();
+
+    // 缓存目录被占用或损坏时CEFManager会改用临时目录，预热结果无法留存
+    if (m_cefManager->isUsingTemporaryCache()) {
+        m_logger->errorEvent(QString("缓存预热: 持久缓存目录不可用（是否有终端实例正在运行？），当前使用临时目录: %1")
+                             .arg(m_cefManager->getCachePath()));
+        QCoreApplication::exit(1);
+        return;
+    }
+
+    m_logger->appEvent(QString("缓存预热: 缓存目录 %1，共%2个URL，内存配置%3")
+                       .arg(m_cefManager->getCachePath()).arg(m_urls.size())
+                       .arg(CEFManager::memoryProfileName(m_cefManager->getMemoryProfile())));
+
+    m_client = new WarmupClient(this);
+    m_messageLoopTimer->start();
+    m_currentIndex = 0;
+    loadCurrentUrl();
+}
+
+void CacheWarmer::loadCurrentUrl()
+{
+    const QString url = m_urls.at(m_currentIndex);
+    m_stage = Stage::Loading;
+    m_reloaded = false;
+    m_pageElapsed.start();
+    m_loadElapsed.start();
+    m_pageTimer->start(kPageTimeoutMs);
+
+    PageTiming timing;
+    timing.url = url;
+    m_timings.append(timing);
+
+    m_logger->appEvent(QString("缓存预热: [%1/%2] 加载 %3").arg(m_currentIndex + 1).arg(m_urls.size()).arg(url));
+
+    if (!m_browser) {
+        if (m_browserCreationPending) {
+            // 上一个页面在浏览器创建完成前已超时：复用创建中的浏览器，创建完成后再跳转
+            return;
+        }
+        m_browserCreationPending = true;
+        m_browserInitialUrl = url;
+        if (!m_cefManager->createWindowlessBrowser(m_client, url)) {
+            m_browserCreationPending = false;
+            m_logger->errorEvent("缓存预热: 离屏浏览器创建失败");
+            m_failed = m_urls.size();
+            finish();
+        }
+        return;
+    }
+
+    m_browser->GetMainFrame()->LoadURL(url.toStdString());
+}
+
+void CacheWarmer::onBrowserCreated(CefRefPtr<CefBrowser> browser)
+{
+    m_browserCreationPending = false;
+    m_browser = browser;
+    m_browserCreateMs = m_totalElapsed.elapsed();
+
+    if (m_stage == Stage::Closing) {
+        // 全部页面在浏览器创建完成前已结束，创建完成后立即关闭
+        browser->GetHost()->CloseBrowser(true);
+        return;
+    }
+
+    // 页面计时不含创建浏览器（及其首个渲染进程）的时间，创建耗时单独记录
+    m_loadElapsed.start();
+
+    // 创建期间前一个页面已超时，改为加载当前页面
+    const QString url = m_urls.at(m_currentIndex);
+    if (url != m_browserInitialUrl) {
+        browser->GetMainFrame()->LoadURL(url.toStdString());
+    }
+}
+
+void CacheWarmer::onMainFrameLoaded(int httpStatusCode)
+{
+    if (m_stage != Stage::Loading) {
+        return;
+    }
+
+    PageTiming& timing = m_timings.last();
+    timing.httpStatus = httpStatusCode;
+    (m_reloaded ? timing.reloadMs : timing.firstLoadMs) = m_loadElapsed.elapsed();
+
+    if (httpStatusCode >= 400) {
+        m_logger->errorEvent(QString("缓存预热: %1 返回HTTP %2").arg(m_urls.at(m_currentIndex)).arg(httpStatusCode));
+        advance(false);
+        return;
+    }
+
+    // 等待页面内的异步请求完成、缓存条目落盘后再进行下一步
+    m_stage = Stage::Settling;
+    m_settleTimer->start();
+}
+
+void CacheWarmer::onMainFrameLoadError(int errorCode, const QString& errorText)
+{
+    if (m_stage != Stage::Loading) {
+        return;
+    }
+
+    m_logger->errorEvent(QString("缓存预热: %1 加载失败 (%2) %3")
+                         .arg(m_urls.at(m_currentIndex)).arg(errorCode).arg(errorText));
+    advance(false);
+}
+
+void CacheWarmer::onSettled()
+{
+    if (m_stage != Stage::Settling) {
+        return;
+    }
+
+    if (!m_reloaded && m_browser) {
+        // 第二次访问时V8才会为脚本生成代码缓存
+        m_reloaded = true;
+        m_stage = Stage::Loading;
+        m_pageTimer->start(kPageTimeoutMs);
+        m_loadElapsed.start();
+        m_browser->Reload();
+        return;
+    }
+
+    advance(true);
+}
+
+void CacheWarmer::onPageTimeout()
+{
+    if (m_stage == Stage::Closing) {
+        m_logger->errorEvent("缓存预热: 等待浏览器关闭超时");
+        finish();
+        return;
+    }
+
+    if (m_stage != Stage::Loading) {
+        return;
+    }
+
+    m_logger->errorEvent(QString("缓存预热: %1 加载超时（%2ms）").arg(m_urls.at(m_currentIndex)).arg(kPageTimeoutMs));
+    if (m_browser) {
+        m_browser->StopLoad();
+    }
+    advance(false);
+}
+
+void CacheWarmer::advance(bool success)
+{
+    m_pageTimer->stop();
+    m_settleTimer->stop();
+
+    m_timings.last().success = success;
+    if (success) {
+        ++m_succeeded;
+        m_logger->appEvent(QString("缓存预热: %1 完成，耗时%2ms")
+                           .arg(m_urls.at(m_currentIndex)).arg(m_pageElapsed.elapsed()));
+    } else {
+        ++m_failed;
+    }
+
+    ++m_currentIndex;
+    if (m_currentIndex < m_urls.size()) {
+        loadCurrentUrl();
+    } else {
+        closeBrowser();
+    }
+}
+
+void CacheWarmer::closeBrowser()
+{
+    if (!m_browser && !m_browserCreationPending) {
+        finish();
+        return;
+    }
+
+    // 等OnBeforeClose后再退出，CefShutdown时缓存才能完整写回；
+    // 浏览器仍在创建中时由onBrowserCreated关闭
+    m_stage = Stage::Closing;
+    m_pageTimer->start(kCloseTimeoutMs);
+    if (m_browser) {
+        m_browser->GetHost()->CloseBrowser(true);
+    }
+}
+
+void CacheWarmer::onBrowserClosed()
+{
+    m_browser = nullptr;
+    if (m_stage == Stage::Closing) {
+        finish();
+    }
+}
+
+void CacheWarmer::finish()
+{
+    if (m_stage == Stage::Finished) {
+        return;
+    }
+
+    m_stage = Stage::Finished;
+    m_pageTimer->stop();
+    m_settleTimer->stop();
+    m_messageLoopTimer->stop();
+    m_browser = nullptr;
+    if (m_client) {
+        m_client->detach();
+    }
+
+    const int exitCode = (m_failed == 0 && m_succeeded > 0) ? 0 : 1;
+    m_logger->appEvent(QString("缓存预热结束: 成功%1，失败%2，总耗时%3ms，退出码%4")
+                       .arg(m_succeeded).arg(m_failed).arg(m_totalElapsed.elapsed()).arg(exitCode));
+    if (m_cefManager) {
+        m_logger->appEvent(QString("缓存预热: 缓存目录可直接打包进镜像: %1").arg(m_cefManager->getCachePath()));
+    }
+    writeReport(exitCode);
+
+    QCoreApplication::exit(exitCode);
+}
+
+void CacheWarmer::writeReport(int exitCode) const
+{
+    const QString path = reportPathFromArguments(QCoreApplication::arguments());
+    if (path.isEmpty()) {
+        return;
+    }
+
+    QJsonArray pages;
+    for (const PageTiming& timing : m_timings) {
+        QJsonObject page;
+        page.insert("url", timing.url);
+        page.insert("firstLoadMs", static_cast<double>(timing.firstLoadMs));
+        page.insert("reloadMs", static_cast<double>(timing.reloadMs));
+        page.insert("httpStatus", timing.httpStatus);
+        page.insert("success", timing.success);
+        pages.append(page);
+    }
+
+    // CPU和内存只含浏览器主进程；渲染、GPU等子进程由调用方按进程树统计
+    QJsonObject root;
+    root.insert("memoryProfile", m_cefManager ? CEFManager::memoryProfileName(m_cefManager->getMemoryProfile()) : QString());
+    root.insert("singleProcess", m_cefManager ? m_cefManager->getRuntimeProfile().singleProcess : false);
+    root.insert("gpuEnabled", m_cefManager ? m_cefManager->getRuntimeProfile().gpuEnabled : false);
+    root.insert("browserCreateMs", static_cast<double>(m_browserCreateMs));
+    root.insert("totalMs", static_cast<double>(m_totalElapsed.elapsed()));
+    root.insert("browserProcessCpuMs", ProcessInfo::cpuTimeMs());
+    root.insert("browserProcessPeakRssMB", ProcessInfo::peakResidentMB());
+    root.insert("exitCode", exitCode);
+    root.insert("pages", pages);
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        m_logger->errorEvent(QString("缓存预热: 报告写入失败: %1").arg(file.errorString()));
+        return;
+    }
+    file.write(QJsonDocument(root).toJson());
+}
+
+void CacheWarmer::pumpMessageLoop()
+{
+    if (m_cefManager) {
+        m_cefManager->doMessageLoopWork();
+    }
+}
@@ -0,0 +1,135 @@
+#ifndef CACHE_WARMER_H
+#define CACHE_WARMER_H
+
+#include <QObject>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QElapsedTimer>
+
+#include "include/cef_browser.h"
+
+class Application;
+class CEFManager;
+class Logger;
+class QTimer;
+class WarmupClient;
+
+/**
+ * @brief 缓存预热模式（--warm-cache）
+ *
+ * 以离屏渲染方式无界面启动CEF，依次访问配置的目标URL及额外URL列表，
+ * 每个页面加载完成后再重新加载一次（V8代码缓存在第二次访问时才会生成），
+ * 让HTTP磁盘缓存、代码缓存充分写入后正常关闭CEF并退出。
+ *
+ * 预热后的缓存目录（CEFManager::getCEFCachePath）可直接打包进系统镜像，
+ * 终端首次启动即命中缓存。
+ *
+ * 命令行：
+ *   --warm-cache                 进入预热模式
+ *   --warm-cache-url=<url>       追加预热URL，可重复
+ *   --warm-cache-urls-only       只访问--warm-cache-url给出的URL（不访问配置的考试地址）
+ *   --warm-cache-report=<file>   结束时把各页面首次加载/重新加载耗时、配置档和本进程CPU/内存写成JSON
+ * 配置项warmCacheUrls同样追加URL。
+ *
+ * 配合CEFManager的--memory-profile=和--cache-dir=，tools/profile_bench用它在本地考试站点替身上
+ * 对比各内存配置档的页面加载耗时、CPU时间和内存占用。
+ */
+class CacheWarmer : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kPageTimeoutMs = 60000;    // 单个页面最长等待时间
+    static constexpr int kSettleDelayMs = 3000;     // 加载完成后等待异步资源和缓存写入的时间
+    static constexpr int kMessageLoopIntervalMs = 10;
+    static constexpr int kCloseTimeoutMs = 10000;   // 等待浏览器关闭的最长时间
+
+    explicit CacheWarmer(Application* app, QObject* parent = nullptr);
+    ~CacheWarmer();
+
+    /**
+     * @brief 命令行是否请求了预热模式
+     */
+    static bool isRequested(int argc, char** argv);
+
+    /**
+     * @brief 从命令行收集额外的预热URL（--warm-cache-url=）
+     */
+    static QStringList urlsFromArguments(const QStringList& arguments);
+
+    /**
+     * @brief 从命令行读取报告文件路径（--warm-cache-report=），未指定时为空
+     */
+    static QString reportPathFromArguments(const QStringList& arguments);
+
+    // 由WarmupClient在CEF UI线程（即Qt主线程）回调
+    void onBrowserCreated(CefRefPtr<CefBrowser> browser);
+    void onMainFrameLoaded(int httpStatusCode);
+    void onMainFrameLoadError(int errorCode, const QString& errorText);
+    void onBrowserClosed();
+
+public slots:
+    /**
+     * @brief 开始预热，结束后以退出码0（全部成功）或1退出事件循环
+     */
+    void start();
+
+private slots:
+    void pumpMessageLoop();
+    void onPageTimeout();
+    void onSettled();
+
+private:
+    /**
+     * @brief 单个页面的计时（从发起导航到主框架加载完成，不含等待缓存落盘的时间）
+     */
+    struct PageTiming {
+        QString url;
+        qint64 firstLoadMs = -1;    // 冷缓存首次加载
+        qint64 reloadMs = -1;       // 重新加载（命中HTTP缓存和代码缓存）
+        int httpStatus = 0;
+        bool success = false;
+    };
+
+    enum class Stage {
+        Idle,
+        Loading,
+        Settling,
+        Closing,
+        Finished
+    };
+
+    void loadCurrentUrl();
+    void advance(bool success);
+    void closeBrowser();
+    void finish();
+    void writeReport(int exitCode) const;
+
+    Application* m_application;
+    Logger* m_logger;
+    CEFManager* m_cefManager;
+
+    CefRefPtr<WarmupClient> m_client;
+    CefRefPtr<CefBrowser> m_browser;
+    bool m_browserCreationPending;  // 已请求创建、尚未收到OnAfterCreated
+    QString m_browserInitialUrl;    // 创建浏览器时使用的URL
+
+    QTimer* m_messageLoopTimer;
+    QTimer* m_pageTimer;
+    QTimer* m_settleTimer;
+
+    QStringList m_urls;
+    int m_currentIndex;
+    Stage m_stage;
+    bool m_reloaded;
+    int m_succeeded;
+    int m_failed;
+    QElapsedTimer m_pageElapsed;
+    QElapsedTimer m_loadElapsed;    // 当前这次导航的耗时
+    QElapsedTimer m_totalElapsed;
+    qint64 m_browserCreateMs;
+    QList<PageTiming> m_timings;
+};
+
+#endif // CACHE_WARMER_H
@@ -0,0 +1,446 @@
+#include "cef_cache_manager.h"
+#include "../logging/logger.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLockFile>
+#include <QStandardPaths>
+#include <QStringList>
+#include <QThread>
+#include <QVector>
+
+#include <algorithm>
+
+namespace {
+
+// 参与裁剪的缓存后端目录：代码缓存和GPU缓存不受disk-cache-size限制，会无限增长。
+// HTTP缓存（Cache）由Chromium按disk-cache-size自行LRU淘汰，这里不再处理。
+// 均为Chromium可自行重建的数据，Cookie、LocalStorage等不在其中
+const char* const kTrimmedSubdirs[] = {
+    "Code Cache/js",
+    "Code Cache/wasm",
+    "GPUCache"
+};
+
+// 需要校验索引的缓存后端目录
+const char* const kIndexedSubdirs[] = {
+    "Cache",
+    "Code Cache/js",
+    "GPUCache"
+};
+
+QString corruptSuffix()
+{
+    return ".corrupt-";
+}
+
+QString trimmedSuffix()
+{
+    return ".trimmed-";
+}
+
+} // namespace
+
+/**
+ * @brief 缓存后台线程
+ *
+ * 启动时开始，与CEF并行运行：先清理上次退出时移出的损坏/裁剪目录，再统计各缓存后端目录的大小和
+ * 最近使用时间，选出需要整体丢弃的后端目录；只读取缓存，不修改Chromium的缓存文件。
+ * 只记录结果，日志在主线程统一输出。
+ */
+class CacheTrimThread : public QThread
+{
+public:
+    struct Backend {
+        QString name;
+        qint64 bytes = 0;
+        int files = 0;
+        qint64 lastUsedMs = 0;
+        bool stale = false;
+    };
+
+    struct Result {
+        QVector<Backend> backends;
+        QStringList discard;        // 需要整体丢弃的后端目录名
+        qint64 totalBytes = 0;
+        qint64 discardBytes = 0;
+        int removedDirs = 0;
+        qint64 scannedAtMs = 0;
+        qint64 elapsedMs = 0;
+        bool interrupted = false;
+    };
+
+    CacheTrimThread(const QString& cachePath, qint64 budgetBytes)
+        : m_cachePath(cachePath), m_budgetBytes(budgetBytes) {}
+
+    const Result& result() const { return m_result; }
+
+protected:
+    void run() override
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        removeDiscardedDirectories();
+        if (!isInterruptionRequested()) {
+            scanBackends();
+        }
+
+        m_result.interrupted = isInterruptionRequested();
+        m_result.elapsedMs = timer.elapsed();
+    }
+
+private:
+    void removeDiscardedDirectories()
+    {
+        // 损坏目录和裁剪目录都已改名移出缓存目录，删除时不会与Chromium冲突
+        const QFileInfo cacheInfo(m_cachePath);
+        QDir parent = cacheInfo.dir();
+        const QStringList leftovers = parent.entryList(
+            QStringList() << cacheInfo.fileName() + corruptSuffix() + "*"
+                          << cacheInfo.fileName() + trimmedSuffix() + "*",
+            QDir::Dirs | QDir::NoDotAndDotDot);
+
+        for (const QString& name : leftovers) {
+            if (isInterruptionRequested()) {
+                return;
+            }
+            if (QDir(parent.filePath(name)).removeRecursively()) {
+                m_result.removedDirs++;
+            }
+        }
+    }
+
+    void scanBackends()
+    {
+        const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+        m_result.scannedAtMs = nowMs;
+        const qint64 staleBeforeMs = nowMs - static_cast<qint64>(CEFCacheManager::kStaleDays) * 24 * 3600 * 1000;
+
+        for (const char* subdir : kTrimmedSubdirs) {
+            Backend backend;
+            backend.name = QString::fromLatin1(subdir);
+            QDirIterator it(QDir(m_cachePath).filePath(subdir), QDir::Files | QDir::Hidden,
+                            QDirIterator::Subdirectories);
+            while (it.hasNext()) {
+                if (isInterruptionRequested()) {
+                    return;
+                }
+                it.next();
+                const QFileInfo file = it.fileInfo();
+                // 多数系统挂载为noatime/relatime，最近使用时间取访问与修改时间的较大者
+                backend.lastUsedMs = qMax(backend.lastUsedMs, qMax(file.lastRead().toMSecsSinceEpoch(),
+                                                                   file.lastModified().toMSecsSinceEpoch()));
+                backend.bytes += file.size();
+                backend.files++;
+            }
+            if (backend.files == 0) {
+                continue;
+            }
+            backend.stale = backend.lastUsedMs < staleBeforeMs;
+            m_result.totalBytes += backend.bytes;
+            m_result.backends.append(backend);
+        }
+
+        // 单个文件不能删：后端索引仍引用被删条目，Chromium会把整个后端判为损坏。
+        // 只整体丢弃后端目录（Chromium启动时重建）：先丢弃长期未用的，仍超预算时按最久未用依次丢弃
+        QVector<Backend> candidates = m_result.backends;
+        std::sort(candidates.begin(), candidates.end(), [](const Backend& a, const Backend& b) {
+            return a.lastUsedMs < b.lastUsedMs;
+        });
+
+        // 超出预算时裁剪到预算的一定比例，留出余量避免每次启动都裁剪
+        const bool overBudget = m_result.totalBytes > m_budgetBytes;
+        const qint64 targetBytes = static_cast<qint64>(m_budgetBytes * CEFCacheManager::kTrimTargetRatio);
+        qint64 remainingBytes = m_result.totalBytes;
+        for (const Backend& backend : candidates) {
+            if (!backend.stale && !(overBudget && remainingBytes > targetBytes)) {
+                continue;
+            }
+            m_result.discard << backend.name;
+            m_result.discardBytes += backend.bytes;
+            remainingBytes -= backend.bytes;
+        }
+    }
+
+    QString m_cachePath;
+    qint64 m_budgetBytes;
+    Result m_result;
+};
+
+CEFCacheManager::CEFCacheManager(const QString& cachePath, qint64 budgetBytes)
+    : m_logger(&Logger::instance())
+    , m_cachePath(cachePath)
+    , m_activePath(cachePath)
+    , m_budgetBytes(budgetBytes)
+    , m_lockFile(nullptr)
+    , m_trimThread(nullptr)
+    , m_prepared(false)
+    , m_usingFallback(false)
+    , m_lastShutdownClean(true)
+    , m_uncleanShutdowns(0)
+{
+}
+
+CEFCacheManager::~CEFCacheManager()
+{
+    if (m_trimThread) {
+        m_trimThread->requestInterruption();
+        m_trimThread->wait();
+        delete m_trimThread;
+    }
+    delete m_lockFile;
+}
+
+QString CEFCacheManager::prepare()
+{
+    if (m_prepared) {
+        return m_activePath;
+    }
+    m_prepared = true;
+    QDir().mkpath(m_cachePath);
+
+    // 目录被另一个仍在运行的实例占用时，两个Chromium共用缓存会互相损坏
+    if (!acquireLock()) {
+        m_logger->appEvent("CEF缓存目录被其他实例占用，本次使用临时缓存目录", L_WARNING);
+        m_activePath = createFallbackDirectory();
+        return m_activePath;
+    }
+
+    if (!isWritable(m_cachePath)) {
+        m_logger->appEvent("CEF缓存目录不可写，本次使用临时缓存目录", L_WARNING);
+        m_activePath = createFallbackDirectory();
+        return m_activePath;
+    }
+
+    readState();
+
+    QString reason;
+    if (!m_lastShutdownClean && m_uncleanShutdowns >= kMaxUncleanShutdowns) {
+        reason = QString("连续%1次未正常退出").arg(m_uncleanShutdowns);
+    } else {
+        looksCorrupt(&reason);
+    }
+
+    if (!reason.isEmpty()) {
+        if (resetCacheDirectory(reason)) {
+            m_uncleanShutdowns = 0;
+        } else {
+            m_logger->appEvent("CEF缓存目录无法重置，本次使用临时缓存目录", L_WARNING);
+            m_activePath = createFallbackDirectory();
+            return m_activePath;
+        }
+    }
+
+    // 运行期间标记为未正常退出，CefShutdown后再改回
+    writeState(false);
+    m_activePath = m_cachePath;
+    return m_activePath;
+}
+
+void CEFCacheManager::startTrim()
+{
+    if (m_trimThread || m_usingFallback || m_budgetBytes <= 0) {
+        return;
+    }
+
+    // 扫描与CEF初始化及整个会话并行，不在CefInitialize前中断；结果在CefShutdown之后使用
+    m_trimThread = new CacheTrimThread(m_cachePath, m_budgetBytes);
+    m_trimThread->start(QThread::LowPriority);
+}
+
+bool CEFCacheManager::applyTrim()
+{
+    if (!m_trimThread) {
+        return true;
+    }
+
+    // 不等待：会话极短、扫描尚未完成时本次不裁剪，下次启动重新扫描
+    if (!m_trimThread->isFinished()) {
+        m_trimThread->requestInterruption();
+        m_logger->logEvent("缓存管理", "缓存扫描在本次运行期间未完成，下次启动重新扫描", "performance.log", L_INFO);
+        return false;
+    }
+
+    const CacheTrimThread::Result result = m_trimThread->result();
+    delete m_trimThread;
+    m_trimThread = nullptr;
+
+    // Chromium已关闭，整个后端目录改名移出缓存目录（瞬间完成），下次Chromium启动时重建空后端；
+    // 移出的目录由下次启动的扫描线程在后台删除，退出时不等待删除
+    int discarded = 0;
+    const QString stamp = QDateTime::currentDateTime().toString("yyyyMMddhhmmss");
+    for (const QString& name : result.discard) {
+        const QString from = QDir(m_cachePath).filePath(name);
+
+        // 扫描时因长期未用而选中、本次会话中又写入过的后端保留（新建条目会更新目录修改时间）
+        const auto backend = std::find_if(result.backends.cbegin(), result.backends.cend(),
+            [&name](const CacheTrimThread::Backend& b) { return b.name == name; });
+        if (backend != result.backends.cend() && backend->stale
+            && QFileInfo(from).lastModified().toMSecsSinceEpoch() >= result.scannedAtMs) {
+            continue;
+        }
+
+        const QString to = m_cachePath + trimmedSuffix() + stamp + "-"
+                         + QString(name).replace(' ', '_').replace('/', '_');
+        if (QDir().rename(from, to)) {
+            discarded++;
+        } else {
+            m_logger->logEvent("缓存管理", QString("缓存目录%1改名失败，本次保留").arg(name), "performance.log", L_WARNING);
+        }
+    }
+
+    m_logger->logEvent("缓存管理", QString("缓存扫描：%1个代码/GPU缓存后端共%2MB，预算%3MB，整体丢弃%4（%5MB，已移出%6个），清理遗留目录%7个，扫描用时%8ms")
+        .arg(result.backends.size())
+        .arg(result.totalBytes / (1024 * 1024))
+        .arg(m_budgetBytes / (1024 * 1024))
+        .arg(result.discard.isEmpty() ? QString("无") : result.discard.join("、"))
+        .arg(result.discardBytes / (1024 * 1024))
+        .arg(discarded)
+        .arg(result.removedDirs)
+        .arg(result.elapsedMs),
+        "performance.log", L_INFO);
+    return true;
+}
+
+void CEFCacheManager::markCleanShutdown()
+{
+    if (!m_prepared) {
+        return;
+    }
+
+    if (m_usingFallback) {
+        QDir(m_activePath).removeRecursively();
+    } else {
+        writeState(true);
+    }
+
+    if (m_lockFile) {
+        m_lockFile->unlock();
+    }
+}
+
+bool CEFCacheManager::acquireLock()
+{
+    if (!m_lockFile) {
+        m_lockFile = new QLockFile(lockFilePath());
+        // 不按时间判定过期（程序会长时间运行），持有进程已退出时QLockFile会自动接管
+        m_lockFile->setStaleLockTime(0);
+    }
+    return m_lockFile->tryLock(0);
+}
+
+bool CEFCacheManager::isWritable(const QString& path) const
+{
+    QFile probe(QDir(path).filePath(".write_probe"));
+    if (!probe.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    const bool written = probe.write("1", 1) == 1;
+    probe.close();
+    probe.remove();
+    return written;
+}
+
+bool CEFCacheManager::looksCorrupt(QString* reason) const
+{
+    // 两种Chromium缓存后端都有index文件；有条目却没有索引说明上次写入中途被打断
+    for (const char* subdir : kIndexedSubdirs) {
+        const QDir dir(QDir(m_cachePath).filePath(subdir));
+        if (!dir.exists()) {
+            continue;
+        }
+
+        const QStringList files = dir.entryList(QDir::Files | QDir::Hidden);
+        if (files.isEmpty() || (files.size() == 1 && files.first() == "index")) {
+            continue;
+        }
+
+        const QFileInfo index(dir.filePath("index"));
+        if (!index.exists() || index.size() == 0) {
+            *reason = QString("%1缺少有效索引").arg(subdir);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool CEFCacheManager::resetCacheDirectory(const QString& reason)
+{
+    // 先整体改名移走（瞬间完成），旧目录由后台裁剪线程删除
+    const QString movedPath = m_cachePath + corruptSuffix() +
+                              QDateTime::currentDateTime().toString("yyyyMMddhhmmss");
+    if (!QDir().rename(m_cachePath, movedPath)) {
+        m_logger->errorEvent(QString("CEF缓存损坏（%1），移走缓存目录失败").arg(reason));
+        return false;
+    }
+
+    QDir().mkpath(m_cachePath);
+    m_logger->appEvent(QString("CEF缓存损坏（%1），已改用全新缓存目录").arg(reason), L_WARNING);
+    return true;
+}
+
+QString CEFCacheManager::createFallbackDirectory()
+{
+    m_usingFallback = true;
+
+    const QString path = QDir(QStandardPaths::writableLocation(QStandardPaths::TempLocation))
+        .filePath(QString("DesktopTerminal-CEFCache-%1").arg(QCoreApplication::applicationPid()));
+    QDir(path).removeRecursively();
+    QDir().mkpath(path);
+    return path;
+}
+
+void CEFCacheManager::readState()
+{
+    QFile file(stateFilePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        // 首次运行，没有可判断的历史
+        m_lastShutdownClean = true;
+        m_uncleanShutdowns = 0;
+        return;
+    }
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value("version").toInt() != kStateVersion) {
+        m_lastShutdownClean = true;
+        m_uncleanShutdowns = 0;
+        return;
+    }
+
+    m_lastShutdownClean = root.value("cleanShutdown").toBool(true);
+    m_uncleanShutdowns = m_lastShutdownClean ? 0 : root.value("uncleanShutdowns").toInt() + 1;
+}
+
+void CEFCacheManager::writeState(bool cleanShutdown) const
+{
+    QJsonObject root;
+    root.insert("version", kStateVersion);
+    root.insert("cleanShutdown", cleanShutdown);
+    root.insert("uncleanShutdowns", cleanShutdown ? 0 : m_uncleanShutdowns);
+    root.insert("updated", QDateTime::currentDateTime().toString(Qt::ISODate));
+
+    QFile file(stateFilePath());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        m_logger->errorEvent(QString("CEF缓存状态保存失败: %1").arg(file.errorString()));
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+}
+
+QString CEFCacheManager::stateFilePath() const
+{
+    return m_cachePath + ".state.json";
+}
+
+QString CEFCacheManager::lockFilePath() const
+{
+    return m_cachePath + ".lock";
+}
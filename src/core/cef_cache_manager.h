@@ -0,0 +1,94 @@
+#ifndef CEF_CACHE_MANAGER_H
+#define CEF_CACHE_MANAGER_H
+
+#include <QString>
+
+class Logger;
+class QLockFile;
+class CacheTrimThread;
+
+/**
+ * @brief CEF磁盘缓存生命周期管理
+ *
+ * 在CefInitialize之前运行：
+ * - 校验缓存目录：目录被其他实例占用或不可写时改用临时目录；
+ *   缓存索引缺失、或连续多次异常退出时视为损坏，整体移走后使用全新目录；
+ * - 后台线程在会话期间统计代码缓存（js/wasm）和GPU缓存后端的大小和最近使用时间，
+ *   这两类缓存不受disk-cache-size限制；HTTP缓存由Chromium按disk-cache-size自行LRU淘汰。
+ *   CefShutdown之后把长期未用或超出预算的后端目录整体改名移走，下次启动时Chromium重建，
+ *   移走的目录由下次启动的扫描线程在后台删除。从不删除后端内的单个文件（后端索引仍引用它们），
+ *   也不在Chromium运行时修改缓存目录；
+ * - 记录本次运行是否正常退出，供下次启动判断缓存是否可信。
+ *
+ * 缓存状态文件和锁文件放在缓存目录旁边，重置缓存目录时不受影响。
+ */
+class CEFCacheManager
+{
+public:
+    static constexpr int kStateVersion = 1;
+    static constexpr int kMaxUncleanShutdowns = 2;  // 连续异常退出达到此次数即重置缓存
+    static constexpr int kStaleDays = 30;           // 超过此天数未使用的条目直接删除
+    static constexpr double kTrimTargetRatio = 0.8; // 超出预算时裁剪到预算的比例
+
+    /**
+     * @param cachePath 持久缓存目录（settings.cache_path）
+     * @param budgetBytes 代码缓存与GPU缓存合计的字节预算
+     */
+    CEFCacheManager(const QString& cachePath, qint64 budgetBytes);
+    ~CEFCacheManager();
+
+    /**
+     * @brief 校验并准备缓存目录（加锁、损坏检测、必要时回退）
+     * @return 本次应使用的缓存目录
+     */
+    QString prepare();
+
+    /**
+     * @brief 在后台线程开始扫描缓存后端（须在prepare之后调用，扫描与CEF运行并行）
+     */
+    void startTrim();
+
+    /**
+     * @brief 按扫描结果整体移走需要丢弃的后端目录（须在CefShutdown之后调用，不阻塞）
+     * @return 扫描尚未完成而本次跳过裁剪时返回false
+     */
+    bool applyTrim();
+
+    /**
+     * @brief CEF关闭后（或初始化失败退出时）调用：记录正常退出并释放目录锁
+     */
+    void markCleanShutdown();
+
+    QString activePath() const { return m_activePath; }
+    bool isUsingFallback() const { return m_usingFallback; }
+
+private:
+    CEFCacheManager(const CEFCacheManager&) = delete;
+    CEFCacheManager& operator=(const CEFCacheManager&) = delete;
+
+    bool acquireLock();
+    bool isWritable(const QString& path) const;
+    bool looksCorrupt(QString* reason) const;
+    bool resetCacheDirectory(const QString& reason);
+    QString createFallbackDirectory();
+    void readState();
+    void writeState(bool cleanShutdown) const;
+
+    QString stateFilePath() const;
+    QString lockFilePath() const;
+
+    Logger* m_logger;
+    QString m_cachePath;
+    QString m_activePath;
+    qint64 m_budgetBytes;
+
+    QLockFile* m_lockFile;
+    CacheTrimThread* m_trimThread;
+
+    bool m_prepared;
+    bool m_usingFallback;
+    bool m_lastShutdownClean;
+    int m_uncleanShutdowns;
+};
+
+#endif // CEF_CACHE_MANAGER_H
@@ -1,8 +1,11 @@
 #include "cef_manager.h"
 #include "application.h"
+#include "hardware_calibration.h"
+#include "cef_cache_manager.h"
 #include "../logging/logger.h"
 #include "../config/config_manager.h"
 #include "../cef/cef_app_impl.h"
+#include "../cef/chromium_switches.h"
 
 #include <QDir>
 #include <QStandardPaths>
@@ -10,6 +13,8 @@
 #include <QFileInfo>
 #include <QMessageBox>
 #include <QWidget>
+#include <QTcpServer>
+#include <QHostAddress>
 
 #include "cef_browser.h"
 #include "cef_command_line.h"
@@ -30,10 +35,11 @@ CEFManager::CEFManager(Application* app, CefRefPtr<CEFApp> sharedApp, QObject* p
     , m_memoryProfile(MemoryProfile::Minimal)
     , m_cefApp(sharedApp)
     , m_cefClient(nullptr)
-    , m_maxRenderProcessCount(1)
-    , m_cacheSizeMB(64)
-    , m_hardwareAccelerationEnabled(false)
+    , m_cacheManager(nullptr)
+    , m_runtimeProfile(runtimeProfileFor(MemoryProfile::Minimal))
     , m_webSecurityEnabled(true)
+    , m_windowlessRendering(false)
+    , m_remoteDebuggingPort(0)
 {
     // 选择最优配置
     m_processMode = selectOptimalProcessMode();
@@ -43,25 +49,27 @@ CEFManager::CEFManager(Application* app, CefRefPtr<CEFApp> sharedApp, QObject* p
     m_cefPath = QCoreApplication::applicationDirPath();
     m_cachePath = getCEFCachePath();
     m_logPath = getCEFLogPath();
+    m_subprocessPath = findSubprocessHelper();
 
-    // 应用配置参数
-    switch (m_memoryProfile) {
-        case MemoryProfile::Minimal:
-            m_maxRenderProcessCount = 1;
-            m_cacheSizeMB = 32;
-            m_hardwareAccelerationEnabled = false;
-            break;
-        case MemoryProfile::Balanced:
-            m_maxRenderProcessCount = 2;
-            m_cacheSizeMB = 128;
-            m_hardwareAccelerationEnabled = !Application::isWindows7SP1();
-            break;
-        case MemoryProfile::Performance:
-            m_maxRenderProcessCount = 4;
-            m_cacheSizeMB = 256;
-            m_hardwareAccelerationEnabled = true;
-            break;
+    // 应用配置参数：配置文件显式给出的缓存大小和硬件加速开关优先于配置档
+    m_runtimeProfile = runtimeProfileFor(m_memoryProfile);
+    m_runtimeProfile.singleProcess = (m_processMode == ProcessMode::SingleProcess);
+    const int cacheSizeOverrideMB = m_configManager->getCEFCacheSizeOverrideMB();
+    if (cacheSizeOverrideMB > 0) {
+        m_runtimeProfile.diskCacheMB = qMax(8, cacheSizeOverrideMB);
     }
+    if (m_configManager->isHardwareAccelerationDisabled() || Application::isWindows7SP1()) {
+        m_runtimeProfile.gpuEnabled = false;
+    }
+
+    // 光栅线程数按实际核心数收敛，配置档的值作为上限
+    m_runtimeProfile.rasterThreads = qMin(m_runtimeProfile.rasterThreads,
+                                          HardwareCalibration::instance().recommendedRasterThreads());
+
+    // 裁剪预算只针对代码缓存和GPU缓存（不受disk-cache-size限制），与HTTP缓存上限相同；
+    // HTTP缓存由Chromium按disk-cache-size自行淘汰
+    m_cacheManager = new CEFCacheManager(m_cachePath,
+        static_cast<qint64>(m_runtimeProfile.diskCacheMB) * 1024 * 1024);
 
     // 构建用户代理字符串
     m_userAgent = QString("DesktopTerminal-CEF/%1 (%2)")
@@ -83,6 +91,7 @@ CEFManager::CEFManager(Application* app, CefRefPtr<CEFApp> sharedApp, QObject* p
 CEFManager::~CEFManager()
 {
     shutdown();
+    delete m_cacheManager;
 }
 
 bool CEFManager::initialize()
@@ -94,6 +103,10 @@ bool CEFManager::initialize()
     m_logger->appEvent("开始初始化CEF...");
     emit initializationProgress(0, "开始初始化CEF...");
 
+    // 校验缓存目录（损坏或被占用时回退到新目录）；缓存扫描在后台与CEF运行并行，CefShutdown后按结果裁剪
+    m_cachePath = m_cacheManager->prepare();
+    m_cacheManager->startTrim();
+
     // 验证CEF安装
     emit initializationProgress(20, "正在验证CEF安装...");
     if (!verifyCEFInstallation()) {
@@ -141,9 +154,11 @@ bool CEFManager::initialize()
     m_logger->appEvent("CEF初始化成功");
     m_logger->appEvent(QString("进程模式: %1").arg(
         m_processMode == ProcessMode::SingleProcess ? "单进程" : "多进程"));
-    m_logger->appEvent(QString("内存配置: %1").arg(
-        m_memoryProfile == MemoryProfile::Minimal ? "最小" : 
-        m_memoryProfile == MemoryProfile::Balanced ? "平衡" : "性能"));
+    m_logger->appEvent(QString("内存配置: %1").arg(memoryProfileName(m_memoryProfile)));
+    m_logger->appEvent(QString("子进程入口: %1").arg(
+        usesSubprocessHelper() ? m_subprocessPath : "主程序自身（未找到DesktopTerminal-CEF-Helper）"));
+    m_logger->appEvent(QString("Chromium开关: %1").arg(
+        buildCEFCommandLine(m_cefApp->switchConditions()).join(' ')));
     
     // 记录crashpad状态信息
     QString crashpadStatus = checkCrashpadStatus();
@@ -169,8 +184,14 @@ void CEFManager::shutdown()
         CefShutdown();
         m_initialized = false;
         m_logger->appEvent("CEF关闭完成");
+
+        // Chromium已释放缓存文件，按会话期间的扫描结果整体移走需要丢弃的后端目录
+        m_cacheManager->applyTrim();
     }
 
+    // 初始化在prepare()之后失败也属于正常退出，不计入异常退出次数
+    m_cacheManager->markCleanShutdown();
+
     m_cefApp = nullptr;
     m_cefClient = nullptr; // 清理客户端引用
 }
@@ -276,6 +297,48 @@ int CEFManager::createBrowser(void* parentWidget, const QString& url)
     }
 }
 
+bool CEFManager::createWindowlessBrowser(CefRefPtr<CefClient> client, const QString& url)
+{
+    if (!m_initialized || !m_windowlessRendering) {
+        m_logger->errorEvent("CEF未以离屏渲染模式初始化，无法创建离屏浏览器");
+        return false;
+    }
+
+    CefWindowInfo windowInfo;
+    windowInfo.SetAsWindowless(0);
+
+    CefBrowserSettings browserSettings;
+    browserSettings.web_security = m_webSecurityEnabled ? STATE_ENABLED : STATE_DISABLED;
+    browserSettings.javascript = STATE_ENABLED;
+    browserSettings.javascript_close_windows = STATE_DISABLED;
+    browserSettings.javascript_access_clipboard = STATE_DISABLED;
+    browserSettings.plugins = STATE_DISABLED;
+    browserSettings.image_loading = STATE_ENABLED;
+    // 绘制结果不会被使用，帧率降到最低以节省CPU
+    browserSettings.windowless_frame_rate = 1;
+
+    bool result = CefBrowserHost::CreateBrowser(
+        windowInfo,
+        client,
+        url.toStdString(),
+        browserSettings,
+        nullptr,
+        nullptr
+    );
+
+    if (result) {
+        m_logger->appEvent(QString("离屏浏览器创建成功，URL: %1").arg(url));
+    } else {
+        m_logger->errorEvent("离屏浏览器创建失败");
+    }
+    return result;
+}
+
+bool CEFManager::isUsingTemporaryCache() const
+{
+    return m_cacheManager && m_cacheManager->isUsingFallback();
+}
+
 void CEFManager::doMessageLoopWork()
 {
     if (m_initialized) {
@@ -326,82 +389,103 @@ bool CEFManager::setBrowserZoomLevel(int browserId, double zoomLevel)
 
 CEFManager::ProcessMode CEFManager::selectOptimalProcessMode()
 {
-    if (Application::is32BitSystem() || Application::isWindows7SP1()) {
+    // 配置文件可强制单进程；32位/Windows 7强制单进程；其余按首次运行的硬件标定结果选择。
+    // 选定的模式经CEFRuntimeProfile::singleProcess决定是否追加--single-process
+    if (ConfigManager::instance().isCEFSingleProcessMode()) {
         return ProcessMode::SingleProcess;
     }
+    return HardwareCalibration::instance().recommendsMultiProcess()
+        ? ProcessMode::MultiProcess
+        : ProcessMode::SingleProcess;
+}
+
+CEFRuntimeProfile CEFManager::runtimeProfileFor(MemoryProfile profile)
+{
+    // 下表取值为经验估计，尚未实测：各档的页面加载耗时与进程内存未经对比验证。
+    // 调整前用tools/profile_bench（BUILD_PROFILE_BENCH）在本地考试站点替身上按--memory-profile=
+    // 逐档测量冷缓存首次加载/重新加载耗时、进程树CPU时间和峰值内存，以各档中位数为依据修改。
+    // 单进程与否由进程模式决定，这里一律为false，由构造函数覆盖
+    //                           缓存MB 渲染进程 光栅线程 JS堆MB 预连接 GPU    单进程
+    static const CEFRuntimeProfile kMinimal     = { 32,    1,       1,       128,   false, false, false };
+    static const CEFRuntimeProfile kBalanced    = { 128,   2,       2,       512,   true,  true,  false };
+    static const CEFRuntimeProfile kPerformance = { 256,   4,       4,       0,     true,  true,  false };
+
+    switch (profile) {
+        case MemoryProfile::Minimal:
+            return kMinimal;
+        case MemoryProfile::Performance:
+            return kPerformance;
+        case MemoryProfile::Balanced:
+        default:
+            return kBalanced;
+    }
+}
 
-    return ProcessMode::MultiProcess;
+QString CEFManager::memoryProfileName(MemoryProfile profile)
+{
+    switch (profile) {
+        case MemoryProfile::Minimal:
+            return "minimal";
+        case MemoryProfile::Performance:
+            return "performance";
+        case MemoryProfile::Balanced:
+        default:
+            return "balanced";
+    }
 }
 
 CEFManager::MemoryProfile CEFManager::selectOptimalMemoryProfile()
 {
-    // 32位系统强制使用最小内存配置
-    if (Application::is32BitSystem()) {
+    // 命令行或配置文件可强制指定配置档，便于在同一台机器上对比各配置档的实测数据
+    QString forced = ConfigManager::instance().getMemoryProfileOverride();
+    for (const QString& argument : QCoreApplication::arguments()) {
+        if (argument.startsWith(QLatin1String(kMemoryProfileSwitch))) {
+            forced = argument.mid(static_cast<int>(qstrlen(kMemoryProfileSwitch))).trimmed().toLower();
+        }
+    }
+    if (forced == memoryProfileName(MemoryProfile::Minimal)) {
         return MemoryProfile::Minimal;
     }
-
-    // 传统系统使用平衡配置
-    if (Application::getCompatibilityLevel() == Application::CompatibilityLevel::LegacySystem) {
+    if (forced == memoryProfileName(MemoryProfile::Balanced)) {
         return MemoryProfile::Balanced;
     }
-
-    // 现代系统使用平衡配置，最优系统使用性能配置
-    if (Application::getCompatibilityLevel() == Application::CompatibilityLevel::OptimalSystem) {
+    if (forced == memoryProfileName(MemoryProfile::Performance)) {
         return MemoryProfile::Performance;
     }
 
-    return MemoryProfile::Balanced;
+    // 按硬件标定（内存、核心数、单线程性能、存储延迟）选择
+    switch (HardwareCalibration::instance().recommendedMemoryTier()) {
+        case 0:
+            return MemoryProfile::Minimal;
+        case 2:
+            return MemoryProfile::Performance;
+        default:
+            return MemoryProfile::Balanced;
+    }
 }
 
-QStringList CEFManager::buildCEFCommandLine()
+QStringList CEFManager::buildCEFCommandLine(uint32_t conditions)
 {
+    // 与CEFApp::OnBeforeCommandLineProcessing使用同一张开关表，仅用于日志和诊断
     QStringList args;
-
-    // 基础参数
-    args << "--no-sandbox";
-    args << "--disable-web-security";
-    args << "--disable-features=VizDisplayCompositor";
-    args << "--disable-background-timer-throttling";
-    args << "--disable-renderer-backgrounding";
-    args << "--disable-backgrounding-occluded-windows";
-
-    // DPI 缩放由 CEFApp::applyCompatibilityFlags() 在 OnBeforeCommandLineProcessing
-    // 中按主显示器 DPI 动态注入 force-device-scale-factor；这里不再硬编码=1，
-    // 否则 200% DPI 下 CSS 视口会变成物理像素尺寸，网页只画在左上 1/4 区域。
-    args << "--disable-gpu-driver-bug-workarounds";
-
-    // 32位系统和Windows 7特殊参数（强制单进程）
-    if (Application::is32BitSystem() || Application::isWindows7SP1()) {
-        args << "--single-process";
-        args << "--disable-gpu";
-        args << "--disable-gpu-compositing";
-        args << "--disable-gpu-rasterization";
-        args << "--disable-software-rasterizer";
-        args << "--disable-extensions";
-        args << "--disable-plugins";
-        args << "--max-old-space-size=256";
-    }
-
-    // Windows 7额外参数
-    if (Application::isWindows7SP1()) {
-        args << "--disable-d3d11";
-        args << "--disable-gpu-sandbox";
-        args << "--disable-features=AudioServiceOutOfProcess";
-        args << "--disable-dev-shm-usage";
-        args << "--no-zygote";
+    for (const std::string& item : ChromiumSwitches::describe(conditions)) {
+        args << QString::fromStdString(item);
     }
-
-    // 安全参数
-    args << "--disable-default-apps";
-    args << "--disable-sync";
-    args << "--disable-translate";
-    args << "--disable-spell-checking";
-
     return args;
 }
 
 QString CEFManager::getCEFCachePath()
 {
+    for (const QString& argument : QCoreApplication::arguments()) {
+        if (argument.startsWith(QLatin1String(kCacheDirSwitch))) {
+            const QString path = QDir::cleanPath(argument.mid(static_cast<int>(qstrlen(kCacheDirSwitch))));
+            if (!path.isEmpty()) {
+                QDir().mkpath(path);
+                return QDir(path).absolutePath();
+            }
+        }
+    }
+
     QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
     QDir cacheDir(appDataPath);
     
@@ -424,6 +508,21 @@ QString CEFManager::getCEFLogPath()
     return dir.filePath("cef_debug.log");
 }
 
+QString CEFManager::findSubprocessHelper()
+{
+#ifdef Q_OS_WIN
+    const QString helperName = "DesktopTerminal-CEF-Helper.exe";
+#else
+    const QString helperName = "DesktopTerminal-CEF-Helper";
+#endif
+    // 子进程程序与主程序部署在同一目录，缺失时子进程回退为主程序自身
+    QFileInfo helper(QDir(QCoreApplication::applicationDirPath()).filePath(helperName));
+    if (!helper.isFile() || !helper.isExecutable()) {
+        return QString();
+    }
+    return helper.absoluteFilePath();
+}
+
 bool CEFManager::initializeCEFSettings()
 {
     try {
@@ -434,6 +533,9 @@ bool CEFManager::initializeCEFSettings()
         CefString(&settings.cache_path) = m_cachePath.toStdString();
         CefString(&settings.log_file) = m_logPath.toStdString();
         CefString(&settings.user_agent) = m_userAgent.toStdString();
+        if (!m_subprocessPath.isEmpty()) {
+            CefString(&settings.browser_subprocess_path) = QDir::toNativeSeparators(m_subprocessPath).toStdString();
+        }
 
         // 应用内存优化
         applyMemoryOptimizations(settings);
@@ -463,6 +565,7 @@ bool CEFManager::initializeCEFSettings()
         if (!m_cefApp) {
             m_cefApp = new CEFApp();
         }
+        m_cefApp->setRuntimeProfile(m_runtimeProfile);
 
         bool result = CefInitialize(mainArgs, settings, m_cefApp.get(), nullptr);
         
@@ -502,14 +605,18 @@ void CEFManager::buildCEFSettings(CefSettings& settings)
     settings.multi_threaded_message_loop = false;
     settings.log_severity = LOGSEVERITY_WARNING;
     
-    // 启用远程调试功能以支持F12开发者工具（修复F12无效问题）
-    // 动态分配端口以避免冲突
-    int debugPort = findAvailablePort(9222);
-    settings.remote_debugging_port = debugPort;
-    m_logger->appEvent(QString("CEF远程调试端口已启用: %1 - F12开发者工具现在应该可以工作").arg(debugPort));
+    // F12开发者工具走进程内ShowDevTools，不依赖远程调试端口。
+    // 远程调试HTTP服务只在开发者模式下开启，考试模式不监听任何调试端口，也不做端口探测
+    if (m_configManager->isDeveloperModeEnabled()) {
+        m_remoteDebuggingPort = allocateRemoteDebuggingPort();
+        if (m_remoteDebuggingPort > 0) {
+            settings.remote_debugging_port = m_remoteDebuggingPort;
+            m_logger->appEvent(QString("开发者模式：CEF远程调试端口 %1").arg(m_remoteDebuggingPort));
+        }
+    }
 
-    // CEF 75版本兼容性设置
-    // windowless_rendering_enabled 在CEF 75中可能不存在
+    // 离屏渲染仅用于缓存预热模式，正常运行使用原生子窗口
+    settings.windowless_rendering_enabled = m_windowlessRendering;
 }
 
 void CEFManager::applyMemoryOptimizations(CefSettings& settings)
@@ -520,10 +627,8 @@ void CEFManager::applyMemoryOptimizations(CefSettings& settings)
             apply32BitOptimizations(settings);
             break;
         case MemoryProfile::Balanced:
-            // 默认设置已经是平衡的
-            break;
         case MemoryProfile::Performance:
-            // 性能模式的额外设置可以在这里添加
+            // 缓存、进程上限、光栅线程等由CEFApp在命令行处理时按运行配置档应用
             break;
     }
 }
@@ -592,22 +697,66 @@ void CEFManager::handleInitializationError(const QString& error)
     QMessageBox::critical(nullptr, "CEF初始化失败", fullError);
 }
 
+namespace {
+
+struct RuntimeFile {
+    const char* name;
+    bool required;   // 缺失即判定安装不完整
+};
+
+// CEF运行时文件，按CefInitialize的加载顺序排列；安装校验和启动预读共用这一份清单
+const RuntimeFile kRuntimeFiles[] = {
+#ifdef Q_OS_WIN
+    { "libcef.dll", true },
+    { "chrome_elf.dll", false },
+#elif defined(Q_OS_MAC)
+    { "Chromium Embedded Framework.framework", true },
+#else
+    { "libcef.so", true },
+#endif
+    { "icudtl.dat", false },
+    { "natives_blob.bin", false },
+    { "snapshot_blob.bin", false },
+    { "v8_context_snapshot.bin", false },
+#ifdef Q_OS_WIN
+    { "cef.pak", true },
+#else
+    { "cef.pak", false },
+#endif
+    { "cef_100_percent.pak", false },
+    { "cef_200_percent.pak", false },
+    { "cef_extensions.pak", false },
+    { "devtools_resources.pak", false },
+    { "locales/zh-CN.pak", false },
+    { "locales/en-US.pak", false },
+#ifdef Q_OS_WIN
+    { "libEGL.dll", false },
+    { "libGLESv2.dll", false },
+    { "d3dcompiler_47.dll", false },
+    { "DesktopTerminal-CEF-Helper.exe", false },
+#elif defined(Q_OS_LINUX)
+    { "libEGL.so", false },
+    { "libGLESv2.so", false },
+    { "DesktopTerminal-CEF-Helper", false },
+#endif
+};
+
+} // namespace
+
 bool CEFManager::verifyCEFInstallation()
 {
     // 检查CEF库文件
     QStringList requiredFiles;
+    for (const RuntimeFile& file : kRuntimeFiles) {
+        if (file.required) {
+            requiredFiles << QString::fromLatin1(file.name);
+        }
+    }
 
 #ifdef Q_OS_WIN
-    // CEF核心库文件
-    requiredFiles << "libcef.dll";
-    requiredFiles << "cef.pak";
-    
-    // CEF子进程文件（仅在多进程模式下需要）
     if (Application::is32BitSystem() || Application::isWindows7SP1()) {
         // 单进程兼容模式需要额外的D3D组件
         requiredFiles << "d3dcompiler_47.dll";
-    } else {
-        // 多进程模式使用当前可执行文件作为子进程入口，无需额外subprocess二进制
     }
     
     // CEF可选文件列表（缺失时不影响核心功能）
@@ -615,10 +764,6 @@ bool CEFManager::verifyCEFInstallation()
     
     // CEF崩溃处理程序（可选功能）
     optionalFiles << "crashpad_handler.exe";
-#elif defined(Q_OS_MAC)
-    requiredFiles << "Chromium Embedded Framework.framework";
-#else
-    requiredFiles << "libcef.so";
 #endif
 
     QString cefDir = QCoreApplication::applicationDirPath();
@@ -640,6 +785,19 @@ bool CEFManager::verifyCEFInstallation()
     return true;
 }
 
+QStringList CEFManager::runtimeFiles(const QString& cefDir)
+{
+    QStringList files;
+    const QDir dir(cefDir);
+    for (const RuntimeFile& file : kRuntimeFiles) {
+        const QString path = dir.filePath(QString::fromLatin1(file.name));
+        if (QFileInfo(path).isFile()) {
+            files << path;
+        }
+    }
+    return files;
+}
+
 bool CEFManager::checkCEFDependencies()
 {
     // 检查系统依赖
@@ -714,6 +872,16 @@ void CEFManager::notifyUrlExitTriggered(const QString& url)
     emit urlExitTriggered(url);
 }
 
+void CEFManager::notifyHostUnreachable(const QString& host, const QString& failedUrl)
+{
+    emit hostUnreachable(host, failedUrl);
+}
+
+void CEFManager::notifyMainFrameLoaded(const QString& url)
+{
+    emit mainFrameLoaded(url);
+}
+
 bool CEFManager::showDevTools(int browserId)
 {
     if (!m_initialized) {
@@ -728,6 +896,9 @@ bool CEFManager::showDevTools(int browserId)
     
     // 通过CEFClient实例显示开发者工具（修夏F12无效问题）
     m_cefClient->showDevTools();
+    if (m_remoteDebuggingPort > 0) {
+        m_logger->appEvent(QString("远程调试地址: http://127.0.0.1:%1").arg(m_remoteDebuggingPort));
+    }
     m_logger->appEvent("开发者工具已开启 - F12功能现在应该正常工作");
     return true;
 }
@@ -755,13 +926,23 @@ void CEFManager::onApplicationShutdown()
     shutdown();
 }
 
-int CEFManager::findAvailablePort(int startPort)
+int CEFManager::allocateRemoteDebuggingPort()
 {
-    // 简化端口检测逻辑，避免在CI环境中的网络API限制
-    // 在大多数情况下，9222端口应该是可用的
-    m_logger->appEvent(QString("使用调试端口: %1").arg(startPort));
-    
-    // 如果需要更严格的端口检测，可以在生产环境中启用
-    // 这里直接返回请求的端口，让CEF处理端口冲突
-    return startPort;
+    // 由系统分配空闲端口，只绑定一次。
+    // CEF 75不接受--remote-debugging-port=0，只能先取得端口号再交给CefInitialize
+    QTcpServer probe;
+    if (!probe.listen(QHostAddress::LocalHost, 0)) {
+        m_logger->errorEvent(QString("远程调试端口分配失败: %1").arg(probe.errorString()));
+        return 0;
+    }
+
+    const int port = probe.serverPort();
+    probe.close();
+
+    // CEF只接受1024~65534范围内的端口
+    if (port < 1024 || port >= 65535) {
+        m_logger->errorEvent(QString("系统分配的远程调试端口超出CEF允许范围: %1").arg(port));
+        return 0;
+    }
+    return port;
 }
@@ -39,6 +39,17 @@ public:
         Performance // 性能模式（高端64位系统）
     };
 
+    /**
+     * @brief 命令行强制内存配置（--memory-profile=minimal|balanced|performance），优先于配置文件；
+     * 与--cache-dir=一起供tools/profile_bench在同一台机器上对比各配置档
+     */
+    static constexpr const char* kMemoryProfileSwitch = "--memory-profile=";
+
+    /**
+     * @brief 命令行指定缓存目录（--cache-dir=路径），替代默认的AppDataLocation/CEFCache
+     */
+    static constexpr const char* kCacheDirSwitch = "--cache-dir=";
+
     explicit CEFManager(Application* app, CefRefPtr<CEFApp> sharedApp = nullptr, QObject* parent = nullptr);
     ~CEFManager();
 
@@ -104,6 +115,19 @@ public:
      */
     void notifyUrlExitTriggered(const QString& url);
 
+    /**
+     * @brief 通知主框架因连接错误加载失败（由CEFClient调用）
+     * @param host 加载失败的主机
+     * @param failedUrl 加载失败的地址
+     */
+    void notifyHostUnreachable(const QString& host, const QString& failedUrl);
+
+    /**
+     * @brief 通知主框架收到服务器响应并加载完成（由CEFClient调用）
+     * @param url 加载完成的地址
+     */
+    void notifyMainFrameLoaded(const QString& url);
+
     /**
      * @brief 显示开发者工具
      * @param browserId 浏览器ID
@@ -118,12 +142,65 @@ public:
      */
     bool closeDevTools(int browserId);
 
+    /**
+     * @brief 获取内存配置对应的运行配置档（磁盘缓存、渲染进程上限、光栅线程、V8堆、预连接、GPU）
+     *
+     * 各档取值未经实测，用tools/profile_bench测量各档页面加载耗时与内存后再调整。
+     */
+    static CEFRuntimeProfile runtimeProfileFor(MemoryProfile profile);
+
+    /**
+     * @brief 内存配置名称（与配置项memoryProfile取值一致）
+     */
+    static QString memoryProfileName(MemoryProfile profile);
+
+    /**
+     * @brief 当前生效的运行配置档
+     */
+    const CEFRuntimeProfile& getRuntimeProfile() const { return m_runtimeProfile; }
+
+    /**
+     * @brief 子进程是否使用独立的DesktopTerminal-CEF-Helper（否则回退为主程序自身）
+     */
+    bool usesSubprocessHelper() const { return !m_subprocessPath.isEmpty(); }
+
+    /**
+     * @brief 启用离屏渲染（须在initialize之前调用，供缓存预热模式使用）
+     */
+    void setWindowlessRenderingEnabled(bool enabled) { m_windowlessRendering = enabled; }
+
+    /**
+     * @brief 创建离屏浏览器（不依赖原生窗口，绘制结果交给client的CefRenderHandler）
+     * @param client 浏览器客户端，须提供CefRenderHandler
+     * @param url 初始URL
+     * @return 成功返回true
+     */
+    bool createWindowlessBrowser(CefRefPtr<CefClient> client, const QString& url);
+
+    /**
+     * @brief 当前生效的缓存目录（initialize之后可能是回退的临时目录）
+     */
+    QString getCachePath() const { return m_cachePath; }
+
+    /**
+     * @brief 是否因持久缓存目录不可用而改用了临时目录
+     */
+    bool isUsingTemporaryCache() const;
+
     // 静态配置方法
     static ProcessMode selectOptimalProcessMode();
     static MemoryProfile selectOptimalMemoryProfile();
-    static QStringList buildCEFCommandLine();
+    static QStringList buildCEFCommandLine(uint32_t conditions);
     static QString getCEFCachePath();
     static QString getCEFLogPath();
+    static QString findSubprocessHelper();
+
+    /**
+     * @brief CEF运行时文件（按CefInitialize加载顺序，只返回存在的文件），供启动预读使用
+     * 与verifyCEFInstallation共用同一份文件清单
+     * @param cefDir CEF运行时所在目录
+     */
+    static QStringList runtimeFiles(const QString& cefDir);
 
 private:
     // 初始化步骤
@@ -159,8 +236,8 @@ private:
     void checkOptionalFiles(const QStringList& optionalFiles, const QString& cefDir);
     QString checkCrashpadStatus();
     
-    // 端口管理
-    int findAvailablePort(int startPort);
+    // 端口管理：由系统分配远程调试端口，失败返回0
+    int allocateRemoteDebuggingPort();
 
 signals:
     /**
@@ -169,6 +246,19 @@ signals:
      */
     void urlExitTriggered(const QString& url);
 
+    /**
+     * @brief 主框架因连接错误加载失败时发出此信号
+     * @param host 加载失败的主机
+     * @param failedUrl 加载失败的地址
+     */
+    void hostUnreachable(const QString& host, const QString& failedUrl);
+
+    /**
+     * @brief 主框架收到服务器响应并加载完成时发出此信号
+     * @param url 加载完成的地址
+     */
+    void mainFrameLoaded(const QString& url);
+
     /**
      * @brief 初始化进度更新信号
      * @param progress 进度百分比 (0-100)
@@ -196,17 +286,19 @@ private:
     ProcessMode m_processMode;
     MemoryProfile m_memoryProfile;
 
-    CefRefPtr<CefApp> m_cefApp;
+    CefRefPtr<CEFApp> m_cefApp;
     CefRefPtr<class CEFClient> m_cefClient; // CEF客户端实例（用于开发者工具管理）
     QString m_cefPath;
     QString m_cachePath;
     QString m_logPath;
+    QString m_subprocessPath;   // 子进程程序路径，为空表示使用主程序自身
+    class CEFCacheManager* m_cacheManager; // 缓存目录校验与裁剪
 
     // 配置参数
-    int m_maxRenderProcessCount;
-    int m_cacheSizeMB;
-    bool m_hardwareAccelerationEnabled;
+    CEFRuntimeProfile m_runtimeProfile;
     bool m_webSecurityEnabled;
+    bool m_windowlessRendering;
+    int m_remoteDebuggingPort;  // 远程调试端口，0表示未开启（考试模式）
     QString m_userAgent;
 };
 
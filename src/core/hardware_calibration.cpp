@@ -0,0 +1,295 @@
+#include "hardware_calibration.h"
+#include "application.h"
+#include "../logging/logger.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QStringList>
+#include <QSysInfo>
+#include <QThread>
+#include <QTextStream>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+HardwareCalibration& HardwareCalibration::instance()
+{
+    static HardwareCalibration calibration;
+    return calibration;
+}
+
+HardwareCalibration::HardwareCalibration()
+    : m_logger(&Logger::instance())
+    , m_calibrated(false)
+{
+}
+
+const HardwareCalibration::Result& HardwareCalibration::result()
+{
+    ensureCalibrated();
+    return m_result;
+}
+
+bool HardwareCalibration::recommendsMultiProcess()
+{
+    ensureCalibrated();
+
+    // 32位系统和Windows 7仍强制单进程；其余机器按内存和核心数判断
+    if (Application::is32BitSystem() || Application::isWindows7SP1()) {
+        return false;
+    }
+    return m_result.totalMemoryMB >= kMultiProcessMinMemoryMB && m_result.cpuCores >= kMultiProcessMinCores;
+}
+
+int HardwareCalibration::recommendedMemoryTier()
+{
+    ensureCalibrated();
+
+    if (Application::is32BitSystem() ||
+        m_result.totalMemoryMB < kBalancedMinMemoryMB || m_result.availableMemoryMB < kBalancedMinAvailableMB) {
+        return 0;
+    }
+
+    const bool strongMachine = m_result.totalMemoryMB >= kPerformanceMinMemoryMB &&
+                               m_result.cpuCores >= kPerformanceMinCores &&
+                               m_result.cpuScore >= kFastCpuScore &&
+                               m_result.storageLatencyMs < kSlowStorageLatencyMs;
+    return strongMachine ? 2 : 1;
+}
+
+int HardwareCalibration::recommendedRasterThreads()
+{
+    ensureCalibrated();
+
+    // 软件光栅化时一半核心用于光栅，至少1个，最多4个
+    return qBound(1, m_result.cpuCores / 2, kMaxRasterThreads);
+}
+
+void HardwareCalibration::ensureCalibrated()
+{
+    if (m_calibrated) {
+        return;
+    }
+    m_calibrated = true;
+
+    const QString fingerprint = computeFingerprint();
+    if (loadCache(fingerprint)) {
+        m_logger->appEvent(QString("硬件标定：使用缓存结果 (指纹 %1)").arg(fingerprint.left(12)));
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    m_result = Result();
+    m_result.fingerprint = fingerprint;
+    runCalibration();
+    saveCache();
+
+    m_logger->appEvent(QString("硬件标定完成，耗时%1ms：内存%2MB(可用%3MB)，核心%4，单线程得分%5，存储延迟%6ms")
+        .arg(timer.elapsed())
+        .arg(m_result.totalMemoryMB)
+        .arg(m_result.availableMemoryMB)
+        .arg(m_result.cpuCores)
+        .arg(m_result.cpuScore, 0, 'f', 0)
+        .arg(m_result.storageLatencyMs, 0, 'f', 1));
+}
+
+bool HardwareCalibration::loadCache(const QString& fingerprint)
+{
+    QFile file(cacheFilePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value("version").toInt() != kCacheVersion ||
+        root.value("fingerprint").toString() != fingerprint) {
+        return false;
+    }
+
+    m_result.fingerprint = fingerprint;
+    m_result.totalMemoryMB = static_cast<qint64>(root.value("totalMemoryMB").toDouble());
+    m_result.cpuCores = root.value("cpuCores").toInt(1);
+    m_result.cpuScore = root.value("cpuScore").toDouble();
+    m_result.storageLatencyMs = root.value("storageLatencyMs").toDouble();
+    m_result.fromCache = true;
+
+    // 可用内存随运行状态变化，每次启动重新读取
+    qint64 totalMB = 0;
+    readMemory(&totalMB, &m_result.availableMemoryMB);
+    return true;
+}
+
+void HardwareCalibration::saveCache() const
+{
+    QJsonObject root;
+    root.insert("version", kCacheVersion);
+    root.insert("fingerprint", m_result.fingerprint);
+    root.insert("totalMemoryMB", static_cast<double>(m_result.totalMemoryMB));
+    root.insert("cpuCores", m_result.cpuCores);
+    root.insert("cpuScore", m_result.cpuScore);
+    root.insert("storageLatencyMs", m_result.storageLatencyMs);
+
+    QFile file(cacheFilePath());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        m_logger->errorEvent(QString("硬件标定结果保存失败: %1").arg(file.errorString()));
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+}
+
+void HardwareCalibration::runCalibration()
+{
+    readMemory(&m_result.totalMemoryMB, &m_result.availableMemoryMB);
+    m_result.cpuCores = qMax(1, QThread::idealThreadCount());
+    m_result.cpuScore = measureCpuScore();
+    m_result.storageLatencyMs = measureStorageLatencyMs();
+}
+
+QString HardwareCalibration::computeFingerprint()
+{
+    QString cpuName;
+#ifdef Q_OS_WIN
+    QSettings cpuKey("HKEY_LOCAL_MACHINE\\HARDWARE\\DESCRIPTION\\System\\CentralProcessor\\0",
+                     QSettings::NativeFormat);
+    cpuName = cpuKey.value("ProcessorNameString").toString().trimmed();
+#elif defined(Q_OS_LINUX)
+    QFile cpuInfo("/proc/cpuinfo");
+    if (cpuInfo.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        QTextStream stream(&cpuInfo);
+        QString line;
+        while (stream.readLineInto(&line)) {
+            if (line.startsWith("model name")) {
+                cpuName = line.section(':', 1).trimmed();
+                break;
+            }
+        }
+    }
+#endif
+
+    // 内存按256MB取整，避免不同内核保留内存导致指纹抖动
+    qint64 totalMB = 0;
+    qint64 availableMB = 0;
+    readMemory(&totalMB, &availableMB);
+
+    const QString source = QStringList({
+        cpuName,
+        QSysInfo::currentCpuArchitecture(),
+        QString::number(QThread::idealThreadCount()),
+        QString::number(totalMB / 256),
+        QSysInfo::kernelType(),
+        QSysInfo::kernelVersion(),
+        QSysInfo::machineHostName()
+    }).join('|');
+
+    return QString::fromLatin1(QCryptographicHash::hash(source.toUtf8(), QCryptographicHash::Sha1).toHex());
+}
+
+QString HardwareCalibration::cacheFilePath()
+{
+    QDir dir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+    if (!dir.exists()) {
+        dir.mkpath(".");
+    }
+    return dir.filePath("hardware_calibration.json");
+}
+
+void HardwareCalibration::readMemory(qint64* totalMB, qint64* availableMB)
+{
+    *totalMB = 0;
+    *availableMB = 0;
+
+#ifdef Q_OS_WIN
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    if (GlobalMemoryStatusEx(&status)) {
+        *totalMB = static_cast<qint64>(status.ullTotalPhys / (1024 * 1024));
+        *availableMB = static_cast<qint64>(status.ullAvailPhys / (1024 * 1024));
+    }
+#elif defined(Q_OS_LINUX)
+    QFile memInfo("/proc/meminfo");
+    if (memInfo.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        QTextStream stream(&memInfo);
+        QString line;
+        while (stream.readLineInto(&line)) {
+            const qint64 valueMB = line.section(':', 1).trimmed().section(' ', 0, 0).toLongLong() / 1024;
+            if (line.startsWith("MemTotal:")) {
+                *totalMB = valueMB;
+            } else if (line.startsWith("MemAvailable:")) {
+                *availableMB = valueMB;
+            }
+        }
+    }
+#endif
+}
+
+double HardwareCalibration::measureCpuScore()
+{
+    // 依赖链上的xorshift迭代，测的是单核整数吞吐；取3次中最好的一次以排除调度干扰
+    const int iterations = 2000000;
+    double bestScore = 0.0;
+    volatile quint64 sink = 0;
+
+    for (int run = 0; run < 3; ++run) {
+        quint64 state = 0x9E3779B97F4A7C15ull + static_cast<quint64>(run);
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < iterations; ++i) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+        }
+        sink = sink + state;
+        const double elapsedMs = qMax<qint64>(1, timer.nsecsElapsed()) / 1000000.0;
+        bestScore = qMax(bestScore, iterations / elapsedMs / 1000.0);
+    }
+
+    return bestScore;
+}
+
+double HardwareCalibration::measureStorageLatencyMs()
+{
+    // 写入并落盘一个16KB小文件再读回，近似CEF缓存与日志的小文件访问延迟
+    const QString path = QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation))
+                             .filePath("calibration.tmp");
+    const QByteArray payload(16 * 1024, 'x');
+    const int rounds = 5;
+    qint64 totalNs = 0;
+
+    for (int i = 0; i < rounds; ++i) {
+        QElapsedTimer timer;
+        timer.start();
+
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            return 0.0;
+        }
+        file.write(payload);
+        file.flush();
+#ifdef Q_OS_WIN
+        FlushFileBuffers(reinterpret_cast<HANDLE>(_get_osfhandle(file.handle())));
+#else
+        fsync(file.handle());
+#endif
+        file.close();
+
+        if (file.open(QIODevice::ReadOnly)) {
+            file.readAll();
+            file.close();
+        }
+        totalNs += timer.nsecsElapsed();
+    }
+
+    QFile::remove(path);
+    return totalNs / 1000000.0 / rounds;
+}
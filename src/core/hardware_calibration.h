@@ -0,0 +1,97 @@
+#ifndef HARDWARE_CALIBRATION_H
+#define HARDWARE_CALIBRATION_H
+
+#include <QString>
+
+class Logger;
+
+/**
+ * @brief 首次运行硬件标定
+ *
+ * 首次启动时做一次短时间标定（内存、核心数、单线程性能、存储延迟），
+ * 结果按硬件指纹缓存到磁盘；硬件不变时后续启动直接读取缓存。
+ * CEFManager据此选择进程模式、内存配置档和光栅线程数。
+ */
+class HardwareCalibration
+{
+public:
+    /**
+     * @brief 标定结果
+     */
+    struct Result {
+        QString fingerprint;        // 硬件指纹
+        qint64 totalMemoryMB;       // 物理内存总量
+        qint64 availableMemoryMB;   // 标定时可用内存
+        int cpuCores;               // 逻辑核心数
+        double cpuScore;            // 单线程得分（每毫秒完成的基准迭代千次数）
+        double storageLatencyMs;    // 小文件写入+读取平均延迟
+        bool fromCache;             // 是否来自缓存
+
+        Result()
+            : totalMemoryMB(0), availableMemoryMB(0), cpuCores(1)
+            , cpuScore(0.0), storageLatencyMs(0.0), fromCache(false) {}
+    };
+
+    static constexpr int kCacheVersion = 1;
+    static constexpr double kFastCpuScore = 400.0;        // 高于此值视为单线程性能较好
+    static constexpr double kSlowStorageLatencyMs = 20.0; // 高于此值视为慢速存储
+
+    // 多进程模式门槛
+    static constexpr qint64 kMultiProcessMinMemoryMB = 3072;
+    static constexpr int kMultiProcessMinCores = 2;
+
+    // 内存档位门槛：低于平衡档门槛为最小档，全部达到性能档门槛为性能档
+    static constexpr qint64 kBalancedMinMemoryMB = 3072;
+    static constexpr qint64 kBalancedMinAvailableMB = 1024;
+    static constexpr qint64 kPerformanceMinMemoryMB = 8192;
+    static constexpr int kPerformanceMinCores = 4;
+
+    static constexpr int kMaxRasterThreads = 4;           // 光栅线程上限
+
+    /**
+     * @brief 获取单例实例
+     */
+    static HardwareCalibration& instance();
+
+    /**
+     * @brief 获取标定结果（首次调用时读取缓存或执行标定）
+     */
+    const Result& result();
+
+    /**
+     * @brief 推荐是否使用多进程模式
+     */
+    bool recommendsMultiProcess();
+
+    /**
+     * @brief 推荐的内存档位：0=最小 1=平衡 2=性能
+     */
+    int recommendedMemoryTier();
+
+    /**
+     * @brief 推荐的光栅线程数
+     */
+    int recommendedRasterThreads();
+
+private:
+    HardwareCalibration();
+    HardwareCalibration(const HardwareCalibration&) = delete;
+    HardwareCalibration& operator=(const HardwareCalibration&) = delete;
+
+    void ensureCalibrated();
+    bool loadCache(const QString& fingerprint);
+    void saveCache() const;
+    void runCalibration();
+
+    static QString computeFingerprint();
+    static QString cacheFilePath();
+    static void readMemory(qint64* totalMB, qint64* availableMB);
+    static double measureCpuScore();
+    static double measureStorageLatencyMs();
+
+    Logger* m_logger;
+    Result m_result;
+    bool m_calibrated;
+};
+
+#endif // HARDWARE_CALIBRATION_H
@@ -0,0 +1,114 @@
+#include "process_info.h"
+
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#include <sys/resource.h>
+#endif
+
+double ProcessInfo::ageMs()
+{
+#ifdef _WIN32
+    FILETIME creation, exitTime, kernel, user, now;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exitTime, &kernel, &user)) {
+        return -1.0;
+    }
+    GetSystemTimeAsFileTime(&now);
+
+    ULARGE_INTEGER start, current;
+    start.LowPart = creation.dwLowDateTime;
+    start.HighPart = creation.dwHighDateTime;
+    current.LowPart = now.dwLowDateTime;
+    current.HighPart = now.dwHighDateTime;
+    // FILETIME单位为100纳秒
+    return static_cast<double>(current.QuadPart - start.QuadPart) / 10000.0;
+#elif defined(__linux__)
+    // /proc/self/stat 第22列为进程启动时刻（开机以来的时钟滴答数），与/proc/uptime相减
+    char buffer[1024];
+    FILE* file = std::fopen("/proc/self/stat", "r");
+    if (!file) {
+        return -1.0;
+    }
+    const size_t length = std::fread(buffer, 1, sizeof(buffer) - 1, file);
+    std::fclose(file);
+    buffer[length] = '\0';
+
+    // 进程名可能含空格，从最后一个')'之后（第3列）开始数
+    const char* fields = std::strrchr(buffer, ')');
+    unsigned long long startTicks = 0;
+    if (!fields || std::sscanf(fields + 1,
+            " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %*u %*u %*d %*d %*d %*d %*d %*d %llu",
+            &startTicks) != 1) {
+        return -1.0;
+    }
+
+    double uptimeSeconds = 0.0;
+    file = std::fopen("/proc/uptime", "r");
+    if (!file) {
+        return -1.0;
+    }
+    const int parsed = std::fscanf(file, "%lf", &uptimeSeconds);
+    std::fclose(file);
+    if (parsed != 1) {
+        return -1.0;
+    }
+
+    const long ticksPerSecond = sysconf(_SC_CLK_TCK);
+    if (ticksPerSecond <= 0) {
+        return -1.0;
+    }
+    return (uptimeSeconds - static_cast<double>(startTicks) / ticksPerSecond) * 1000.0;
+#else
+    return -1.0;
+#endif
+}
+
+double ProcessInfo::cpuTimeMs()
+{
+#ifdef _WIN32
+    FILETIME creation, exitTime, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exitTime, &kernel, &user)) {
+        return -1.0;
+    }
+    ULARGE_INTEGER kernelTime, userTime;
+    kernelTime.LowPart = kernel.dwLowDateTime;
+    kernelTime.HighPart = kernel.dwHighDateTime;
+    userTime.LowPart = user.dwLowDateTime;
+    userTime.HighPart = user.dwHighDateTime;
+    return static_cast<double>(kernelTime.QuadPart + userTime.QuadPart) / 10000.0;
+#elif defined(__linux__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1.0;
+    }
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000.0
+         + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000.0;
+#else
+    return -1.0;
+#endif
+}
+
+double ProcessInfo::peakResidentMB()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return -1.0;
+    }
+    return static_cast<double>(counters.PeakWorkingSetSize) / (1024.0 * 1024.0);
+#elif defined(__linux__)
+    // Linux上ru_maxrss单位为KB
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1.0;
+    }
+    return static_cast<double>(usage.ru_maxrss) / 1024.0;
+#else
+    return -1.0;
+#endif
+}
@@ -0,0 +1,28 @@
+#ifndef PROCESS_INFO_H
+#define PROCESS_INFO_H
+
+/**
+ * @brief 当前进程信息
+ *
+ * 不依赖Qt和CEF，主程序与CEF子进程程序（DesktopTerminal-CEF-Helper）共用。
+ */
+class ProcessInfo
+{
+public:
+    /**
+     * @brief 当前进程从创建到现在的毫秒数，无法获取时返回-1
+     */
+    static double ageMs();
+
+    /**
+     * @brief 当前进程累计占用的CPU时间（用户态+内核态，毫秒），无法获取时返回-1
+     */
+    static double cpuTimeMs();
+
+    /**
+     * @brief 当前进程的峰值常驻内存（Windows为峰值工作集，MB），无法获取时返回-1
+     */
+    static double peakResidentMB();
+};
+
+#endif // PROCESS_INFO_H
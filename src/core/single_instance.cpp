@@ -0,0 +1,126 @@
+#include "single_instance.h"
+#include "../logging/logger.h"
+
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QCryptographicHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+
+SingleInstanceServer::SingleInstanceServer(QObject* parent)
+    : QObject(parent)
+    , m_logger(&Logger::instance())
+    , m_server(new QLocalServer(this))
+{
+    // 仅当前用户可连接，其他用户的进程无法向考试窗口转交参数
+    m_server->setSocketOptions(QLocalServer::UserAccessOption);
+    connect(m_server, &QLocalServer::newConnection, this, &SingleInstanceServer::onNewConnection);
+}
+
+SingleInstanceServer::~SingleInstanceServer()
+{
+    m_server->close();
+}
+
+QString SingleInstanceServer::serverName()
+{
+    QByteArray user = qgetenv("USERNAME");
+    if (user.isEmpty()) {
+        user = qgetenv("USER");
+    }
+    const QByteArray digest = QCryptographicHash::hash(user, QCryptographicHash::Sha1).toHex().left(12);
+    return QString("DesktopTerminal-CEF-%1").arg(QString::fromLatin1(digest));
+}
+
+bool SingleInstanceServer::forwardToRunningInstance(int argc, char** argv, double launchMs)
+{
+    // 此时尚未创建QApplication，只使用QLocalSocket的阻塞接口，不依赖事件循环
+    QLocalSocket socket;
+    socket.connectToServer(serverName());
+    if (!socket.waitForConnected(kConnectTimeoutMs)) {
+        return false;
+    }
+
+    QJsonArray args;
+    for (int i = 1; i < argc; ++i) {
+        args.append(QString::fromLocal8Bit(argv[i]));
+    }
+
+    QJsonObject message;
+    message["args"] = args;
+    message["launchMs"] = launchMs;
+
+    socket.write(QJsonDocument(message).toJson(QJsonDocument::Compact));
+    socket.write("\n");
+    if (!socket.waitForBytesWritten(kConnectTimeoutMs)) {
+        return false;
+    }
+
+    // 等待应答，确认运行中的实例确实处理了本次启动
+    while (!socket.canReadLine()) {
+        if (!socket.waitForReadyRead(kConnectTimeoutMs)) {
+            return false;
+        }
+    }
+    return socket.readLine().trimmed() == "ok";
+}
+
+bool SingleInstanceServer::listen()
+{
+    const QString name = serverName();
+
+    // 已持有单实例锁，同名套接字只可能是上次崩溃遗留的
+    QLocalServer::removeServer(name);
+
+    if (!m_server->listen(name)) {
+        m_logger->errorEvent(QString("单实例监听失败: %1").arg(m_server->errorString()));
+        return false;
+    }
+
+    m_logger->appEvent(QString("单实例监听已启动: %1").arg(m_server->fullServerName()));
+    return true;
+}
+
+void SingleInstanceServer::onNewConnection()
+{
+    while (QLocalSocket* socket = m_server->nextPendingConnection()) {
+        connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket]() { handleConnection(socket); });
+        if (socket->canReadLine()) {
+            handleConnection(socket);
+        }
+    }
+}
+
+void SingleInstanceServer::handleConnection(QLocalSocket* socket)
+{
+    if (!socket->canReadLine()) {
+        if (socket->bytesAvailable() > kMaxMessageBytes) {
+            m_logger->errorEvent("单实例转交消息过长，已断开");
+            socket->abort();
+        }
+        return;
+    }
+
+    const QByteArray line = socket->readLine(kMaxMessageBytes);
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(line, &parseError);
+    if (parseError.error != QJsonParseError::NoError || !document.isObject()) {
+        m_logger->errorEvent(QString("单实例转交消息格式错误: %1").arg(parseError.errorString()));
+        socket->abort();
+        return;
+    }
+
+    const QJsonObject message = document.object();
+    QStringList arguments;
+    for (const QJsonValue& value : message["args"].toArray()) {
+        arguments << value.toString();
+    }
+
+    socket->write("ok\n");
+    socket->flush();
+    socket->disconnectFromServer();
+
+    emit instanceLaunched(arguments, message["launchMs"].toDouble(-1));
+}
@@ -0,0 +1,73 @@
+#ifndef SINGLE_INSTANCE_H
+#define SINGLE_INSTANCE_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+class QLocalServer;
+class QLocalSocket;
+class Logger;
+
+/**
+ * @brief 单实例快速转交
+ *
+ * 首个实例取得单实例锁后在本地套接字上监听；重复启动的进程在创建QApplication和
+ * 初始化CEF之前先尝试连接，连上即把命令行参数转交给运行中的实例并立即退出，
+ * 通常在几毫秒内完成。运行中的实例据此把窗口提到前台，或按--url=切换页面。
+ *
+ * 连接不上（首个实例尚在启动、或已崩溃）时回退到原有的锁文件判断。
+ *
+ * 协议：客户端发送一行JSON {"args": [...], "launchMs": 进程启动到发送的毫秒数}，
+ * 服务端处理后回复一行"ok"。
+ */
+class SingleInstanceServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kConnectTimeoutMs = 200;  // 重复启动方连接、等待应答的超时
+    static constexpr int kMaxMessageBytes = 64 * 1024;
+
+    explicit SingleInstanceServer(QObject* parent = nullptr);
+    ~SingleInstanceServer();
+
+    /**
+     * @brief 本地套接字名（按当前用户区分，避免多用户会话互相干扰）
+     */
+    static QString serverName();
+
+    /**
+     * @brief 尝试把参数转交给运行中的实例（可在QApplication创建之前调用）
+     * @param argc 命令行参数个数
+     * @param argv 命令行参数
+     * @param launchMs 本进程启动到此刻的毫秒数，-1表示未知
+     * @return 已由运行中的实例接收时返回true，调用方应直接退出
+     */
+    static bool forwardToRunningInstance(int argc, char** argv, double launchMs);
+
+    /**
+     * @brief 开始监听（须在取得单实例锁之后调用，会清理上次崩溃遗留的套接字）
+     * @return 成功返回true
+     */
+    bool listen();
+
+signals:
+    /**
+     * @brief 收到重复启动进程转交的参数
+     * @param arguments 对方的命令行参数（不含程序路径）
+     * @param launchMs 对方从进程启动到完成转交所用的毫秒数，-1表示未知
+     */
+    void instanceLaunched(const QStringList& arguments, double launchMs);
+
+private slots:
+    void onNewConnection();
+
+private:
+    void handleConnection(QLocalSocket* socket);
+
+    Logger* m_logger;
+    QLocalServer* m_server;
+};
+
+#endif // SINGLE_INSTANCE_H
@@ -0,0 +1,240 @@
+#include "startup_preloader.h"
+#include "cef_manager.h"
+#include "../logging/logger.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <cstdint>
+#elif defined(Q_OS_LINUX)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+StartupPreloader::StartupPreloader(const QString& appDir, QObject* parent)
+    : QThread(parent)
+    , m_appDir(appDir)
+    , m_reported(false)
+{
+}
+
+StartupPreloader::~StartupPreloader()
+{
+    requestInterruption();
+    wait();
+}
+
+bool StartupPreloader::isDisabled(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (argv[i] && qstrcmp(argv[i], "--no-preload") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QString StartupPreloader::executableDirectory(int argc, char** argv)
+{
+#ifdef Q_OS_WIN
+    wchar_t path[MAX_PATH];
+    const DWORD length = GetModuleFileNameW(nullptr, path, MAX_PATH);
+    if (length > 0 && length < MAX_PATH) {
+        return QFileInfo(QString::fromWCharArray(path, static_cast<int>(length))).absolutePath();
+    }
+#elif defined(Q_OS_LINUX)
+    const QString target = QFile::symLinkTarget("/proc/self/exe");
+    if (!target.isEmpty()) {
+        return QFileInfo(target).absolutePath();
+    }
+#endif
+    if (argc > 0 && argv[0]) {
+        return QFileInfo(QString::fromLocal8Bit(argv[0])).absolutePath();
+    }
+    return QDir::currentPath();
+}
+
+QStringList StartupPreloader::fontconfigCacheFiles()
+{
+    QStringList files;
+#ifdef Q_OS_LINUX
+    QStringList dirs;
+    const QByteArray xdgCache = qgetenv("XDG_CACHE_HOME");
+    if (!xdgCache.isEmpty()) {
+        dirs << QString::fromLocal8Bit(xdgCache) + "/fontconfig";
+    } else {
+        dirs << QString::fromLocal8Bit(qgetenv("HOME")) + "/.cache/fontconfig";
+    }
+    dirs << "/var/cache/fontconfig" << "/usr/lib/fontconfig/cache";
+
+    for (const QString& dir : dirs) {
+        const QFileInfoList entries = QDir(dir).entryInfoList(QStringList() << "*.cache-*", QDir::Files);
+        for (const QFileInfo& entry : entries) {
+            files << entry.absoluteFilePath();
+        }
+    }
+#endif
+    return files;
+}
+
+void StartupPreloader::reportWhenFinished()
+{
+    // 先连接再检查：线程恰好在两步之间结束时也不会漏掉结果，重复调用由m_reported去重
+    // QThread对象属于主线程，finished经队列回到主线程
+    connect(this, &QThread::finished, this, &StartupPreloader::logResult, Qt::UniqueConnection);
+    if (isFinished()) {
+        logResult();
+    }
+}
+
+void StartupPreloader::run()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // 按CefInitialize的加载顺序预读，最先用到的文件最先进入页缓存
+    const QStringList runtimeFiles = CEFManager::runtimeFiles(m_appDir);
+    for (const QString& file : runtimeFiles) {
+        if (isInterruptionRequested()) {
+            break;
+        }
+        const qint64 bytes = preloadFile(file);
+        if (bytes >= 0) {
+            ++m_result.files;
+            m_result.bytes += bytes;
+        } else {
+            ++m_result.failedFiles;
+        }
+    }
+
+    // fontconfig缓存：Qt字体数据库和Chromium首次排版都会读取
+    const QStringList fontFiles = fontconfigCacheFiles();
+    for (const QString& file : fontFiles) {
+        if (isInterruptionRequested()) {
+            break;
+        }
+        const qint64 bytes = preloadFile(file);
+        if (bytes >= 0) {
+            ++m_result.fontCacheFiles;
+            m_result.bytes += bytes;
+        } else {
+            ++m_result.failedFiles;
+        }
+    }
+
+    m_result.interrupted = isInterruptionRequested();
+    m_result.elapsedMs = timer.elapsed();
+}
+
+qint64 StartupPreloader::preloadFile(const QString& path)
+{
+#ifdef Q_OS_WIN
+    const qint64 mapped = prefetchMapped(path);
+    if (mapped >= 0) {
+        return mapped;
+    }
+#elif defined(Q_OS_LINUX)
+    // readahead在内核中把整个文件读入页缓存，不经过用户态缓冲
+    const int fd = ::open(QFile::encodeName(path).constData(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && ::readahead(fd, 0, static_cast<size_t>(st.st_size)) == 0) {
+        ::close(fd);
+        return static_cast<qint64>(st.st_size);
+    }
+    ::close(fd);
+#endif
+
+    // 通用方式：顺序读一遍，由系统缓存保留页面
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    QByteArray buffer(kReadChunkBytes, Qt::Uninitialized);
+    qint64 total = 0;
+    while (!isInterruptionRequested()) {
+        const qint64 read = file.read(buffer.data(), buffer.size());
+        if (read <= 0) {
+            break;
+        }
+        total += read;
+    }
+    return total;
+}
+
+#ifdef Q_OS_WIN
+qint64 StartupPreloader::prefetchMapped(const QString& path)
+{
+    // 只读映射文件：页面进入系统缓存，不经过用户态缓冲，也不复制上百MB的libcef.dll
+    const HANDLE file = CreateFileW(reinterpret_cast<const wchar_t*>(path.utf16()), GENERIC_READ,
+                                    FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return -1;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0 || static_cast<quint64>(size.QuadPart) > static_cast<quint64>(SIZE_MAX)) {
+        CloseHandle(file);
+        return -1;
+    }
+    const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) {
+        return -1;
+    }
+    // 32位进程地址空间紧张时映射可能失败，由调用方退化为顺序读
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view) {
+        return -1;
+    }
+    const SIZE_T length = static_cast<SIZE_T>(size.QuadPart);
+
+    // PrefetchVirtualMemory（Win8+）一次性异步提交整段读取；Win7上没有此函数，逐页访问触发缺页读入
+    struct MemoryRange {
+        PVOID address;
+        SIZE_T bytes;
+    };
+    typedef BOOL (WINAPI *PrefetchVirtualMemoryFn)(HANDLE, ULONG_PTR, MemoryRange*, ULONG);
+    static const PrefetchVirtualMemoryFn prefetch = reinterpret_cast<PrefetchVirtualMemoryFn>(
+        GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "PrefetchVirtualMemory"));
+
+    MemoryRange range = { view, length };
+    if (!prefetch || !prefetch(GetCurrentProcess(), 1, &range, 0)) {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        const volatile char* bytes = static_cast<const volatile char*>(view);
+        for (SIZE_T offset = 0; offset < length && !isInterruptionRequested(); offset += info.dwPageSize) {
+            (void)bytes[offset];
+        }
+    }
+
+    UnmapViewOfFile(view);
+    return static_cast<qint64>(length);
+}
+#endif
+
+void StartupPreloader::logResult()
+{
+    if (m_reported) {
+        return;
+    }
+    m_reported = true;
+
+    Logger::instance().logEvent("启动预读",
+        QString("预读运行时文件%1个、fontconfig缓存%2个，失败%3个，共%4MB，耗时%5ms%6")
+            .arg(m_result.files)
+            .arg(m_result.fontCacheFiles)
+            .arg(m_result.failedFiles)
+            .arg(m_result.bytes / (1024.0 * 1024.0), 0, 'f', 1)
+            .arg(m_result.elapsedMs)
+            .arg(m_result.interrupted ? "（已中断）" : ""),
+        "performance.log", L_INFO);
+}
@@ -0,0 +1,81 @@
+#ifndef STARTUP_PRELOADER_H
+#define STARTUP_PRELOADER_H
+
+#include <QThread>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief 启动预读线程
+ *
+ * main开头（CefExecuteProcess之后、创建QApplication之前）启动，在后台把CEF运行时文件
+ * （libcef、icudtl.dat、.pak资源、V8快照等，见CEFManager::runtimeFiles）和fontconfig
+ * 缓存读入页缓存。冷启动时CefInitialize和首帧渲染不再逐个缺页读盘。
+ *
+ * Linux使用readahead，Windows只读映射后PrefetchVirtualMemory（Win7逐页访问），
+ * 失败时退化为顺序读；其他平台顺序读取。
+ * 此线程不写日志（Logger尚未创建），结果在reportWhenFinished之后由主线程写入performance.log。
+ * 命令行--no-preload可关闭预读，用于对比冷启动耗时。
+ */
+class StartupPreloader : public QThread
+{
+    Q_OBJECT
+
+public:
+    struct Result {
+        int files = 0;            // 成功预读的运行时文件数
+        int fontCacheFiles = 0;   // 成功预读的fontconfig缓存文件数
+        int failedFiles = 0;      // 打开或读取失败的文件数
+        qint64 bytes = 0;         // 预读总字节数
+        qint64 elapsedMs = 0;
+        bool interrupted = false;
+    };
+
+    static constexpr int kReadChunkBytes = 1024 * 1024;
+
+    /**
+     * @param appDir 程序所在目录（CEF运行时文件所在目录）
+     */
+    explicit StartupPreloader(const QString& appDir, QObject* parent = nullptr);
+    ~StartupPreloader();
+
+    /**
+     * @brief 命令行是否带--no-preload
+     */
+    static bool isDisabled(int argc, char** argv);
+
+    /**
+     * @brief 不依赖QCoreApplication获取程序所在目录
+     */
+    static QString executableDirectory(int argc, char** argv);
+
+    /**
+     * @brief 当前用户和系统的fontconfig缓存文件（非Linux返回空）
+     */
+    static QStringList fontconfigCacheFiles();
+
+    /**
+     * @brief 预读结束后把结果写入performance.log（须在Logger可用后于主线程调用）
+     */
+    void reportWhenFinished();
+
+    const Result& result() const { return m_result; }
+
+protected:
+    void run() override;
+
+private slots:
+    void logResult();
+
+private:
+    qint64 preloadFile(const QString& path);
+#ifdef Q_OS_WIN
+    qint64 prefetchMapped(const QString& path);
+#endif
+
+    QString m_appDir;
+    Result m_result;
+    bool m_reported;   // 结果只写一次（主线程访问）
+};
+
+#endif // STARTUP_PRELOADER_H
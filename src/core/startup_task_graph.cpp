@@ -0,0 +1,258 @@
+#include "startup_task_graph.h"
+#include "../logging/logger.h"
+
+#include <QRunnable>
+#include <QTimer>
+#include <QHash>
+
+namespace {
+
+/**
+ * @brief 在线程池中执行一个启动任务
+ */
+class StartupTaskRunnable : public QRunnable
+{
+public:
+    explicit StartupTaskRunnable(std::function<void()> body) : m_body(body) {}
+    void run() override { m_body(); }
+
+private:
+    std::function<void()> m_body;
+};
+
+} // namespace
+
+StartupTaskGraph::StartupTaskGraph(QObject* parent)
+    : QObject(parent)
+    , m_logger(&Logger::instance())
+    , m_running(false)
+    , m_activeTasks(0)
+{
+}
+
+StartupTaskGraph::~StartupTaskGraph()
+{
+    // 在析构函数体内等待，完成回调排队时对象仍完整；已排队的完成事件随对象销毁丢弃
+    m_pool.waitForDone();
+}
+
+void StartupTaskGraph::addTask(const QString& name, const QStringList& dependencies, Affinity affinity,
+                               std::function<bool()> task)
+{
+    Task entry;
+    entry.name = name;
+    entry.dependencies = dependencies;
+    entry.affinity = affinity;
+    entry.body = [task](Completion done) { done(task()); };
+    entry.state = State::Pending;
+    entry.durationMs = 0;
+    m_tasks.append(entry);
+}
+
+void StartupTaskGraph::addAsyncTask(const QString& name, const QStringList& dependencies, AsyncTask task)
+{
+    Task entry;
+    entry.name = name;
+    entry.dependencies = dependencies;
+    entry.affinity = Affinity::UiThread;
+    entry.body = task;
+    entry.state = State::Pending;
+    entry.durationMs = 0;
+    m_tasks.append(entry);
+}
+
+bool StartupTaskGraph::start()
+{
+    if (m_running) {
+        return true;
+    }
+
+    QString error;
+    if (!validate(&error)) {
+        m_logger->errorEvent(QString("启动任务图无效: %1").arg(error));
+        emit finished(false, QString());
+        return false;
+    }
+
+    for (Task& task : m_tasks) {
+        task.state = State::Pending;
+        task.durationMs = 0;
+    }
+    m_failedTask.clear();
+    m_activeTasks = 0;
+    m_running = true;
+    m_totalElapsed.start();
+
+    scheduleReadyTasks();
+    finishIfIdle();
+    return true;
+}
+
+int StartupTaskGraph::indexOf(const QString& name) const
+{
+    for (int i = 0; i < m_tasks.size(); ++i) {
+        if (m_tasks.at(i).name == name) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool StartupTaskGraph::validate(QString* error) const
+{
+    // 名称唯一、依赖存在
+    QHash<QString, int> indegree;
+    for (const Task& task : m_tasks) {
+        if (indegree.contains(task.name)) {
+            *error = QString("任务名重复: %1").arg(task.name);
+            return false;
+        }
+        indegree.insert(task.name, task.dependencies.size());
+    }
+    for (const Task& task : m_tasks) {
+        for (const QString& dependency : task.dependencies) {
+            if (!indegree.contains(dependency)) {
+                *error = QString("任务%1依赖未知任务%2").arg(task.name, dependency);
+                return false;
+            }
+        }
+    }
+
+    // 拓扑排序检查环
+    QStringList ready;
+    for (auto it = indegree.constBegin(); it != indegree.constEnd(); ++it) {
+        if (it.value() == 0) {
+            ready << it.key();
+        }
+    }
+    int visited = 0;
+    while (!ready.isEmpty()) {
+        const QString name = ready.takeFirst();
+        ++visited;
+        for (const Task& task : m_tasks) {
+            if (task.dependencies.contains(name) && --indegree[task.name] == 0) {
+                ready << task.name;
+            }
+        }
+    }
+    if (visited != m_tasks.size()) {
+        *error = "任务依赖存在环";
+        return false;
+    }
+    return true;
+}
+
+void StartupTaskGraph::scheduleReadyTasks()
+{
+    for (int i = 0; i < m_tasks.size(); ++i) {
+        Task& task = m_tasks[i];
+        if (task.state != State::Pending) {
+            continue;
+        }
+
+        bool ready = true;
+        for (const QString& dependency : task.dependencies) {
+            if (m_tasks.at(indexOf(dependency)).state != State::Done) {
+                ready = false;
+                break;
+            }
+        }
+        if (!ready) {
+            continue;
+        }
+
+        task.state = State::Running;
+        ++m_activeTasks;
+
+        if (task.affinity == Affinity::UiThread) {
+            // 排队执行，让加载对话框在两个任务之间重绘
+            QTimer::singleShot(0, this, [this, i]() { runTask(i); });
+        } else {
+            runTask(i);
+        }
+    }
+}
+
+void StartupTaskGraph::runTask(int index)
+{
+    Task& task = m_tasks[index];
+
+    // 排队期间已有任务失败：不再执行，退回未执行状态
+    if (!m_failedTask.isEmpty()) {
+        task.state = State::Pending;
+        --m_activeTasks;
+        finishIfIdle();
+        return;
+    }
+
+    emit taskStarted(task.name);
+    task.elapsed.start();
+
+    // 完成通知可能来自工作线程，统一排队回到主线程
+    Completion done = [this, index](bool success) {
+        QMetaObject::invokeMethod(this, "onTaskCompleted", Qt::QueuedConnection,
+                                  Q_ARG(int, index), Q_ARG(bool, success));
+    };
+
+    if (task.affinity == Affinity::AnyThread) {
+        AsyncTask body = task.body;
+        m_pool.start(new StartupTaskRunnable([body, done]() { body(done); }));
+    } else {
+        task.body(done);
+    }
+}
+
+void StartupTaskGraph::onTaskCompleted(int index, bool success)
+{
+    Task& task = m_tasks[index];
+    if (task.state != State::Running) {
+        return;
+    }
+
+    task.durationMs = task.elapsed.elapsed();
+    task.state = success ? State::Done : State::Failed;
+    --m_activeTasks;
+
+    m_logger->logEvent("启动任务",
+        QString("%1: %2ms（%3）%4")
+            .arg(task.name)
+            .arg(task.durationMs)
+            .arg(task.affinity == Affinity::UiThread ? "主线程" : "工作线程")
+            .arg(success ? "完成" : "失败"),
+        "performance.log", success ? L_INFO : L_WARNING);
+
+    if (!success && m_failedTask.isEmpty()) {
+        m_failedTask = task.name;
+    }
+
+    // 有任务失败后不再启动新任务，等已在运行的任务结束
+    if (m_failedTask.isEmpty()) {
+        scheduleReadyTasks();
+    }
+    finishIfIdle();
+}
+
+void StartupTaskGraph::finishIfIdle()
+{
+    if (!m_running || m_activeTasks > 0) {
+        return;
+    }
+
+    bool allDone = true;
+    for (const Task& task : m_tasks) {
+        if (task.state != State::Done) {
+            allDone = false;
+            break;
+        }
+    }
+    if (m_failedTask.isEmpty() && !allDone) {
+        return;
+    }
+
+    m_running = false;
+    const bool success = m_failedTask.isEmpty();
+    m_logger->logEvent("启动任务",
+        QString("启动任务图%1，总耗时%2ms").arg(success ? "完成" : "中止").arg(m_totalElapsed.elapsed()),
+        "performance.log", L_INFO);
+    emit finished(success, m_failedTask);
+}
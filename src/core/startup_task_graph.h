@@ -0,0 +1,124 @@
+#ifndef STARTUP_TASK_GRAPH_H
+#define STARTUP_TASK_GRAPH_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QElapsedTimer>
+#include <QList>
+#include <QThreadPool>
+
+#include <functional>
+
+class Logger;
+
+/**
+ * @brief 启动任务依赖图
+ *
+ * 把应用初始化拆成若干带依赖关系的任务，依赖全部完成的任务即可执行：
+ * - UiThread任务排队到主线程事件循环执行，任务之间会让出事件循环，加载动画不再卡住；
+ * - AnyThread任务放入任务图自己的线程池，与其他任务并行（析构时只等待这些任务）；
+ * - 异步任务（如网络检测）通过完成回调结束，不再嵌套QEventLoop。
+ *
+ * 每个任务的耗时和所在线程写入performance.log。任一任务失败即停止调度新任务，
+ * 已在运行的工作线程任务结束后发出finished(false, 任务名)。
+ */
+class StartupTaskGraph : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Affinity {
+        UiThread,   // 只能在主线程执行（Qt界面、CEF初始化等）
+        AnyThread   // 可在工作线程执行（不得触碰界面对象）
+    };
+
+    /**
+     * @brief 任务完成回调，参数为是否成功；可在任意线程调用，但只能调用一次
+     */
+    typedef std::function<void(bool)> Completion;
+
+    /**
+     * @brief 异步任务体：启动后通过Completion报告结果
+     */
+    typedef std::function<void(Completion)> AsyncTask;
+
+    explicit StartupTaskGraph(QObject* parent = nullptr);
+
+    /**
+     * @brief 等待本图仍在运行的工作线程任务结束（不涉及全局线程池中的其他任务）
+     */
+    ~StartupTaskGraph();
+
+    /**
+     * @brief 添加同步任务，返回值表示成功与否
+     */
+    void addTask(const QString& name, const QStringList& dependencies, Affinity affinity,
+                 std::function<bool()> task);
+
+    /**
+     * @brief 添加异步任务（只能是UiThread，结果经回调返回）
+     */
+    void addAsyncTask(const QString& name, const QStringList& dependencies, AsyncTask task);
+
+    /**
+     * @brief 校验依赖（未知依赖、环）后开始执行；须在主线程调用
+     * @return 依赖图无效时返回false并发出finished(false, ...)
+     */
+    bool start();
+
+    bool isRunning() const { return m_running; }
+
+signals:
+    /**
+     * @brief 任务开始执行
+     */
+    void taskStarted(const QString& name);
+
+    /**
+     * @brief 所有任务结束或某任务失败
+     * @param success 是否全部成功
+     * @param failedTask 失败的任务名（成功时为空）
+     */
+    void finished(bool success, const QString& failedTask);
+
+private slots:
+    /**
+     * @brief 任务完成（完成回调可能来自工作线程，经QMetaObject::invokeMethod排队回到主线程）
+     */
+    void onTaskCompleted(int index, bool success);
+
+private:
+    enum class State {
+        Pending,
+        Running,
+        Done,
+        Failed
+    };
+
+    struct Task {
+        QString name;
+        QStringList dependencies;
+        Affinity affinity;
+        AsyncTask body;
+        State state;
+        QElapsedTimer elapsed;
+        qint64 durationMs;
+    };
+
+    int indexOf(const QString& name) const;
+    bool validate(QString* error) const;
+    void scheduleReadyTasks();
+    void runTask(int index);
+    void finishIfIdle();
+
+    Logger* m_logger;
+    QThreadPool m_pool;
+    QList<Task> m_tasks;
+    QElapsedTimer m_totalElapsed;
+    QString m_failedTask;
+    bool m_running;
+    int m_activeTasks;
+};
+
+#endif // STARTUP_TASK_GRAPH_H
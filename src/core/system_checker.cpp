@@ -2,6 +2,9 @@
 #include "application.h"
 #include "../logging/logger.h"
 #include "../config/config_manager.h"
+#include "../network/connectivity_service.h"
+#include "../network/link_state_monitor.h"
+#include "../network/proxy_resolver.h"
 
 #include <QApplication>
 #include <QDir>
@@ -17,11 +20,11 @@
 #include <QNetworkRequest>
 #include <QUrl>
 #include <QTimer>
-#include <QThread>
 #include <QHostAddress>
 #include <QNetworkAddressEntry>
 #include <QLibrary>
 #include <QProcess>
+#include <QRandomGenerator>
 #include <QSysInfo>
 
 #ifdef Q_OS_WIN
@@ -35,16 +38,23 @@ SystemChecker::SystemChecker(QObject *parent)
     , m_configManager(&ConfigManager::instance())
     , m_networkTimeout(nullptr)
     , m_networkManager(nullptr)
+    , m_benchmark(nullptr)
+    , m_benchmarkDelay(nullptr)
+    , m_benchmarkPending(false)
     , m_currentCheck(0)
-    , m_totalChecks(6)
+    , m_totalChecks(7)
     , m_checkInProgress(false)
 {
     // 注册自定义类型用于信号槽
     qRegisterMetaType<SystemChecker::CheckResult>("SystemChecker::CheckResult");
     
-    // 初始化网络管理器
-    m_networkManager = new QNetworkAccessManager(this);
-    m_logger->appEvent("网络管理器已初始化");
+    // 与网络检测共用同一个网络管理器（连接、DNS缓存复用）
+    m_networkManager = ConnectivityService::instance().networkManager();
+
+    // 网络质量测量的随机等待/退避等待
+    m_benchmarkDelay = new QTimer(this);
+    m_benchmarkDelay->setSingleShot(true);
+    connect(m_benchmarkDelay, &QTimer::timeout, this, &SystemChecker::startNetworkBenchmark);
     
     m_logger->appEvent("SystemChecker初始化完成");
 }
@@ -70,43 +80,61 @@ void SystemChecker::startSystemCheck()
 
     m_logger->appEvent("=== 开始全面系统检测 ===");
 
-    // 按顺序执行各项检测
-    QStringList checkNames = {
+    // 每项检测单独经事件循环执行：检测之间UI照常刷新，网络检测提前发起的探测也在后续检测期间真正并行
+    QTimer::singleShot(0, this, &SystemChecker::runNextCheck);
+}
+
+void SystemChecker::runNextCheck()
+{
+    if (!m_checkInProgress) {
+        return;
+    }
+
+    static const QStringList checkNames = {
         "系统兼容性检测",
-        "网络连接检测", 
+        "网络连接检测",
+        "网络质量测量",
         "运行库依赖检查",
         "CEF依赖检查",
         "配置权限验证",
         "组件预加载"
     };
 
-    for (int i = 0; i < checkNames.size(); ++i) {
-        m_currentCheck = i + 1;
-        emit checkProgress(m_currentCheck, m_totalChecks, checkNames[i]);
-        
-        CheckResult result;
-        switch (i) {
-            case 0: result = checkSystemCompatibility(); break;
-            case 1: result = checkNetworkConnection(); break;
-            case 2: result = checkRuntimeDependencies(); break;
-            case 3: result = checkCEFDependencies(); break;
-            case 4: result = checkConfigPermissions(); break;
-            case 5: result = preloadComponents(); break;
-        }
-        
-        m_results.append(result);
-        emit checkItemCompleted(result);
-        
-        // 如果遇到致命错误，停止后续检测
-        if (result.level == LEVEL_FATAL) {
-            m_logger->errorEvent(QString("检测到致命错误: %1").arg(result.message));
-            break;
-        }
-        
-        // 给UI一些时间更新
-        QThread::msleep(100);
+    const int index = m_currentCheck;
+    if (index >= checkNames.size()) {
+        finishSystemCheck();
+        return;
+    }
+
+    m_currentCheck = index + 1;
+    emit checkProgress(m_currentCheck, m_totalChecks, checkNames[index]);
+
+    CheckResult result;
+    switch (index) {
+        case 0: result = checkSystemCompatibility(); break;
+        case 1: result = checkNetworkConnection(); break;
+        case 2: result = checkNetworkQuality(); break;
+        case 3: result = checkRuntimeDependencies(); break;
+        case 4: result = checkCEFDependencies(); break;
+        case 5: result = checkConfigPermissions(); break;
+        case 6: result = preloadComponents(); break;
+    }
+
+    m_results.append(result);
+    emit checkItemCompleted(result);
+
+    // 如果遇到致命错误，停止后续检测
+    if (result.level == LEVEL_FATAL) {
+        m_logger->errorEvent(QString("检测到致命错误: %1").arg(result.message));
+        finishSystemCheck();
+        return;
     }
 
+    QTimer::singleShot(0, this, &SystemChecker::runNextCheck);
+}
+
+void SystemChecker::finishSystemCheck()
+{
     bool success = !hasFatalErrors();
     m_checkInProgress = false;
     
@@ -199,14 +227,13 @@ SystemChecker::CheckResult SystemChecker::checkNetworkConnection()
     QStringList issues;
     CheckLevel maxLevel = LEVEL_OK;
 
-    // 检查网络接口
-    QList<QNetworkInterface> interfaces = QNetworkInterface::allInterfaces();
+    // 检查网络接口：读取链路跟踪缓存的状态（Linux由rtnetlink事件维护），不再逐个扫描
+    LinkStateMonitor& linkState = LinkStateMonitor::instance();
+    const QList<LinkStateMonitor::InterfaceState> interfaces = linkState.interfaces();
     bool hasActiveInterface = false;
     
-    for (const QNetworkInterface &interface : interfaces) {
-        if (interface.flags() & QNetworkInterface::IsUp && 
-            interface.flags() & QNetworkInterface::IsRunning &&
-            !(interface.flags() & QNetworkInterface::IsLoopBack)) {
+    for (const LinkStateMonitor::InterfaceState &interface : interfaces) {
+        if (interface.up && interface.running && !interface.loopback) {
             hasActiveInterface = true;
             break;
         }
@@ -218,10 +245,10 @@ SystemChecker::CheckResult SystemChecker::checkNetworkConnection()
         
         // 如果没有活动接口，尝试检查更多信息
         bool hasAnyInterface = false;
-        for (const QNetworkInterface &interface : interfaces) {
-            if (!(interface.flags() & QNetworkInterface::IsLoopBack)) {
+        for (const LinkStateMonitor::InterfaceState &interface : interfaces) {
+            if (!interface.loopback) {
                 hasAnyInterface = true;
-                m_logger->appEvent(QString("发现网络接口 %1，但未激活").arg(interface.name()));
+                m_logger->appEvent(QString("发现网络接口 %1，但未激活").arg(interface.name));
             }
         }
         
@@ -240,29 +267,17 @@ SystemChecker::CheckResult SystemChecker::checkNetworkConnection()
         result.solution = "网络连接完全断开，请检查：\n1. 网络电缆连接\n2. WiFi开关状态\n3. 网络适配器状态\n4. 联系网络管理员";
     } else {
         // 有活动接口，进一步检查网络连通性
-        // 检查是否只有本地连接
-        bool hasInternetCapability = false;
-        for (const QNetworkInterface &interface : interfaces) {
-            if (interface.flags() & QNetworkInterface::IsUp && 
-                interface.flags() & QNetworkInterface::IsRunning &&
-                !(interface.flags() & QNetworkInterface::IsLoopBack)) {
-                
-                // 检查是否有非本地IP地址
-                QList<QNetworkAddressEntry> entries = interface.addressEntries();
-                for (const QNetworkAddressEntry &entry : entries) {
-                    QHostAddress addr = entry.ip();
-                    if (!addr.isLoopback() && !addr.isLinkLocal()) {
-                        hasInternetCapability = true;
-                        break;
-                    }
-                }
-            }
-        }
+        // 检查是否只有本地连接（需有非回环、非链路本地地址）
+        const bool hasInternetCapability = linkState.hasUsableLink();
         
         if (!hasInternetCapability) {
             issues << "仅本地网络连接，无法访问互联网";
             maxLevel = qMax(maxLevel, LEVEL_ERROR);
             result.solution = "请检查：\n1. 路由器互联网连接\n2. DNS设置\n3. 代理服务器设置";
+        } else {
+            // 接口可用：在后台提前发起连通性探测，剩余检测项执行期间完成，
+            // 启动任务图的网络检测直接复用结果
+            ConnectivityService::instance().prefetch();
         }
     }
 
@@ -289,6 +304,131 @@ SystemChecker::CheckResult SystemChecker::checkNetworkConnection()
     return result;
 }
 
+SystemChecker::CheckResult SystemChecker::checkTargetReachability()
+{
+    CheckResult result;
+    result.type = CHECK_NETWORK_QUALITY;
+    result.title = "目标可达性检测";
+    result.canRetry = true;
+
+    // 依据最近一次网络测量：任何HTTP响应都说明服务器可达
+    if (m_lastBenchmark.isReachable()) {
+        result.message = "测量地址可以访问";
+        return result;
+    }
+
+    result.level = LEVEL_WARNING;
+    result.message = "测量地址无法访问，无法评估网络质量";
+    result.details << QString("地址: %1").arg(m_configManager->getNetworkBenchmarkUrl());
+    if (!m_lastBenchmark.lastError.isEmpty()) {
+        result.details << QString("错误: %1").arg(m_lastBenchmark.lastError);
+    }
+    result.solution = "请检查：\n1. 考试服务器地址是否正确\n2. 防火墙或代理是否拦截\n3. 联系网络管理员";
+    return result;
+}
+
+SystemChecker::CheckResult SystemChecker::checkNetworkQuality()
+{
+    CheckResult result;
+    result.type = CHECK_NETWORK_QUALITY;
+    result.title = "网络质量测量";
+    result.canRetry = true;
+
+    if (!m_configManager->isNetworkBenchmarkEnabled()) {
+        result.message = "网络质量测量已关闭";
+        return result;
+    }
+    if (!LinkStateMonitor::instance().hasUsableLink()) {
+        // 网络连接检测已报告问题，这里不再重复
+        result.message = "无可用网络，跳过测量";
+        return result;
+    }
+    if (ProxyResolver::hasInstance() && !ProxyResolver::instance().isResolved()) {
+        // 代理解析超时时Qt仍按直连访问，在只允许代理出网的考场会误报测量地址不可达
+        result.message = "系统代理尚未确定，跳过测量";
+        return result;
+    }
+
+    // 测量在后台进行，后续检测和启动流程不等待；结果到达后替换这里的占位结果
+    scheduleNetworkBenchmark();
+    result.message = "网络质量测量已在后台开始";
+    return result;
+}
+
+SystemChecker::CheckResult SystemChecker::evaluateNetworkQuality()
+{
+    CheckResult result;
+    result.type = CHECK_NETWORK_QUALITY;
+    result.title = "网络质量测量";
+    result.canRetry = true;
+
+    CheckResult reachability = checkTargetReachability();
+    if (reachability.level != LEVEL_OK) {
+        return reachability;
+    }
+
+    const NetworkBenchmark::Result& measured = m_lastBenchmark;
+    const double p50 = measured.percentileRtt(0.5);
+    const double p90 = measured.percentileRtt(0.9);
+    const double worst = measured.percentileRtt(1.0);
+    const double throughput = measured.throughputKbps();
+    const int rttWarningMs = m_configManager->getNetworkRttWarningMs();
+    const int throughputWarningKbps = m_configManager->getNetworkThroughputWarningKbps();
+
+    QStringList issues;
+    CheckLevel maxLevel = LEVEL_OK;
+
+    if (measured.setupMs >= 0) {
+        result.details << QString("首次请求（含建连）: %1ms").arg(measured.setupMs, 0, 'f', 0);
+    }
+    if (p50 >= 0) {
+        result.details << QString("往返时间: p50 %1ms / p90 %2ms / 最大 %3ms（%4个样本）")
+            .arg(p50, 0, 'f', 0).arg(p90, 0, 'f', 0).arg(worst, 0, 'f', 0).arg(measured.rttMs.size());
+    }
+    if (throughput >= 0) {
+        result.details << QString("下载吞吐量: %1 Mbps（%2 / %3ms）")
+            .arg(throughput / 1000.0, 0, 'f', 1).arg(formatFileSize(measured.downloadBytes)).arg(measured.downloadMs);
+    } else {
+        result.details << QString("下载吞吐量: 数据量不足，未能测量（收到%1）").arg(formatFileSize(measured.downloadBytes));
+    }
+
+    // 样本不足时（如只有建连请求）以首次请求耗时代替，宁可偏保守
+    const double rttForCheck = p90 >= 0 ? p90 : measured.setupMs;
+    if (rttForCheck > rttWarningMs) {
+        issues << QString("网络延迟偏高：%1ms，阈值%2ms").arg(rttForCheck, 0, 'f', 0).arg(rttWarningMs);
+        maxLevel = LEVEL_WARNING;
+    }
+    if (throughput >= 0 && throughput < throughputWarningKbps) {
+        issues << QString("下载带宽不足：%1 Mbps，阈值%2 Mbps")
+            .arg(throughput / 1000.0, 0, 'f', 1).arg(throughputWarningKbps / 1000.0, 0, 'f', 1);
+        maxLevel = LEVEL_WARNING;
+    }
+    if (measured.failures > 0) {
+        issues << QString("%1/%2个测量请求失败：%3").arg(measured.failures).arg(measured.requests).arg(measured.lastError);
+        maxLevel = LEVEL_WARNING;
+    }
+    if (measured.timedOut) {
+        issues << QString("测量未能在%1ms内完成").arg(m_configManager->getNetworkBenchmarkBudgetMs());
+        maxLevel = LEVEL_WARNING;
+    }
+
+    result.level = maxLevel;
+    result.details = issues + result.details;
+
+    if (maxLevel == LEVEL_OK) {
+        result.message = p90 >= 0
+            ? QString("网络质量良好（RTT p90 %1ms）").arg(p90, 0, 'f', 0)
+            : QString("网络质量良好");
+    } else {
+        result.message = "网络质量可能无法支撑考试";
+        result.solution = "考场网络延迟或带宽不达标，请联系监考或网络管理员检查交换机、无线接入点和出口带宽";
+    }
+
+    m_logger->logEvent("网络质量测量", QString("%1；%2").arg(result.message, result.details.join("；")),
+                       "network.log", maxLevel == LEVEL_OK ? L_INFO : L_WARNING);
+    return result;
+}
+
 SystemChecker::CheckResult SystemChecker::checkCEFDependencies()
 {
     CheckResult result;
@@ -629,6 +769,75 @@ bool SystemChecker::installVCRuntimePackage()
 #endif
 }
 
+void SystemChecker::scheduleNetworkBenchmark()
+{
+    if (!m_benchmark) {
+        // 使用共用网络管理器，与连通性探测复用连接、DNS和代理设置
+        m_benchmark = new NetworkBenchmark(m_networkManager, this);
+        connect(m_benchmark, &NetworkBenchmark::finished, this, &SystemChecker::onNetworkBenchmarkFinished);
+    }
+
+    // 重新检测时作废上一次未完成的测量
+    m_benchmarkPending = false;
+    m_benchmarkDelay->stop();
+    m_benchmark->abort();
+
+    // 随机错开开始时间，并服从连通性探测共用的退避：整个考场同时开机或一起点重试时，
+    // 测量请求不会在同一时刻集中到达考试服务器
+    const int jitterMs = static_cast<int>(QRandomGenerator::global()->bounded(
+        static_cast<quint32>(m_configManager->getNetworkBenchmarkJitterMs()) + 1));
+    const qint64 backoffMs = ConnectivityService::instance().retryScheduler().remainingMs();
+    const int delayMs = static_cast<int>(qMax<qint64>(jitterMs, backoffMs));
+
+    m_benchmarkPending = true;
+    m_benchmarkDelay->start(delayMs);
+    m_logger->logEvent("网络质量测量", QString("%1ms后在后台开始（随机等待%2ms，退避剩余%3ms）")
+        .arg(delayMs).arg(jitterMs).arg(backoffMs), "network.log", L_DEBUG);
+}
+
+void SystemChecker::startNetworkBenchmark()
+{
+    // 代理已由Application::prepareProxy在系统检测之前应用，测量与CEF走同一路径
+    m_benchmark->start(QUrl(m_configManager->getNetworkBenchmarkUrl()),
+                       m_configManager->getNetworkBenchmarkSamples(),
+                       QUrl(m_configManager->getNetworkBenchmarkDownloadUrl()),
+                       m_configManager->getNetworkBenchmarkDownloadBytes(),
+                       m_configManager->getNetworkBenchmarkBudgetMs());
+}
+
+void SystemChecker::onNetworkBenchmarkFinished(const NetworkBenchmark::Result& measured)
+{
+    if (!m_benchmarkPending) {
+        return;   // 已作废的测量
+    }
+    m_benchmarkPending = false;
+    m_lastBenchmark = measured;
+
+    // 测量地址完全不可达时计入共用退避，连通性探测的下一次重试随之推后
+    RetryScheduler& retry = ConnectivityService::instance().retryScheduler();
+    if (!measured.isReachable()) {
+        const int delay = retry.recordFailure();
+        m_logger->logEvent("网络质量测量", QString("测量地址不可达，共用退避%1ms").arg(delay),
+                           "network.log", L_WARNING);
+    }
+
+    const CheckResult result = evaluateNetworkQuality();
+
+    // 替换检测开始时的占位结果；系统检测已结束时结果照常发出，加载界面仍在时会显示
+    bool replaced = false;
+    for (int i = 0; i < m_results.size(); ++i) {
+        if (m_results[i].type == CHECK_NETWORK_QUALITY) {
+            m_results[i] = result;
+            replaced = true;
+            break;
+        }
+    }
+    if (!replaced) {
+        m_results.append(result);
+    }
+    emit checkItemCompleted(result);
+}
+
 void SystemChecker::retryCheck(CheckType type)
 {
     m_logger->appEvent(QString("重试检测项目: %1").arg(static_cast<int>(type)));
@@ -637,6 +846,7 @@ void SystemChecker::retryCheck(CheckType type)
     switch (type) {
         case CHECK_SYSTEM_COMPATIBILITY: result = checkSystemCompatibility(); break;
         case CHECK_NETWORK_CONNECTION: result = checkNetworkConnection(); break;
+        case CHECK_NETWORK_QUALITY: result = checkNetworkQuality(); break;
         case CHECK_CEF_DEPENDENCIES: result = checkCEFDependencies(); break;
         case CHECK_RUNTIME_DEPENDENCIES: result = checkRuntimeDependencies(); break;
         case CHECK_CONFIG_PERMISSIONS: result = checkConfigPermissions(); break;
@@ -8,6 +8,7 @@
 #include <QNetworkInterface>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
+#include "../network/network_benchmark.h"
 
 class Logger;
 class ConfigManager;
@@ -18,6 +19,7 @@ class ConfigManager;
  * 负责启动时的各种系统检测，包括：
  * - 系统兼容性检测（Qt版本、OpenGL驱动、操作系统）
  * - 网络连接检测（连接状态、质量、目标可达性）
+ * - 网络质量测量（RTT分布、下载吞吐量，超过配置阈值时警告；在后台进行，不阻塞后续检测和启动）
  * - CEF依赖完整性检查（文件存在、版本兼容、完整性）
  * - 配置和权限验证（文件权限、管理员权限、磁盘空间）
  */
@@ -45,7 +47,8 @@ public:
         CHECK_CEF_DEPENDENCIES,      // CEF依赖
         CHECK_RUNTIME_DEPENDENCIES,  // 运行时依赖
         CHECK_CONFIG_PERMISSIONS,    // 配置和权限
-        CHECK_PRELOAD_COMPONENTS     // 预加载组件
+        CHECK_PRELOAD_COMPONENTS,    // 预加载组件
+        CHECK_NETWORK_QUALITY        // 网络质量（延迟、带宽）
     };
 
     /**
@@ -69,6 +72,7 @@ public:
 
     /**
      * @brief 开始全面系统检测
+     * 各项检测依次经事件循环异步执行，结束后发出checkCompleted
      */
     void startSystemCheck();
 
@@ -133,8 +137,13 @@ signals:
 
 private slots:
     void onNetworkCheckTimeout();
+    void runNextCheck();
+    void startNetworkBenchmark();
+    void onNetworkBenchmarkFinished(const NetworkBenchmark::Result& measured);
 
 private:
+    void finishSystemCheck();
+
     // 具体检测方法
     CheckResult checkSystemCompatibility();
     CheckResult checkQtCompatibility();
@@ -145,6 +154,7 @@ private:
     CheckResult checkNetworkConnection();
     CheckResult checkBasicConnectivity();
     CheckResult checkNetworkQuality();
+    CheckResult evaluateNetworkQuality();
     CheckResult checkTargetReachability();
 
     CheckResult checkCEFDependencies();
@@ -166,6 +176,7 @@ private:
     qint64 getAvailableDiskSpace(const QString& path);
     QString getSystemDescription();
     bool installVCRuntimePackage();
+    void scheduleNetworkBenchmark();
 
 private:
     Logger* m_logger;
@@ -173,6 +184,10 @@ private:
     QList<CheckResult> m_results;
     QTimer* m_networkTimeout;
     QNetworkAccessManager* m_networkManager;
+    NetworkBenchmark* m_benchmark;
+    NetworkBenchmark::Result m_lastBenchmark;
+    QTimer* m_benchmarkDelay;
+    bool m_benchmarkPending;    // 有尚未给出结果的测量
     
     int m_currentCheck;
     int m_totalChecks;
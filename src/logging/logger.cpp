@@ -49,6 +49,7 @@ Logger& Logger::instance()
 Logger::Logger()
     : QObject(nullptr)
     , m_logLevel(L_INFO)
+    , m_bufferMutex(QMutex::Recursive)
     , m_flushTimer(nullptr)
     , m_performanceTimer(nullptr)
 {
@@ -104,6 +105,7 @@ void Logger::logEvent(const QString &category, const QString &message, const QSt
     entry.message = message;
     entry.filename = filename;
 
+    QMutexLocker locker(&m_bufferMutex);
     m_logBuffer[filename].append(entry);
 
     // 如果缓冲区达到限制或者是警告/错误级别，立即刷新
@@ -114,6 +116,7 @@ void Logger::logEvent(const QString &category, const QString &message, const QSt
 
 void Logger::flushLogBuffer(const QString &filename)
 {
+    QMutexLocker locker(&m_bufferMutex);
     if (m_logBuffer[filename].isEmpty()) {
         return;
     }
@@ -148,6 +151,7 @@ void Logger::flushLogBuffer(const QString &filename)
 
 void Logger::flushAllLogBuffers()
 {
+    QMutexLocker locker(&m_bufferMutex);
     const QStringList keys = m_logBuffer.keys();
     for (const QString &key : keys) {
         flushLogBuffer(key);
@@ -281,6 +285,25 @@ void Logger::performanceEvent(const PerformanceMetrics &metrics)
      .arg(metrics.processThreads);
 
     logEvent("性能监控", message, "performance.log", L_INFO);
+
+    const PagePerformanceMetrics &page = metrics.page;
+    if (page.updated.isValid()) {
+        logEvent("页面性能", QString(
+            "长任务: %1次/%2ms (最长%3ms) | LCP: %4ms | CLS: %5 | JS堆: %6/%7MB | 渲染进程内存: %8MB | "
+            "缓存命中: %9/%10 (%11%)"
+        ).arg(page.longTaskCount)
+         .arg(page.longTaskTotalMs, 0, 'f', 0)
+         .arg(page.longTaskMaxMs, 0, 'f', 0)
+         .arg(page.lcpMs, 0, 'f', 0)
+         .arg(page.cls, 0, 'f', 3)
+         .arg(page.jsHeapUsedMB, 0, 'f', 1)
+         .arg(page.jsHeapLimitMB, 0, 'f', 1)
+         .arg(page.rendererRssMB, 0, 'f', 1)
+         .arg(page.resourceCachedCount)
+         .arg(page.resourceCount)
+         .arg(page.resourceCount > 0 ? 100.0 * page.resourceCachedCount / page.resourceCount : 0.0, 0, 'f', 1),
+         "performance.log", L_INFO);
+    }
 }
 
 void Logger::startPerformanceMonitoring()
@@ -303,6 +326,56 @@ void Logger::onPerformanceTimerTimeout()
 {
     PerformanceMetrics metrics = collectPerformanceMetrics();
     performanceEvent(metrics);
+
+    // 长任务、资源请求按监控周期统计
+    m_pagePerformance.longTaskCount = 0;
+    m_pagePerformance.longTaskTotalMs = 0.0;
+    m_pagePerformance.longTaskMaxMs = 0.0;
+    m_pagePerformance.resourceCount = 0;
+    m_pagePerformance.resourceCachedCount = 0;
+
+    // 渲染进程遥测汇总与系统指标写入同一文件，便于对照
+    if (m_rendererTelemetry.batches > 0) {
+        logEvent("渲染进程遥测", QString(
+            "批次: %1 | 字节: %2KB | 丢弃批次: %3 | 安全事件: %4 | JS错误: %5 | 性能条目: %6"
+        ).arg(m_rendererTelemetry.batches)
+         .arg(m_rendererTelemetry.bytes / 1024)
+         .arg(m_rendererTelemetry.droppedBatches)
+         .arg(m_rendererTelemetry.securityEvents)
+         .arg(m_rendererTelemetry.jsErrors)
+         .arg(m_rendererTelemetry.perfEntries),
+         "performance.log", L_INFO);
+    }
+}
+
+void Logger::rendererTelemetryEvent(const RendererTelemetry &delta)
+{
+    m_rendererTelemetry.batches += delta.batches;
+    m_rendererTelemetry.bytes += delta.bytes;
+    m_rendererTelemetry.droppedBatches += delta.droppedBatches;
+    m_rendererTelemetry.securityEvents += delta.securityEvents;
+    m_rendererTelemetry.jsErrors += delta.jsErrors;
+    m_rendererTelemetry.perfEntries += delta.perfEntries;
+}
+
+RendererTelemetry Logger::rendererTelemetry() const
+{
+    return m_rendererTelemetry;
+}
+
+void Logger::pagePerformanceEvent(const PagePerformanceMetrics &sample)
+{
+    m_pagePerformance.longTaskCount += sample.longTaskCount;
+    m_pagePerformance.longTaskTotalMs += sample.longTaskTotalMs;
+    m_pagePerformance.longTaskMaxMs = qMax(m_pagePerformance.longTaskMaxMs, sample.longTaskMaxMs);
+    m_pagePerformance.lcpMs = sample.lcpMs;
+    m_pagePerformance.cls = sample.cls;
+    m_pagePerformance.jsHeapUsedMB = sample.jsHeapUsedMB;
+    m_pagePerformance.jsHeapLimitMB = sample.jsHeapLimitMB;
+    m_pagePerformance.rendererRssMB = sample.rendererRssMB;
+    m_pagePerformance.resourceCount += sample.resourceCount;
+    m_pagePerformance.resourceCachedCount += sample.resourceCachedCount;
+    m_pagePerformance.updated = QDateTime::currentDateTime();
 }
 
 PerformanceMetrics Logger::collectPerformanceMetrics()
@@ -324,15 +397,17 @@ PerformanceMetrics Logger::collectPerformanceMetrics()
     metrics.processThreads = 0;
 
 #ifdef Q_OS_WIN
-    return collectWindowsPerformanceMetrics();
+    metrics = collectWindowsPerformanceMetrics();
 #elif defined(Q_OS_MAC)
-    return collectMacOSPerformanceMetrics();
+    metrics = collectMacOSPerformanceMetrics();
 #elif defined(Q_OS_LINUX)
-    return collectLinuxPerformanceMetrics();
+    metrics = collectLinuxPerformanceMetrics();
 #else
     errorEvent("不支持的平台，无法收集性能指标");
-    return metrics;
 #endif
+
+    metrics.page = m_pagePerformance;
+    return metrics;
 }
 
 #ifdef Q_OS_WIN
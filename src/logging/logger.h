@@ -7,6 +7,7 @@
 #include <QMap>
 #include <QList>
 #include <QTimer>
+#include <QMutex>
 
 class QWidget;
 
@@ -26,6 +27,26 @@ struct LogEntry {
     QString filename;
 };
 
+// 页面性能指标（渲染进程PerformanceObserver汇总，经遥测通道上报）
+struct PagePerformanceMetrics {
+    int longTaskCount;           // 本监控周期长任务数
+    double longTaskTotalMs;      // 本监控周期长任务总时长 (ms)
+    double longTaskMaxMs;        // 本监控周期最长任务 (ms)
+    double lcpMs;                // 当前页面LCP (ms，未观测到为0)
+    double cls;                  // 当前页面累计布局偏移
+    double jsHeapUsedMB;         // 主框架JS堆已用 (MB)
+    double jsHeapLimitMB;        // 主框架JS堆上限 (MB)
+    double rendererRssMB;        // 渲染进程常驻内存 (MB)
+    int resourceCount;           // 本监控周期可判断来源的资源请求数
+    int resourceCachedCount;     // 本监控周期由缓存提供的请求数
+    QDateTime updated;           // 最近一次上报时间（无效表示尚未收到）
+
+    PagePerformanceMetrics()
+        : longTaskCount(0), longTaskTotalMs(0.0), longTaskMaxMs(0.0)
+        , lcpMs(0.0), cls(0.0), jsHeapUsedMB(0.0), jsHeapLimitMB(0.0), rendererRssMB(0.0)
+        , resourceCount(0), resourceCachedCount(0) {}
+};
+
 // 性能指标数据结构
 struct PerformanceMetrics {
     double cpuUsageSystem;      // 系统CPU使用率 (%)
@@ -40,6 +61,21 @@ struct PerformanceMetrics {
     int processHandles;          // 进程句柄数
     int processThreads;          // 进程线程数
     QDateTime timestamp;         // 采集时间戳
+    PagePerformanceMetrics page; // 页面性能指标
+};
+
+// 渲染进程遥测累计数据（由CEF遥测IPC通道解码后累加）
+struct RendererTelemetry {
+    quint64 batches;             // 收到的批次数
+    quint64 bytes;               // 收到的字节数
+    quint64 droppedBatches;      // 版本不符或损坏而丢弃的批次数
+    quint64 securityEvents;      // 页面安全钩子事件数
+    quint64 jsErrors;            // 未捕获JS异常数
+    quint64 perfEntries;         // 页面性能条目数
+
+    RendererTelemetry()
+        : batches(0), bytes(0), droppedBatches(0)
+        , securityEvents(0), jsErrors(0), perfEntries(0) {}
 };
 
 /**
@@ -142,6 +178,22 @@ public:
      */
     PerformanceMetrics collectPerformanceMetrics();
 
+    /**
+     * @brief 累加一个遥测批次的统计增量
+     */
+    void rendererTelemetryEvent(const RendererTelemetry &delta);
+
+    /**
+     * @brief 获取渲染进程遥测累计数据
+     */
+    RendererTelemetry rendererTelemetry() const;
+
+    /**
+     * @brief 合并一次页面性能汇总
+     * 长任务按监控周期累加（写入performance.log后清零），其余指标取最新值
+     */
+    void pagePerformanceEvent(const PagePerformanceMetrics &sample);
+
 private:
     Logger();
     ~Logger();
@@ -166,8 +218,11 @@ private:
     
     LogLevel m_logLevel;
     QMap<QString, QList<LogEntry>> m_logBuffer;
+    QMutex m_bufferMutex;   // 保护m_logBuffer，启动任务可能在工作线程写日志
     QTimer* m_flushTimer;
     QTimer* m_performanceTimer;
+    RendererTelemetry m_rendererTelemetry;
+    PagePerformanceMetrics m_pagePerformance;
 };
 
 #endif // LOGGER_H
\ No newline at end of file
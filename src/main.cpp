@@ -4,12 +4,19 @@
 #include <QMessageBox>
 #include <QTextCodec>
 #include <QMetaObject>
+#include <QTimer>
 #include <QInputDialog>
 
 #include "core/application.h"
 #include "core/secure_browser.h"
+#include "core/cache_warmer.h"
+#include "core/single_instance.h"
+#include "core/startup_preloader.h"
+#include "core/process_info.h"
 #include "logging/logger.h"
 #include "config/config_manager.h"
+#include "network/link_state_monitor.h"
+#include "network/connectivity_service.h"
 #include "ui/loading_dialog.h"
 #include "cef/cef_app_impl.h"
 
@@ -168,6 +175,22 @@ int main(int argc, char *argv[])
         return exit_code;
     }
 
+    // 重复启动：在创建QApplication、初始化CEF之前把参数转交给运行中的实例并退出。
+    // 缓存预热模式需要独占缓存目录，不做转交
+    const bool warmCacheMode = CacheWarmer::isRequested(originalArgc, originalArgv);
+    if (!warmCacheMode &&
+        SingleInstanceServer::forwardToRunningInstance(originalArgc, originalArgv,
+                                                       ProcessInfo::ageMs())) {
+        return 0;
+    }
+
+    // 确定是本程序的主进程后立即开始后台预读CEF运行时文件，与Qt、配置加载并行
+    StartupPreloader* preloader = nullptr;
+    if (!StartupPreloader::isDisabled(originalArgc, originalArgv)) {
+        preloader = new StartupPreloader(StartupPreloader::executableDirectory(originalArgc, originalArgv));
+        preloader->start();
+    }
+
     // 注意：不在这里创建QApplication，而是使用Application类（继承自QApplication）
 
 #ifdef Q_OS_WIN
@@ -179,6 +202,11 @@ int main(int argc, char *argv[])
     SetErrorMode(SEM_FAILCRITICALERRORS | SEM_NOGPFAULTERRORBOX);
 #endif
 
+    // 缓存预热模式无界面运行：使用offscreen平台插件，镜像构建环境无需显示器
+    if (warmCacheMode && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
     // Qt高DPI感知开启（与上面的SetProcessDpiAwarenessContext=PerMonitorV2配合）：
     // - AA_EnableHighDpiScaling：Qt按系统DPI自动缩放QWidget布局、字体、对话框
     // - AA_UseHighDpiPixmaps：位图资源按DPR加载，避免图标/启动页模糊
@@ -189,6 +217,10 @@ int main(int argc, char *argv[])
     // 创建应用程序实例（必须在使用任何Qt功能之前创建）
     Application application(argc, argv, originalArgc, originalArgv);
     application.setSharedCEFApp(sharedCefApp);
+    if (preloader) {
+        // 随Application析构，析构时若仍在预读则中断并等待
+        preloader->setParent(&application);
+    }
 
     // 初始化日志系统
     Logger& logger = Logger::instance();
@@ -198,10 +230,16 @@ int main(int argc, char *argv[])
     
     // 记录系统信息
     logger.logSystemInfo();
+
+    if (preloader) {
+        preloader->reportWhenFinished();
+    } else {
+        logger.appEvent("启动预读已关闭（--no-preload）");
+    }
     
 #ifdef Q_OS_WIN
     // Windows平台：检查管理员权限（作为清单文件的备用方案）
-    if (!requireAdminPrivilegesOrExit(argc, argv, logger)) {
+    if (!warmCacheMode && !requireAdminPrivilegesOrExit(argc, argv, logger)) {
         return 0;
     }
 #endif
@@ -221,6 +259,15 @@ int main(int argc, char *argv[])
     logger.appEvent(QString("应用程序名称: %1").arg(configManager.getAppName()));
     logger.appEvent(QString("目标URL: %1").arg(configManager.getUrl()));
 
+    // 缓存预热模式：不显示加载对话框和主窗口，预热结束后以退出码表示是否全部成功
+    if (warmCacheMode) {
+        CacheWarmer warmer(&application);
+        QTimer::singleShot(0, &warmer, &CacheWarmer::start);
+        int warmResult = application.exec();
+        logger.appEvent(QString("缓存预热退出，返回码: %1").arg(warmResult));
+        return warmResult;
+    }
+
     // 创建并显示加载对话框
     LoadingDialog* loadingDialog = new LoadingDialog();
     loadingDialog->show();
@@ -232,32 +279,33 @@ int main(int argc, char *argv[])
     bool applicationInitialized = false;
     bool shouldExit = false;
 
+    // 连接初始化进度信号（只连接一次，重试时复用）
+    QObject::connect(&application, &Application::initializationProgress,
+                     loadingDialog, &LoadingDialog::setStatus);
+    QObject::connect(&application, &Application::initializationError,
+                     loadingDialog, &LoadingDialog::setError);
+    QObject::connect(&application, &Application::initializationError, [&](const QString& error) {
+        logger.errorEvent(QString("应用程序初始化失败: %1").arg(error));
+    });
+    QObject::connect(&application, &Application::initializationCompleted, [&]() {
+        applicationInitialized = true;
+        logger.appEvent("应用程序初始化成功，准备启动主窗口");
+
+        // 初始化成功后，触发主窗口启动
+        // 注意：不能直接调用 startMainWindow()，因为需要通过 readyToStartApplication 信号
+        // 来确保所有相关的信号连接都已建立
+        QMetaObject::invokeMethod(loadingDialog, "readyToStartApplication", Qt::QueuedConnection);
+    });
+
     // 连接系统检测完成信号（必须在startSystemCheck之前连接）
     QObject::connect(loadingDialog, &LoadingDialog::systemCheckCompleted, 
                      [&](bool checkSuccess) {
         if (checkSuccess) {
             logger.appEvent("系统检测通过，开始初始化应用程序");
-            
-            // 连接初始化进度信号
-            QObject::connect(&application, &Application::initializationProgress,
-                             loadingDialog, &LoadingDialog::setStatus);
-            QObject::connect(&application, &Application::initializationError,
-                             loadingDialog, &LoadingDialog::setError);
-            
-            // 开始应用程序初始化
+
+            // 开始应用程序初始化：各步骤在事件循环中按依赖图执行，加载动画保持流畅
             loadingDialog->startApplicationLoad();
-            if (application.initialize()) {
-                applicationInitialized = true;
-                logger.appEvent("应用程序初始化成功，准备启动主窗口");
-
-                // 初始化成功后，触发主窗口启动
-                // 注意：不能直接调用 startMainWindow()，因为需要通过 readyToStartApplication 信号
-                // 来确保所有相关的信号连接都已建立
-                QMetaObject::invokeMethod(loadingDialog, "readyToStartApplication", Qt::QueuedConnection);
-            } else {
-                logger.errorEvent("应用程序初始化失败");
-                loadingDialog->setError("应用程序初始化失败\n请查看日志文件");
-            }
+            application.startInitialization();
         } else {
             logger.errorEvent("系统检测失败，阻止应用程序启动");
             // 停留在LoadingDialog显示错误，等待用户操作
@@ -274,7 +322,7 @@ int main(int argc, char *argv[])
             // 如果应用程序已初始化，重新初始化应用程序
             loadingDialog->startAnimation();
             loadingDialog->setStatus("重新初始化...");
-            application.initialize();
+            application.startInitialization();
         }
     });
     
@@ -334,9 +382,23 @@ int main(int argc, char *argv[])
         }
     });
 
-    // 所有信号连接完成后，开始系统检测
+    // 加载期间网络链路断开/恢复立即反映到对话框（对话框关闭后自动断开连接）
+    QObject::connect(&LinkStateMonitor::instance(), &LinkStateMonitor::usableLinkChanged, loadingDialog,
+                     [loadingDialog](bool usable, const QString& summary) {
+        loadingDialog->setStatus(usable ? "网络已恢复" : "网络连接已断开：" + summary);
+    });
+
+    // 重试被退避推迟时提示用户，避免误以为点击无效
+    QObject::connect(&ConnectivityService::instance(), &ConnectivityService::retryScheduled, loadingDialog,
+                     [loadingDialog](int delayMs, int) {
+        loadingDialog->setStatus(QString("网络暂不可用，%1秒后自动重试...").arg((delayMs + 999) / 1000));
+    });
+
+    // 所有信号连接完成后，开始系统检测；检测的网络探测须与CEF走同一代理，先确定系统代理
     logger.appEvent("开始系统检测流程");
-    loadingDialog->startSystemCheck();
+    application.prepareProxy([loadingDialog]() {
+        loadingDialog->startSystemCheck();
+    });
 
     logger.appEvent("应用程序启动完成，进入事件循环");
 
@@ -0,0 +1,181 @@
+#include "connectivity_service.h"
+#include "link_state_monitor.h"
+#include "../config/config_manager.h"
+#include "../logging/logger.h"
+
+#include <QCoreApplication>
+#include <QNetworkAccessManager>
+#include <QTimer>
+
+ConnectivityService* ConnectivityService::s_instance = nullptr;
+
+ConnectivityService& ConnectivityService::instance()
+{
+    if (!s_instance) {
+        // 挂在QApplication下，网络管理器在事件循环结束后、QApplication析构时释放
+        s_instance = new ConnectivityService(QCoreApplication::instance());
+    }
+    return *s_instance;
+}
+
+ConnectivityService::ConnectivityService(QObject* parent)
+    : QObject(parent)
+    , m_logger(&Logger::instance())
+    , m_networkManager(new QNetworkAccessManager(this))
+    , m_checker(nullptr)
+    , m_retryTimer(nullptr)
+    , m_hasVerdict(false)
+    , m_verdictStatus(NetworkChecker::Unknown)
+    , m_cacheTtlMs(kDefaultCacheTtlMs)
+{
+    m_checker = new NetworkChecker(this, m_networkManager);
+    connect(m_checker, &NetworkChecker::checkCompleted, this, &ConnectivityService::onCheckCompleted);
+
+    // 链路变化后缓存的结论不再可信
+    connect(&LinkStateMonitor::instance(), &LinkStateMonitor::usableLinkChanged, this, [this](bool, const QString&) {
+        invalidate();
+    });
+
+    m_retryTimer = new QTimer(this);
+    m_retryTimer->setSingleShot(true);
+    connect(m_retryTimer, &QTimer::timeout, this, &ConnectivityService::startCheck);
+
+    ConfigManager& config = ConfigManager::instance();
+    if (config.isLoaded()) {
+        m_cacheTtlMs = config.getConnectivityCacheTtlMs();
+        m_retry.setDelays(config.getRetryBaseDelayMs(), config.getRetryMaxDelayMs());
+    }
+
+    m_logger->appEvent("网络连通性服务已创建");
+}
+
+ConnectivityService::~ConnectivityService()
+{
+    s_instance = nullptr;
+}
+
+void ConnectivityService::requestCheck(QObject* context, Callback callback, bool forceRefresh)
+{
+    Waiter waiter;
+    waiter.context = context;
+    waiter.callback = callback;
+
+    if (!forceRefresh && hasFreshVerdict()) {
+        m_logger->appEvent(QString("复用%1ms前的网络连通结论").arg(m_verdictAge.elapsed()));
+        deliver(waiter, m_verdictStatus, m_verdictDetails);
+        return;
+    }
+
+    m_waiters.append(waiter);
+    if (m_checker->isChecking() || isRetryPending()) {
+        // 已有探测在进行或已排定：等同一结果，不重复探测
+        m_logger->appEvent("网络探测进行中，等待同一结果");
+        return;
+    }
+    beginCheck();
+}
+
+void ConnectivityService::prefetch()
+{
+    if (hasFreshVerdict() || m_checker->isChecking() || isRetryPending()) {
+        return;
+    }
+    m_logger->appEvent("提前发起网络连通性探测");
+    beginCheck();
+}
+
+bool ConnectivityService::isRetryPending() const
+{
+    return m_retryTimer->isActive();
+}
+
+bool ConnectivityService::hasFreshVerdict() const
+{
+    // 经代理连通不代表直连（或换用另一代理）也连通，代理解析改变了应用级代理时须重新探测
+    return m_hasVerdict && m_verdictAge.isValid() && m_verdictAge.elapsed() < m_cacheTtlMs
+        && m_verdictProxy == QNetworkProxy::applicationProxy();
+}
+
+void ConnectivityService::invalidate()
+{
+    m_hasVerdict = false;
+}
+
+void ConnectivityService::cancel()
+{
+    m_retryTimer->stop();
+    m_checker->stopCheck();
+
+    const QList<Waiter> waiters = m_waiters;
+    m_waiters.clear();
+    for (const Waiter& waiter : waiters) {
+        deliver(waiter, NetworkChecker::Unknown, "网络检测已取消");
+    }
+}
+
+void ConnectivityService::beginCheck()
+{
+    // 上次失败后的退避未到期：推迟到期后再探测（用户连点重试也不会提前）
+    const qint64 remaining = m_retry.remainingMs();
+    if (remaining > 0) {
+        m_logger->appEvent(QString("网络探测退避中，%1ms后重试（连续失败%2次）")
+            .arg(remaining).arg(m_retry.failures()));
+        m_retryTimer->start(static_cast<int>(remaining));
+        emit retryScheduled(static_cast<int>(remaining), m_retry.failures());
+        return;
+    }
+    startCheck();
+}
+
+void ConnectivityService::startCheck()
+{
+    ConfigManager& config = ConfigManager::instance();
+    m_probeProxy = QNetworkProxy::applicationProxy();
+    m_checker->setCheckUrls(config.getBackupCheckUrls());
+    m_checker->setProbeMethod(NetworkChecker::probeMethodFromString(config.getNetworkProbeMethod()));
+    m_checker->startCheck(config.getCheckUrl(), config.getNetworkCheckTimeout());
+}
+
+void ConnectivityService::onCheckCompleted(NetworkChecker::NetworkStatus status, const QString& details)
+{
+    // 只缓存连通结论；失败时用户多半会修好网络再重试，重试必须重新探测
+    m_hasVerdict = status == NetworkChecker::Connected;
+    if (m_hasVerdict) {
+        m_verdictStatus = status;
+        m_verdictDetails = details;
+        m_verdictAge.start();
+        m_verdictProxy = m_probeProxy;
+        m_retry.recordSuccess();
+    } else {
+        // 轮询后端在网络正常后停止扫描，探测失败时重新扫描以便及时发现断网
+        LinkStateMonitor::instance().requestRescan();
+        const int delay = m_retry.recordFailure(m_checker->getRetryAfterMs());
+        m_logger->appEvent(QString("网络探测失败，下次探测最早在%1ms后%2")
+            .arg(delay)
+            .arg(m_checker->getRetryAfterMs() > 0
+                 ? QString("（服务器要求等待%1ms）").arg(m_checker->getRetryAfterMs()) : QString()));
+    }
+
+    emit verdictChanged(status, details);
+
+    const QList<Waiter> waiters = m_waiters;
+    m_waiters.clear();
+    for (const Waiter& waiter : waiters) {
+        deliver(waiter, status, details);
+    }
+}
+
+void ConnectivityService::deliver(const Waiter& waiter, NetworkChecker::NetworkStatus status, const QString& details)
+{
+    if (!waiter.context) {
+        return;
+    }
+    // 统一经事件循环回调：缓存命中时调用方也不会在requestCheck内部被重入
+    QPointer<QObject> context = waiter.context;
+    Callback callback = waiter.callback;
+    QTimer::singleShot(0, context.data(), [context, callback, status, details]() {
+        if (context) {
+            callback(status, details);
+        }
+    });
+}
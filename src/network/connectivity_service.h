@@ -0,0 +1,158 @@
+#ifndef CONNECTIVITY_SERVICE_H
+#define CONNECTIVITY_SERVICE_H
+
+#include <QObject>
+#include <QPointer>
+#include <QList>
+#include <QElapsedTimer>
+#include <QNetworkProxy>
+
+#include <functional>
+
+#include "network_checker.h"
+#include "retry_scheduler.h"
+
+class QNetworkAccessManager;
+class QTimer;
+class Logger;
+
+/**
+ * @brief 进程内唯一的网络连通性服务
+ *
+ * 持有全进程共用的QNetworkAccessManager和NetworkChecker：
+ * - 连通结论缓存kDefaultCacheTtlMs（可由配置connectivityCacheTtlMs调整），有效期内的请求直接复用；
+ *   结论与探测时的应用级代理绑定，代理变化后不再复用；
+ * - 失败结论不缓存，重试总会重新探测；
+ * - 探测进行中的请求挂到同一次探测上，不会并发第二次；
+ * - 结果一律经事件循环异步回调，调用方不需要也不应嵌套QEventLoop；
+ * - 探测失败后按RetryScheduler的抖动退避推迟下一次探测（含服务器Retry-After），
+ *   考场断网恢复时各终端的重试自然错开。
+ *
+ * 加载对话框的系统检测通过prefetch()提前发起探测，启动任务图的网络检测随后复用同一结果。
+ */
+class ConnectivityService : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 检测结果回调：状态和详细信息
+     */
+    typedef std::function<void(NetworkChecker::NetworkStatus, const QString&)> Callback;
+
+    static constexpr int kDefaultCacheTtlMs = 30000;
+
+    /**
+     * @brief 获取单例实例（首次调用须在QApplication创建之后，随QApplication销毁）
+     */
+    static ConnectivityService& instance();
+
+    /**
+     * @brief 单例是否已创建（关闭流程中避免为了清理而创建）
+     */
+    static bool hasInstance() { return s_instance != nullptr; }
+
+    /**
+     * @brief 全进程共用的网络管理器
+     */
+    QNetworkAccessManager* networkManager() const { return m_networkManager; }
+
+    /**
+     * @brief 获取连通性结论
+     * @param context 回调的接收者，在结果到达前销毁则不回调
+     * @param callback 结果回调（在主线程经事件循环调用）
+     * @param forceRefresh 忽略缓存重新探测
+     */
+    void requestCheck(QObject* context, Callback callback, bool forceRefresh = false);
+
+    /**
+     * @brief 没有有效缓存且未在探测时发起一次探测，不关心结果
+     */
+    void prefetch();
+
+    /**
+     * @brief 是否有有效期内、且与当前应用级代理一致的连通结论
+     */
+    bool hasFreshVerdict() const;
+
+    /**
+     * @brief 丢弃缓存的结论（网络切换等场景）
+     */
+    void invalidate();
+
+    /**
+     * @brief 取消正在进行的探测，等待中的回调收到Unknown
+     */
+    void cancel();
+
+    /**
+     * @brief 最近一次结论的状态描述
+     */
+    QString statusDescription() const { return m_checker->getStatusDescription(); }
+
+    bool isChecking() const { return m_checker->isChecking(); }
+
+    /**
+     * @brief 是否正在退避等待下一次探测
+     */
+    bool isRetryPending() const;
+
+    /**
+     * @brief 共用的退避状态
+     *
+     * 系统检测的网络质量测量等其他发往考试服务器的请求也按它错开，
+     * 这些请求完全失败时同样记入，连通性探测的重试随之推后。
+     */
+    RetryScheduler& retryScheduler() { return m_retry; }
+
+signals:
+    /**
+     * @brief 每次探测得出结论后发出
+     */
+    void verdictChanged(NetworkChecker::NetworkStatus status, const QString& details);
+
+    /**
+     * @brief 因退避推迟了探测
+     * @param delayMs 距离实际探测的时间
+     * @param failures 连续失败次数
+     */
+    void retryScheduled(int delayMs, int failures);
+
+private slots:
+    void onCheckCompleted(NetworkChecker::NetworkStatus status, const QString& details);
+
+private:
+    explicit ConnectivityService(QObject* parent);
+    ~ConnectivityService() override;
+    ConnectivityService(const ConnectivityService&) = delete;
+    ConnectivityService& operator=(const ConnectivityService&) = delete;
+
+    struct Waiter {
+        QPointer<QObject> context;
+        Callback callback;
+    };
+
+    void beginCheck();
+    void startCheck();
+    void deliver(const Waiter& waiter, NetworkChecker::NetworkStatus status, const QString& details);
+
+    static ConnectivityService* s_instance;
+
+    Logger* m_logger;
+    QNetworkAccessManager* m_networkManager;
+    NetworkChecker* m_checker;
+    QList<Waiter> m_waiters;
+    RetryScheduler m_retry;
+    QTimer* m_retryTimer;
+
+    // 缓存的连通结论
+    bool m_hasVerdict;
+    NetworkChecker::NetworkStatus m_verdictStatus;
+    QString m_verdictDetails;
+    QElapsedTimer m_verdictAge;
+    QNetworkProxy m_verdictProxy;   // 得出结论时使用的应用级代理
+    QNetworkProxy m_probeProxy;     // 进行中的探测使用的应用级代理
+    int m_cacheTtlMs;
+};
+
+#endif // CONNECTIVITY_SERVICE_H
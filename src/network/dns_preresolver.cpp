@@ -0,0 +1,454 @@
+#include "dns_preresolver.h"
+#include "../logging/logger.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QHostInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStandardPaths>
+#include <QTcpSocket>
+#include <QTimer>
+
+namespace {
+
+// 启动流程和页面加载失败时的forgetHost都在Qt主线程读写缓存文件（CEF未启用多线程消息循环），
+// 互斥只为保证forgetHost按接口约定可从任意线程调用
+QMutex g_cacheFileMutex;
+
+}
+
+DnsPreresolver::DnsPreresolver(QObject* parent)
+    : QObject(parent)
+    , m_logger(&Logger::instance())
+    , m_timeoutTimer(new QTimer(this))
+    , m_cacheFallbackTimer(new QTimer(this))
+    , m_cacheTtlSeconds(kDefaultCacheTtlSeconds)
+    , m_started(false)
+    , m_finished(false)
+{
+    m_timeoutTimer->setSingleShot(true);
+    connect(m_timeoutTimer, &QTimer::timeout, this, [this]() {
+        finish(true);
+    });
+
+    m_cacheFallbackTimer->setSingleShot(true);
+    connect(m_cacheFallbackTimer, &QTimer::timeout, this, &DnsPreresolver::onCacheFallback);
+}
+
+DnsPreresolver::~DnsPreresolver()
+{
+    for (Target& target : m_targets) {
+        if (target.lookupId >= 0) {
+            QHostInfo::abortHostLookup(target.lookupId);
+        }
+    }
+}
+
+void DnsPreresolver::setCacheTtlSeconds(int seconds)
+{
+    m_cacheTtlSeconds = qMax(0, seconds);
+}
+
+void DnsPreresolver::start(const QList<QUrl>& urls, int timeoutMs)
+{
+    if (m_started) {
+        return;
+    }
+    m_started = true;
+    m_elapsed.start();
+
+    for (const QUrl& url : urls) {
+        const QString host = url.host().toLower();
+        if (host.isEmpty() || !QHostAddress(host).isNull() || findTarget(host)) {
+            continue;   // 空主机、已是IP地址或重复主机
+        }
+        Target target;
+        target.host = host;
+        target.port = static_cast<quint16>(url.port(url.scheme() == "https" ? 443 : 80));
+        m_targets.append(target);
+    }
+
+    if (m_targets.isEmpty()) {
+        QTimer::singleShot(0, this, [this]() {
+            finish(false);
+        });
+        return;
+    }
+
+    loadCache();
+
+    // 先建好全部目标再发起解析，避免回调中访问尚未加入的目标
+    for (Target& target : m_targets) {
+        const QString host = target.host;
+        target.lookupId = QHostInfo::lookupHost(host, this, [this, host](const QHostInfo& info) {
+            onLookupFinished(host, info);
+        });
+
+        // 缓存地址只作后备：实时解析在上限的一半内没有结果（或解析失败）时才验证缓存地址
+        const CacheEntry entry = m_cache.value(host);
+        if (isCacheFresh(entry)) {
+            QList<QHostAddress> cached;
+            for (const QString& address : entry.addresses) {
+                cached.append(QHostAddress(address));
+            }
+            target.cachedAddress = preferredAddress(cached);
+        }
+    }
+
+    const int timeout = qMax(1, timeoutMs);
+    m_timeoutTimer->start(timeout);
+    m_cacheFallbackTimer->start(timeout / 2);
+}
+
+void DnsPreresolver::finishNow()
+{
+    if (!m_started || m_finished) {
+        return;
+    }
+    m_logger->logEvent("DNS预解析", QString("CEF开始初始化，预解析提前结束（%1ms）").arg(m_elapsed.elapsed()),
+                       "network.log", L_INFO);
+    finish(false);
+}
+
+QString DnsPreresolver::hostResolverRules() const
+{
+    QStringList rules;
+    for (const Target& target : m_targets) {
+        if (!target.pinnedAddress.isEmpty()) {
+            rules << QString("MAP %1 %2").arg(target.host, target.pinnedAddress);
+        }
+    }
+    return rules.join(",");
+}
+
+QStringList DnsPreresolver::pinnedHosts() const
+{
+    QStringList hosts;
+    for (const Target& target : m_targets) {
+        if (!target.pinnedAddress.isEmpty()) {
+            hosts << target.host;
+        }
+    }
+    return hosts;
+}
+
+QHostAddress DnsPreresolver::pinnedAddress(const QString& host) const
+{
+    for (const Target& target : m_targets) {
+        if (target.host == host && !target.pinnedAddress.isEmpty()) {
+            // 规则中的IPv6地址带方括号
+            QString address = target.pinnedAddress;
+            if (address.startsWith('[') && address.endsWith(']')) {
+                address = address.mid(1, address.length() - 2);
+            }
+            return QHostAddress(address);
+        }
+    }
+    return QHostAddress();
+}
+
+void DnsPreresolver::onLookupFinished(const QString& host, const QHostInfo& info)
+{
+    Target* target = findTarget(host);
+    if (!target) {
+        return;
+    }
+    target->lookupId = -1;
+    target->lookupDone = true;
+
+    if (info.error() != QHostInfo::NoError || info.addresses().isEmpty()) {
+        m_logger->logEvent("DNS预解析",
+            QString("%1 实时解析失败（%2ms）: %3").arg(host).arg(m_elapsed.elapsed()).arg(info.errorString()),
+            "network.log", L_WARNING);
+    } else {
+        // 超时之后到达的结果也写入缓存，供下次启动使用
+        CacheEntry entry;
+        for (const QHostAddress& address : info.addresses()) {
+            entry.addresses << address.toString();
+        }
+        entry.resolvedAtMs = QDateTime::currentMSecsSinceEpoch();
+        m_cache.insert(host, entry);
+        saveCache();
+
+        target->liveAddress = preferredAddress(info.addresses());
+        m_logger->logEvent("DNS预解析",
+            QString("%1 实时解析 -> %2（%3ms）").arg(host, entry.addresses.join(" ")).arg(m_elapsed.elapsed()),
+            "network.log", L_DEBUG);
+    }
+
+    if (m_finished || target->settled) {
+        return;
+    }
+
+    if (!target->liveAddress.isNull()) {
+        // 实时结果优先：正在验证的缓存地址与之相同时等该验证结果，否则改为验证实时地址
+        if (target->probe && target->candidate == target->liveAddress) {
+            return;
+        }
+        verify(*target, target->liveAddress, false);
+    } else if (target->probe) {
+        return;   // 实时解析失败，等缓存地址的验证结果
+    } else if (!target->cachedAddress.isNull()) {
+        verify(*target, target->cachedAddress, true);
+    } else {
+        settle(*target, QString());
+        checkFinished();
+    }
+}
+
+void DnsPreresolver::onCacheFallback()
+{
+    if (m_finished) {
+        return;
+    }
+    for (Target& target : m_targets) {
+        if (target.settled || target.lookupDone || target.probe || target.cachedAddress.isNull()) {
+            continue;
+        }
+        m_logger->logEvent("DNS预解析",
+            QString("%1 实时解析%2ms未返回，改用缓存地址").arg(target.host).arg(m_elapsed.elapsed()),
+            "network.log", L_INFO);
+        verify(target, target.cachedAddress, true);
+    }
+}
+
+void DnsPreresolver::verify(Target& target, const QHostAddress& address, bool fromCache)
+{
+    releaseProbe(target);
+    target.candidate = address;
+    target.candidateFromCache = fromCache;
+
+    // 只确认地址可以建立TCP连接，不发送数据
+    QTcpSocket* probe = new QTcpSocket(this);
+    target.probe = probe;
+    const QString host = target.host;
+    connect(probe, &QTcpSocket::connected, this, [this, host]() {
+        onVerifyResult(host, true);
+    });
+    connect(probe, &QTcpSocket::errorOccurred, this, [this, host](QAbstractSocket::SocketError) {
+        onVerifyResult(host, false);
+    });
+    probe->connectToHost(address, target.port);
+}
+
+void DnsPreresolver::onVerifyResult(const QString& host, bool reachable)
+{
+    Target* target = findTarget(host);
+    if (!target || target->settled || m_finished) {
+        return;
+    }
+    releaseProbe(*target);
+
+    const QString source = target->candidateFromCache ? "缓存" : "实时";
+    if (reachable) {
+        settle(*target, ruleAddress(target->candidate));
+        m_logger->logEvent("DNS预解析",
+            QString("%1 固定到%2地址 %3（%4ms）").arg(host, source, target->pinnedAddress).arg(m_elapsed.elapsed()),
+            "network.log", L_INFO);
+        checkFinished();
+        return;
+    }
+
+    m_logger->logEvent("DNS预解析",
+        QString("%1 的%2地址 %3:%4 无法连接").arg(host, source, target->candidate.toString()).arg(target->port),
+        "network.log", L_WARNING);
+
+    if (!target->lookupDone) {
+        return;   // 等实时解析结果
+    }
+    if (target->candidateFromCache && !target->liveAddress.isNull() && target->liveAddress != target->candidate) {
+        verify(*target, target->liveAddress, false);
+        return;
+    }
+    settle(*target, QString());
+    checkFinished();
+}
+
+void DnsPreresolver::settle(Target& target, const QString& pinnedAddress)
+{
+    releaseProbe(target);
+    target.pinnedAddress = pinnedAddress;
+    target.settled = true;
+}
+
+void DnsPreresolver::releaseProbe(Target& target)
+{
+    if (target.probe) {
+        target.probe->disconnect(this);
+        target.probe->abort();
+        target.probe->deleteLater();
+        target.probe = nullptr;
+    }
+}
+
+void DnsPreresolver::checkFinished()
+{
+    for (const Target& target : m_targets) {
+        if (!target.settled) {
+            return;
+        }
+    }
+    finish(false);
+}
+
+void DnsPreresolver::finish(bool timedOut)
+{
+    if (m_finished) {
+        return;
+    }
+    m_finished = true;
+    m_timeoutTimer->stop();
+    m_cacheFallbackTimer->stop();
+
+    for (Target& target : m_targets) {
+        if (!target.settled) {
+            // 未完成的实时解析继续在后台进行，只为刷新缓存
+            settle(target, QString());
+            m_logger->logEvent("DNS预解析",
+                QString("%1 %2ms内未能确认地址，交由CEF实时解析").arg(target.host).arg(m_elapsed.elapsed()),
+                "network.log", L_WARNING);
+        }
+    }
+
+    if (timedOut) {
+        m_logger->logEvent("DNS预解析", QString("预解析超时，已固定%1/%2个主机")
+            .arg(pinnedHosts().size()).arg(m_targets.size()), "network.log", L_WARNING);
+    }
+    emit finished(hostResolverRules());
+}
+
+DnsPreresolver::Target* DnsPreresolver::findTarget(const QString& host)
+{
+    for (Target& target : m_targets) {
+        if (target.host == host) {
+            return &target;
+        }
+    }
+    return nullptr;
+}
+
+bool DnsPreresolver::isCacheFresh(const CacheEntry& entry) const
+{
+    if (entry.addresses.isEmpty() || entry.resolvedAtMs <= 0) {
+        return false;
+    }
+    const qint64 ageMs = QDateTime::currentMSecsSinceEpoch() - entry.resolvedAtMs;
+    return ageMs >= 0 && ageMs < static_cast<qint64>(m_cacheTtlSeconds) * 1000;
+}
+
+void DnsPreresolver::loadCache()
+{
+    QMutexLocker locker(&g_cacheFileMutex);
+    QFile file(cacheFilePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value("version").toInt() != kCacheVersion) {
+        return;
+    }
+
+    const QJsonObject hosts = root.value("hosts").toObject();
+    for (auto it = hosts.constBegin(); it != hosts.constEnd(); ++it) {
+        const QJsonObject item = it.value().toObject();
+        CacheEntry entry;
+        for (const QJsonValue& address : item.value("addresses").toArray()) {
+            entry.addresses << address.toString();
+        }
+        entry.resolvedAtMs = static_cast<qint64>(item.value("resolvedAt").toDouble());
+        if (isCacheFresh(entry)) {
+            m_cache.insert(it.key(), entry);   // 过期条目不再加载，写回时自然清除
+        }
+    }
+}
+
+void DnsPreresolver::saveCache()
+{
+    QJsonObject hosts;
+    for (auto it = m_cache.constBegin(); it != m_cache.constEnd(); ++it) {
+        QJsonObject item;
+        item["addresses"] = QJsonArray::fromStringList(it.value().addresses);
+        item["resolvedAt"] = static_cast<double>(it.value().resolvedAtMs);
+        hosts[it.key()] = item;
+    }
+
+    QJsonObject root;
+    root["version"] = kCacheVersion;
+    root["hosts"] = hosts;
+
+    QMutexLocker locker(&g_cacheFileMutex);
+    QFile file(cacheFilePath());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        m_logger->errorEvent(QString("DNS缓存保存失败: %1").arg(file.errorString()));
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+}
+
+void DnsPreresolver::forgetHost(const QString& host)
+{
+    const QString key = host.toLower();
+    if (key.isEmpty()) {
+        return;
+    }
+
+    QMutexLocker locker(&g_cacheFileMutex);
+    QFile file(cacheFilePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    file.close();
+
+    QJsonObject hosts = root.value("hosts").toObject();
+    if (!hosts.contains(key)) {
+        return;
+    }
+    hosts.remove(key);
+    root["hosts"] = hosts;
+
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+        Logger::instance().logEvent("DNS预解析",
+            QString("%1 的固定地址不可用，已删除缓存，下次启动使用实时解析").arg(key),
+            "network.log", L_WARNING);
+    }
+}
+
+QString DnsPreresolver::cacheFilePath()
+{
+    QDir dir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+    if (!dir.exists()) {
+        dir.mkpath(".");
+    }
+    return dir.filePath("dns_cache.json");
+}
+
+QHostAddress DnsPreresolver::preferredAddress(const QList<QHostAddress>& addresses)
+{
+    // 优先IPv4，考试网络中IPv6路由常不可用
+    for (const QHostAddress& address : addresses) {
+        if (address.protocol() == QAbstractSocket::IPv4Protocol) {
+            return address;
+        }
+    }
+    for (const QHostAddress& address : addresses) {
+        if (!address.isNull()) {
+            return address;
+        }
+    }
+    return QHostAddress();
+}
+
+QString DnsPreresolver::ruleAddress(const QHostAddress& address)
+{
+    return address.protocol() == QAbstractSocket::IPv6Protocol
+        ? QString("[%1]").arg(address.toString())
+        : address.toString();
+}
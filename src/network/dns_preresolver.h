@@ -0,0 +1,148 @@
+#ifndef DNS_PRERESOLVER_H
+#define DNS_PRERESOLVER_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QUrl>
+#include <QHostAddress>
+#include <QElapsedTimer>
+
+class QHostInfo;
+class QTcpSocket;
+class QTimer;
+class Logger;
+
+/**
+ * @brief 考试目标主机的DNS预解析与固定
+ *
+ * 考场DNS常常又慢又不稳定，冷启动时Qt和Chromium各自从头解析一次考试主机。
+ * 本类在CEF初始化前并行解析考试地址和网络检测地址的主机名：
+ * - 每次都发起实时解析，结果带时间戳写入磁盘缓存（超时后继续在后台完成）；
+ * - 实时解析优先；在等待上限的一半内仍未返回或解析失败时，才改用TTL内的缓存地址；
+ * - 选定的地址先用TCP连接验证，连得上才生成“MAP host ip”规则交给CEF，
+ *   连不上或超时的主机不固定，由CEF按实时DNS解析。
+ *
+ * CEF运行期间规则无法修改，考试中也不重启程序：页面因连接错误加载失败时由Application
+ * 在会话内退避重新加载；只有链路可用、连通性探测正常且实时解析结果不含固定地址时，
+ * 才调用forgetHost()删除缓存，下次正常启动不再沿用该地址。
+ */
+class DnsPreresolver : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kDefaultTimeoutMs = 1000;
+    static constexpr int kDefaultCacheTtlSeconds = 3600;
+    static constexpr int kCacheVersion = 1;
+
+    /**
+     * @brief 禁用本次运行的主机固定（现场排障时手动附加）
+     */
+    static constexpr const char* kNoPinSwitch = "--no-dns-pin";
+
+    explicit DnsPreresolver(QObject* parent = nullptr);
+    ~DnsPreresolver() override;
+
+    /**
+     * @brief 设置磁盘缓存有效期（秒）
+     */
+    void setCacheTtlSeconds(int seconds);
+
+    /**
+     * @brief 并行预解析各URL的主机（IP地址和重复主机自动跳过）
+     * @param timeoutMs 整体等待上限，超时未完成的主机不固定
+     *
+     * 完成或超时后发出一次finished()。
+     */
+    void start(const QList<QUrl>& urls, int timeoutMs = kDefaultTimeoutMs);
+
+    /**
+     * @brief 立即结束（CEF即将初始化时调用）：已验证的主机照常固定，其余不固定
+     * 同步发出finished()；已结束时无操作
+     */
+    void finishNow();
+
+    /**
+     * @brief 已验证主机的CEF host-resolver-rules，如"MAP a.example.com 10.0.0.8,MAP b.example.com 10.0.0.9"
+     */
+    QString hostResolverRules() const;
+
+    /**
+     * @brief 已固定地址的主机
+     */
+    QStringList pinnedHosts() const;
+
+    /**
+     * @brief 主机的固定地址，未固定时为空地址
+     */
+    QHostAddress pinnedAddress(const QString& host) const;
+
+    /**
+     * @brief 从磁盘缓存中删除主机（固定地址不可用时调用，线程安全）
+     */
+    static void forgetHost(const QString& host);
+
+    /**
+     * @brief 磁盘缓存文件路径
+     */
+    static QString cacheFilePath();
+
+signals:
+    /**
+     * @brief 预解析结束
+     * @param rules 交给CEF的规则，没有可固定的主机时为空
+     */
+    void finished(const QString& rules);
+
+private:
+    struct Target {
+        QString host;
+        quint16 port = 0;
+        int lookupId = -1;
+        bool lookupDone = false;
+        QHostAddress liveAddress;       // 实时解析结果，失败时为空
+        QHostAddress cachedAddress;     // TTL内的缓存地址，实时解析赶不上时使用
+        QHostAddress candidate;         // 正在验证的地址
+        bool candidateFromCache = false;
+        QTcpSocket* probe = nullptr;
+        QString pinnedAddress;          // 验证通过的地址（IPv6带方括号）
+        bool settled = false;
+    };
+
+    struct CacheEntry {
+        QStringList addresses;
+        qint64 resolvedAtMs = 0;
+    };
+
+    void onLookupFinished(const QString& host, const QHostInfo& info);
+    void onCacheFallback();
+    void verify(Target& target, const QHostAddress& address, bool fromCache);
+    void onVerifyResult(const QString& host, bool reachable);
+    void settle(Target& target, const QString& pinnedAddress);
+    void releaseProbe(Target& target);
+    void checkFinished();
+    void finish(bool timedOut);
+    Target* findTarget(const QString& host);
+    bool isCacheFresh(const CacheEntry& entry) const;
+
+    void loadCache();
+    void saveCache();
+
+    static QHostAddress preferredAddress(const QList<QHostAddress>& addresses);
+    static QString ruleAddress(const QHostAddress& address);
+
+    Logger* m_logger;
+    QList<Target> m_targets;
+    QHash<QString, CacheEntry> m_cache;
+    QTimer* m_timeoutTimer;
+    QTimer* m_cacheFallbackTimer;       // 上限的一半：实时解析仍未返回时改用缓存
+    QElapsedTimer m_elapsed;
+    int m_cacheTtlSeconds;
+    bool m_started;
+    bool m_finished;
+};
+
+#endif // DNS_PRERESOLVER_H
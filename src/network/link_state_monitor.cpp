@@ -0,0 +1,567 @@
+#include "link_state_monitor.h"
+#include "../logging/logger.h"
+
+#include <QCoreApplication>
+#include <QNetworkInterface>
+#include <QSocketNotifier>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QtEndian>
+#include <QStringList>
+
+#ifdef Q_OS_WIN
+#include <winsock2.h>
+#include <ws2ipdef.h>
+#include <iphlpapi.h>
+#include <netioapi.h>
+#endif
+
+#ifdef Q_OS_LINUX
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <poll.h>
+#include <errno.h>
+#include <string.h>
+#endif
+
+LinkStateMonitor* LinkStateMonitor::s_instance = nullptr;
+
+#ifdef Q_OS_WIN
+namespace {
+
+// 通知在系统线程池中回调，投递到主线程合并后再扫描
+VOID NETIOAPI_API_ onInterfaceChange(PVOID context, PMIB_IPINTERFACE_ROW, MIB_NOTIFICATION_TYPE)
+{
+    QMetaObject::invokeMethod(static_cast<QObject*>(context), "scheduleRescan", Qt::QueuedConnection);
+}
+
+VOID NETIOAPI_API_ onAddressChange(PVOID context, PMIB_UNICASTIPADDRESS_ROW, MIB_NOTIFICATION_TYPE)
+{
+    QMetaObject::invokeMethod(static_cast<QObject*>(context), "scheduleRescan", Qt::QueuedConnection);
+}
+
+} // namespace
+#endif
+
+bool LinkStateMonitor::InterfaceState::isUsable() const
+{
+    if (!up || !running || loopback) {
+        return false;
+    }
+    for (const QHostAddress& address : addresses) {
+        if (!address.isLoopback() && !address.isLinkLocal()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+LinkStateMonitor& LinkStateMonitor::instance()
+{
+    if (!s_instance) {
+        s_instance = new LinkStateMonitor(QCoreApplication::instance());
+    }
+    return *s_instance;
+}
+
+LinkStateMonitor::LinkStateMonitor(QObject* parent)
+    : QObject(parent)
+    , m_logger(&Logger::instance())
+    , m_usable(false)
+    , m_ready(false)
+    , m_netlinkFd(-1)
+    , m_notifier(nullptr)
+    , m_dumpSeq(0)
+    , m_seq(0)
+    , m_interfaceNotification(nullptr)
+    , m_addressNotification(nullptr)
+    , m_rescanTimer(nullptr)
+    , m_pollTimer(nullptr)
+{
+    if (openNetlink()) {
+        m_logger->appEvent("链路状态跟踪: 使用rtnetlink事件");
+        requestFullDump();
+        waitForInitialDump();
+        return;
+    }
+
+    m_rescanTimer = new QTimer(this);
+    m_rescanTimer->setSingleShot(true);
+    connect(m_rescanTimer, &QTimer::timeout, this, &LinkStateMonitor::pollInterfaces);
+
+    if (registerChangeNotifications()) {
+        pollInterfaces();
+        m_logger->appEvent("链路状态跟踪: 使用系统网络变化通知");
+        return;
+    }
+
+    // 无系统通知：只在启动、断网和调用方报告失败后的窗口内定时扫描
+    m_pollTimer = new QTimer(this);
+    connect(m_pollTimer, &QTimer::timeout, this, &LinkStateMonitor::pollInterfaces);
+    pollInterfaces();
+    startPollWindow();
+    m_logger->appEvent(QString("链路状态跟踪: 启动后%1ms内每%2ms扫描网络接口")
+        .arg(kStartupPollWindowMs).arg(kPollIntervalMs));
+}
+
+LinkStateMonitor::~LinkStateMonitor()
+{
+    cancelChangeNotifications();
+    closeNetlink();
+    s_instance = nullptr;
+}
+
+bool LinkStateMonitor::isEventDriven() const
+{
+    return m_netlinkFd >= 0 || m_interfaceNotification || m_addressNotification;
+}
+
+void LinkStateMonitor::requestRescan()
+{
+    if (isEventDriven() || !m_pollTimer) {
+        return;
+    }
+    pollInterfaces();
+    startPollWindow();
+}
+
+void LinkStateMonitor::startPollWindow()
+{
+    m_pollWindow.start();
+    if (!m_pollTimer->isActive()) {
+        m_pollTimer->start(kPollIntervalMs);
+    }
+}
+
+void LinkStateMonitor::scheduleRescan()
+{
+    if (!m_rescanTimer->isActive()) {
+        m_rescanTimer->start(kRescanDelayMs);
+    }
+}
+
+bool LinkStateMonitor::registerChangeNotifications()
+{
+#ifdef Q_OS_WIN
+    HANDLE interfaceHandle = nullptr;
+    DWORD error = NotifyIpInterfaceChange(AF_UNSPEC, onInterfaceChange, this, FALSE, &interfaceHandle);
+    if (error != NO_ERROR) {
+        m_logger->errorEvent(QString("NotifyIpInterfaceChange注册失败: %1").arg(error));
+        return false;
+    }
+    m_interfaceNotification = interfaceHandle;
+
+    HANDLE addressHandle = nullptr;
+    error = NotifyUnicastIpAddressChange(AF_UNSPEC, onAddressChange, this, FALSE, &addressHandle);
+    if (error != NO_ERROR) {
+        // 只有接口通知时获取地址会晚到，仍优于轮询
+        m_logger->errorEvent(QString("NotifyUnicastIpAddressChange注册失败: %1").arg(error));
+    } else {
+        m_addressNotification = addressHandle;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void LinkStateMonitor::cancelChangeNotifications()
+{
+#ifdef Q_OS_WIN
+    // CancelMibChangeNotify2会等待正在执行的回调返回
+    if (m_interfaceNotification) {
+        CancelMibChangeNotify2(static_cast<HANDLE>(m_interfaceNotification));
+        m_interfaceNotification = nullptr;
+    }
+    if (m_addressNotification) {
+        CancelMibChangeNotify2(static_cast<HANDLE>(m_addressNotification));
+        m_addressNotification = nullptr;
+    }
+#endif
+}
+
+bool LinkStateMonitor::hasUsableLink() const
+{
+    if (m_ready) {
+        return m_usable;
+    }
+    for (const InterfaceState& state : scanInterfaces()) {
+        if (state.isUsable()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QList<LinkStateMonitor::InterfaceState> LinkStateMonitor::interfaces() const
+{
+    return m_ready ? m_interfaces.values() : scanInterfaces().values();
+}
+
+bool LinkStateMonitor::hasDefaultRoute() const
+{
+    return m_netlinkFd < 0 || !m_defaultRoutes.isEmpty();
+}
+
+QString LinkStateMonitor::summary() const
+{
+    QStringList parts;
+    for (const InterfaceState& state : m_interfaces) {
+        if (!state.isUsable()) {
+            continue;
+        }
+        QStringList addresses;
+        for (const QHostAddress& address : state.addresses) {
+            if (!address.isLinkLocal()) {
+                addresses << address.toString();
+            }
+        }
+        parts << QString("%1(%2)").arg(state.name, addresses.join(","));
+    }
+    if (parts.isEmpty()) {
+        return "无可用网络接口";
+    }
+    return parts.join("; ") + (hasDefaultRoute() ? "" : "，无默认路由");
+}
+
+bool LinkStateMonitor::openNetlink()
+{
+#ifdef Q_OS_LINUX
+    const int fd = ::socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_ROUTE);
+    if (fd < 0) {
+        m_logger->errorEvent(QString("rtnetlink套接字创建失败: %1").arg(QString::fromLocal8Bit(strerror(errno))));
+        return false;
+    }
+
+    struct sockaddr_nl address;
+    memset(&address, 0, sizeof(address));
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR
+                      | RTMGRP_IPV4_ROUTE | RTMGRP_IPV6_ROUTE;
+    if (::bind(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) < 0) {
+        m_logger->errorEvent(QString("rtnetlink绑定失败: %1").arg(QString::fromLocal8Bit(strerror(errno))));
+        ::close(fd);
+        return false;
+    }
+
+    m_netlinkFd = fd;
+    m_notifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &LinkStateMonitor::onNetlinkReadable);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void LinkStateMonitor::closeNetlink()
+{
+#ifdef Q_OS_LINUX
+    if (m_notifier) {
+        m_notifier->setEnabled(false);
+        delete m_notifier;
+        m_notifier = nullptr;
+    }
+    if (m_netlinkFd >= 0) {
+        ::close(m_netlinkFd);
+        m_netlinkFd = -1;
+    }
+#endif
+}
+
+void LinkStateMonitor::requestFullDump()
+{
+#ifdef Q_OS_LINUX
+    // 同一套接字同时只能进行一个dump，按链路、地址、路由依次请求
+    m_interfaces.clear();
+    m_defaultRoutes.clear();
+    m_pendingDumps = QList<int>() << RTM_GETLINK << RTM_GETADDR << RTM_GETROUTE;
+    m_dumpSeq = 0;
+    sendNextDump();
+#endif
+}
+
+void LinkStateMonitor::sendNextDump()
+{
+#ifdef Q_OS_LINUX
+    if (m_pendingDumps.isEmpty()) {
+        m_dumpSeq = 0;
+        if (!m_ready) {
+            m_ready = true;
+            m_logger->logEvent("链路状态", QString("初始状态: %1").arg(summary()), "network.log", L_INFO);
+        }
+        updateUsable();
+        return;
+    }
+
+    struct {
+        struct nlmsghdr header;
+        struct rtgenmsg message;
+    } request;
+    memset(&request, 0, sizeof(request));
+    request.header.nlmsg_len = NLMSG_LENGTH(sizeof(struct rtgenmsg));
+    request.header.nlmsg_type = static_cast<__u16>(m_pendingDumps.takeFirst());
+    request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    request.header.nlmsg_seq = ++m_seq;
+    request.message.rtgen_family = AF_UNSPEC;
+
+    struct sockaddr_nl kernel;
+    memset(&kernel, 0, sizeof(kernel));
+    kernel.nl_family = AF_NETLINK;
+
+    m_dumpSeq = request.header.nlmsg_seq;
+    if (::sendto(m_netlinkFd, &request, request.header.nlmsg_len, 0,
+                 reinterpret_cast<struct sockaddr*>(&kernel), sizeof(kernel)) < 0) {
+        m_logger->errorEvent(QString("rtnetlink dump请求失败: %1").arg(QString::fromLocal8Bit(strerror(errno))));
+        sendNextDump();
+    }
+#endif
+}
+
+void LinkStateMonitor::waitForInitialDump()
+{
+#ifdef Q_OS_LINUX
+    // 全量dump通常几毫秒内完成；同步等待（有上限），构造后即可读取缓存状态
+    QElapsedTimer timer;
+    timer.start();
+    while (!m_ready && timer.elapsed() < kInitialDumpTimeoutMs) {
+        struct pollfd descriptor;
+        descriptor.fd = m_netlinkFd;
+        descriptor.events = POLLIN;
+        descriptor.revents = 0;
+        const int remaining = kInitialDumpTimeoutMs - static_cast<int>(timer.elapsed());
+        if (::poll(&descriptor, 1, qMax(0, remaining)) <= 0) {
+            break;
+        }
+        onNetlinkReadable();
+    }
+    if (!m_ready) {
+        m_logger->logEvent("链路状态", "初始状态获取超时，稍后由事件补齐", "network.log", L_WARNING);
+    }
+#endif
+}
+
+void LinkStateMonitor::onNetlinkReadable()
+{
+#ifdef Q_OS_LINUX
+    QByteArray buffer(kReceiveBufferBytes, Qt::Uninitialized);
+    bool overrun = false;
+
+    for (;;) {
+        const ssize_t length = ::recv(m_netlinkFd, buffer.data(), static_cast<size_t>(buffer.size()), 0);
+        if (length < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == ENOBUFS) {
+                // 内核通知队列溢出，增量状态已不可信
+                overrun = true;
+                continue;
+            }
+            break;  // EAGAIN：已读完
+        }
+        if (length == 0) {
+            break;
+        }
+
+        int remaining = static_cast<int>(length);
+        for (const struct nlmsghdr* header = reinterpret_cast<const struct nlmsghdr*>(buffer.constData());
+             NLMSG_OK(header, remaining); header = NLMSG_NEXT(header, remaining)) {
+            if (header->nlmsg_type == NLMSG_DONE || header->nlmsg_type == NLMSG_ERROR) {
+                if (m_dumpSeq != 0 && header->nlmsg_seq == m_dumpSeq) {
+                    sendNextDump();
+                }
+                continue;
+            }
+            handleMessage(header);
+        }
+    }
+
+    if (overrun) {
+        m_logger->logEvent("链路状态", "rtnetlink通知溢出，重新获取全量状态", "network.log", L_WARNING);
+        requestFullDump();
+        return;
+    }
+
+    // dump进行中不评估，避免全量状态只到一半时误报断网
+    if (m_dumpSeq == 0) {
+        updateUsable();
+    }
+#endif
+}
+
+void LinkStateMonitor::handleMessage(const void* data)
+{
+#ifdef Q_OS_LINUX
+    const struct nlmsghdr* header = static_cast<const struct nlmsghdr*>(data);
+
+    switch (header->nlmsg_type) {
+    case RTM_NEWLINK:
+    case RTM_DELLINK: {
+        const struct ifinfomsg* info = static_cast<const struct ifinfomsg*>(NLMSG_DATA(header));
+        if (header->nlmsg_type == RTM_DELLINK) {
+            const QString name = m_interfaces.value(info->ifi_index).name;
+            m_interfaces.remove(info->ifi_index);
+            if (m_ready) {
+                emit linkChanged(name, false);
+            }
+            break;
+        }
+
+        InterfaceState& state = m_interfaces[info->ifi_index];
+        const bool wasRunning = state.running;
+        state.index = info->ifi_index;
+        state.up = info->ifi_flags & IFF_UP;
+        state.running = info->ifi_flags & IFF_RUNNING;
+        state.loopback = info->ifi_flags & IFF_LOOPBACK;
+
+        int attributeLength = static_cast<int>(IFLA_PAYLOAD(header));
+        for (const struct rtattr* attribute = IFLA_RTA(info); RTA_OK(attribute, attributeLength);
+             attribute = RTA_NEXT(attribute, attributeLength)) {
+            if (attribute->rta_type == IFLA_IFNAME) {
+                state.name = QString::fromLocal8Bit(static_cast<const char*>(RTA_DATA(attribute)));
+            }
+        }
+
+        if (m_ready && wasRunning != state.running) {
+            m_logger->logEvent("链路状态",
+                QString("%1 链路%2").arg(state.name, state.running ? "已连接" : "已断开"),
+                "network.log", state.running ? L_INFO : L_WARNING);
+            emit linkChanged(state.name, state.running);
+        }
+        break;
+    }
+    case RTM_NEWADDR:
+    case RTM_DELADDR: {
+        const struct ifaddrmsg* info = static_cast<const struct ifaddrmsg*>(NLMSG_DATA(header));
+        QHostAddress address;
+        int attributeLength = static_cast<int>(IFA_PAYLOAD(header));
+        for (const struct rtattr* attribute = IFA_RTA(info); RTA_OK(attribute, attributeLength);
+             attribute = RTA_NEXT(attribute, attributeLength)) {
+            // 点对点接口IFA_LOCAL为本端地址，其余接口只有IFA_ADDRESS
+            if (attribute->rta_type != IFA_LOCAL && !(attribute->rta_type == IFA_ADDRESS && address.isNull())) {
+                continue;
+            }
+            if (info->ifa_family == AF_INET && RTA_PAYLOAD(attribute) >= 4) {
+                address.setAddress(qFromBigEndian<quint32>(RTA_DATA(attribute)));
+            } else if (info->ifa_family == AF_INET6 && RTA_PAYLOAD(attribute) >= 16) {
+                address.setAddress(static_cast<const quint8*>(RTA_DATA(attribute)));
+            }
+        }
+        if (address.isNull()) {
+            break;
+        }
+
+        InterfaceState& state = m_interfaces[static_cast<int>(info->ifa_index)];
+        state.index = static_cast<int>(info->ifa_index);
+        state.addresses.removeAll(address);
+        if (header->nlmsg_type == RTM_NEWADDR) {
+            state.addresses.append(address);
+        }
+        break;
+    }
+    case RTM_NEWROUTE:
+    case RTM_DELROUTE: {
+        const struct rtmsg* route = static_cast<const struct rtmsg*>(NLMSG_DATA(header));
+        if (route->rtm_table != RT_TABLE_MAIN || route->rtm_dst_len != 0 || route->rtm_type != RTN_UNICAST) {
+            break;
+        }
+
+        quint32 outputInterface = 0;
+        quint32 priority = 0;
+        int attributeLength = static_cast<int>(RTM_PAYLOAD(header));
+        for (const struct rtattr* attribute = RTM_RTA(route); RTA_OK(attribute, attributeLength);
+             attribute = RTA_NEXT(attribute, attributeLength)) {
+            if (attribute->rta_type == RTA_OIF) {
+                outputInterface = *static_cast<const quint32*>(RTA_DATA(attribute));
+            } else if (attribute->rta_type == RTA_PRIORITY) {
+                priority = *static_cast<const quint32*>(RTA_DATA(attribute));
+            }
+        }
+
+        const QByteArray key = QByteArray::number(route->rtm_family) + ":"
+                             + QByteArray::number(outputInterface) + ":" + QByteArray::number(priority);
+        if (header->nlmsg_type == RTM_NEWROUTE) {
+            m_defaultRoutes.insert(key);
+        } else {
+            m_defaultRoutes.remove(key);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+#else
+    Q_UNUSED(data);
+#endif
+}
+
+QHash<int, LinkStateMonitor::InterfaceState> LinkStateMonitor::scanInterfaces()
+{
+    QHash<int, InterfaceState> interfaces;
+    for (const QNetworkInterface& iface : QNetworkInterface::allInterfaces()) {
+        InterfaceState state;
+        state.index = iface.index();
+        state.name = iface.humanReadableName();
+        state.up = iface.flags() & QNetworkInterface::IsUp;
+        state.running = iface.flags() & QNetworkInterface::IsRunning;
+        state.loopback = iface.flags() & QNetworkInterface::IsLoopBack;
+        for (const QNetworkAddressEntry& entry : iface.addressEntries()) {
+            state.addresses << entry.ip();
+        }
+        interfaces.insert(state.index, state);
+    }
+    return interfaces;
+}
+
+void LinkStateMonitor::pollInterfaces()
+{
+    const QHash<int, InterfaceState> interfaces = scanInterfaces();
+    if (m_ready) {
+        for (const InterfaceState& state : interfaces) {
+            if (m_interfaces.value(state.index).running != state.running) {
+                m_logger->logEvent("链路状态",
+                    QString("%1 链路%2").arg(state.name, state.running ? "已连接" : "已断开"),
+                    "network.log", state.running ? L_INFO : L_WARNING);
+                emit linkChanged(state.name, state.running);
+            }
+        }
+    }
+
+    m_interfaces = interfaces;
+    if (!m_ready) {
+        m_ready = true;
+        m_logger->logEvent("链路状态", QString("初始状态: %1").arg(summary()), "network.log", L_INFO);
+    }
+    updateUsable();
+
+    // 轮询窗口结束且网络可用时停止轮询；无可用链路时继续，以便发现恢复
+    if (m_pollTimer && m_pollTimer->isActive() && m_usable
+        && m_pollWindow.isValid() && m_pollWindow.elapsed() >= kStartupPollWindowMs) {
+        m_pollTimer->stop();
+    }
+}
+
+void LinkStateMonitor::updateUsable()
+{
+    bool usable = false;
+    for (const InterfaceState& state : m_interfaces) {
+        if (state.isUsable()) {
+            usable = true;
+            break;
+        }
+    }
+
+    if (usable == m_usable) {
+        return;
+    }
+    m_usable = usable;
+
+    const QString description = summary();
+    m_logger->logEvent("链路状态",
+        QString("网络%1: %2").arg(usable ? "可用" : "不可用", description),
+        "network.log", usable ? L_INFO : L_WARNING);
+    emit usableLinkChanged(usable, description);
+}
@@ -0,0 +1,161 @@
+#ifndef LINK_STATE_MONITOR_H
+#define LINK_STATE_MONITOR_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QByteArray>
+#include <QHostAddress>
+#include <QElapsedTimer>
+
+class QSocketNotifier;
+class QTimer;
+class Logger;
+
+/**
+ * @brief 网络链路状态跟踪
+ *
+ * Linux上订阅rtnetlink的链路、地址和路由事件（RTMGRP_LINK / IFADDR / ROUTE），
+ * 启动时先dump一次全量状态，之后按事件增量更新，网线拔出、Wi-Fi断开在毫秒级内通知到界面和日志。
+ * Windows上用NotifyIpInterfaceChange / NotifyUnicastIpAddressChange注册变化通知，
+ * 通知到达后（合并kRescanDelayMs内的连续通知）扫描一次QNetworkInterface。
+ * 其他平台或注册失败时退化为轮询，且只在启动后kStartupPollWindowMs内、无可用链路期间
+ * 以及requestRescan()之后的同样时长内每kPollIntervalMs扫描一次，网络正常时不常驻轮询。
+ *
+ * 系统检测和NetworkChecker直接读取这里缓存的状态，不再每次重新扫描网络接口。
+ * 内核通知队列溢出（ENOBUFS）时丢弃缓存并重新dump。
+ */
+class LinkStateMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 单个网络接口的状态
+     */
+    struct InterfaceState {
+        int index = 0;
+        QString name;
+        bool up = false;            // 管理状态（IFF_UP）
+        bool running = false;       // 链路就绪（IFF_RUNNING，网线/Wi-Fi已连接）
+        bool loopback = false;
+        QList<QHostAddress> addresses;
+
+        /**
+         * @brief 是否可用于访问外部网络：启用、链路就绪、非回环且有非链路本地地址
+         */
+        bool isUsable() const;
+    };
+
+    static constexpr int kPollIntervalMs = 2000;
+    static constexpr int kStartupPollWindowMs = 30000;
+    static constexpr int kRescanDelayMs = 200;
+    static constexpr int kReceiveBufferBytes = 64 * 1024;
+    static constexpr int kInitialDumpTimeoutMs = 300;
+
+    /**
+     * @brief 获取单例实例（首次调用时开始跟踪；须在QApplication创建之后调用）
+     */
+    static LinkStateMonitor& instance();
+
+    /**
+     * @brief 是否有可用的网络接口（初始状态未就绪时现场扫描）
+     */
+    bool hasUsableLink() const;
+
+    /**
+     * @brief 是否存在默认路由（仅rtnetlink后端可知，其他后端总为true）
+     */
+    bool hasDefaultRoute() const;
+
+    /**
+     * @brief 是否由系统事件驱动（false表示轮询）
+     */
+    bool isEventDriven() const;
+
+    /**
+     * @brief 网络请求失败时调用：事件驱动时无操作，轮询时重新开启一个轮询窗口
+     */
+    void requestRescan();
+
+    /**
+     * @brief 初始状态是否已就绪（未就绪时调用方应自行扫描接口）
+     */
+    bool isReady() const { return m_ready; }
+
+    /**
+     * @brief 所有接口的当前状态（初始状态未就绪时现场扫描）
+     */
+    QList<InterfaceState> interfaces() const;
+
+    /**
+     * @brief 用QNetworkInterface扫描一次接口状态
+     */
+    static QHash<int, InterfaceState> scanInterfaces();
+
+    /**
+     * @brief 可用接口及地址的简要描述，用于日志和检测结果
+     */
+    QString summary() const;
+
+signals:
+    /**
+     * @brief 可用性变化（有/无可用接口）
+     */
+    void usableLinkChanged(bool usable, const QString& summary);
+
+    /**
+     * @brief 某个接口的链路状态变化
+     */
+    void linkChanged(const QString& name, bool running);
+
+private slots:
+    void onNetlinkReadable();
+    void pollInterfaces();
+    void scheduleRescan();
+
+private:
+    explicit LinkStateMonitor(QObject* parent);
+    ~LinkStateMonitor() override;
+    LinkStateMonitor(const LinkStateMonitor&) = delete;
+    LinkStateMonitor& operator=(const LinkStateMonitor&) = delete;
+
+    bool openNetlink();
+    void closeNetlink();
+    void requestFullDump();
+    void waitForInitialDump();
+    void sendNextDump();
+    void handleMessage(const void* header);
+    void updateUsable();
+    bool registerChangeNotifications();
+    void cancelChangeNotifications();
+    void startPollWindow();
+
+    static LinkStateMonitor* s_instance;
+
+    Logger* m_logger;
+    QHash<int, InterfaceState> m_interfaces;
+    QSet<QByteArray> m_defaultRoutes;   // 族:出接口:优先级
+    bool m_usable;
+    bool m_ready;
+
+    // rtnetlink后端
+    int m_netlinkFd;
+    QSocketNotifier* m_notifier;
+    QList<int> m_pendingDumps;          // 待发送的dump请求类型
+    quint32 m_dumpSeq;                  // 正在进行的dump序号，0表示无
+    quint32 m_seq;
+
+    // Windows通知后端
+    void* m_interfaceNotification;
+    void* m_addressNotification;
+    QTimer* m_rescanTimer;              // 合并连续通知
+
+    // 轮询后端
+    QTimer* m_pollTimer;
+    QElapsedTimer m_pollWindow;         // 当前轮询窗口的起点
+};
+
+#endif // LINK_STATE_MONITOR_H
@@ -0,0 +1,209 @@
+#include "network_benchmark.h"
+
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QTimer>
+#include <QtMath>
+
+#include <algorithm>
+
+double NetworkBenchmark::Result::percentileRtt(double p) const
+{
+    if (rttMs.isEmpty()) {
+        return -1.0;
+    }
+    QList<double> sorted = rttMs;
+    std::sort(sorted.begin(), sorted.end());
+    // 最近秩法：样本很少时取不小于p的最小样本，p90不会被低估
+    const int rank = qBound(0, static_cast<int>(qCeil(qBound(0.0, p, 1.0) * sorted.size())) - 1, sorted.size() - 1);
+    return sorted.at(rank);
+}
+
+double NetworkBenchmark::Result::throughputKbps() const
+{
+    if (downloadBytes < kMinThroughputBytes || downloadMs <= 0) {
+        return -1.0;
+    }
+    return downloadBytes * 8.0 / downloadMs;   // bit/ms == kbit/s
+}
+
+NetworkBenchmark::NetworkBenchmark(QNetworkAccessManager* networkManager, QObject* parent)
+    : QObject(parent)
+    , m_networkManager(networkManager)
+    , m_reply(nullptr)
+    , m_budgetTimer(new QTimer(this))
+    , m_downloadTarget(kDefaultDownloadBytes)
+    , m_samples(kDefaultSamples)
+    , m_budgetMs(kDefaultBudgetMs)
+    , m_running(false)
+{
+    qRegisterMetaType<NetworkBenchmark::Result>("NetworkBenchmark::Result");
+
+    m_budgetTimer->setSingleShot(true);
+    connect(m_budgetTimer, &QTimer::timeout, this, &NetworkBenchmark::onBudgetExpired);
+}
+
+NetworkBenchmark::~NetworkBenchmark()
+{
+    if (m_reply) {
+        m_reply->disconnect(this);
+        m_reply->abort();
+        m_reply->deleteLater();
+        m_reply = nullptr;
+    }
+}
+
+void NetworkBenchmark::start(const QUrl& endpoint, int samples, const QUrl& downloadUrl, qint64 downloadBytes, int budgetMs)
+{
+    if (m_running) {
+        return;
+    }
+
+    m_endpoint = endpoint;
+    m_downloadUrl = downloadUrl;
+    m_downloadTarget = qMax<qint64>(kMinThroughputBytes, downloadBytes);
+    m_samples = qMax(1, samples);
+    m_budgetMs = qMax(100, budgetMs);
+    m_result = Result();
+    m_running = true;
+
+    m_total.start();
+    m_budgetTimer->start(m_budgetMs);
+    sendRttRequest();
+}
+
+void NetworkBenchmark::abort()
+{
+    if (!m_running) {
+        return;
+    }
+    finish();
+}
+
+void NetworkBenchmark::onBudgetExpired()
+{
+    m_result.timedOut = true;
+    // 下载进行中时保留已收到的数据量用于估算吞吐量
+    if (m_reply && m_downloadElapsed.isValid()) {
+        m_result.downloadMs = m_downloadElapsed.elapsed();
+    }
+    finish();
+}
+
+void NetworkBenchmark::sendRttRequest()
+{
+    QNetworkRequest request(m_endpoint);
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+    request.setRawHeader("Cache-Control", "no-cache");
+    request.setTransferTimeout(qMax(1, remainingMs()));
+
+    m_requestElapsed.start();
+    m_reply = m_networkManager->head(request);
+    connect(m_reply, &QNetworkReply::finished, this, &NetworkBenchmark::onRttReplyFinished);
+}
+
+void NetworkBenchmark::onRttReplyFinished()
+{
+    QNetworkReply* reply = m_reply;
+    m_reply = nullptr;
+    reply->deleteLater();
+
+    const double elapsedMs = m_requestElapsed.nsecsElapsed() / 1000000.0;
+    const bool gotResponse = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).isValid();
+
+    ++m_result.requests;
+    if (gotResponse) {
+        if (m_result.requests == 1) {
+            m_result.setupMs = elapsedMs;
+        } else {
+            m_result.rttMs.append(elapsedMs);
+        }
+    } else {
+        ++m_result.failures;
+        m_result.lastError = reply->errorString();
+    }
+
+    if (!m_running) {
+        return;
+    }
+
+    // 第一个请求就连不上时不再继续，后面的请求只会重复同样的错误
+    if (m_result.requests < m_samples && m_result.isReachable()) {
+        sendRttRequest();
+    } else if (m_result.isReachable() && m_downloadUrl.isValid()) {
+        startDownload();
+    } else {
+        finish();
+    }
+}
+
+void NetworkBenchmark::startDownload()
+{
+    QNetworkRequest request(m_downloadUrl);
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+    request.setRawHeader("Cache-Control", "no-cache");
+    request.setRawHeader("Range", QString("bytes=0-%1").arg(m_downloadTarget - 1).toLatin1());
+    request.setTransferTimeout(qMax(1, remainingMs()));
+
+    m_downloadElapsed.invalidate();
+    m_reply = m_networkManager->get(request);
+    connect(m_reply, &QNetworkReply::readyRead, this, &NetworkBenchmark::onDownloadReadyRead);
+    connect(m_reply, &QNetworkReply::finished, this, &NetworkBenchmark::onDownloadFinished);
+}
+
+void NetworkBenchmark::onDownloadReadyRead()
+{
+    if (!m_downloadElapsed.isValid()) {
+        m_downloadElapsed.start();
+    }
+    // 只计数不保存；服务器忽略Range时收够目标字节数即中止
+    m_result.downloadBytes += m_reply->skip(m_reply->bytesAvailable());
+    if (m_result.downloadBytes >= m_downloadTarget) {
+        m_result.downloadMs = m_downloadElapsed.elapsed();
+        m_result.downloadCompleted = true;
+        finish();
+    }
+}
+
+void NetworkBenchmark::onDownloadFinished()
+{
+    QNetworkReply* reply = m_reply;
+    m_reply = nullptr;
+    reply->deleteLater();
+
+    m_result.downloadBytes += reply->skip(reply->bytesAvailable());
+    if (m_downloadElapsed.isValid()) {
+        m_result.downloadMs = m_downloadElapsed.elapsed();
+    }
+    if (reply->error() == QNetworkReply::NoError) {
+        m_result.downloadCompleted = true;     // 资源本身小于目标字节数
+    } else {
+        m_result.lastError = reply->errorString();
+    }
+    finish();
+}
+
+void NetworkBenchmark::finish()
+{
+    if (!m_running) {
+        return;
+    }
+    m_running = false;
+    m_budgetTimer->stop();
+
+    if (m_reply) {
+        QNetworkReply* reply = m_reply;
+        m_reply = nullptr;
+        reply->disconnect(this);
+        reply->abort();
+        reply->deleteLater();
+    }
+
+    emit finished(m_result);
+}
+
+int NetworkBenchmark::remainingMs() const
+{
+    return static_cast<int>(qMax<qint64>(0, m_budgetMs - m_total.elapsed()));
+}
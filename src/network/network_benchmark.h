@@ -0,0 +1,118 @@
+#ifndef NETWORK_BENCHMARK_H
+#define NETWORK_BENCHMARK_H
+
+#include <QObject>
+#include <QList>
+#include <QString>
+#include <QUrl>
+#include <QElapsedTimer>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+class QTimer;
+
+/**
+ * @brief 启动时的一次性网络测量
+ *
+ * 系统检测中用来提前判断考场网络能否支撑考试：
+ * 1. 依次发送若干个HEAD请求，得到RTT分布。第一个请求包含TCP/TLS建连，单独记为建连耗时；
+ * 2. 下载一个指定大小的资源（Range: bytes=0-N），按首字节到结束的时间计算吞吐量。
+ *
+ * 整个测量受总时间预算约束，超出预算时中止当前请求，已得到的样本照常给出。
+ * 任何HTTP响应（包括4xx/5xx）都算一次往返，只有网络层错误计为失败。
+ */
+class NetworkBenchmark : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 测量结果
+     */
+    struct Result {
+        QList<double> rttMs;            // 复用连接后的往返时间样本
+        double setupMs = -1.0;          // 第一个请求耗时（含DNS/TCP/TLS），失败时为-1
+        int requests = 0;
+        int failures = 0;
+        QString lastError;
+        qint64 downloadBytes = 0;
+        qint64 downloadMs = 0;          // 首字节到结束
+        bool downloadCompleted = false;
+        bool timedOut = false;
+
+        /**
+         * @brief 是否至少得到一次HTTP响应
+         */
+        bool isReachable() const { return setupMs >= 0 || !rttMs.isEmpty(); }
+
+        /**
+         * @brief RTT分位数（p取0~1），没有样本时返回-1
+         */
+        double percentileRtt(double p) const;
+
+        /**
+         * @brief 吞吐量（kbit/s），数据量不足kMinThroughputBytes时返回-1
+         */
+        double throughputKbps() const;
+    };
+
+    static constexpr int kDefaultSamples = 5;
+    static constexpr qint64 kDefaultDownloadBytes = 512 * 1024;
+    static constexpr int kDefaultBudgetMs = 3000;
+    static constexpr qint64 kMinThroughputBytes = 32 * 1024;    // 数据太少时吞吐量没有意义
+
+    explicit NetworkBenchmark(QNetworkAccessManager* networkManager, QObject* parent = nullptr);
+    ~NetworkBenchmark() override;
+
+    /**
+     * @brief 开始测量
+     * @param endpoint RTT测量地址
+     * @param samples RTT请求数（含第一个建连请求）
+     * @param downloadUrl 吞吐量测量地址，为空时跳过下载
+     * @param downloadBytes 下载字节数
+     * @param budgetMs 总时间预算
+     */
+    void start(const QUrl& endpoint, int samples, const QUrl& downloadUrl, qint64 downloadBytes, int budgetMs);
+
+    /**
+     * @brief 中止测量（会发出finished）
+     */
+    void abort();
+
+    bool isRunning() const { return m_running; }
+    Result result() const { return m_result; }
+
+signals:
+    void finished(const NetworkBenchmark::Result& result);
+
+private slots:
+    void onBudgetExpired();
+
+private:
+    void sendRttRequest();
+    void onRttReplyFinished();
+    void startDownload();
+    void onDownloadReadyRead();
+    void onDownloadFinished();
+    void finish();
+    int remainingMs() const;
+
+    QNetworkAccessManager* m_networkManager;    // 共用，不拥有
+    QNetworkReply* m_reply;
+    QTimer* m_budgetTimer;
+    QElapsedTimer m_total;
+    QElapsedTimer m_requestElapsed;
+    QElapsedTimer m_downloadElapsed;            // 首字节开始计时
+
+    QUrl m_endpoint;
+    QUrl m_downloadUrl;
+    qint64 m_downloadTarget;
+    int m_samples;
+    int m_budgetMs;
+    bool m_running;
+    Result m_result;
+};
+
+Q_DECLARE_METATYPE(NetworkBenchmark::Result)
+
+#endif // NETWORK_BENCHMARK_H
@@ -1,6 +1,9 @@
 #include "network_checker.h"
 #include "../config/config_manager.h"
 #include "../logging/logger.h"
+#include "link_state_monitor.h"
+#include "retry_scheduler.h"
+#include "proxy_resolver.h"
 
 #include <QNetworkRequest>
 #include <QNetworkProxy>
@@ -9,22 +12,31 @@
 #include <QSslConfiguration>
 #include <QNetworkInterface>
 
-NetworkChecker::NetworkChecker(QObject *parent)
+NetworkChecker::NetworkChecker(QObject *parent, QNetworkAccessManager* networkManager)
     : QObject(parent)
-    , m_networkManager(nullptr)
-    , m_currentReply(nullptr)
+    , m_networkManager(networkManager)
     , m_timeoutTimer(nullptr)
+    , m_staggerTimer(nullptr)
     , m_networkStatus(Unknown)
-    , m_currentUrlIndex(0)
+    , m_nextProbeIndex(0)
+    , m_probeMethod(ProbeHead)
     , m_timeoutMs(10000)
+    , m_retryAfterMs(-1)
     , m_checking(false)
+    , m_failureStatus(Disconnected)
     , m_hasInternet(false)
 {
-    m_networkManager = new QNetworkAccessManager(this);
+    if (!m_networkManager) {
+        m_networkManager = new QNetworkAccessManager(this);
+    }
     
     m_timeoutTimer = new QTimer(this);
     m_timeoutTimer->setSingleShot(true);
     connect(m_timeoutTimer, &QTimer::timeout, this, &NetworkChecker::onCheckTimeout);
+
+    m_staggerTimer = new QTimer(this);
+    m_staggerTimer->setSingleShot(true);
+    connect(m_staggerTimer, &QTimer::timeout, this, &NetworkChecker::launchNextProbe);
     
     // 设置默认检测URL列表
     m_checkUrls << "https://www.baidu.com";
@@ -46,38 +58,49 @@ void NetworkChecker::startCheck(const QString& targetUrl, int timeoutMs)
     }
     
     m_checking = true;
+    m_checkElapsed.start();
     m_timeoutMs = timeoutMs;
     m_networkStatus = Unknown;
     m_errorDetails.clear();
-    m_currentUrlIndex = 0;
-    
-    // 如果指定了目标URL，将其放在检测列表的首位
-    if (!targetUrl.isEmpty()) {
-        m_targetUrl = targetUrl;
-        QStringList urls = m_checkUrls;
-        urls.prepend(targetUrl);
-        m_checkUrls = urls;
-    } else {
-        // 尝试从配置中获取目标URL
+    m_failureStatus = Disconnected;
+    m_failureDetails.clear();
+    m_nextProbeIndex = 0;
+    m_retryAfterMs = -1;
+    
+    // 目标URL放在探测顺序的首位（指定的优先，否则取配置中的URL）
+    m_targetUrl = targetUrl;
+    if (m_targetUrl.isEmpty()) {
         ConfigManager& config = ConfigManager::instance();
         if (config.isLoaded()) {
             m_targetUrl = config.getUrl();
-            if (!m_targetUrl.isEmpty()) {
-                QStringList urls = m_checkUrls;
-                urls.prepend(m_targetUrl);
-                m_checkUrls = urls;
-            }
+        }
+    }
+
+    m_probeUrls.clear();
+    if (!m_targetUrl.isEmpty()) {
+        m_probeUrls << m_targetUrl;
+    }
+    for (const QString& url : m_checkUrls) {
+        if (!url.isEmpty() && !m_probeUrls.contains(url)) {
+            m_probeUrls << url;
         }
     }
     
-    Logger::instance().appEvent(QString("开始网络检测，目标URL: %1").arg(m_targetUrl));
+    Logger::instance().appEvent(QString("开始网络检测，目标URL: %1，并行探测%2个地址")
+        .arg(m_targetUrl).arg(m_probeUrls.size()));
     emit checkProgress("正在检查网络连接...");
     
     // 首先检测本地网络配置
     detectNetworkConfiguration();
+
+    if (m_probeUrls.isEmpty()) {
+        completeCheck(Disconnected, "没有可用的检测地址");
+        return;
+    }
     
-    // 开始URL检测
-    checkNextUrl();
+    // 所有探测共享同一截止时间，最坏情况下timeoutMs后给出结论
+    m_timeoutTimer->start(m_timeoutMs);
+    launchNextProbe();
 }
 
 void NetworkChecker::stopCheck()
@@ -88,12 +111,8 @@ void NetworkChecker::stopCheck()
     
     m_checking = false;
     m_timeoutTimer->stop();
-    
-    if (m_currentReply) {
-        m_currentReply->abort();
-        m_currentReply->deleteLater();
-        m_currentReply = nullptr;
-    }
+    m_staggerTimer->stop();
+    abortProbes();
     
     Logger::instance().appEvent("网络检测已停止");
 }
@@ -148,136 +167,253 @@ QString NetworkChecker::getNetworkConfigInfo() const
     return info;
 }
 
-void NetworkChecker::checkNextUrl()
+NetworkChecker::ProbeMethod NetworkChecker::probeMethodFromString(const QString& name)
 {
-    if (m_currentUrlIndex >= m_checkUrls.size()) {
-        // 所有URL都检测失败
-        completeCheck(Disconnected, "无法连接到任何检测服务器");
+    if (name == "range") {
+        return ProbeRange;
+    }
+    if (name == "get") {
+        return ProbeGet;
+    }
+    return ProbeHead;
+}
+
+bool NetworkChecker::isHealthyStatus(int httpStatus)
+{
+    // 0表示非HTTP协议（如file://），206为Range探测的正常响应
+    return httpStatus == 0 || (httpStatus >= 200 && httpStatus < 300);
+}
+
+void NetworkChecker::launchNextProbe()
+{
+    if (!m_checking || m_nextProbeIndex >= m_probeUrls.size()) {
         return;
     }
     
-    QString url = m_checkUrls[m_currentUrlIndex];
+    QString url = m_probeUrls[m_nextProbeIndex++];
     emit checkProgress(QString("正在检测连接: %1").arg(url));
-    
+    startProbe(url, m_probeMethod);
+
+    // 错开发起下一个探测；当前探测提前失败时会立即发起
+    if (m_nextProbeIndex < m_probeUrls.size()) {
+        m_staggerTimer->start(kProbeStaggerMs);
+    }
+}
+
+void NetworkChecker::startProbe(const QString& url, ProbeMethod method)
+{
     QNetworkRequest request(url);
     request.setRawHeader("User-Agent", "DesktopTerminal-CEF/1.0");
     request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
     request.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::NoLessSafeRedirectPolicy);
     
-    // 设置超时
-    request.setTransferTimeout(m_timeoutMs);
-    
-    m_currentReply = m_networkManager->get(request);
+    // 单个探测最多用到整体截止时间
+    request.setTransferTimeout(qMax(1, m_timeoutMs - static_cast<int>(m_checkElapsed.elapsed())));
     
-    connect(m_currentReply, &QNetworkReply::finished, 
+    // 只为拿到状态码，不下载页面正文
+    QNetworkReply* reply = nullptr;
+    const char* methodName = "HEAD";
+    if (method == ProbeHead) {
+        reply = m_networkManager->head(request);
+    } else {
+        if (method == ProbeRange) {
+            request.setRawHeader("Range", "bytes=0-0");
+            methodName = "GET Range";
+        } else {
+            methodName = "GET";
+        }
+        reply = m_networkManager->get(request);
+    }
+    reply->setProperty("probeUrl", url);
+    reply->setProperty("probeMethod", static_cast<int>(method));
+    reply->setProperty("probeStartMs", m_checkElapsed.elapsed());
+    m_activeReplies.append(reply);
+    
+    connect(reply, &QNetworkReply::metaDataChanged,
+            this, &NetworkChecker::onProbeMetaDataChanged);
+    connect(reply, &QNetworkReply::finished, 
             this, &NetworkChecker::onNetworkReplyFinished);
-    connect(m_currentReply, QOverload<QNetworkReply::NetworkError>::of(&QNetworkReply::error),
-            this, &NetworkChecker::onNetworkError);
-    connect(m_currentReply, &QNetworkReply::sslErrors,
+    connect(reply, &QNetworkReply::sslErrors,
             this, &NetworkChecker::onSslErrors);
     
-    // 启动超时计时器
-    m_timeoutTimer->start(m_timeoutMs);
-    
-    Logger::instance().appEvent(QString("检测URL: %1").arg(url));
+    Logger::instance().appEvent(QString("检测URL: %1 [%2]（第%3ms发起）")
+        .arg(url).arg(methodName).arg(m_checkElapsed.elapsed()));
+}
+
+void NetworkChecker::onProbeMetaDataChanged()
+{
+    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
+    if (!reply || !m_activeReplies.contains(reply)) {
+        return;
+    }
+
+    const QVariant statusAttribute = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute);
+    if (!statusAttribute.isValid()) {
+        return;
+    }
+    const int httpStatus = statusAttribute.toInt();
+    if (httpStatus >= 300 && httpStatus < 400) {
+        return; // 重定向中，等待最终响应
+    }
+
+    // 响应头已足够判定，GET探测中止正文下载（HEAD没有正文，等finished即可）
+    reply->setProperty("headerStatus", httpStatus);
+    if (reply->property("probeMethod").toInt() != ProbeHead) {
+        reply->setProperty("abortedAfterHeaders", true);
+        reply->abort();
+    }
 }
 
 void NetworkChecker::onNetworkReplyFinished()
 {
-    if (!m_currentReply || !m_checking) {
+    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
+    if (!reply || !m_activeReplies.removeOne(reply)) {
+        return;
+    }
+    reply->deleteLater();
+
+    if (!m_checking) {
         return;
     }
     
-    m_timeoutTimer->stop();
-    
-    QNetworkReply::NetworkError error = m_currentReply->error();
-    int httpStatus = m_currentReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    QNetworkReply::NetworkError error = reply->error();
+    int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (reply->property("abortedAfterHeaders").toBool()) {
+        // 主动中止正文下载，不算错误
+        error = QNetworkReply::NoError;
+        httpStatus = reply->property("headerStatus").toInt();
+    }
+    const QString url = reply->property("probeUrl").toString();
+    const qint64 probeMs = m_checkElapsed.elapsed() - reply->property("probeStartMs").toLongLong();
     
-    if (error == QNetworkReply::NoError && (httpStatus == 200 || httpStatus == 0)) {
-        // 检测成功
-        QString url = m_currentReply->url().toString();
-        Logger::instance().appEvent(QString("网络检测成功: %1 (HTTP %2)").arg(url).arg(httpStatus));
+    if (error == QNetworkReply::NoError && isHealthyStatus(httpStatus)) {
+        // 首个健康响应胜出，其余探测取消
+        Logger::instance().appEvent(QString("网络检测成功: %1 (HTTP %2)，探测用时%3ms，检测总用时%4ms")
+            .arg(url).arg(httpStatus).arg(probeMs).arg(m_checkElapsed.elapsed()));
         completeCheck(Connected, QString("网络连接正常，已成功连接到 %1").arg(url));
-    } else {
-        // 当前URL失败，尝试下一个
-        QString errorMsg = getNetworkErrorDescription(error);
-        Logger::instance().appEvent(QString("URL检测失败: %1 - %2 (HTTP %3)")
-            .arg(m_currentReply->url().toString()).arg(errorMsg).arg(httpStatus));
-        
-        m_currentUrlIndex++;
-        
-        if (m_currentReply) {
-            m_currentReply->deleteLater();
-            m_currentReply = nullptr;
+        return;
+    }
+
+    // 服务器不支持HEAD：同一地址改用Range探测，不计为失败
+    if (reply->property("probeMethod").toInt() == ProbeHead && (httpStatus == 405 || httpStatus == 501)) {
+        Logger::instance().appEvent(QString("%1 不支持HEAD (HTTP %2)，改用Range探测").arg(url).arg(httpStatus));
+        startProbe(url, ProbeRange);
+        return;
+    }
+
+    // 服务器过载或限流时记下要求的等待时间，由重试退避采用
+    if ((httpStatus == 429 || httpStatus == 503) && reply->hasRawHeader("Retry-After")) {
+        const int retryAfterMs = RetryScheduler::parseRetryAfter(reply->rawHeader("Retry-After"));
+        if (retryAfterMs > m_retryAfterMs) {
+            m_retryAfterMs = retryAfterMs;
         }
-        
-        checkNextUrl();
+    }
+
+    // 当前探测失败：记录原因，立即发起下一个，不再等待错开间隔
+    QString errorMsg = reply->property("sslErrorDescription").toString();
+    if (errorMsg.isEmpty()) {
+        errorMsg = getNetworkErrorDescription(error);
+    }
+    Logger::instance().appEvent(QString("URL检测失败: %1 - %2 (HTTP %3)，用时%4ms")
+        .arg(url).arg(errorMsg).arg(httpStatus).arg(probeMs));
+
+    NetworkStatus status = statusForError(error);
+    if (!reply->property("sslErrorDescription").toString().isEmpty()) {
+        status = SslError;
+    } else if (error == QNetworkReply::NoError) {
+        status = LimitedAccess;
+        errorMsg = QString("HTTP %1").arg(httpStatus);
+    }
+    recordFailure(status, QString("%1: %2").arg(url, errorMsg));
+
+    if (m_nextProbeIndex < m_probeUrls.size()) {
+        m_staggerTimer->stop();
+        launchNextProbe();
+    } else if (m_activeReplies.isEmpty()) {
+        completeCheck(m_failureStatus, m_failureDetails);
     }
 }
 
-void NetworkChecker::onNetworkError(QNetworkReply::NetworkError error)
+void NetworkChecker::onSslErrors(const QList<QSslError>& errors)
 {
-    if (!m_checking) {
+    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
+    if (!reply || !m_checking) {
         return;
     }
     
-    QString errorDesc = getNetworkErrorDescription(error);
-    Logger::instance().appEvent(QString("网络错误: %1").arg(errorDesc));
+    // 证书错误不忽略，探测随后以握手失败结束，这里只保留详细原因
+    QString errorDesc = getSslErrorDescription(errors);
+    Logger::instance().appEvent(QString("SSL错误: %1 - %2").arg(reply->property("probeUrl").toString(), errorDesc));
+    reply->setProperty("sslErrorDescription", errorDesc);
+}
+
+void NetworkChecker::onCheckTimeout()
+{
+    if (!m_checking) {
+        return;
+    }
     
-    // 根据错误类型设置状态
-    NetworkStatus status;
+    Logger::instance().appEvent(QString("网络检测超时（%1ms），未完成的探测%2个，未发起%3个")
+        .arg(m_timeoutMs).arg(m_activeReplies.size()).arg(m_probeUrls.size() - m_nextProbeIndex));
+
+    // 有探测已明确失败时报告该原因，否则报告超时
+    recordFailure(Timeout, QString("网络检测超时（%1ms）").arg(m_timeoutMs));
+    completeCheck(m_failureStatus, m_failureDetails);
+}
+
+void NetworkChecker::abortProbes()
+{
+    // 先从列表取出再abort，abort同步触发的finished不会再处理
+    const QList<QNetworkReply*> replies = m_activeReplies;
+    m_activeReplies.clear();
+    for (QNetworkReply* reply : replies) {
+        reply->abort();
+        reply->deleteLater();
+    }
+}
+
+NetworkChecker::NetworkStatus NetworkChecker::statusForError(QNetworkReply::NetworkError error)
+{
     switch (error) {
         case QNetworkReply::HostNotFoundError:
         case QNetworkReply::TemporaryNetworkFailureError:
-            status = DnsError;
-            break;
+            return DnsError;
         case QNetworkReply::TimeoutError:
-            status = Timeout;
-            break;
+        case QNetworkReply::OperationCanceledError:   // setTransferTimeout到期
+            return Timeout;
         case QNetworkReply::ProxyConnectionRefusedError:
         case QNetworkReply::ProxyConnectionClosedError:
         case QNetworkReply::ProxyNotFoundError:
         case QNetworkReply::ProxyTimeoutError:
         case QNetworkReply::ProxyAuthenticationRequiredError:
-            status = ProxyError;
-            break;
+            return ProxyError;
+        case QNetworkReply::SslHandshakeFailedError:
+            return SslError;
         default:
-            status = Disconnected;
-            break;
-    }
-    
-    // 如果是严重错误，直接完成检测
-    if (status == ProxyError || status == DnsError) {
-        completeCheck(status, errorDesc);
-        return;
+            return Disconnected;
     }
 }
 
-void NetworkChecker::onSslErrors(const QList<QSslError>& errors)
+int NetworkChecker::failurePriority(NetworkStatus status)
 {
-    if (!m_checking) {
-        return;
+    // 代理、证书问题影响所有地址，最值得提示；其次是DNS、受限访问和超时
+    switch (status) {
+        case ProxyError: return 6;
+        case SslError: return 5;
+        case DnsError: return 4;
+        case LimitedAccess: return 3;
+        case Timeout: return 2;
+        case Disconnected: return 1;
+        default: return 0;
     }
-    
-    QString errorDesc = getSslErrorDescription(errors);
-    Logger::instance().appEvent(QString("SSL错误: %1").arg(errorDesc));
-    completeCheck(SslError, errorDesc);
 }
 
-void NetworkChecker::onCheckTimeout()
+void NetworkChecker::recordFailure(NetworkStatus status, const QString& details)
 {
-    if (!m_checking) {
-        return;
-    }
-    
-    Logger::instance().appEvent("网络检测超时");
-    
-    if (m_currentReply) {
-        m_currentReply->abort();
+    if (m_failureDetails.isEmpty() || failurePriority(status) > failurePriority(m_failureStatus)) {
+        m_failureStatus = status;
+        m_failureDetails = details;
     }
-    
-    m_currentUrlIndex++;
-    checkNextUrl();
 }
 
 void NetworkChecker::completeCheck(NetworkStatus status, const QString& details)
@@ -291,14 +427,11 @@ void NetworkChecker::completeCheck(NetworkStatus status, const QString& details)
     m_errorDetails = details;
     
     m_timeoutTimer->stop();
+    m_staggerTimer->stop();
+    abortProbes();
     
-    if (m_currentReply) {
-        m_currentReply->deleteLater();
-        m_currentReply = nullptr;
-    }
-    
-    Logger::instance().appEvent(QString("网络检测完成: %1 - %2")
-        .arg(getStatusDescription()).arg(details));
+    Logger::instance().appEvent(QString("网络检测完成: %1 - %2，用时%3ms")
+        .arg(getStatusDescription()).arg(details).arg(m_checkElapsed.elapsed()));
     
     emit checkCompleted(status, details);
 }
@@ -389,30 +522,25 @@ QString NetworkChecker::getSslErrorDescription(const QList<QSslError>& errors) c
 
 void NetworkChecker::detectNetworkConfiguration()
 {
-    // 检测代理配置
-    QNetworkProxy proxy = QNetworkProxy::applicationProxy();
-    if (proxy.type() == QNetworkProxy::NoProxy) {
-        m_proxyInfo = "无代理";
+    // 代理由ProxyResolver在启动时解析并设为应用级代理，这里只读取结论，不再现场检测
+    if (ProxyResolver::hasInstance() && ProxyResolver::instance().isResolved()) {
+        m_proxyInfo = ProxyResolver::instance().description();
     } else {
-        m_proxyInfo = QString("%1:%2")
-            .arg(proxy.hostName())
-            .arg(proxy.port());
+        QNetworkProxy proxy = QNetworkProxy::applicationProxy();
+        if (proxy.type() == QNetworkProxy::NoProxy || proxy.type() == QNetworkProxy::DefaultProxy) {
+            m_proxyInfo = "无代理";
+        } else {
+            m_proxyInfo = QString("%1:%2")
+                .arg(proxy.hostName())
+                .arg(proxy.port());
+        }
     }
     
     // 检测DNS配置（简化版）
     m_dnsInfo = "系统默认";
     
-    // 检测网络接口状态
-    m_hasInternet = false;
-    QList<QNetworkInterface> interfaces = QNetworkInterface::allInterfaces();
-    for (const QNetworkInterface& iface : interfaces) {
-        if (iface.flags() & QNetworkInterface::IsUp && 
-            iface.flags() & QNetworkInterface::IsRunning &&
-            !(iface.flags() & QNetworkInterface::IsLoopBack)) {
-            m_hasInternet = true;
-            break;
-        }
-    }
+    // 网络接口状态取链路跟踪的缓存，不再每次检测都扫描接口
+    m_hasInternet = LinkStateMonitor::instance().hasUsableLink();
     
     Logger::instance().appEvent(QString("网络配置检测: 代理=%1, DNS=%2, 接口=%3")
         .arg(m_proxyInfo).arg(m_dnsInfo).arg(m_hasInternet ? "可用" : "不可用"));
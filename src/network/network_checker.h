@@ -6,18 +6,34 @@
 #include <QNetworkReply>
 #include <QTimer>
 #include <QStringList>
+#include <QElapsedTimer>
 
 /**
  * @brief 网络连接状态检测器
  * 
  * 检测网络连接状态，验证目标URL的可达性，
  * 支持多个备用检测URL和超时处理
+ *
+ * 目标URL和备用URL并行竞速探测：按kProbeStaggerMs错开依次发起，
+ * 某个探测失败时立即发起下一个；首个健康响应胜出并取消其余探测。
+ * 整个检测在timeoutMs内必定给出结论。
  */
 class NetworkChecker : public QObject
 {
     Q_OBJECT
 
 public:
+    static constexpr int kProbeStaggerMs = 250;   // 相邻探测的发起间隔
+
+    /**
+     * @brief 探测请求方式
+     */
+    enum ProbeMethod {
+        ProbeHead,      // HEAD请求，只取响应头（服务器不支持时自动改用ProbeRange）
+        ProbeRange,     // GET + Range: bytes=0-0，最多传输1字节
+        ProbeGet        // 普通GET，收到响应头即判定并中止正文下载
+    };
+
     /**
      * @brief 网络状态枚举
      */
@@ -32,13 +48,16 @@ public:
         SslError        // SSL证书错误
     };
 
-    explicit NetworkChecker(QObject *parent = nullptr);
+    /**
+     * @param networkManager 共用的网络管理器（为空时自行创建）
+     */
+    explicit NetworkChecker(QObject *parent = nullptr, QNetworkAccessManager* networkManager = nullptr);
     ~NetworkChecker() override;
 
     /**
      * @brief 开始网络检测
      * @param targetUrl 目标URL（可选，使用配置中的URL）
-     * @param timeoutMs 超时时间（毫秒）
+     * @param timeoutMs 整个检测的最长时间（毫秒），所有探测共享
      */
     void startCheck(const QString& targetUrl = QString(), int timeoutMs = 10000);
 
@@ -57,6 +76,11 @@ public:
      */
     QString getErrorDetails() const { return m_errorDetails; }
 
+    /**
+     * @brief 本次检测中服务器通过Retry-After要求的等待时间（毫秒），没有时为-1
+     */
+    int getRetryAfterMs() const { return m_retryAfterMs; }
+
     /**
      * @brief 获取网络状态描述
      */
@@ -73,6 +97,16 @@ public:
      */
     void setCheckUrls(const QStringList& urls);
 
+    /**
+     * @brief 设置探测请求方式（默认ProbeHead）
+     */
+    void setProbeMethod(ProbeMethod method) { m_probeMethod = method; }
+
+    /**
+     * @brief 由配置值（head/range/get）解析探测方式，无法识别时返回ProbeHead
+     */
+    static ProbeMethod probeMethodFromString(const QString& name);
+
     /**
      * @brief 获取网络配置信息
      */
@@ -94,12 +128,18 @@ signals:
 
 private slots:
     void onNetworkReplyFinished();
-    void onNetworkError(QNetworkReply::NetworkError error);
+    void onProbeMetaDataChanged();
     void onSslErrors(const QList<QSslError>& errors);
     void onCheckTimeout();
+    void launchNextProbe();
 
 private:
-    void checkNextUrl();
+    void startProbe(const QString& url, ProbeMethod method);
+    void abortProbes();
+    static bool isHealthyStatus(int httpStatus);
+    void recordFailure(NetworkStatus status, const QString& details);
+    static NetworkStatus statusForError(QNetworkReply::NetworkError error);
+    static int failurePriority(NetworkStatus status);
     void completeCheck(NetworkStatus status, const QString& details);
     QString getNetworkErrorDescription(QNetworkReply::NetworkError error) const;
     QString getSslErrorDescription(const QList<QSslError>& errors) const;
@@ -107,16 +147,25 @@ private:
 
 private:
     QNetworkAccessManager* m_networkManager;
-    QNetworkReply* m_currentReply;
-    QTimer* m_timeoutTimer;
+    QList<QNetworkReply*> m_activeReplies;  // 正在进行的探测
+    QTimer* m_timeoutTimer;                 // 整体截止时间
+    QTimer* m_staggerTimer;                 // 下一个探测的发起时机
 
     NetworkStatus m_networkStatus;
     QString m_errorDetails;
     QString m_targetUrl;
     QStringList m_checkUrls;
-    int m_currentUrlIndex;
+    QStringList m_probeUrls;                // 本次检测的探测顺序（目标URL在前）
+    int m_nextProbeIndex;
+    ProbeMethod m_probeMethod;
     int m_timeoutMs;
+    int m_retryAfterMs;
     bool m_checking;
+    QElapsedTimer m_checkElapsed;
+
+    // 所有探测失败时报告的状态（按failurePriority取最有诊断意义的一个）
+    NetworkStatus m_failureStatus;
+    QString m_failureDetails;
 
     // 网络配置信息
     QString m_proxyInfo;
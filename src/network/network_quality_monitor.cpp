@@ -0,0 +1,231 @@
+#include "network_quality_monitor.h"
+#include "connectivity_service.h"
+#include "link_state_monitor.h"
+#include "../logging/logger.h"
+
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QTimer>
+#include <QtMath>
+
+NetworkQualityMonitor::NetworkQualityMonitor(QObject* parent)
+    : QObject(parent)
+    , m_logger(&Logger::instance())
+    , m_networkManager(ConnectivityService::instance().networkManager())
+    , m_probeTimer(new QTimer(this))
+    , m_activeReply(nullptr)
+    , m_minIntervalMs(kDefaultMinIntervalMs)
+    , m_maxIntervalMs(kDefaultMaxIntervalMs)
+    , m_probeTimeoutMs(kDefaultProbeTimeoutMs)
+    , m_running(false)
+{
+    qRegisterMetaType<NetworkQualityMonitor::Metrics>("NetworkQualityMonitor::Metrics");
+    qRegisterMetaType<NetworkQualityMonitor::Quality>("NetworkQualityMonitor::Quality");
+
+    m_probeTimer->setSingleShot(true);
+    connect(m_probeTimer, &QTimer::timeout, this, &NetworkQualityMonitor::sendProbe);
+    m_metrics.intervalMs = m_minIntervalMs;
+
+    // 链路变化时不等下一个间隔，立即加密采样
+    connect(&LinkStateMonitor::instance(), &LinkStateMonitor::usableLinkChanged, this, [this](bool, const QString&) {
+        if (m_running && !m_activeReply) {
+            m_metrics.intervalMs = m_minIntervalMs;
+            m_probeTimer->start(0);
+        }
+    });
+}
+
+NetworkQualityMonitor::~NetworkQualityMonitor()
+{
+    stop();
+}
+
+void NetworkQualityMonitor::setTarget(const QString& url)
+{
+    // 只探测源地址，不请求具体页面，避免触发考试系统的业务逻辑
+    const QUrl parsed(url);
+    m_target = QUrl();
+    if (parsed.isValid() && !parsed.host().isEmpty()) {
+        m_target.setScheme(parsed.scheme());
+        m_target.setHost(parsed.host());
+        m_target.setPort(parsed.port());
+        m_target.setPath("/");
+    }
+}
+
+void NetworkQualityMonitor::setIntervals(int minIntervalMs, int maxIntervalMs)
+{
+    m_minIntervalMs = qMax(100, minIntervalMs);
+    m_maxIntervalMs = qMax(m_minIntervalMs, maxIntervalMs);
+    m_metrics.intervalMs = qBound(m_minIntervalMs, m_metrics.intervalMs, m_maxIntervalMs);
+}
+
+void NetworkQualityMonitor::setProbeTimeout(int timeoutMs)
+{
+    m_probeTimeoutMs = qMax(100, timeoutMs);
+}
+
+void NetworkQualityMonitor::start()
+{
+    if (m_running) {
+        return;
+    }
+    if (!m_target.isValid()) {
+        m_logger->errorEvent("网络质量监控: 探测地址无效，未启动");
+        return;
+    }
+
+    m_running = true;
+    m_metrics.intervalMs = m_minIntervalMs;
+    m_logger->appEvent(QString("网络质量监控已启动: %1，探测间隔%2~%3ms")
+        .arg(m_target.toString()).arg(m_minIntervalMs).arg(m_maxIntervalMs));
+    sendProbe();
+}
+
+void NetworkQualityMonitor::stop()
+{
+    if (!m_running) {
+        return;
+    }
+
+    m_running = false;
+    m_probeTimer->stop();
+    if (m_activeReply) {
+        QNetworkReply* reply = m_activeReply;
+        m_activeReply = nullptr;
+        reply->abort();
+        reply->deleteLater();
+    }
+    m_logger->appEvent("网络质量监控已停止");
+}
+
+QString NetworkQualityMonitor::qualityName(Quality quality)
+{
+    switch (quality) {
+        case QualityGood: return "良好";
+        case QualityDegraded: return "较差";
+        case QualityOffline: return "离线";
+        case QualityUnknown:
+        default: return "未知";
+    }
+}
+
+void NetworkQualityMonitor::sendProbe()
+{
+    if (!m_running || m_activeReply) {
+        return;
+    }
+
+    QNetworkRequest request(m_target);
+    request.setRawHeader("User-Agent", "DesktopTerminal-CEF/1.0");
+    // 每次都经过网络，不读本地缓存；连接保持复用，测得的是请求往返而不是握手
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+    request.setTransferTimeout(m_probeTimeoutMs);
+
+    m_probeElapsed.start();
+    m_activeReply = m_networkManager->head(request);
+    connect(m_activeReply, &QNetworkReply::finished, this, &NetworkQualityMonitor::onProbeFinished);
+}
+
+void NetworkQualityMonitor::onProbeFinished()
+{
+    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
+    if (!reply || reply != m_activeReply) {
+        return;
+    }
+    m_activeReply = nullptr;
+    reply->deleteLater();
+
+    const double rttMs = m_probeElapsed.nsecsElapsed() / 1000000.0;
+
+    // 收到任何HTTP响应（包括4xx/5xx）都说明链路可达，只有传输层失败才计为丢包
+    const bool hasResponse = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).isValid();
+    const bool success = reply->error() == QNetworkReply::NoError || hasResponse;
+    if (!success) {
+        LinkStateMonitor::instance().requestRescan();
+        m_logger->logEvent("网络质量",
+            QString("探测失败（%1ms）: %2").arg(rttMs, 0, 'f', 0).arg(reply->errorString()),
+            "network.log", L_DEBUG);
+    }
+
+    recordSample(success, rttMs);
+    scheduleNextProbe();
+}
+
+void NetworkQualityMonitor::recordSample(bool success, double rttMs)
+{
+    ++m_metrics.samples;
+
+    if (success) {
+        if (m_metrics.srttMs <= 0.0) {
+            // 首个成功样本直接作为SRTT，抖动从0开始累积
+            m_metrics.srttMs = rttMs;
+            m_metrics.jitterMs = 0.0;
+        } else {
+            m_metrics.jitterMs += kJitterGain * (qAbs(m_metrics.srttMs - rttMs) - m_metrics.jitterMs);
+            m_metrics.srttMs += kRttGain * (rttMs - m_metrics.srttMs);
+        }
+        m_metrics.lastRttMs = rttMs;
+        m_metrics.consecutiveFailures = 0;
+        m_metrics.lossRate += kLossGain * (0.0 - m_metrics.lossRate);
+    } else {
+        ++m_metrics.failures;
+        ++m_metrics.consecutiveFailures;
+        m_metrics.lossRate += kLossGain * (1.0 - m_metrics.lossRate);
+    }
+
+    const Quality previous = m_metrics.quality;
+    m_metrics.quality = evaluateQuality();
+
+    m_logger->logEvent("网络质量",
+        QString("%1 RTT=%2ms SRTT=%3ms 抖动=%4ms 丢包率=%5% 间隔=%6ms")
+            .arg(success ? "成功" : "失败")
+            .arg(rttMs, 0, 'f', 0)
+            .arg(m_metrics.srttMs, 0, 'f', 0)
+            .arg(m_metrics.jitterMs, 0, 'f', 0)
+            .arg(m_metrics.lossRate * 100.0, 0, 'f', 1)
+            .arg(m_metrics.intervalMs),
+        "network.log", L_DEBUG);
+
+    emit sampleRecorded(success, rttMs, m_metrics);
+
+    if (m_metrics.quality != previous) {
+        m_logger->logEvent("网络质量",
+            QString("网络质量: %1 -> %2（SRTT=%3ms 抖动=%4ms 丢包率=%5%）")
+                .arg(qualityName(previous), qualityName(m_metrics.quality))
+                .arg(m_metrics.srttMs, 0, 'f', 0)
+                .arg(m_metrics.jitterMs, 0, 'f', 0)
+                .arg(m_metrics.lossRate * 100.0, 0, 'f', 1),
+            "network.log", m_metrics.quality == QualityGood ? L_INFO : L_WARNING);
+        emit qualityChanged(m_metrics.quality, previous);
+    }
+}
+
+NetworkQualityMonitor::Quality NetworkQualityMonitor::evaluateQuality() const
+{
+    if (m_metrics.consecutiveFailures >= kOfflineFailures) {
+        return QualityOffline;
+    }
+    if (m_metrics.srttMs > kDegradedRttMs
+        || m_metrics.jitterMs > kDegradedJitterMs
+        || m_metrics.lossRate > kDegradedLossRate) {
+        return QualityDegraded;
+    }
+    return QualityGood;
+}
+
+void NetworkQualityMonitor::scheduleNextProbe()
+{
+    if (!m_running) {
+        return;
+    }
+
+    // 良好时逐步拉长间隔减少请求；变差或失败时立即加密采样
+    if (m_metrics.quality == QualityGood && m_metrics.consecutiveFailures == 0) {
+        m_metrics.intervalMs = qMin(m_metrics.intervalMs * 2, m_maxIntervalMs);
+    } else {
+        m_metrics.intervalMs = m_minIntervalMs;
+    }
+    m_probeTimer->start(m_metrics.intervalMs);
+}
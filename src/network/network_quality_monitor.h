@@ -0,0 +1,139 @@
+#ifndef NETWORK_QUALITY_MONITOR_H
+#define NETWORK_QUALITY_MONITOR_H
+
+#include <QObject>
+#include <QString>
+#include <QUrl>
+#include <QElapsedTimer>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+class QTimer;
+class Logger;
+
+/**
+ * @brief 考试期间的网络质量监控
+ *
+ * 启动检测只在启动时执行一次，考试中途网络变差无从得知。本监控在后台以很低的频率
+ * 向考试站点源地址发送HEAD探测，用EWMA（指数加权移动平均）估计往返时间、抖动和丢包率：
+ * - RTT、抖动的平滑系数与TCP的SRTT/RTTVAR相同（1/8、1/4）；
+ * - 丢包率按每次探测成功与否以kLossGain平滑。
+ *
+ * 探测间隔自适应：网络良好时每次翻倍直到上限，质量下降或探测失败时立即回到下限。
+ * 探测使用ConnectivityService的共用网络管理器，与启动时的网络检测复用连接。
+ * 探测地址、间隔和超时均可设置，可指向本地测试服务器注入延迟和丢包。
+ */
+class NetworkQualityMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 网络质量等级
+     */
+    enum Quality {
+        QualityUnknown,     // 尚无样本
+        QualityGood,        // 正常
+        QualityDegraded,    // RTT、抖动或丢包率超过阈值
+        QualityOffline      // 连续多次探测失败
+    };
+
+    /**
+     * @brief 当前估计值
+     */
+    struct Metrics {
+        double srttMs = 0.0;        // 平滑往返时间
+        double jitterMs = 0.0;      // 平滑抖动（相邻样本与SRTT之差）
+        double lossRate = 0.0;      // 平滑丢包率 0~1
+        double lastRttMs = 0.0;     // 最近一次成功探测的RTT
+        int samples = 0;            // 探测总数
+        int failures = 0;           // 失败总数
+        int consecutiveFailures = 0;
+        int intervalMs = 0;         // 当前探测间隔
+        Quality quality = QualityUnknown;
+    };
+
+    static constexpr double kRttGain = 0.125;
+    static constexpr double kJitterGain = 0.25;
+    static constexpr double kLossGain = 0.1;
+    static constexpr int kOfflineFailures = 3;              // 连续失败多少次判定离线
+    static constexpr double kDegradedRttMs = 800.0;
+    static constexpr double kDegradedJitterMs = 300.0;
+    static constexpr double kDegradedLossRate = 0.1;
+    static constexpr int kDefaultMinIntervalMs = 5000;
+    static constexpr int kDefaultMaxIntervalMs = 60000;
+    static constexpr int kDefaultProbeTimeoutMs = 5000;
+
+    explicit NetworkQualityMonitor(QObject* parent = nullptr);
+    ~NetworkQualityMonitor() override;
+
+    /**
+     * @brief 设置探测目标，只取其源地址（scheme://host:port/）
+     */
+    void setTarget(const QString& url);
+
+    /**
+     * @brief 设置探测间隔范围（毫秒）
+     */
+    void setIntervals(int minIntervalMs, int maxIntervalMs);
+
+    /**
+     * @brief 设置单次探测超时（毫秒），超时计为丢包
+     */
+    void setProbeTimeout(int timeoutMs);
+
+    /**
+     * @brief 开始监控，立即发送第一次探测
+     */
+    void start();
+
+    /**
+     * @brief 停止监控并取消正在进行的探测
+     */
+    void stop();
+
+    bool isRunning() const { return m_running; }
+
+    Metrics metrics() const { return m_metrics; }
+
+    static QString qualityName(Quality quality);
+
+signals:
+    /**
+     * @brief 每次探测结束后发出
+     * @param success 探测是否成功
+     * @param rttMs 本次往返时间（失败时为到失败为止的耗时）
+     * @param metrics 更新后的估计值
+     */
+    void sampleRecorded(bool success, double rttMs, const NetworkQualityMonitor::Metrics& metrics);
+
+    /**
+     * @brief 质量等级变化
+     */
+    void qualityChanged(NetworkQualityMonitor::Quality quality, NetworkQualityMonitor::Quality previous);
+
+private slots:
+    void sendProbe();
+    void onProbeFinished();
+
+private:
+    void recordSample(bool success, double rttMs);
+    Quality evaluateQuality() const;
+    void scheduleNextProbe();
+
+    Logger* m_logger;
+    QNetworkAccessManager* m_networkManager;   // 共用，不持有
+    QTimer* m_probeTimer;
+    QNetworkReply* m_activeReply;
+    QElapsedTimer m_probeElapsed;
+
+    QUrl m_target;
+    int m_minIntervalMs;
+    int m_maxIntervalMs;
+    int m_probeTimeoutMs;
+    bool m_running;
+
+    Metrics m_metrics;
+};
+
+#endif // NETWORK_QUALITY_MONITOR_H
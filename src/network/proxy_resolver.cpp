@@ -0,0 +1,450 @@
+#include "proxy_resolver.h"
+#include "link_state_monitor.h"
+#include "../logging/logger.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkProxyFactory>
+#include <QNetworkProxyQuery>
+#include <QPointer>
+#include <QStandardPaths>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <algorithm>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <winhttp.h>
+#endif
+
+ProxyResolver* ProxyResolver::s_instance = nullptr;
+
+ProxyResolver& ProxyResolver::instance()
+{
+    if (!s_instance) {
+        s_instance = new ProxyResolver(QCoreApplication::instance());
+    }
+    return *s_instance;
+}
+
+ProxyResolver::ProxyResolver(QObject* parent)
+    : QObject(parent)
+    , m_logger(&Logger::instance())
+    , m_readyTimer(new QTimer(this))
+    , m_cacheTtlSeconds(kDefaultCacheTtlSeconds)
+    , m_resolved(false)
+    , m_started(false)
+    , m_readyEmitted(true)
+{
+    m_readyTimer->setSingleShot(true);
+    connect(m_readyTimer, &QTimer::timeout, this, [this]() {
+        m_logger->logEvent("代理解析", "代理解析超时，CEF将自行发现代理", "network.log", L_WARNING);
+        markReady(false);
+    });
+
+    // 换网后代理可能不同（如从校园网切到热点）
+    connect(&LinkStateMonitor::instance(), &LinkStateMonitor::usableLinkChanged, this, [this](bool usable, const QString&) {
+        if (usable) {
+            onNetworkChanged();
+        }
+    });
+}
+
+ProxyResolver::~ProxyResolver()
+{
+    s_instance = nullptr;
+}
+
+void ProxyResolver::setCacheTtlSeconds(int seconds)
+{
+    m_cacheTtlSeconds = qMax(0, seconds);
+}
+
+void ProxyResolver::resolve(const QUrl& target, int timeoutMs)
+{
+    if (m_started && m_target == target) {
+        // 系统检测之前已发起：复用同一次解析，已就绪时补发一次结论
+        if (m_readyEmitted) {
+            QTimer::singleShot(0, this, [this]() {
+                emit ready(m_resolved);
+            });
+        }
+        return;
+    }
+
+    m_started = true;
+    m_target = target;
+    m_fingerprint = networkFingerprint();
+    m_readyEmitted = false;
+    loadCache();
+
+    const CacheEntry entry = m_cache.value(m_fingerprint);
+    if (isCacheFresh(entry)) {
+        apply(entry, "缓存");
+        // 与DNS预解析一致：结论经事件循环回调，调用方不会在resolve内部被重入
+        QTimer::singleShot(0, this, [this]() {
+            markReady(true);
+        });
+    } else {
+        m_readyTimer->start(qMax(1, timeoutMs));
+    }
+
+    // 缓存命中也重新解析一次，刷新缓存供下次启动使用
+    startLookup(m_fingerprint);
+}
+
+QString ProxyResolver::chromiumProxyServer() const
+{
+    // Chromium按列表顺序回退：前一个代理连接失败时尝试下一个，direct://表示直连
+    QStringList entries;
+    for (const QNetworkProxy& proxy : m_proxies) {
+        entries << chromiumProxyEntry(proxy);
+    }
+    if (entries.isEmpty() || entries == QStringList("direct://")) {
+        return "direct";
+    }
+    return entries.join(',');
+}
+
+QString ProxyResolver::description() const
+{
+    if (!m_resolved) {
+        return "未解析";
+    }
+    const QString server = chromiumProxyServer();
+    const QString route = m_pacUrl.isEmpty()
+        ? (server == "direct" ? QString("直连") : server)
+        : QString("PAC %1，考试地址: %2").arg(m_pacUrl, server == "direct" ? QString("直连") : server);
+    return QString("%1（%2）").arg(route, m_source);
+}
+
+void ProxyResolver::startLookup(const QString& fingerprint)
+{
+    if (m_inFlight.contains(fingerprint)) {
+        return;
+    }
+    m_inFlight.insert(fingerprint);
+
+    // Windows上会执行WinHTTP的WPAD发现和PAC脚本，可能耗时数秒，放到独立线程池；
+    // 不用全局线程池，退出和启动任务图都不必等待代理发现结束
+    const QUrl target = m_target;
+    QPointer<ProxyResolver> guard(this);
+    lookupPool()->start([fingerprint, target, guard]() {
+        QElapsedTimer elapsed;
+        elapsed.start();
+        CacheEntry result;
+        result.proxies = normalized(QNetworkProxyFactory::systemProxyForQuery(QNetworkProxyQuery(target)));
+        result.pacUrl = systemPacUrl();
+        result.resolvedAtMs = QDateTime::currentMSecsSinceEpoch();
+        const qint64 elapsedMs = elapsed.elapsed();
+
+        // 结果投递回主线程；应用已退出时直接丢弃，解析器已销毁时由guard拦截
+        QCoreApplication* app = QCoreApplication::instance();
+        if (!app) {
+            return;
+        }
+        QMetaObject::invokeMethod(app, [fingerprint, result, elapsedMs, guard]() {
+            if (guard) {
+                guard->onLookupFinished(fingerprint, result, elapsedMs);
+            }
+        }, Qt::QueuedConnection);
+    });
+}
+
+QThreadPool* ProxyResolver::lookupPool()
+{
+    // 有意不释放：QThreadPool析构会等待任务完成，进程退出时未结束的代理发现随进程一并终止
+    static QThreadPool* pool = []() {
+        QThreadPool* created = new QThreadPool;
+        created->setMaxThreadCount(2);
+        return created;
+    }();
+    return pool;
+}
+
+void ProxyResolver::onLookupFinished(const QString& fingerprint, const CacheEntry& result, qint64 elapsedMs)
+{
+    m_inFlight.remove(fingerprint);
+
+    m_cache.insert(fingerprint, result);
+    saveCache();
+
+    QStringList entries;
+    for (const QNetworkProxy& proxy : result.proxies) {
+        entries << chromiumProxyEntry(proxy);
+    }
+    m_logger->logEvent("代理解析",
+        QString("系统代理解析完成（%1ms）: %2%3").arg(elapsedMs).arg(entries.join(','))
+            .arg(result.pacUrl.isEmpty() ? QString() : QString("，PAC %1").arg(result.pacUrl)),
+        "network.log", L_INFO);
+
+    if (fingerprint != m_fingerprint) {
+        return;   // 解析期间已换网，结果只进缓存
+    }
+
+    // 与缓存结论不同时以实时结果为准；是否还能交给CEF由Application根据CEF是否已初始化决定
+    const bool changed = !m_resolved || m_proxies != result.proxies || m_pacUrl != result.pacUrl;
+    if (changed) {
+        if (m_resolved) {
+            m_logger->logEvent("代理解析", "实时解析结果与缓存不同，改用实时结果", "network.log", L_WARNING);
+        }
+        apply(result, "实时解析");
+    }
+    markReady(true);
+}
+
+void ProxyResolver::onNetworkChanged()
+{
+    const QString fingerprint = networkFingerprint();
+    if (fingerprint == m_fingerprint || m_target.isEmpty()) {
+        return;
+    }
+    m_fingerprint = fingerprint;
+
+    const CacheEntry entry = m_cache.value(fingerprint);
+    if (isCacheFresh(entry)) {
+        apply(entry, "缓存");
+        return;
+    }
+    m_logger->logEvent("代理解析", "网络已变化，重新解析系统代理", "network.log", L_INFO);
+    startLookup(fingerprint);
+}
+
+void ProxyResolver::apply(const CacheEntry& entry, const QString& source)
+{
+    m_proxies = entry.proxies;
+    m_pacUrl = entry.pacUrl;
+    m_source = source;
+    m_resolved = true;
+
+    // 共享的QNetworkAccessManager使用应用级代理；Qt不支持回退列表，取首选项
+    QNetworkProxy::setApplicationProxy(proxy());
+
+    m_logger->logEvent("代理解析", QString("应用代理: %1").arg(description()), "network.log", L_INFO);
+    emit proxyChanged(description());
+}
+
+void ProxyResolver::markReady(bool resolved)
+{
+    if (m_readyEmitted) {
+        return;
+    }
+    m_readyEmitted = true;
+    m_readyTimer->stop();
+    emit ready(resolved);
+}
+
+bool ProxyResolver::isCacheFresh(const CacheEntry& entry) const
+{
+    if (entry.resolvedAtMs <= 0) {
+        return false;
+    }
+    const qint64 ageMs = QDateTime::currentMSecsSinceEpoch() - entry.resolvedAtMs;
+    return ageMs >= 0 && ageMs < static_cast<qint64>(m_cacheTtlSeconds) * 1000;
+}
+
+void ProxyResolver::loadCache()
+{
+    QFile file(cacheFilePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value("version").toInt() != kCacheVersion) {
+        return;
+    }
+
+    const QJsonObject networks = root.value("networks").toObject();
+    for (auto it = networks.constBegin(); it != networks.constEnd(); ++it) {
+        const QJsonObject item = it.value().toObject();
+        CacheEntry entry;
+        for (const QJsonValue& value : item.value("proxies").toArray()) {
+            const QJsonObject proxy = value.toObject();
+            const QString type = proxy.value("type").toString();
+            if (type == "http") {
+                entry.proxies << QNetworkProxy(QNetworkProxy::HttpProxy, proxy.value("host").toString(),
+                                               static_cast<quint16>(proxy.value("port").toInt()));
+            } else if (type == "socks5") {
+                entry.proxies << QNetworkProxy(QNetworkProxy::Socks5Proxy, proxy.value("host").toString(),
+                                               static_cast<quint16>(proxy.value("port").toInt()));
+            } else {
+                entry.proxies << QNetworkProxy(QNetworkProxy::NoProxy);
+            }
+        }
+        if (entry.proxies.isEmpty()) {
+            entry.proxies << QNetworkProxy(QNetworkProxy::NoProxy);
+        }
+        entry.pacUrl = item.value("pac").toString();
+        entry.resolvedAtMs = static_cast<qint64>(item.value("resolvedAt").toDouble());
+        if (isCacheFresh(entry)) {
+            m_cache.insert(it.key(), entry);   // 过期条目不再加载，写回时自然清除
+        }
+    }
+}
+
+void ProxyResolver::saveCache()
+{
+    QJsonObject networks;
+    for (auto it = m_cache.constBegin(); it != m_cache.constEnd(); ++it) {
+        QJsonArray proxies;
+        for (const QNetworkProxy& proxy : it.value().proxies) {
+            QJsonObject entry;
+            if (proxy.type() == QNetworkProxy::Socks5Proxy) {
+                entry["type"] = "socks5";
+            } else if (proxy.type() == QNetworkProxy::HttpProxy) {
+                entry["type"] = "http";
+            } else {
+                entry["type"] = "direct";
+            }
+            if (proxy.type() != QNetworkProxy::NoProxy) {
+                entry["host"] = proxy.hostName();
+                entry["port"] = proxy.port();
+            }
+            proxies.append(entry);
+        }
+        QJsonObject item;
+        item["proxies"] = proxies;
+        if (!it.value().pacUrl.isEmpty()) {
+            item["pac"] = it.value().pacUrl;
+        }
+        item["resolvedAt"] = static_cast<double>(it.value().resolvedAtMs);
+        networks[it.key()] = item;
+    }
+
+    QJsonObject root;
+    root["version"] = kCacheVersion;
+    root["networks"] = networks;
+
+    QFile file(cacheFilePath());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        m_logger->errorEvent(QString("代理缓存保存失败: %1").arg(file.errorString()));
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+}
+
+QString ProxyResolver::networkFingerprint()
+{
+    QStringList parts;
+    for (const LinkStateMonitor::InterfaceState& state : LinkStateMonitor::instance().interfaces()) {
+        if (!state.isUsable()) {
+            continue;
+        }
+        QStringList addresses;
+        for (const QHostAddress& address : state.addresses) {
+            addresses << address.toString();
+        }
+        std::sort(addresses.begin(), addresses.end());
+        parts << QString("%1=%2").arg(state.name, addresses.join(","));
+    }
+    std::sort(parts.begin(), parts.end());
+
+    return QString::fromLatin1(
+        QCryptographicHash::hash(parts.join('|').toUtf8(), QCryptographicHash::Sha1).toHex().left(16));
+}
+
+QString ProxyResolver::cacheFilePath()
+{
+    QDir dir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+    if (!dir.exists()) {
+        dir.mkpath(".");
+    }
+    return dir.filePath("proxy_cache.json");
+}
+
+QList<QNetworkProxy> ProxyResolver::normalized(const QList<QNetworkProxy>& proxies)
+{
+    // 保留PAC给出的顺序作为回退列表；Chromium开关只支持HTTP和SOCKS5，直连之后的项不会用到
+    QList<QNetworkProxy> result;
+    for (const QNetworkProxy& proxy : proxies) {
+        QNetworkProxy entry;
+        switch (proxy.type()) {
+        case QNetworkProxy::NoProxy:
+        case QNetworkProxy::DefaultProxy:
+            entry = QNetworkProxy(QNetworkProxy::NoProxy);
+            break;
+        case QNetworkProxy::HttpProxy:
+        case QNetworkProxy::HttpCachingProxy:
+            entry = QNetworkProxy(QNetworkProxy::HttpProxy, proxy.hostName(), proxy.port());
+            break;
+        case QNetworkProxy::Socks5Proxy:
+            entry = QNetworkProxy(QNetworkProxy::Socks5Proxy, proxy.hostName(), proxy.port());
+            break;
+        default:
+            continue;
+        }
+        if (!result.contains(entry)) {
+            result << entry;
+        }
+        if (entry.type() == QNetworkProxy::NoProxy) {
+            break;
+        }
+    }
+    if (result.isEmpty()) {
+        result << QNetworkProxy(QNetworkProxy::NoProxy);
+    }
+    return result;
+}
+
+QString ProxyResolver::chromiumProxyEntry(const QNetworkProxy& proxy)
+{
+    switch (proxy.type()) {
+    case QNetworkProxy::HttpProxy:
+        return QString("http://%1:%2").arg(proxy.hostName()).arg(proxy.port());
+    case QNetworkProxy::Socks5Proxy:
+        return QString("socks5://%1:%2").arg(proxy.hostName()).arg(proxy.port());
+    default:
+        return "direct://";
+    }
+}
+
+QString ProxyResolver::systemPacUrl()
+{
+#ifdef Q_OS_WIN
+    // 在工作线程调用：WPAD发现可能耗时数秒
+    WINHTTP_CURRENT_USER_IE_PROXY_CONFIG config;
+    ZeroMemory(&config, sizeof(config));
+    if (!WinHttpGetIEProxyConfigForCurrentUser(&config)) {
+        return QString();
+    }
+
+    QString pacUrl;
+    if (config.lpszAutoConfigUrl) {
+        pacUrl = QString::fromWCharArray(config.lpszAutoConfigUrl);
+    }
+    const bool autoDetect = config.fAutoDetect;
+    if (config.lpszAutoConfigUrl) {
+        GlobalFree(config.lpszAutoConfigUrl);
+    }
+    if (config.lpszProxy) {
+        GlobalFree(config.lpszProxy);
+    }
+    if (config.lpszProxyBypass) {
+        GlobalFree(config.lpszProxyBypass);
+    }
+
+    if (pacUrl.isEmpty() && autoDetect) {
+        LPWSTR detected = nullptr;
+        if (WinHttpDetectAutoProxyConfigUrl(WINHTTP_AUTO_DETECT_TYPE_DHCP | WINHTTP_AUTO_DETECT_TYPE_DNS_A, &detected)
+            && detected) {
+            pacUrl = QString::fromWCharArray(detected);
+        }
+        if (detected) {
+            GlobalFree(detected);
+        }
+    }
+    return pacUrl;
+#else
+    return QString();
+#endif
+}
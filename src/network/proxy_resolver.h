@@ -0,0 +1,155 @@
+#ifndef PROXY_RESOLVER_H
+#define PROXY_RESOLVER_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QUrl>
+#include <QNetworkProxy>
+
+class QThreadPool;
+class QTimer;
+class Logger;
+
+/**
+ * @brief 系统代理/PAC的一次性解析与缓存
+ *
+ * 学校网络常配置WPAD/PAC，Chromium每次启动都要自行发现和执行PAC，页面加载可能多出数秒；
+ * Qt默认又完全不读系统代理，检测结果与浏览器实际走的路径不一致。
+ * 本类在独立线程池（退出时不等待）中用QNetworkProxyFactory::systemProxyForQuery()为考试地址解析一次代理，
+ * 结果按网络指纹（可用接口及其地址）缓存到磁盘：
+ * - Qt侧通过QNetworkProxy::setApplicationProxy()生效（取列表第一项），共享的QNetworkAccessManager随之使用；
+ * - CEF侧由Application在CefInitialize之前传入：系统配置了PAC（显式地址或WPAD发现）时
+ *   以--proxy-pac-url传入PAC地址，其他资源也按PAC选路，只省去WPAD发现；否则以--proxy-server
+ *   传入完整的回退列表（如"http://p:3128,direct://"），首选代理不可用时Chromium依次回退。
+ *
+ * Application在系统检测之前发起解析，缓存命中时立即可用，同时在后台重新解析刷新缓存；
+ * 实时结果在CefInitialize之前到达时替换缓存结果。网络指纹变化（换网）后重新解析，
+ * 新结果只更新Qt侧，CEF沿用启动时的代理直到下次启动。
+ */
+class ProxyResolver : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kDefaultCacheTtlSeconds = 24 * 3600;
+    static constexpr int kCacheVersion = 2;
+
+    /**
+     * @brief 获取单例实例（须在QApplication创建之后调用）
+     */
+    static ProxyResolver& instance();
+
+    /**
+     * @brief 单例是否已创建
+     */
+    static bool hasInstance() { return s_instance != nullptr; }
+
+    /**
+     * @brief 设置磁盘缓存有效期（秒）
+     */
+    void setCacheTtlSeconds(int seconds);
+
+    /**
+     * @brief 为目标地址解析代理
+     * @param timeoutMs 等待上限；缓存命中时立即就绪，超时后解析仍在后台完成
+     *
+     * 就绪或超时后发出一次ready()。同一目标重复调用时不重新解析，
+     * 复用进行中的解析或已有的结论（已就绪时经事件循环再发出一次ready()）。
+     */
+    void resolve(const QUrl& target, int timeoutMs);
+
+    /**
+     * @brief 是否已有可用的代理结论（缓存或实时解析）
+     */
+    bool isResolved() const { return m_resolved; }
+
+    /**
+     * @brief 当前生效的代理（列表第一项，未解析时为NoProxy）
+     */
+    QNetworkProxy proxy() const { return m_proxies.value(0, QNetworkProxy(QNetworkProxy::NoProxy)); }
+
+    /**
+     * @brief Chromium代理开关取值："direct"表示直连，否则为回退列表，如"http://10.0.0.1:3128,direct://"
+     */
+    QString chromiumProxyServer() const;
+
+    /**
+     * @brief 系统配置的PAC地址（显式配置或WPAD发现），没有时为空
+     */
+    QString pacUrl() const { return m_pacUrl; }
+
+    /**
+     * @brief 代理及其来源的简要描述，用于日志
+     */
+    QString description() const;
+
+    /**
+     * @brief 当前网络指纹（可用接口名及地址的摘要）
+     */
+    static QString networkFingerprint();
+
+    /**
+     * @brief 磁盘缓存文件路径
+     */
+    static QString cacheFilePath();
+
+signals:
+    /**
+     * @brief 启动等待结束
+     * @param resolved 是否已有代理结论（false表示超时，CEF应自行发现代理）
+     */
+    void ready(bool resolved);
+
+    /**
+     * @brief 生效的代理发生变化
+     */
+    void proxyChanged(const QString& description);
+
+private:
+    struct CacheEntry {
+        QList<QNetworkProxy> proxies;
+        QString pacUrl;
+        qint64 resolvedAtMs = 0;
+    };
+
+    explicit ProxyResolver(QObject* parent);
+    ~ProxyResolver() override;
+    ProxyResolver(const ProxyResolver&) = delete;
+    ProxyResolver& operator=(const ProxyResolver&) = delete;
+
+    void startLookup(const QString& fingerprint);
+    void onLookupFinished(const QString& fingerprint, const CacheEntry& result, qint64 elapsedMs);
+    void onNetworkChanged();
+    void apply(const CacheEntry& entry, const QString& source);
+    void markReady(bool resolved);
+    bool isCacheFresh(const CacheEntry& entry) const;
+
+    void loadCache();
+    void saveCache();
+
+    static QThreadPool* lookupPool();
+    static QList<QNetworkProxy> normalized(const QList<QNetworkProxy>& proxies);
+    static QString systemPacUrl();
+    static QString chromiumProxyEntry(const QNetworkProxy& proxy);
+
+    static ProxyResolver* s_instance;
+
+    Logger* m_logger;
+    QUrl m_target;
+    QString m_fingerprint;
+    QList<QNetworkProxy> m_proxies;    // 按优先级排列，最后一项可能是直连
+    QString m_pacUrl;
+    QString m_source;
+    QHash<QString, CacheEntry> m_cache;
+    QTimer* m_readyTimer;
+    int m_cacheTtlSeconds;
+    QSet<QString> m_inFlight;          // 正在解析的网络指纹
+    bool m_resolved;
+    bool m_started;
+    bool m_readyEmitted;
+};
+
+#endif // PROXY_RESOLVER_H
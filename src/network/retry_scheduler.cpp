@@ -0,0 +1,85 @@
+#include "retry_scheduler.h"
+
+#include <QDateTime>
+#include <QLocale>
+#include <QRandomGenerator>
+
+RetryScheduler::RetryScheduler(int baseDelayMs, int maxDelayMs)
+    : m_baseDelayMs(kDefaultBaseDelayMs)
+    , m_maxDelayMs(kDefaultMaxDelayMs)
+    , m_previousDelayMs(kDefaultBaseDelayMs)
+    , m_currentDelayMs(0)
+    , m_failures(0)
+{
+    setDelays(baseDelayMs, maxDelayMs);
+}
+
+void RetryScheduler::setDelays(int baseDelayMs, int maxDelayMs)
+{
+    m_baseDelayMs = qMax(1, baseDelayMs);
+    m_maxDelayMs = qMax(m_baseDelayMs, maxDelayMs);
+    // 去相关抖动的初值为base：首次失败即在[base, base×3]内取值，而不是固定等于base
+    if (m_failures == 0) {
+        m_previousDelayMs = m_baseDelayMs;
+    }
+}
+
+int RetryScheduler::recordFailure(int serverHintMs)
+{
+    ++m_failures;
+
+    // 去相关抖动：在[base, 上次等待×3]内随机取值（m_previousDelayMs不超过上限，乘3不会溢出）
+    const int upper = qMax(m_baseDelayMs, m_previousDelayMs * 3);
+    int delay = qMin(m_maxDelayMs, static_cast<int>(QRandomGenerator::global()->bounded(m_baseDelayMs, upper + 1)));
+
+    // 服务器明确要求等待时以其为准，叠加抖动避免所有终端在同一时刻返回
+    if (serverHintMs > 0) {
+        const int hint = qMin(serverHintMs, kMaxServerHintMs);
+        delay = qMax(delay, hint + static_cast<int>(QRandomGenerator::global()->bounded(m_baseDelayMs + 1)));
+    }
+
+    m_previousDelayMs = qMin(delay, m_maxDelayMs);
+    m_currentDelayMs = delay;
+    m_sinceFailure.start();
+    return delay;
+}
+
+void RetryScheduler::recordSuccess()
+{
+    m_failures = 0;
+    m_previousDelayMs = m_baseDelayMs;
+    m_currentDelayMs = 0;
+    m_sinceFailure.invalidate();
+}
+
+qint64 RetryScheduler::remainingMs() const
+{
+    if (!m_sinceFailure.isValid()) {
+        return 0;
+    }
+    return qMax<qint64>(0, m_currentDelayMs - m_sinceFailure.elapsed());
+}
+
+int RetryScheduler::parseRetryAfter(const QByteArray& value)
+{
+    const QByteArray trimmed = value.trimmed();
+    if (trimmed.isEmpty()) {
+        return -1;
+    }
+
+    // delta-seconds
+    bool ok = false;
+    const qint64 seconds = trimmed.toLongLong(&ok);
+    if (ok) {
+        return seconds < 0 ? -1 : static_cast<int>(qMin<qint64>(seconds * 1000, kMaxServerHintMs));
+    }
+
+    // HTTP-date，如 "Wed, 21 Oct 2015 07:28:00 GMT"
+    QDateTime date = QLocale::c().toDateTime(QString::fromLatin1(trimmed), "ddd, dd MMM yyyy HH:mm:ss 'GMT'");
+    if (!date.isValid()) {
+        return -1;
+    }
+    date.setTimeSpec(Qt::UTC);
+    const qint64 deltaMs = QDateTime::currentDateTimeUtc().msecsTo(date);
+    return static_cast<int>(qBound<qint64>(0, deltaMs, kMaxServerHintMs));
+}
@@ -0,0 +1,69 @@
+#ifndef RETRY_SCHEDULER_H
+#define RETRY_SCHEDULER_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+
+/**
+ * @brief 带去相关抖动的指数退避
+ *
+ * 考场上行链路恢复时，几十台终端若按相同的固定间隔重试，会在同一时刻一起冲击服务器。
+ * 每次失败后的等待时间按“去相关抖动”计算：
+ *     delay = min(cap, random(base, previous * 3))
+ * 各终端的随机序列相互独立，重试时间很快错开，整体仍按指数增长直到上限。
+ *
+ * 服务器通过Retry-After（429/503）给出等待时间时，至少等待该时间，再叠加0~base的抖动。
+ * 本类只计算“下次最早何时可以重试”，由调用方用自己的定时器执行重试。
+ */
+class RetryScheduler
+{
+public:
+    static constexpr int kDefaultBaseDelayMs = 1000;
+    static constexpr int kDefaultMaxDelayMs = 30000;
+    static constexpr int kMaxServerHintMs = 10 * 60 * 1000;   // 忽略超过10分钟的Retry-After
+
+    explicit RetryScheduler(int baseDelayMs = kDefaultBaseDelayMs, int maxDelayMs = kDefaultMaxDelayMs);
+
+    /**
+     * @brief 设置退避参数（不影响已计算的等待时间）
+     */
+    void setDelays(int baseDelayMs, int maxDelayMs);
+
+    /**
+     * @brief 记录一次失败，计算下次重试前的等待时间
+     * @param serverHintMs 服务器给出的Retry-After（毫秒），没有时为-1
+     * @return 等待时间（毫秒）
+     */
+    int recordFailure(int serverHintMs = -1);
+
+    /**
+     * @brief 记录成功，退避清零
+     */
+    void recordSuccess();
+
+    /**
+     * @brief 距离允许下次重试还有多久（毫秒），0表示现在即可重试
+     */
+    qint64 remainingMs() const;
+
+    /**
+     * @brief 连续失败次数
+     */
+    int failures() const { return m_failures; }
+
+    /**
+     * @brief 解析Retry-After响应头（秒数或HTTP日期）
+     * @return 毫秒数，无法解析时返回-1
+     */
+    static int parseRetryAfter(const QByteArray& value);
+
+private:
+    int m_baseDelayMs;
+    int m_maxDelayMs;
+    int m_previousDelayMs;
+    int m_currentDelayMs;
+    int m_failures;
+    QElapsedTimer m_sinceFailure;
+};
+
+#endif // RETRY_SCHEDULER_H
@@ -0,0 +1,108 @@
+#ifndef KEY_COMBO_SET_H
+#define KEY_COMBO_SET_H
+
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * @brief 按键组合查找表（开放寻址、线性探测）
+ *
+ * 键为打包后的整数组合码（Qt键值 | 修饰键），值为一个字节的判定结果。
+ * 只在初始化时插入，运行期查找不分配内存、不构造字符串。
+ * 组合码0保留为空槽标记（Qt没有值为0的有效按键）。
+ */
+class KeyComboSet
+{
+public:
+    KeyComboSet() : m_mask(0), m_size(0) {}
+
+    /**
+     * @brief 清空并按预计元素数量预留容量（负载因子不超过0.5）
+     */
+    void reset(int expectedCount)
+    {
+        int capacity = 16;
+        while (capacity < expectedCount * 2) {
+            capacity <<= 1;
+        }
+        m_codes.fill(0, capacity);
+        m_values.fill(0, capacity);
+        m_mask = static_cast<quint32>(capacity - 1);
+        m_size = 0;
+    }
+
+    /**
+     * @brief 插入或覆盖组合码对应的值
+     */
+    void insert(quint32 code, quint8 value)
+    {
+        if (code == 0) {
+            return;
+        }
+        if (m_codes.isEmpty() || (m_size + 1) * 2 > m_codes.size()) {
+            grow();
+        }
+
+        quint32 slot = hash(code) & m_mask;
+        while (m_codes[slot] != 0 && m_codes[slot] != code) {
+            slot = (slot + 1) & m_mask;
+        }
+        if (m_codes[slot] == 0) {
+            m_codes[slot] = code;
+            m_size++;
+        }
+        m_values[slot] = value;
+    }
+
+    /**
+     * @brief 查找组合码
+     * @param value 找到时写入对应值
+     * @return 找到返回true
+     */
+    bool find(quint32 code, quint8* value) const
+    {
+        if (m_size == 0) {
+            return false;
+        }
+
+        const quint32* codes = m_codes.constData();
+        quint32 slot = hash(code) & m_mask;
+        while (codes[slot] != 0) {
+            if (codes[slot] == code) {
+                *value = m_values.constData()[slot];
+                return true;
+            }
+            slot = (slot + 1) & m_mask;
+        }
+        return false;
+    }
+
+    int size() const { return m_size; }
+    int capacity() const { return m_codes.size(); }
+
+private:
+    static quint32 hash(quint32 code)
+    {
+        // Fibonacci散列：键值低位与修饰键高位都参与槽位计算
+        return (code * 2654435769u) >> 7;
+    }
+
+    void grow()
+    {
+        const QVector<quint32> oldCodes = m_codes;
+        const QVector<quint8> oldValues = m_values;
+        reset(qMax(m_size + 1, oldCodes.size()));
+        for (int i = 0; i < oldCodes.size(); ++i) {
+            if (oldCodes[i] != 0) {
+                insert(oldCodes[i], oldValues[i]);
+            }
+        }
+    }
+
+    QVector<quint32> m_codes;
+    QVector<quint8> m_values;
+    quint32 m_mask;
+    int m_size;
+};
+
+#endif // KEY_COMBO_SET_H
@@ -0,0 +1,118 @@
+#include "key_policy.h"
+#include "key_combo_set.h"
+
+#include <QVector>
+
+unsigned KeyPolicy::fromQtModifiers(Qt::KeyboardModifiers modifiers)
+{
+    return ((modifiers & Qt::ShiftModifier) ? static_cast<unsigned>(MOD_SHIFT) : 0u)
+         | ((modifiers & Qt::ControlModifier) ? static_cast<unsigned>(MOD_CTRL) : 0u)
+         | ((modifiers & Qt::AltModifier) ? static_cast<unsigned>(MOD_ALT) : 0u)
+         | ((modifiers & Qt::MetaModifier) ? static_cast<unsigned>(MOD_META) : 0u);
+}
+
+int KeyPolicy::fromQtKey(int qtKey)
+{
+    // 字母、数字、空格：Qt键值与虚拟键码一致
+    if ((qtKey >= Qt::Key_A && qtKey <= Qt::Key_Z) ||
+        (qtKey >= Qt::Key_0 && qtKey <= Qt::Key_9) ||
+        qtKey == Qt::Key_Space) {
+        return qtKey;
+    }
+
+    // F1-F24 连续编码
+    if (qtKey >= Qt::Key_F1 && qtKey <= Qt::Key_F24) {
+        return KeyPolicyVk::F1 + (qtKey - Qt::Key_F1);
+    }
+
+    switch (qtKey) {
+        case Qt::Key_Escape:     return KeyPolicyVk::Escape;
+        case Qt::Key_Tab:
+        case Qt::Key_Backtab:    return KeyPolicyVk::Tab;
+        case Qt::Key_Backspace:  return KeyPolicyVk::Back;
+        case Qt::Key_Return:
+        case Qt::Key_Enter:      return KeyPolicyVk::Return;
+        case Qt::Key_Insert:     return 0x2D;
+        case Qt::Key_Delete:     return KeyPolicyVk::Delete;
+        case Qt::Key_Pause:      return 0x13;
+        case Qt::Key_Print:      return 0x2C;
+        case Qt::Key_Home:       return 0x24;
+        case Qt::Key_End:        return 0x23;
+        case Qt::Key_Left:       return KeyPolicyVk::Left;
+        case Qt::Key_Up:         return KeyPolicyVk::Up;
+        case Qt::Key_Right:      return KeyPolicyVk::Right;
+        case Qt::Key_Down:       return KeyPolicyVk::Down;
+        case Qt::Key_PageUp:     return 0x21;
+        case Qt::Key_PageDown:   return 0x22;
+        case Qt::Key_Shift:      return KeyPolicyVk::Shift;
+        case Qt::Key_Control:    return KeyPolicyVk::Control;
+        case Qt::Key_Alt:        return KeyPolicyVk::Menu;
+        case Qt::Key_Meta:       return KeyPolicyVk::LWin;
+        case Qt::Key_CapsLock:   return 0x14;
+        case Qt::Key_NumLock:    return 0x90;
+        case Qt::Key_ScrollLock: return 0x91;
+        case Qt::Key_Menu:       return 0x5D;
+        default:                 return 0;
+    }
+}
+
+void KeyPolicy::buildQtComboTable(KeyComboSet& table)
+{
+    static const Qt::KeyboardModifier kModifierBits[] = {
+        Qt::ShiftModifier, Qt::ControlModifier, Qt::AltModifier, Qt::MetaModifier
+    };
+
+    QVector<int> qtKeys;
+    for (int key = Qt::Key_A; key <= Qt::Key_Z; ++key) qtKeys << key;
+    for (int key = Qt::Key_0; key <= Qt::Key_9; ++key) qtKeys << key;
+    for (int key = Qt::Key_F1; key <= Qt::Key_F24; ++key) qtKeys << key;
+    for (int key = Qt::Key_Escape; key <= Qt::Key_ScrollLock; ++key) qtKeys << key;
+    qtKeys << Qt::Key_Space << Qt::Key_Menu;
+
+    table.reset(256);
+    for (int key : qtKeys) {
+        const int vk = fromQtKey(key);
+        if (vk == 0) {
+            continue;
+        }
+        for (unsigned mods = 0; mods < static_cast<unsigned>(kModifierCombos); ++mods) {
+            const Verdict v = verdict(vk, mods);
+            if (v == defaultVerdict(mods)) {
+                continue;
+            }
+            quint32 code = static_cast<quint32>(key);
+            for (int bit = 0; bit < 4; ++bit) {
+                if (mods & (1u << bit)) {
+                    code |= static_cast<quint32>(kModifierBits[bit]);
+                }
+            }
+            table.insert(code, static_cast<quint8>(v));
+        }
+    }
+}
+
+KeyPolicy::Verdict KeyPolicy::qtComboVerdict(const KeyComboSet& table, int qtKey, Qt::KeyboardModifiers modifiers)
+{
+    static const quint32 kModifierMask = Qt::ShiftModifier | Qt::ControlModifier | Qt::AltModifier | Qt::MetaModifier;
+    const quint32 relevantModifiers = static_cast<quint32>(modifiers) & kModifierMask;
+
+    quint8 v = 0;
+    if (table.find(static_cast<quint32>(qtKey) | relevantModifiers, &v)) {
+        return static_cast<Verdict>(v);
+    }
+    return defaultVerdict(fromQtModifiers(modifiers));
+}
+
+const char* KeyPolicy::verdictName(Verdict v)
+{
+    switch (v) {
+        case VERDICT_ALLOW:     return "允许";
+        case VERDICT_EXIT:      return "退出热键";
+        case VERDICT_DANGEROUS: return "危险按键";
+        case VERDICT_SYSTEM:    return "系统按键";
+        case VERDICT_DEBUG:     return "调试按键";
+        case VERDICT_DEVTOOLS:  return "开发者工具按键";
+        case VERDICT_SHORTCUT:  return "快捷键";
+    }
+    return "未知";
+}
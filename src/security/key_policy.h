@@ -0,0 +1,345 @@
+#ifndef KEY_POLICY_H
+#define KEY_POLICY_H
+
+#include <cstdint>
+#include <Qt>
+
+class KeyComboSet;
+
+/**
+ * @brief 统一按键策略
+ *
+ * CEFClient、KeyboardFilter、WindowsKeyBlocker 三处按键判定共用同一份策略：
+ * 规则以声明式列表给出（见 kKeyPolicyRules），编译期展开为
+ * [归一化修饰键掩码][虚拟键码] 的稠密表，运行时查询只是一次数组下标访问。
+ *
+ * 键码统一使用Windows虚拟键码（VK_*）：CEF的windows_key_code与低级键盘钩子的vkCode
+ * 本身就是该编码，Qt键值通过 fromQtKey() 映射。
+ */
+class KeyPolicy
+{
+public:
+    /**
+     * @brief 归一化修饰键掩码（与具体来源的标志位无关）
+     */
+    enum Modifier : uint8_t {
+        MOD_NONE  = 0,
+        MOD_SHIFT = 1 << 0,
+        MOD_CTRL  = 1 << 1,
+        MOD_ALT   = 1 << 2,
+        MOD_META  = 1 << 3   // Windows键/Command键
+    };
+
+    /**
+     * @brief 按键判定结果
+     */
+    enum Verdict : uint8_t {
+        VERDICT_ALLOW = 0,     // 放行
+        VERDICT_EXIT,          // 安全退出热键（放行，由上层触发退出流程）
+        VERDICT_DANGEROUS,     // 危险组合（切换/关闭/锁屏等）
+        VERDICT_SYSTEM,        // 系统功能键（帮助、全屏等）
+        VERDICT_DEBUG,         // 调试组合（始终禁止）
+        VERDICT_DEVTOOLS,      // 开发者工具组合（仅开发者模式放行）
+        VERDICT_SHORTCUT       // 未列出的带系统修饰键组合（默认禁止）
+    };
+
+    static constexpr int kKeyCodeCount = 256;
+    static constexpr int kModifierCombos = 16;
+    static constexpr uint8_t kVerdictMask = 0x0F;
+    static constexpr uint8_t kOsHookFlag = 0x80;   // 需要在系统级钩子中一并拦截
+    static constexpr uint8_t kWindowOnlyFlag = 0x40;   // 仅Qt窗口路径放行，浏览器路径按原白名单禁止
+
+    /**
+     * @brief 查询原始表项（判定 | 标志位）
+     */
+    static constexpr uint8_t entry(int vk, unsigned mods);
+
+    /**
+     * @brief 查询按键判定
+     * @param vk Windows虚拟键码
+     * @param mods 归一化修饰键掩码
+     */
+    static constexpr Verdict verdict(int vk, unsigned mods);
+
+    /**
+     * @brief 未命中任何规则时的默认判定
+     * 无修饰键或仅Shift视为普通输入，其余带Ctrl/Alt/Meta的组合一律禁止
+     */
+    static constexpr Verdict defaultVerdict(unsigned mods);
+
+    /**
+     * @brief 判定结果是否应放行（三处共同的最小放行集合）
+     * @param developerMode 是否处于开发者模式
+     */
+    static constexpr bool isAllowed(Verdict v, bool developerMode);
+
+    /**
+     * @brief CEF浏览器路径是否放行
+     * @param vk Windows虚拟键码
+     * @param mods 归一化修饰键掩码
+     * 沿用原CEFClient白名单：不带Ctrl/Alt/Meta的系统功能键（F1、F5、F11、Shift+F10）交给页面处理，
+     * 标记kWindowOnlyFlag的组合（Ctrl+F5）只在Qt窗口放行
+     */
+    static constexpr bool isAllowedInBrowser(int vk, unsigned mods, bool developerMode);
+
+    /**
+     * @brief Qt窗口路径（KeyboardFilter）是否放行
+     * 沿用原KeyboardFilter黑名单：只拦截明确列出的组合，未列出的快捷键（如对话框中的Ctrl+V）放行
+     */
+    static constexpr bool isAllowedInWindow(Verdict v, bool developerMode);
+
+    /**
+     * @brief 是否需要由系统级键盘钩子拦截（Win键、Ctrl+Esc等应用层无法拦截的组合）
+     */
+    static constexpr bool requiresOsHook(int vk, unsigned mods);
+
+    /**
+     * @brief CEF事件标志（EVENTFLAG_*）转换为归一化修饰键掩码
+     * 自动忽略NumLock/CapsLock/小键盘/左右侧等与安全无关的标志
+     */
+    static constexpr unsigned fromCefModifiers(uint32_t flags);
+
+    /**
+     * @brief 低级键盘钩子中的修饰键状态转换为归一化修饰键掩码
+     */
+    static constexpr unsigned fromHookModifiers(bool ctrl, bool alt, bool shift, bool win);
+
+    /**
+     * @brief Qt修饰键转换为归一化修饰键掩码
+     */
+    static unsigned fromQtModifiers(Qt::KeyboardModifiers modifiers);
+
+    /**
+     * @brief Qt键值转换为Windows虚拟键码
+     * @return 无对应虚拟键码时返回0（按默认规则处理）
+     */
+    static int fromQtKey(int qtKey);
+
+    /**
+     * @brief 把与默认判定不同的Qt按键组合展开为打包组合码（Qt键值 | 修饰键）写入查找表
+     *
+     * KeyboardFilter初始化时调用一次，运行期不再做键码转换
+     */
+    static void buildQtComboTable(KeyComboSet& table);
+
+    /**
+     * @brief 按组合码查询Qt按键判定，未命中时按默认规则
+     */
+    static Verdict qtComboVerdict(const KeyComboSet& table, int qtKey, Qt::KeyboardModifiers modifiers);
+
+    /**
+     * @brief 判定结果名称（仅用于日志）
+     */
+    static const char* verdictName(Verdict v);
+
+    // CEF 75 cef_event_flags_t 取值，cef_client_impl.cpp 中有static_assert校验
+    static constexpr uint32_t kCefShiftDown = 1u << 1;
+    static constexpr uint32_t kCefControlDown = 1u << 2;
+    static constexpr uint32_t kCefAltDown = 1u << 3;
+    static constexpr uint32_t kCefCommandDown = 1u << 7;
+};
+
+/**
+ * @brief 声明式按键规则
+ *
+ * exactModifiers为true时仅匹配给定修饰键；否则匹配所有包含给定修饰键的组合。
+ * 规则按顺序展开，后面的规则覆盖前面的规则。
+ */
+struct KeyPolicyRule {
+    uint8_t vk;
+    uint8_t modifiers;
+    bool exactModifiers;
+    uint8_t entry;
+};
+
+// 常用Windows虚拟键码（避免在公共头文件中包含windows.h）
+namespace KeyPolicyVk {
+    constexpr uint8_t Back = 0x08, Tab = 0x09, Return = 0x0D, Escape = 0x1B, Space = 0x20;
+    constexpr uint8_t Shift = 0x10, Control = 0x11, Menu = 0x12;
+    constexpr uint8_t LShift = 0xA0, RShift = 0xA1, LControl = 0xA2, RControl = 0xA3, LMenu = 0xA4, RMenu = 0xA5;
+    constexpr uint8_t Left = 0x25, Up = 0x26, Right = 0x27, Down = 0x28, Delete = 0x2E;
+    constexpr uint8_t LWin = 0x5B, RWin = 0x5C;
+    constexpr uint8_t F1 = 0x70, F4 = 0x73, F5 = 0x74, F10 = 0x79, F11 = 0x7A, F12 = 0x7B;
+}
+
+constexpr KeyPolicyRule kKeyPolicyRules[] = {
+    // 单独按下的修饰键本身不触发任何操作，任意修饰键状态下均放行
+    { KeyPolicyVk::Shift,    KeyPolicy::MOD_NONE, false, KeyPolicy::VERDICT_ALLOW },
+    { KeyPolicyVk::Control,  KeyPolicy::MOD_NONE, false, KeyPolicy::VERDICT_ALLOW },
+    { KeyPolicyVk::Menu,     KeyPolicy::MOD_NONE, false, KeyPolicy::VERDICT_ALLOW },
+    { KeyPolicyVk::LShift,   KeyPolicy::MOD_NONE, false, KeyPolicy::VERDICT_ALLOW },
+    { KeyPolicyVk::RShift,   KeyPolicy::MOD_NONE, false, KeyPolicy::VERDICT_ALLOW },
+    { KeyPolicyVk::LControl, KeyPolicy::MOD_NONE, false, KeyPolicy::VERDICT_ALLOW },
+    { KeyPolicyVk::RControl, KeyPolicy::MOD_NONE, false, KeyPolicy::VERDICT_ALLOW },
+    { KeyPolicyVk::LMenu,    KeyPolicy::MOD_NONE, false, KeyPolicy::VERDICT_ALLOW },
+    { KeyPolicyVk::RMenu,    KeyPolicy::MOD_NONE, false, KeyPolicy::VERDICT_ALLOW },
+
+    // 基本导航键：任意修饰键均放行（由后续危险规则覆盖例外）
+    { KeyPolicyVk::Back,   KeyPolicy::MOD_NONE, false, KeyPolicy::VERDICT_ALLOW },
+    { KeyPolicyVk::Tab,    KeyPolicy::MOD_NONE, false, KeyPolicy::VERDICT_ALLOW },
+    { KeyPolicyVk::Return, KeyPolicy::MOD_NONE, false, KeyPolicy::VERDICT_ALLOW },
+    { KeyPolicyVk::Escape, KeyPolicy::MOD_NONE, false, KeyPolicy::VERDICT_ALLOW },
+    { KeyPolicyVk::Left,   KeyPolicy::MOD_NONE, false, KeyPolicy::VERDICT_ALLOW },
+    { KeyPolicyVk::Up,     KeyPolicy::MOD_NONE, false, KeyPolicy::VERDICT_ALLOW },
+    { KeyPolicyVk::Right,  KeyPolicy::MOD_NONE, false, KeyPolicy::VERDICT_ALLOW },
+    { KeyPolicyVk::Down,   KeyPolicy::MOD_NONE, false, KeyPolicy::VERDICT_ALLOW },
+    { KeyPolicyVk::Delete, KeyPolicy::MOD_NONE, false, KeyPolicy::VERDICT_ALLOW },
+
+    // 允许的快捷键：刷新（Ctrl+F5原本只在KeyboardFilter的放行列表中，浏览器一直禁止）
+    { 'R',             KeyPolicy::MOD_CTRL,  true, KeyPolicy::VERDICT_ALLOW },
+    { KeyPolicyVk::F5, KeyPolicy::MOD_CTRL,  true, KeyPolicy::VERDICT_ALLOW | KeyPolicy::kWindowOnlyFlag },
+    { KeyPolicyVk::F5, KeyPolicy::MOD_SHIFT, true, KeyPolicy::VERDICT_ALLOW },
+
+    // 安全退出热键
+    { KeyPolicyVk::F10, KeyPolicy::MOD_NONE, true, KeyPolicy::VERDICT_EXIT },
+
+    // 系统按键
+    { KeyPolicyVk::F1,  KeyPolicy::MOD_NONE,  true, KeyPolicy::VERDICT_SYSTEM },   // 帮助
+    { KeyPolicyVk::F5,  KeyPolicy::MOD_NONE,  true, KeyPolicy::VERDICT_SYSTEM },   // 刷新（部分情况）
+    { KeyPolicyVk::F11, KeyPolicy::MOD_NONE,  true, KeyPolicy::VERDICT_SYSTEM },   // 全屏切换
+    { KeyPolicyVk::F11, KeyPolicy::MOD_CTRL,  true, KeyPolicy::VERDICT_SYSTEM },   // 全屏切换
+    { KeyPolicyVk::F12, KeyPolicy::MOD_CTRL,  true, KeyPolicy::VERDICT_SYSTEM },   // 开发者工具
+    { KeyPolicyVk::F10, KeyPolicy::MOD_SHIFT, true, KeyPolicy::VERDICT_SYSTEM },   // 右键菜单
+
+    // 调试按键
+    { 'U',              KeyPolicy::MOD_CTRL,                        true, KeyPolicy::VERDICT_DEBUG },     // 查看源代码
+    { 'U',              KeyPolicy::MOD_CTRL | KeyPolicy::MOD_SHIFT, true, KeyPolicy::VERDICT_DEBUG },     // 查看源代码
+    { KeyPolicyVk::F12, KeyPolicy::MOD_NONE,                        true, KeyPolicy::VERDICT_DEVTOOLS },  // 开发者工具
+    { 'I',              KeyPolicy::MOD_CTRL | KeyPolicy::MOD_SHIFT, true, KeyPolicy::VERDICT_DEVTOOLS },  // 开发者工具
+    { 'J',              KeyPolicy::MOD_CTRL | KeyPolicy::MOD_SHIFT, true, KeyPolicy::VERDICT_DEVTOOLS },  // 控制台
+    { 'C',              KeyPolicy::MOD_CTRL | KeyPolicy::MOD_SHIFT, true, KeyPolicy::VERDICT_DEVTOOLS },  // 元素检查器
+
+    // 危险按键组合
+    { KeyPolicyVk::Tab,    KeyPolicy::MOD_ALT,                        true, KeyPolicy::VERDICT_DANGEROUS },  // 切换应用程序
+    { KeyPolicyVk::F4,     KeyPolicy::MOD_ALT,                        true, KeyPolicy::VERDICT_DANGEROUS },  // 关闭应用程序
+    { KeyPolicyVk::Escape, KeyPolicy::MOD_ALT,                        true, KeyPolicy::VERDICT_DANGEROUS },  // 切换应用程序
+    { KeyPolicyVk::Space,  KeyPolicy::MOD_ALT,                        true, KeyPolicy::VERDICT_DANGEROUS },  // 系统菜单
+    { KeyPolicyVk::Delete, KeyPolicy::MOD_CTRL | KeyPolicy::MOD_ALT,  true, KeyPolicy::VERDICT_DANGEROUS },  // 任务管理器
+    { KeyPolicyVk::F4,     KeyPolicy::MOD_CTRL | KeyPolicy::MOD_ALT,  true, KeyPolicy::VERDICT_DANGEROUS },  // 虚拟终端
+    { KeyPolicyVk::Delete, KeyPolicy::MOD_CTRL | KeyPolicy::MOD_SHIFT, true, KeyPolicy::VERDICT_DANGEROUS }, // 高级启动
+    { 'N',                 KeyPolicy::MOD_CTRL | KeyPolicy::MOD_SHIFT, true, KeyPolicy::VERDICT_DANGEROUS }, // 新建私密窗口
+    { 'W',                 KeyPolicy::MOD_CTRL,                       true, KeyPolicy::VERDICT_DANGEROUS },  // 关闭窗口
+    { 'T',                 KeyPolicy::MOD_CTRL,                       true, KeyPolicy::VERDICT_DANGEROUS },  // 新标签页
+    { 'N',                 KeyPolicy::MOD_CTRL,                       true, KeyPolicy::VERDICT_DANGEROUS },  // 新窗口
+    { KeyPolicyVk::F4,     KeyPolicy::MOD_CTRL,                       true, KeyPolicy::VERDICT_DANGEROUS },  // 关闭标签页
+    { 'L',                 KeyPolicy::MOD_META,                       true, KeyPolicy::VERDICT_DANGEROUS },  // 锁定屏幕
+    { 'D',                 KeyPolicy::MOD_META,                       true, KeyPolicy::VERDICT_DANGEROUS },  // 显示桌面
+    { 'M',                 KeyPolicy::MOD_META,                       true, KeyPolicy::VERDICT_DANGEROUS },  // 最小化所有窗口
+    { 'R',                 KeyPolicy::MOD_META,                       true, KeyPolicy::VERDICT_DANGEROUS },  // 运行对话框
+    { 'X',                 KeyPolicy::MOD_META,                       true, KeyPolicy::VERDICT_DANGEROUS },  // 高级用户菜单
+    { KeyPolicyVk::Tab,    KeyPolicy::MOD_META,                       true, KeyPolicy::VERDICT_DANGEROUS },  // 应用程序切换
+
+    // 系统级钩子拦截：Win键本身（任意修饰键）以及任意包含Ctrl的Esc（开始菜单/任务管理器）
+    // Win键由钩子在系统层吞掉，应用层收到时与其他修饰键一样放行，不再报告为危险按键
+    { KeyPolicyVk::LWin,   KeyPolicy::MOD_NONE, false, KeyPolicy::VERDICT_ALLOW | KeyPolicy::kOsHookFlag },
+    { KeyPolicyVk::RWin,   KeyPolicy::MOD_NONE, false, KeyPolicy::VERDICT_ALLOW | KeyPolicy::kOsHookFlag },
+    { KeyPolicyVk::Escape, KeyPolicy::MOD_CTRL, false, KeyPolicy::VERDICT_DANGEROUS | KeyPolicy::kOsHookFlag },
+};
+
+/**
+ * @brief 编译期生成的稠密策略表
+ */
+struct KeyPolicyTable {
+    uint8_t entries[KeyPolicy::kModifierCombos][KeyPolicy::kKeyCodeCount];
+};
+
+constexpr KeyPolicy::Verdict KeyPolicy::defaultVerdict(unsigned mods)
+{
+    return (mods & ~static_cast<unsigned>(MOD_SHIFT)) ? VERDICT_SHORTCUT : VERDICT_ALLOW;
+}
+
+constexpr KeyPolicyTable buildKeyPolicyTable()
+{
+    KeyPolicyTable table{};
+
+    for (int mods = 0; mods < KeyPolicy::kModifierCombos; ++mods) {
+        const uint8_t fallback = KeyPolicy::defaultVerdict(mods);
+        for (int vk = 0; vk < KeyPolicy::kKeyCodeCount; ++vk) {
+            table.entries[mods][vk] = fallback;
+        }
+    }
+
+    for (const KeyPolicyRule& rule : kKeyPolicyRules) {
+        for (int mods = 0; mods < KeyPolicy::kModifierCombos; ++mods) {
+            const bool matches = rule.exactModifiers ? (mods == rule.modifiers)
+                                                     : ((mods & rule.modifiers) == rule.modifiers);
+            if (matches) {
+                table.entries[mods][rule.vk] = rule.entry;
+            }
+        }
+    }
+
+    return table;
+}
+
+inline constexpr KeyPolicyTable kKeyPolicyTable = buildKeyPolicyTable();
+
+constexpr uint8_t KeyPolicy::entry(int vk, unsigned mods)
+{
+    return kKeyPolicyTable.entries[mods & (kModifierCombos - 1)][static_cast<uint8_t>(vk)];
+}
+
+constexpr KeyPolicy::Verdict KeyPolicy::verdict(int vk, unsigned mods)
+{
+    return static_cast<Verdict>(entry(vk, mods) & kVerdictMask);
+}
+
+constexpr bool KeyPolicy::isAllowed(Verdict v, bool developerMode)
+{
+    return v == VERDICT_ALLOW || v == VERDICT_EXIT || (developerMode && v == VERDICT_DEVTOOLS);
+}
+
+constexpr bool KeyPolicy::isAllowedInBrowser(int vk, unsigned mods, bool developerMode)
+{
+    return (entry(vk, mods) & kWindowOnlyFlag) == 0
+        && (isAllowed(verdict(vk, mods), developerMode)
+            || (verdict(vk, mods) == VERDICT_SYSTEM && (mods & ~static_cast<unsigned>(MOD_SHIFT)) == 0));
+}
+
+constexpr bool KeyPolicy::isAllowedInWindow(Verdict v, bool developerMode)
+{
+    return isAllowed(v, developerMode) || v == VERDICT_SHORTCUT;
+}
+
+constexpr bool KeyPolicy::requiresOsHook(int vk, unsigned mods)
+{
+    return (entry(vk, mods) & kOsHookFlag) != 0;
+}
+
+constexpr unsigned KeyPolicy::fromCefModifiers(uint32_t flags)
+{
+    return ((flags & kCefShiftDown) ? static_cast<unsigned>(MOD_SHIFT) : 0u)
+         | ((flags & kCefControlDown) ? static_cast<unsigned>(MOD_CTRL) : 0u)
+         | ((flags & kCefAltDown) ? static_cast<unsigned>(MOD_ALT) : 0u)
+         | ((flags & kCefCommandDown) ? static_cast<unsigned>(MOD_META) : 0u);
+}
+
+constexpr unsigned KeyPolicy::fromHookModifiers(bool ctrl, bool alt, bool shift, bool win)
+{
+    return (ctrl ? static_cast<unsigned>(MOD_CTRL) : 0u)
+         | (alt ? static_cast<unsigned>(MOD_ALT) : 0u)
+         | (shift ? static_cast<unsigned>(MOD_SHIFT) : 0u)
+         | (win ? static_cast<unsigned>(MOD_META) : 0u);
+}
+
+// 编译期一致性校验：三处过滤器依赖的关键判定
+static_assert(KeyPolicy::verdict('R', KeyPolicy::MOD_CTRL) == KeyPolicy::VERDICT_ALLOW, "Ctrl+R必须放行");
+static_assert(KeyPolicy::verdict('A', KeyPolicy::MOD_SHIFT) == KeyPolicy::VERDICT_ALLOW, "Shift+字符必须放行");
+static_assert(KeyPolicy::verdict(0x60, KeyPolicy::fromCefModifiers((1u << 8) | (1u << 9))) == KeyPolicy::VERDICT_ALLOW,
+              "NumLock下的小键盘数字必须放行");
+static_assert(KeyPolicy::verdict('C', KeyPolicy::MOD_CTRL) == KeyPolicy::VERDICT_SHORTCUT, "未列出的Ctrl组合默认禁止");
+static_assert(KeyPolicy::verdict(KeyPolicyVk::Tab, KeyPolicy::MOD_ALT) == KeyPolicy::VERDICT_DANGEROUS, "Alt+Tab必须禁止");
+static_assert(KeyPolicy::verdict(KeyPolicyVk::F10, KeyPolicy::MOD_NONE) == KeyPolicy::VERDICT_EXIT, "F10为安全退出热键");
+static_assert(KeyPolicy::requiresOsHook(KeyPolicyVk::LWin, KeyPolicy::MOD_NONE), "Win键需系统级拦截");
+static_assert(KeyPolicy::requiresOsHook(KeyPolicyVk::Escape, KeyPolicy::MOD_CTRL | KeyPolicy::MOD_SHIFT), "Ctrl+Shift+Esc需系统级拦截");
+static_assert(!KeyPolicy::requiresOsHook(KeyPolicyVk::Escape, KeyPolicy::MOD_NONE), "单独Esc不应被系统级拦截");
+static_assert(!KeyPolicy::requiresOsHook(KeyPolicyVk::Tab, KeyPolicy::MOD_ALT), "系统级钩子仅拦截Win键与Ctrl+Esc");
+static_assert(KeyPolicy::verdict(KeyPolicyVk::Control, KeyPolicy::MOD_CTRL) == KeyPolicy::VERDICT_ALLOW, "单独按下Ctrl必须放行");
+static_assert(KeyPolicy::verdict(KeyPolicyVk::LWin, KeyPolicy::MOD_META) == KeyPolicy::VERDICT_ALLOW, "Win键在应用层不报危险");
+static_assert(KeyPolicy::isAllowedInBrowser(KeyPolicyVk::F5, KeyPolicy::MOD_NONE, false), "浏览器路径沿用原白名单放行F5");
+static_assert(!KeyPolicy::isAllowedInBrowser(KeyPolicyVk::F11, KeyPolicy::MOD_CTRL, false), "浏览器路径禁止Ctrl+F11");
+static_assert(!KeyPolicy::isAllowedInBrowser(KeyPolicyVk::F5, KeyPolicy::MOD_CTRL, false), "浏览器路径沿用原白名单禁止Ctrl+F5");
+static_assert(KeyPolicy::isAllowedInWindow(KeyPolicy::verdict('V', KeyPolicy::MOD_CTRL), false), "Qt窗口路径放行未列出的快捷键");
+static_assert(!KeyPolicy::isAllowedInWindow(KeyPolicy::verdict(KeyPolicyVk::F5, KeyPolicy::MOD_NONE), false), "Qt窗口路径沿用原黑名单拦截F5");
+
+#endif // KEY_POLICY_H
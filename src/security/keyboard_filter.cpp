@@ -53,108 +53,54 @@ bool KeyboardFilter::shouldFilterKeyEvent(QKeyEvent* event)
     }
     
     m_totalKeyEvents++;
+    return evaluateKeyEvent(event);
+}
+
+bool KeyboardFilter::evaluateKeyEvent(QKeyEvent* event)
+{
+    // 查询统一按键策略表（与CEFClient、WindowsKeyBlocker共用）
+    const KeyPolicy::Verdict verdict = policyVerdict(event->key(), event->modifiers());
     
-    int key = event->key();
-    Qt::KeyboardModifiers modifiers = event->modifiers();
-    
-    // 检查是否为安全退出热键
-    if (isSecurityExitHotkey(event)) {
-        emit securityExitRequested();
-        return false; // 不过滤安全退出热键
-    }
-    
-    // 检查是否为允许的功能键
-    if (isAllowedFunctionKey(event)) {
-        return false;
-    }
-    
-    // 检查危险按键组合
-    if (isDangerousKeyCombo(key, modifiers)) {
-        m_filteredKeyEvents++;
-        QString keyDesc = getKeyDescription(event);
-        logFilterEvent(QString("过滤危险按键: %1").arg(keyDesc), true);
-        emit dangerousKeyDetected(keyDesc);
-        return true;
-    }
-    
-    // 检查系统按键组合
-    if (isSystemKeyCombo(key, modifiers)) {
-        m_filteredKeyEvents++;
-        QString keyDesc = getKeyDescription(event);
-        logFilterEvent(QString("过滤系统按键: %1").arg(keyDesc), true);
-        return true;
-    }
-    
-    // 检查调试按键组合（在开发者模式下允许部分调试按键）
-    if (isDebugKeyCombo(key, modifiers)) {
-        // 开发者模式下允许F12和部分调试按键
-        if (m_developerModeEnabled && (key == Qt::Key_F12 || 
-                                       (key == Qt::Key_I && modifiers == (Qt::ControlModifier | Qt::ShiftModifier)) ||
-                                       (key == Qt::Key_J && modifiers == (Qt::ControlModifier | Qt::ShiftModifier)) ||
-                                       (key == Qt::Key_C && modifiers == (Qt::ControlModifier | Qt::ShiftModifier)))) {
-            logFilterEvent(QString("开发者模式允许调试按键: %1").arg(getKeyDescription(event)), false);
+    switch (verdict) {
+        case KeyPolicy::VERDICT_ALLOW:
+        case KeyPolicy::VERDICT_SHORTCUT:
+            // Qt窗口只拦截明确列出的组合，未列出的快捷键（对话框中的复制粘贴等）放行，
+            // 见 KeyPolicy::isAllowedInWindow
             return false;
-        }
         
-        m_filteredKeyEvents++;
-        QString keyDesc = getKeyDescription(event);
-        logFilterEvent(QString("过滤调试按键: %1").arg(keyDesc), true);
-        return true;
+        case KeyPolicy::VERDICT_EXIT:
+            emit securityExitRequested();
+            return false; // 不过滤安全退出热键
+        
+        case KeyPolicy::VERDICT_DEVTOOLS:
+            // 开发者模式下允许F12和部分调试按键
+            if (m_developerModeEnabled) {
+                logFilterEvent(event, verdict, false);
+                return false;
+            }
+            break;
+        
+        default:
+            break;
     }
     
-    return false;
+    m_filteredKeyEvents++;
+    logFilterEvent(event, verdict, true);
+    
+    if (verdict == KeyPolicy::VERDICT_DANGEROUS) {
+        emit dangerousKeyDetected(getKeyDescription(event));
+    }
+    return true;
 }
 
 bool KeyboardFilter::isSecurityExitHotkey(QKeyEvent* event)
 {
-    int key = event->key();
-    Qt::KeyboardModifiers modifiers = event->modifiers();
-    
-    // F10 单独按下
-    if (key == Qt::Key_F10 && modifiers == Qt::NoModifier) {
-        return true;
-    }
-    
-    return false;
+    return policyVerdict(event->key(), event->modifiers()) == KeyPolicy::VERDICT_EXIT;
 }
 
 bool KeyboardFilter::isAllowedFunctionKey(QKeyEvent* event)
 {
-    int key = event->key();
-    Qt::KeyboardModifiers modifiers = event->modifiers();
-    
-    // 允许 Ctrl+R 刷新
-    if (key == Qt::Key_R && modifiers == Qt::ControlModifier) {
-        return true;
-    }
-    
-    // 允许单纯的 Shift 修饰键（与原项目逻辑一致）
-    if (key >= Qt::Key_Shift && key <= Qt::Key_ScrollLock && modifiers == Qt::ShiftModifier) {
-        return true;
-    }
-    
-    // 允许基本的导航键
-    if (modifiers == Qt::NoModifier) {
-        switch (key) {
-            case Qt::Key_Tab:
-            case Qt::Key_Return:
-            case Qt::Key_Enter:
-            case Qt::Key_Space:
-            case Qt::Key_Backspace:
-            case Qt::Key_Delete:
-            case Qt::Key_Left:
-            case Qt::Key_Right:
-            case Qt::Key_Up:
-            case Qt::Key_Down:
-            case Qt::Key_Home:
-            case Qt::Key_End:
-            case Qt::Key_PageUp:
-            case Qt::Key_PageDown:
-                return true;
-        }
-    }
-    
-    return false;
+    return policyVerdict(event->key(), event->modifiers()) == KeyPolicy::VERDICT_ALLOW;
 }
 
 void KeyboardFilter::setFilterEnabled(bool enabled)
@@ -204,63 +150,13 @@ void KeyboardFilter::updateStatistics()
 
 void KeyboardFilter::initializeFilterRules()
 {
-    // 危险按键组合（完全禁止）
-    m_dangerousKeyCombos.clear();
-    
-    // Alt + 危险键
-    m_dangerousKeyCombos << "Alt+Tab"      // 切换应用程序
-                         << "Alt+F4"       // 关闭应用程序
-                         << "Alt+Esc"      // 切换应用程序
-                         << "Alt+Space";   // 系统菜单
-    
-    // Ctrl + Alt + 危险键
-    m_dangerousKeyCombos << "Ctrl+Alt+Del"    // 任务管理器
-                         << "Ctrl+Alt+Esc"    // 任务管理器
-                         << "Ctrl+Alt+F4";    // 虚拟终端
-    
-    // Ctrl + Shift + 危险键
-    m_dangerousKeyCombos << "Ctrl+Shift+Esc"  // 任务管理器
-                         << "Ctrl+Shift+Del"  // 高级启动
-                         << "Ctrl+Shift+N";   // 新建私密窗口
-    
-    // Windows 键组合
-    m_dangerousKeyCombos << "Meta+L"      // 锁定屏幕
-                         << "Meta+D"      // 显示桌面
-                         << "Meta+M"      // 最小化所有窗口
-                         << "Meta+R"      // 运行对话框
-                         << "Meta+X"      // 高级用户菜单
-                         << "Meta+Tab";   // 应用程序切换
+    // 过滤规则统一定义在 key_policy.h 的 kKeyPolicyRules 中；
+    // 这里把与默认判定不同的Qt按键组合预先展开为打包整数码（Qt键值 | 修饰键），
+    // 运行期查找不再做键码转换，也不构造QKeySequence字符串
+    KeyPolicy::buildQtComboTable(m_comboVerdicts);
     
-    // 系统按键组合
-    m_systemKeyCombos.clear();
-    m_systemKeyCombos << "F1"           // 帮助
-                      << "F5"           // 刷新（部分情况）
-                      << "F11"          // 全屏切换
-                      << "F12"          // 开发者工具
-                      << "Ctrl+F11"     // 全屏切换
-                      << "Ctrl+F12"     // 开发者工具
-                      << "Shift+F10";   // 右键菜单
-    
-    // 调试按键组合
-    m_debugKeyCombos.clear();
-    m_debugKeyCombos << "Ctrl+Shift+I"    // 开发者工具
-                     << "Ctrl+Shift+J"    // 控制台
-                     << "Ctrl+Shift+C"    // 元素检查器
-                     << "Ctrl+U"          // 查看源代码
-                     << "Ctrl+Shift+U"    // 查看源代码
-                     << "F12";            // 开发者工具
-    
-    // 允许的按键组合
-    m_allowedKeyCombos.clear();
-    m_allowedKeyCombos << "Ctrl+R"        // 刷新页面
-                       << "Ctrl+F5"       // 强制刷新
-                       << "Shift+F5";     // 强制刷新
-    
-    // 安全退出热键
-    m_exitHotkeys.clear();
-    m_exitHotkeys << "F10";
-    
-    m_logger->appEvent(QString("键盘过滤规则初始化完成，危险组合: %1个").arg(m_dangerousKeyCombos.size()));
+    m_logger->appEvent(QString("键盘过滤规则初始化完成，非默认组合: %1个，查找表容量: %2")
+        .arg(m_comboVerdicts.size()).arg(m_comboVerdicts.capacity()));
 }
 
 void KeyboardFilter::initializeStatisticsTimer()
@@ -272,22 +168,9 @@ void KeyboardFilter::initializeStatisticsTimer()
     m_logger->appEvent("键盘统计定时器启动");
 }
 
-bool KeyboardFilter::isDangerousKeyCombo(int key, Qt::KeyboardModifiers modifiers)
+KeyPolicy::Verdict KeyboardFilter::policyVerdict(int key, Qt::KeyboardModifiers modifiers) const
 {
-    QString combo = getKeyDescription(key, modifiers);
-    return m_dangerousKeyCombos.contains(combo);
-}
-
-bool KeyboardFilter::isSystemKeyCombo(int key, Qt::KeyboardModifiers modifiers)
-{
-    QString combo = getKeyDescription(key, modifiers);
-    return m_systemKeyCombos.contains(combo);
-}
-
-bool KeyboardFilter::isDebugKeyCombo(int key, Qt::KeyboardModifiers modifiers)
-{
-    QString combo = getKeyDescription(key, modifiers);
-    return m_debugKeyCombos.contains(combo);
+    return KeyPolicy::qtComboVerdict(m_comboVerdicts, key, modifiers);
 }
 
 QString KeyboardFilter::getKeyDescription(QKeyEvent* event)
@@ -312,9 +195,13 @@ bool KeyboardFilter::isDeveloperModeEnabled() const
     return m_developerModeEnabled;
 }
 
-void KeyboardFilter::logFilterEvent(const QString& description, bool filtered)
+void KeyboardFilter::logFilterEvent(QKeyEvent* event, KeyPolicy::Verdict verdict, bool filtered)
 {
+    // 仅在实际写日志时才生成按键描述
     if (m_logger->getLogLevel() <= L_DEBUG) {
+        const QString description = filtered
+            ? QString("过滤%1: %2").arg(KeyPolicy::verdictName(verdict)).arg(getKeyDescription(event))
+            : QString("开发者模式允许调试按键: %1").arg(getKeyDescription(event));
         m_logger->logEvent("键盘过滤", description, "keyboard.log", L_DEBUG);
     }
-}
\ No newline at end of file
+}
@@ -4,9 +4,11 @@
 #include <QObject>
 #include <QKeyEvent>
 #include <QStringList>
-#include <QSet>
 #include <QTimer>
 
+#include "key_policy.h"
+#include "key_combo_set.h"
+
 class Logger;
 class ConfigManager;
 
@@ -14,7 +16,7 @@ class ConfigManager;
  * @brief 键盘过滤器类
  * 
  * 负责拦截和过滤危险的键盘组合，防止用户绕过安全控制
- * 与原项目的键盘拦截逻辑保持一致
+ * 判定规则来自统一按键策略表（KeyPolicy），与CEFClient、WindowsKeyBlocker保持一致
  */
 class KeyboardFilter : public QObject
 {
@@ -101,14 +103,13 @@ signals:
     void securityExitRequested();
 
 private:
+    bool evaluateKeyEvent(QKeyEvent* event);
     void initializeFilterRules();
     void initializeStatisticsTimer();
-    bool isDangerousKeyCombo(int key, Qt::KeyboardModifiers modifiers);
-    bool isSystemKeyCombo(int key, Qt::KeyboardModifiers modifiers);
-    bool isDebugKeyCombo(int key, Qt::KeyboardModifiers modifiers);
+    KeyPolicy::Verdict policyVerdict(int key, Qt::KeyboardModifiers modifiers) const;
     QString getKeyDescription(QKeyEvent* event);
     QString getKeyDescription(int key, Qt::KeyboardModifiers modifiers);
-    void logFilterEvent(const QString& description, bool filtered);
+    void logFilterEvent(QKeyEvent* event, KeyPolicy::Verdict verdict, bool filtered);
 
 private:
     Logger* m_logger;
@@ -119,21 +120,13 @@ private:
     bool m_strictMode;
     bool m_developerModeEnabled;
     
-    // 危险按键组合集合
-    QSet<QString> m_dangerousKeyCombos;
-    QSet<QString> m_systemKeyCombos;
-    QSet<QString> m_debugKeyCombos;
-    
-    // 允许的按键组合
-    QSet<QString> m_allowedKeyCombos;
+    // 非默认判定的按键组合（打包整数码 -> 判定），initializeFilterRules中一次性构建
+    KeyComboSet m_comboVerdicts;
     
     // 统计信息
     int m_totalKeyEvents;
     int m_filteredKeyEvents;
     QTimer* m_statisticsTimer;
-    
-    // 安全退出热键
-    QStringList m_exitHotkeys;
 };
 
 #endif // KEYBOARD_FILTER_H
\ No newline at end of file
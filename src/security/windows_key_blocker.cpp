@@ -1,5 +1,6 @@
 #include "windows_key_blocker.h"
 #include "../logging/logger.h"
+#include "key_policy.h"
 
 #ifdef Q_OS_WIN
 
@@ -309,10 +310,17 @@ LRESULT CALLBACK WindowsKeyBlocker::LowLevelKeyboardProc(
 
         const bool ctrlPressed = s_instance
             && (s_instance->m_leftCtrlPressed || s_instance->m_rightCtrlPressed);
+
+        // 归一化修饰键后查询统一按键策略表，仅拦截标记为系统级的组合
+        // （左右Win键、Ctrl+Esc；其余组合由应用层CEFClient/KeyboardFilter处理）
+        const unsigned mods = KeyPolicy::fromHookModifiers(
+            ctrlPressed,
+            (pKeyboard->flags & LLKHF_ALTDOWN) != 0,
+            (GetAsyncKeyState(VK_SHIFT) & 0x8000) != 0,
+            ((GetAsyncKeyState(VK_LWIN) | GetAsyncKeyState(VK_RWIN)) & 0x8000) != 0);
         const bool ctrlEsc = (pKeyboard->vkCode == VK_ESCAPE) && ctrlPressed;
 
-        // 拦截左右Win键（VK_LWIN=0x5B, VK_RWIN=0x5C）以及 Ctrl+Esc
-        if (pKeyboard->vkCode == VK_LWIN || pKeyboard->vkCode == VK_RWIN || ctrlEsc) {
+        if (KeyPolicy::requiresOsHook(static_cast<int>(pKeyboard->vkCode), mods)) {
             if (s_instance && s_instance->m_logger) {
                 if (isKeyDown) {
                     s_instance->m_blockedCount++;
@@ -0,0 +1,167 @@
+#include "../src/security/keyboard_filter.h"
+#include "../src/security/key_policy.h"
+#include "../src/security/key_combo_set.h"
+#include "../src/logging/logger.h"
+
+#include <QKeyEvent>
+#include <QKeySequence>
+#include <QSet>
+#include <QVector>
+#include <QtTest>
+
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 键盘过滤判定基准测试（手动运行，不加入ctest）
+ *
+ * 主要测量KeyboardFilter::shouldFilterKeyEvent对真实QKeyEvent的单次耗时，
+ * 包括修饰键归一化、判定分支、统计计数和日志分支（日志级别为INFO时只做级别判断，
+ * DEBUG时实际生成描述并写日志）。另外对比判定所用的组合码查找、直接查稠密表，
+ * 以及改造前逐次构造QKeySequence字符串再查集合的做法。
+ * 输入为一组常见按键（普通字符、功能键、被拦截的组合）循环判定。
+ *
+ * 运行：key_filter_benchmark -platform offscreen -iterations 1000
+ */
+class KeyFilterBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void filterKeyEvent();
+    void filterKeyEventWithDebugLogging();
+    void comboTableLookup();
+    void denseTableLookup();
+    void keySequenceStringLookup();
+
+private:
+    struct KeyInput {
+        int key;
+        Qt::KeyboardModifiers modifiers;
+    };
+
+    int runFilter();
+
+    QVector<KeyInput> m_inputs;
+    std::vector<std::unique_ptr<QKeyEvent>> m_events;
+    std::unique_ptr<KeyboardFilter> m_filter;
+    LogLevel m_savedLogLevel = L_INFO;
+    KeyComboSet m_comboVerdicts;
+    QSet<QString> m_blockedSequences;
+};
+
+void KeyFilterBenchmark::initTestCase()
+{
+    m_inputs = {
+        { Qt::Key_A, Qt::NoModifier },
+        { Qt::Key_B, Qt::ShiftModifier },
+        { Qt::Key_5, Qt::NoModifier },
+        { Qt::Key_Space, Qt::NoModifier },
+        { Qt::Key_Backspace, Qt::NoModifier },
+        { Qt::Key_Left, Qt::NoModifier },
+        { Qt::Key_F5, Qt::NoModifier },
+        { Qt::Key_Tab, Qt::AltModifier },
+        { Qt::Key_F4, Qt::AltModifier },
+        { Qt::Key_C, Qt::ControlModifier },
+        { Qt::Key_I, Qt::ControlModifier | Qt::ShiftModifier },
+        { Qt::Key_Q, Qt::ControlModifier | Qt::AltModifier | Qt::ShiftModifier },
+    };
+
+    // 事件对象预先构造，计时只包含过滤器本身
+    for (const KeyInput& input : m_inputs) {
+        m_events.emplace_back(new QKeyEvent(QEvent::KeyPress, input.key, input.modifiers));
+    }
+
+    m_savedLogLevel = Logger::instance().getLogLevel();
+    m_filter.reset(new KeyboardFilter);
+    m_filter->initialize();
+    m_filter->setFilterEnabled(true);
+
+    KeyPolicy::buildQtComboTable(m_comboVerdicts);
+
+    // 改造前的做法：被拦截组合以字符串集合保存
+    m_blockedSequences = {
+        "Alt+Tab", "Alt+F4", "Ctrl+Shift+I", "Ctrl+Shift+J", "Ctrl+U", "F5", "F11", "F12"
+    };
+}
+
+void KeyFilterBenchmark::cleanupTestCase()
+{
+    m_filter.reset();
+    Logger::instance().setLogLevel(m_savedLogLevel);
+}
+
+int KeyFilterBenchmark::runFilter()
+{
+    int filtered = 0;
+    for (const std::unique_ptr<QKeyEvent>& event : m_events) {
+        filtered += m_filter->shouldFilterKeyEvent(event.get()) ? 1 : 0;
+    }
+    return filtered;
+}
+
+void KeyFilterBenchmark::filterKeyEvent()
+{
+    // 考试期间的常规日志级别：过滤日志只做一次级别判断
+    Logger::instance().setLogLevel(L_INFO);
+    int filtered = 0;
+    QBENCHMARK {
+        filtered += runFilter();
+    }
+    QVERIFY(filtered > 0);
+}
+
+void KeyFilterBenchmark::filterKeyEventWithDebugLogging()
+{
+    // 调试日志级别：被过滤的按键生成描述并写入keyboard.log
+    Logger::instance().setLogLevel(L_DEBUG);
+    int filtered = 0;
+    QBENCHMARK {
+        filtered += runFilter();
+    }
+    Logger::instance().setLogLevel(m_savedLogLevel);
+    QVERIFY(filtered > 0);
+}
+
+void KeyFilterBenchmark::comboTableLookup()
+{
+    int filtered = 0;
+    QBENCHMARK {
+        for (const KeyInput& input : m_inputs) {
+            const KeyPolicy::Verdict verdict = KeyPolicy::qtComboVerdict(m_comboVerdicts, input.key, input.modifiers);
+            filtered += KeyPolicy::isAllowedInWindow(verdict, false) ? 0 : 1;
+        }
+    }
+    QVERIFY(filtered > 0);
+}
+
+void KeyFilterBenchmark::denseTableLookup()
+{
+    int filtered = 0;
+    QBENCHMARK {
+        for (const KeyInput& input : m_inputs) {
+            const KeyPolicy::Verdict verdict = KeyPolicy::verdict(
+                KeyPolicy::fromQtKey(input.key), KeyPolicy::fromQtModifiers(input.modifiers));
+            filtered += KeyPolicy::isAllowedInWindow(verdict, false) ? 0 : 1;
+        }
+    }
+    QVERIFY(filtered > 0);
+}
+
+void KeyFilterBenchmark::keySequenceStringLookup()
+{
+    int filtered = 0;
+    QBENCHMARK {
+        for (const KeyInput& input : m_inputs) {
+            const QString sequence = QKeySequence(input.key | input.modifiers).toString(QKeySequence::PortableText);
+            filtered += m_blockedSequences.contains(sequence) ? 1 : 0;
+        }
+    }
+    QVERIFY(filtered > 0);
+}
+
+// KeyboardFilter依赖的Logger/ConfigManager使用Widgets，按键描述需要QGuiApplication
+QTEST_MAIN(KeyFilterBenchmark)
+#include "key_filter_benchmark.moc"
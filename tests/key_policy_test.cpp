@@ -0,0 +1,281 @@
+#include "../src/security/key_policy.h"
+#include "../src/security/key_combo_set.h"
+
+#include <QtTest>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#endif
+
+/**
+ * @brief 统一按键策略测试
+ *
+ * 表内规则已有static_assert覆盖，这里检查表外的映射：
+ * Qt键值到虚拟键码、三条拦截路径各自的放行语义、低级钩子修饰键归一化，
+ * 以及KeyboardFilter实际查询的Qt组合码表与稠密表逐项一致。
+ */
+class KeyPolicyTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void fromQtKey_data();
+    void fromQtKey();
+    void fromQtModifiers();
+    void bareModifiersAllowed();
+    void browserPath_data();
+    void browserPath();
+    void windowPath_data();
+    void windowPath();
+    void qtComboTableMatchesDenseTable();
+    void hookModifiers();
+    void hookInterceptsWinAndCtrlEsc();
+    void virtualKeysMatchWindows();
+};
+
+void KeyPolicyTest::fromQtKey_data()
+{
+    QTest::addColumn<int>("qtKey");
+    QTest::addColumn<int>("vk");
+
+    QTest::newRow("A") << int(Qt::Key_A) << 0x41;
+    QTest::newRow("Z") << int(Qt::Key_Z) << 0x5A;
+    QTest::newRow("0") << int(Qt::Key_0) << 0x30;
+    QTest::newRow("9") << int(Qt::Key_9) << 0x39;
+    QTest::newRow("Space") << int(Qt::Key_Space) << 0x20;
+    QTest::newRow("F1") << int(Qt::Key_F1) << 0x70;
+    QTest::newRow("F5") << int(Qt::Key_F5) << 0x74;
+    QTest::newRow("F12") << int(Qt::Key_F12) << 0x7B;
+    QTest::newRow("F24") << int(Qt::Key_F24) << 0x87;
+    QTest::newRow("Escape") << int(Qt::Key_Escape) << 0x1B;
+    QTest::newRow("Tab") << int(Qt::Key_Tab) << 0x09;
+    QTest::newRow("Backtab") << int(Qt::Key_Backtab) << 0x09;
+    QTest::newRow("Backspace") << int(Qt::Key_Backspace) << 0x08;
+    QTest::newRow("Return") << int(Qt::Key_Return) << 0x0D;
+    QTest::newRow("Enter") << int(Qt::Key_Enter) << 0x0D;
+    QTest::newRow("Insert") << int(Qt::Key_Insert) << 0x2D;
+    QTest::newRow("Delete") << int(Qt::Key_Delete) << 0x2E;
+    QTest::newRow("Pause") << int(Qt::Key_Pause) << 0x13;
+    QTest::newRow("Print") << int(Qt::Key_Print) << 0x2C;
+    QTest::newRow("Home") << int(Qt::Key_Home) << 0x24;
+    QTest::newRow("End") << int(Qt::Key_End) << 0x23;
+    QTest::newRow("Left") << int(Qt::Key_Left) << 0x25;
+    QTest::newRow("Up") << int(Qt::Key_Up) << 0x26;
+    QTest::newRow("Right") << int(Qt::Key_Right) << 0x27;
+    QTest::newRow("Down") << int(Qt::Key_Down) << 0x28;
+    QTest::newRow("PageUp") << int(Qt::Key_PageUp) << 0x21;
+    QTest::newRow("PageDown") << int(Qt::Key_PageDown) << 0x22;
+    QTest::newRow("Shift") << int(Qt::Key_Shift) << 0x10;
+    QTest::newRow("Control") << int(Qt::Key_Control) << 0x11;
+    QTest::newRow("Alt") << int(Qt::Key_Alt) << 0x12;
+    QTest::newRow("Meta") << int(Qt::Key_Meta) << 0x5B;
+    QTest::newRow("CapsLock") << int(Qt::Key_CapsLock) << 0x14;
+    QTest::newRow("NumLock") << int(Qt::Key_NumLock) << 0x90;
+    QTest::newRow("ScrollLock") << int(Qt::Key_ScrollLock) << 0x91;
+    QTest::newRow("Menu") << int(Qt::Key_Menu) << 0x5D;
+    QTest::newRow("未映射") << int(Qt::Key_Launch0) << 0;
+}
+
+void KeyPolicyTest::fromQtKey()
+{
+    QFETCH(int, qtKey);
+    QFETCH(int, vk);
+    QCOMPARE(KeyPolicy::fromQtKey(qtKey), vk);
+}
+
+void KeyPolicyTest::fromQtModifiers()
+{
+    QCOMPARE(KeyPolicy::fromQtModifiers(Qt::NoModifier), unsigned(KeyPolicy::MOD_NONE));
+    QCOMPARE(KeyPolicy::fromQtModifiers(Qt::ControlModifier | Qt::AltModifier),
+             unsigned(KeyPolicy::MOD_CTRL | KeyPolicy::MOD_ALT));
+    QCOMPARE(KeyPolicy::fromQtModifiers(Qt::ShiftModifier | Qt::MetaModifier),
+             unsigned(KeyPolicy::MOD_SHIFT | KeyPolicy::MOD_META));
+    // 小键盘标志不参与判定
+    QCOMPARE(KeyPolicy::fromQtModifiers(Qt::KeypadModifier), unsigned(KeyPolicy::MOD_NONE));
+}
+
+void KeyPolicyTest::bareModifiersAllowed()
+{
+    // 按下修饰键时，修饰键本身的标志已经置位
+    QCOMPARE(KeyPolicy::verdict(KeyPolicy::fromQtKey(Qt::Key_Control), KeyPolicy::MOD_CTRL), KeyPolicy::VERDICT_ALLOW);
+    QCOMPARE(KeyPolicy::verdict(KeyPolicy::fromQtKey(Qt::Key_Alt), KeyPolicy::MOD_ALT), KeyPolicy::VERDICT_ALLOW);
+    QCOMPARE(KeyPolicy::verdict(KeyPolicy::fromQtKey(Qt::Key_Shift), KeyPolicy::MOD_SHIFT), KeyPolicy::VERDICT_ALLOW);
+    QCOMPARE(KeyPolicy::verdict(KeyPolicy::fromQtKey(Qt::Key_Meta), KeyPolicy::MOD_META), KeyPolicy::VERDICT_ALLOW);
+    QCOMPARE(KeyPolicy::verdict(KeyPolicyVk::LControl, KeyPolicy::MOD_CTRL | KeyPolicy::MOD_SHIFT), KeyPolicy::VERDICT_ALLOW);
+    QCOMPARE(KeyPolicy::verdict(KeyPolicyVk::RMenu, KeyPolicy::MOD_CTRL | KeyPolicy::MOD_ALT), KeyPolicy::VERDICT_ALLOW);
+}
+
+void KeyPolicyTest::browserPath_data()
+{
+    QTest::addColumn<int>("vk");
+    QTest::addColumn<unsigned>("mods");
+    QTest::addColumn<bool>("developerMode");
+    QTest::addColumn<bool>("allowed");
+
+    // 原CEFClient白名单：无修饰键或仅Shift的按键、Ctrl+R、导航键放行
+    QTest::newRow("F1") << 0x70 << unsigned(KeyPolicy::MOD_NONE) << false << true;
+    QTest::newRow("F5") << 0x74 << unsigned(KeyPolicy::MOD_NONE) << false << true;
+    QTest::newRow("F11") << 0x7A << unsigned(KeyPolicy::MOD_NONE) << false << true;
+    QTest::newRow("Shift+F10") << 0x79 << unsigned(KeyPolicy::MOD_SHIFT) << false << true;
+    QTest::newRow("Ctrl+R") << int('R') << unsigned(KeyPolicy::MOD_CTRL) << false << true;
+    QTest::newRow("Shift+F5") << 0x74 << unsigned(KeyPolicy::MOD_SHIFT) << false << true;
+    QTest::newRow("Ctrl+F5") << 0x74 << unsigned(KeyPolicy::MOD_CTRL) << false << false;
+    QTest::newRow("Ctrl+Left") << 0x25 << unsigned(KeyPolicy::MOD_CTRL) << false << true;
+    QTest::newRow("Ctrl") << 0x11 << unsigned(KeyPolicy::MOD_CTRL) << false << true;
+    QTest::newRow("Ctrl+C") << int('C') << unsigned(KeyPolicy::MOD_CTRL) << false << false;
+    QTest::newRow("Ctrl+F11") << 0x7A << unsigned(KeyPolicy::MOD_CTRL) << false << false;
+    QTest::newRow("Alt+F4") << 0x73 << unsigned(KeyPolicy::MOD_ALT) << false << false;
+    QTest::newRow("Ctrl+Shift+I") << int('I') << unsigned(KeyPolicy::MOD_CTRL | KeyPolicy::MOD_SHIFT) << false << false;
+    QTest::newRow("F12") << 0x7B << unsigned(KeyPolicy::MOD_NONE) << false << false;
+    QTest::newRow("F12（开发者模式）") << 0x7B << unsigned(KeyPolicy::MOD_NONE) << true << true;
+}
+
+void KeyPolicyTest::browserPath()
+{
+    QFETCH(int, vk);
+    QFETCH(unsigned, mods);
+    QFETCH(bool, developerMode);
+    QFETCH(bool, allowed);
+    QCOMPARE(KeyPolicy::isAllowedInBrowser(vk, mods, developerMode), allowed);
+}
+
+void KeyPolicyTest::windowPath_data()
+{
+    QTest::addColumn<int>("qtKey");
+    QTest::addColumn<int>("qtModifiers");
+    QTest::addColumn<bool>("allowed");
+
+    // 原KeyboardFilter黑名单：只拦截列出的组合
+    QTest::newRow("Ctrl+C") << int(Qt::Key_C) << int(Qt::ControlModifier) << true;
+    QTest::newRow("Ctrl+V") << int(Qt::Key_V) << int(Qt::ControlModifier) << true;
+    QTest::newRow("Ctrl") << int(Qt::Key_Control) << int(Qt::ControlModifier) << true;
+    QTest::newRow("Alt") << int(Qt::Key_Alt) << int(Qt::AltModifier) << true;
+    QTest::newRow("F1") << int(Qt::Key_F1) << int(Qt::NoModifier) << false;
+    QTest::newRow("F5") << int(Qt::Key_F5) << int(Qt::NoModifier) << false;
+    QTest::newRow("Ctrl+F5") << int(Qt::Key_F5) << int(Qt::ControlModifier) << true;
+    QTest::newRow("F11") << int(Qt::Key_F11) << int(Qt::NoModifier) << false;
+    QTest::newRow("Alt+Tab") << int(Qt::Key_Tab) << int(Qt::AltModifier) << false;
+    QTest::newRow("Alt+F4") << int(Qt::Key_F4) << int(Qt::AltModifier) << false;
+    QTest::newRow("Ctrl+Shift+I") << int(Qt::Key_I) << int(Qt::ControlModifier | Qt::ShiftModifier) << false;
+}
+
+void KeyPolicyTest::windowPath()
+{
+    QFETCH(int, qtKey);
+    QFETCH(int, qtModifiers);
+    QFETCH(bool, allowed);
+    const unsigned mods = KeyPolicy::fromQtModifiers(Qt::KeyboardModifiers(qtModifiers));
+    QCOMPARE(KeyPolicy::isAllowedInWindow(KeyPolicy::verdict(KeyPolicy::fromQtKey(qtKey), mods), false), allowed);
+}
+
+void KeyPolicyTest::qtComboTableMatchesDenseTable()
+{
+    KeyComboSet table;
+    KeyPolicy::buildQtComboTable(table);
+
+    // buildQtComboTable覆盖的键，加上几个无虚拟键码映射的键（应落到默认判定）
+    QVector<int> qtKeys;
+    for (int key = Qt::Key_A; key <= Qt::Key_Z; ++key) qtKeys << key;
+    for (int key = Qt::Key_0; key <= Qt::Key_9; ++key) qtKeys << key;
+    for (int key = Qt::Key_F1; key <= Qt::Key_F35; ++key) qtKeys << key;
+    for (int key = Qt::Key_Escape; key <= Qt::Key_ScrollLock; ++key) qtKeys << key;
+    for (int key = Qt::Key_Space; key <= Qt::Key_AsciiTilde; ++key) qtKeys << key;
+    qtKeys << Qt::Key_Menu << Qt::Key_Launch0 << Qt::Key_VolumeUp << Qt::Key_unknown;
+
+    static const Qt::KeyboardModifier kModifierBits[] = {
+        Qt::ShiftModifier, Qt::ControlModifier, Qt::AltModifier, Qt::MetaModifier, Qt::KeypadModifier
+    };
+
+    int checked = 0;
+    for (int key : qtKeys) {
+        for (int mask = 0; mask < (1 << 5); ++mask) {
+            Qt::KeyboardModifiers modifiers = Qt::NoModifier;
+            for (int bit = 0; bit < 5; ++bit) {
+                if (mask & (1 << bit)) {
+                    modifiers |= kModifierBits[bit];
+                }
+            }
+
+            const KeyPolicy::Verdict expected =
+                KeyPolicy::verdict(KeyPolicy::fromQtKey(key), KeyPolicy::fromQtModifiers(modifiers));
+            const KeyPolicy::Verdict actual = KeyPolicy::qtComboVerdict(table, key, modifiers);
+            if (actual != expected) {
+                QFAIL(qPrintable(QString("Qt键值0x%1 修饰键0x%2: 组合码表%3，稠密表%4")
+                    .arg(key, 0, 16).arg(int(modifiers), 0, 16)
+                    .arg(KeyPolicy::verdictName(actual)).arg(KeyPolicy::verdictName(expected))));
+            }
+            ++checked;
+        }
+    }
+    QVERIFY(checked > 0);
+}
+
+void KeyPolicyTest::hookModifiers()
+{
+    QCOMPARE(KeyPolicy::fromHookModifiers(false, false, false, false), unsigned(KeyPolicy::MOD_NONE));
+    QCOMPARE(KeyPolicy::fromHookModifiers(true, false, false, false), unsigned(KeyPolicy::MOD_CTRL));
+    QCOMPARE(KeyPolicy::fromHookModifiers(false, true, false, false), unsigned(KeyPolicy::MOD_ALT));
+    QCOMPARE(KeyPolicy::fromHookModifiers(false, false, true, false), unsigned(KeyPolicy::MOD_SHIFT));
+    QCOMPARE(KeyPolicy::fromHookModifiers(false, false, false, true), unsigned(KeyPolicy::MOD_META));
+    QCOMPARE(KeyPolicy::fromHookModifiers(true, true, true, true), unsigned(KeyPolicy::kModifierCombos - 1));
+}
+
+void KeyPolicyTest::hookInterceptsWinAndCtrlEsc()
+{
+    for (unsigned mods = 0; mods < unsigned(KeyPolicy::kModifierCombos); ++mods) {
+        QVERIFY(KeyPolicy::requiresOsHook(KeyPolicyVk::LWin, mods));
+        QVERIFY(KeyPolicy::requiresOsHook(KeyPolicyVk::RWin, mods));
+    }
+    QVERIFY(KeyPolicy::requiresOsHook(KeyPolicyVk::Escape, KeyPolicy::fromHookModifiers(true, false, false, false)));
+    QVERIFY(KeyPolicy::requiresOsHook(KeyPolicyVk::Escape, KeyPolicy::fromHookModifiers(true, false, true, false)));
+    QVERIFY(!KeyPolicy::requiresOsHook(KeyPolicyVk::Escape, KeyPolicy::fromHookModifiers(false, false, false, false)));
+    QVERIFY(!KeyPolicy::requiresOsHook(KeyPolicyVk::Tab, KeyPolicy::fromHookModifiers(false, true, false, false)));
+    QVERIFY(!KeyPolicy::requiresOsHook(KeyPolicyVk::Control, KeyPolicy::fromHookModifiers(true, false, false, false)));
+}
+
+void KeyPolicyTest::virtualKeysMatchWindows()
+{
+#ifdef Q_OS_WIN
+    // 与windows.h中的VK_*逐一核对，防止手写键码与钩子收到的vkCode不一致
+    QCOMPARE(int(KeyPolicyVk::Back), VK_BACK);
+    QCOMPARE(int(KeyPolicyVk::Tab), VK_TAB);
+    QCOMPARE(int(KeyPolicyVk::Return), VK_RETURN);
+    QCOMPARE(int(KeyPolicyVk::Escape), VK_ESCAPE);
+    QCOMPARE(int(KeyPolicyVk::Space), VK_SPACE);
+    QCOMPARE(int(KeyPolicyVk::Shift), VK_SHIFT);
+    QCOMPARE(int(KeyPolicyVk::Control), VK_CONTROL);
+    QCOMPARE(int(KeyPolicyVk::Menu), VK_MENU);
+    QCOMPARE(int(KeyPolicyVk::LShift), VK_LSHIFT);
+    QCOMPARE(int(KeyPolicyVk::RShift), VK_RSHIFT);
+    QCOMPARE(int(KeyPolicyVk::LControl), VK_LCONTROL);
+    QCOMPARE(int(KeyPolicyVk::RControl), VK_RCONTROL);
+    QCOMPARE(int(KeyPolicyVk::LMenu), VK_LMENU);
+    QCOMPARE(int(KeyPolicyVk::RMenu), VK_RMENU);
+    QCOMPARE(int(KeyPolicyVk::LWin), VK_LWIN);
+    QCOMPARE(int(KeyPolicyVk::RWin), VK_RWIN);
+    QCOMPARE(int(KeyPolicyVk::Left), VK_LEFT);
+    QCOMPARE(int(KeyPolicyVk::Up), VK_UP);
+    QCOMPARE(int(KeyPolicyVk::Right), VK_RIGHT);
+    QCOMPARE(int(KeyPolicyVk::Down), VK_DOWN);
+    QCOMPARE(int(KeyPolicyVk::Delete), VK_DELETE);
+    QCOMPARE(int(KeyPolicyVk::F1), VK_F1);
+
+    QCOMPARE(KeyPolicy::fromQtKey(Qt::Key_F12), VK_F12);
+    QCOMPARE(KeyPolicy::fromQtKey(Qt::Key_Insert), VK_INSERT);
+    QCOMPARE(KeyPolicy::fromQtKey(Qt::Key_Pause), VK_PAUSE);
+    QCOMPARE(KeyPolicy::fromQtKey(Qt::Key_Print), VK_SNAPSHOT);
+    QCOMPARE(KeyPolicy::fromQtKey(Qt::Key_Home), VK_HOME);
+    QCOMPARE(KeyPolicy::fromQtKey(Qt::Key_End), VK_END);
+    QCOMPARE(KeyPolicy::fromQtKey(Qt::Key_PageUp), VK_PRIOR);
+    QCOMPARE(KeyPolicy::fromQtKey(Qt::Key_PageDown), VK_NEXT);
+    QCOMPARE(KeyPolicy::fromQtKey(Qt::Key_CapsLock), VK_CAPITAL);
+    QCOMPARE(KeyPolicy::fromQtKey(Qt::Key_NumLock), VK_NUMLOCK);
+    QCOMPARE(KeyPolicy::fromQtKey(Qt::Key_ScrollLock), VK_SCROLL);
+    QCOMPARE(KeyPolicy::fromQtKey(Qt::Key_Menu), VK_APPS);
+#else
+    QSKIP("VK_*常量仅在Windows上可用");
+#endif
+}
+
+QTEST_GUILESS_MAIN(KeyPolicyTest)
+#include "key_policy_test.moc"
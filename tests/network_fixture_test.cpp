@@ -0,0 +1,215 @@
+#include "../src/network/network_checker.h"
+#include "../src/network/network_quality_monitor.h"
+#include "../tools/fixture_server/exam_fixture_server.h"
+
+#include <QtTest>
+#include <QNetworkProxy>
+
+#include <memory>
+
+/**
+ * @brief 网络检测与质量监控的本地替身测试
+ *
+ * 用本地考试站点替身驱动NetworkChecker和NetworkQualityMonitor。
+ * 替身在进程内以随机端口启动，Options中的latencyMs/dropRate即命令行的--latency/--drop-rate，
+ * /slow、/dead、/status/503等固定路径与手动测速时相同，不访问外网。
+ */
+class NetworkFixtureTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void checkerConnectsToHealthyTarget();
+    void checkerReportsServiceUnavailable();
+    void checkerTimesOutOnDeadTarget();
+    void checkerRacesPastDeadTarget();
+    void checkerRacesPastSlowTarget();
+    void checkerMeasuresInjectedLatency();
+    void checkerFailsFastOnDroppedConnections();
+
+    void monitorTracksInjectedLatency();
+    void monitorGoesOfflineOnDroppedConnections();
+
+private:
+    std::unique_ptr<ExamFixtureServer> startServer(int latencyMs = 0, double dropRate = 0.0);
+    QString urlFor(const ExamFixtureServer& server, const QString& path) const;
+
+    /**
+     * @brief 运行一次检测，返回状态，elapsedMs为从发起到checkCompleted的耗时
+     */
+    NetworkChecker::NetworkStatus runCheck(const QString& target, const QStringList& backups,
+                                           int timeoutMs, qint64* elapsedMs);
+};
+
+void NetworkFixtureTest::initTestCase()
+{
+    // 本地回环不走代理，避免测试环境的代理变量影响结果
+    QNetworkProxy::setApplicationProxy(QNetworkProxy::NoProxy);
+    qRegisterMetaType<NetworkChecker::NetworkStatus>("NetworkStatus");
+}
+
+std::unique_ptr<ExamFixtureServer> NetworkFixtureTest::startServer(int latencyMs, double dropRate)
+{
+    ExamFixtureServer::Options options;
+    options.address = QHostAddress::LocalHost;
+    options.port = 0;
+    options.latencyMs = latencyMs;
+    options.dropRate = dropRate;
+    options.bundleSizeKB = 1;
+    options.imageSizeKB = 1;
+
+    std::unique_ptr<ExamFixtureServer> server(new ExamFixtureServer(options));
+    if (!server->start()) {
+        qWarning("fixture server failed: %s", qPrintable(server->errorString()));
+        return nullptr;
+    }
+    return server;
+}
+
+QString NetworkFixtureTest::urlFor(const ExamFixtureServer& server, const QString& path) const
+{
+    return QString("http://127.0.0.1:%1%2").arg(server.serverPort()).arg(path);
+}
+
+NetworkChecker::NetworkStatus NetworkFixtureTest::runCheck(const QString& target, const QStringList& backups,
+                                                           int timeoutMs, qint64* elapsedMs)
+{
+    NetworkChecker checker;
+    checker.setCheckUrls(backups);
+    QSignalSpy completed(&checker, &NetworkChecker::checkCompleted);
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    checker.startCheck(target, timeoutMs);
+    if (completed.isEmpty() && !completed.wait(timeoutMs + 2000)) {
+        return NetworkChecker::Unknown;
+    }
+    *elapsedMs = elapsed.elapsed();
+    return checker.getNetworkStatus();
+}
+
+void NetworkFixtureTest::checkerConnectsToHealthyTarget()
+{
+    auto server = startServer();
+    QVERIFY(server);
+
+    qint64 elapsedMs = 0;
+    QCOMPARE(runCheck(urlFor(*server, "/login"), QStringList(), 3000, &elapsedMs), NetworkChecker::Connected);
+}
+
+void NetworkFixtureTest::checkerReportsServiceUnavailable()
+{
+    auto server = startServer();
+    QVERIFY(server);
+
+    // 服务器有响应但不健康：不算连通，也不应拖到超时
+    qint64 elapsedMs = 0;
+    const NetworkChecker::NetworkStatus status = runCheck(urlFor(*server, "/status/503"), QStringList(), 3000, &elapsedMs);
+    QVERIFY(status != NetworkChecker::Connected);
+    QVERIFY(status != NetworkChecker::Timeout);
+    QVERIFY2(elapsedMs < 3000, qPrintable(QString("elapsed %1ms").arg(elapsedMs)));
+}
+
+void NetworkFixtureTest::checkerTimesOutOnDeadTarget()
+{
+    auto server = startServer();
+    QVERIFY(server);
+
+    // 整个检测在timeoutMs内必定给出结论
+    qint64 elapsedMs = 0;
+    QCOMPARE(runCheck(urlFor(*server, "/dead"), QStringList(), 1000, &elapsedMs), NetworkChecker::Timeout);
+    QVERIFY2(elapsedMs < 1500, qPrintable(QString("elapsed %1ms").arg(elapsedMs)));
+}
+
+void NetworkFixtureTest::checkerRacesPastDeadTarget()
+{
+    auto server = startServer();
+    QVERIFY(server);
+
+    // 目标挂死时备用地址在错开间隔后发起并胜出，不等目标超时
+    qint64 elapsedMs = 0;
+    QCOMPARE(runCheck(urlFor(*server, "/dead"), QStringList() << urlFor(*server, "/login"), 5000, &elapsedMs),
+             NetworkChecker::Connected);
+    QVERIFY2(elapsedMs < NetworkChecker::kProbeStaggerMs + 1000, qPrintable(QString("elapsed %1ms").arg(elapsedMs)));
+}
+
+void NetworkFixtureTest::checkerRacesPastSlowTarget()
+{
+    auto server = startServer();
+    QVERIFY(server);
+
+    qint64 elapsedMs = 0;
+    QCOMPARE(runCheck(urlFor(*server, "/slow?ms=3000"), QStringList() << urlFor(*server, "/login"), 5000, &elapsedMs),
+             NetworkChecker::Connected);
+    QVERIFY2(elapsedMs < 3000, qPrintable(QString("elapsed %1ms").arg(elapsedMs)));
+}
+
+void NetworkFixtureTest::checkerMeasuresInjectedLatency()
+{
+    auto server = startServer(200);
+    QVERIFY(server);
+
+    qint64 elapsedMs = 0;
+    QCOMPARE(runCheck(urlFor(*server, "/login"), QStringList(), 3000, &elapsedMs), NetworkChecker::Connected);
+    QVERIFY2(elapsedMs >= 200, qPrintable(QString("elapsed %1ms").arg(elapsedMs)));
+}
+
+void NetworkFixtureTest::checkerFailsFastOnDroppedConnections()
+{
+    auto server = startServer(0, 1.0);
+    QVERIFY(server);
+
+    // 连接被断开属于传输层失败，所有探测失败后立即给出结论
+    qint64 elapsedMs = 0;
+    const NetworkChecker::NetworkStatus status = runCheck(urlFor(*server, "/login"),
+        QStringList() << urlFor(*server, "/questions"), 5000, &elapsedMs);
+    QVERIFY(status != NetworkChecker::Connected);
+    QVERIFY(status != NetworkChecker::Timeout);
+    QVERIFY2(elapsedMs < 5000, qPrintable(QString("elapsed %1ms").arg(elapsedMs)));
+}
+
+void NetworkFixtureTest::monitorTracksInjectedLatency()
+{
+    auto server = startServer(100);
+    QVERIFY(server);
+
+    NetworkQualityMonitor monitor;
+    monitor.setTarget(urlFor(*server, "/login"));
+    monitor.setIntervals(100, 100);
+    monitor.setProbeTimeout(2000);
+    QSignalSpy samples(&monitor, &NetworkQualityMonitor::sampleRecorded);
+
+    monitor.start();
+    QTRY_VERIFY_WITH_TIMEOUT(samples.count() >= 3, 5000);
+    monitor.stop();
+
+    const NetworkQualityMonitor::Metrics metrics = monitor.metrics();
+    QCOMPARE(metrics.failures, 0);
+    QVERIFY2(metrics.srttMs >= 100.0, qPrintable(QString("SRTT %1ms").arg(metrics.srttMs)));
+    QCOMPARE(metrics.quality, NetworkQualityMonitor::QualityGood);
+}
+
+void NetworkFixtureTest::monitorGoesOfflineOnDroppedConnections()
+{
+    auto server = startServer(0, 1.0);
+    QVERIFY(server);
+
+    NetworkQualityMonitor monitor;
+    monitor.setTarget(urlFor(*server, "/login"));
+    monitor.setIntervals(100, 100);
+    monitor.setProbeTimeout(1000);
+    QSignalSpy samples(&monitor, &NetworkQualityMonitor::sampleRecorded);
+
+    monitor.start();
+    QTRY_VERIFY_WITH_TIMEOUT(samples.count() >= NetworkQualityMonitor::kOfflineFailures, 5000);
+    monitor.stop();
+
+    const NetworkQualityMonitor::Metrics metrics = monitor.metrics();
+    QVERIFY(metrics.consecutiveFailures >= NetworkQualityMonitor::kOfflineFailures);
+    QCOMPARE(metrics.quality, NetworkQualityMonitor::QualityOffline);
+}
+
+QTEST_GUILESS_MAIN(NetworkFixtureTest)
+#include "network_fixture_test.moc"
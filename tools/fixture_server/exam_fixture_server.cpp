@@ -0,0 +1,557 @@
+#include "exam_fixture_server.h"
+
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QPointer>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <QUrl>
+#include <QUrlQuery>
+#include <QtEndian>
+
+namespace {
+
+constexpr int kMaxHeaderBytes = 64 * 1024;
+constexpr int kThrottleIntervalMs = 100;
+
+} // namespace
+
+ExamFixtureServer::ExamFixtureServer(const Options& options, QObject* parent)
+    : QObject(parent)
+    , m_options(options)
+    , m_server(new QTcpServer(this))
+    , m_logFile(nullptr)
+{
+    connect(m_server, &QTcpServer::newConnection, this, &ExamFixtureServer::onNewConnection);
+}
+
+ExamFixtureServer::~ExamFixtureServer()
+{
+    m_server->close();
+    if (m_logFile) {
+        m_logFile->close();
+        delete m_logFile;
+    }
+}
+
+bool ExamFixtureServer::start()
+{
+    if (!m_options.logFile.isEmpty()) {
+        m_logFile = new QFile(m_options.logFile);
+        if (!m_logFile->open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+            m_errorString = QString("无法打开日志文件 %1: %2").arg(m_options.logFile, m_logFile->errorString());
+            delete m_logFile;
+            m_logFile = nullptr;
+            return false;
+        }
+    }
+
+    if (!m_server->listen(m_options.address, m_options.port)) {
+        m_errorString = m_server->errorString();
+        return false;
+    }
+    return true;
+}
+
+quint16 ExamFixtureServer::serverPort() const
+{
+    return m_server->serverPort();
+}
+
+void ExamFixtureServer::onNewConnection()
+{
+    while (QTcpSocket* socket = m_server->nextPendingConnection()) {
+        Connection connection;
+        connection.logPrefix = QString("%1:%2").arg(socket->peerAddress().toString()).arg(socket->peerPort()).toUtf8();
+        m_connections.insert(socket, connection);
+
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { onReadyRead(socket); });
+        connect(socket, &QTcpSocket::bytesWritten, this, [this, socket]() {
+            // 未限速的响应全部写出后结束本次请求
+            auto it = m_connections.find(socket);
+            if (it != m_connections.end() && it->busy && !it->throttleTimer && socket->bytesToWrite() == 0) {
+                finishRequest(socket);
+            }
+        });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() { closeConnection(socket); });
+    }
+}
+
+void ExamFixtureServer::onReadyRead(QTcpSocket* socket)
+{
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end()) {
+        return;
+    }
+    it->buffer.append(socket->readAll());
+    if (it->buffer.size() > kMaxHeaderBytes && !it->buffer.contains("\r\n\r\n")) {
+        closeConnection(socket);
+        return;
+    }
+    processNextRequest(socket);
+}
+
+void ExamFixtureServer::processNextRequest(QTcpSocket* socket)
+{
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end() || it->busy) {
+        return;
+    }
+
+    Request request;
+    bool complete = false;
+    if (!parseRequest(&it->buffer, &request, &complete)) {
+        Response response;
+        response.status = 400;
+        response.body = "bad request\n";
+        request.keepAlive = false;
+        it->busy = true;
+        it->closeAfterSend = true;
+        it->requestLine = "-";
+        it->elapsed.start();
+        sendResponse(socket, request, response);
+        return;
+    }
+    if (!complete) {
+        return;
+    }
+
+    it->busy = true;
+    it->elapsed.start();
+    it->closeAfterSend = !request.keepAlive;
+    it->requestLine = request.method + " " + request.path;
+    it->status = 0;
+    it->bodyBytes = 0;
+    dispatch(socket, request);
+}
+
+bool ExamFixtureServer::parseRequest(QByteArray* buffer, Request* request, bool* complete) const
+{
+    *complete = false;
+    const int headerEnd = buffer->indexOf("\r\n\r\n");
+    if (headerEnd < 0) {
+        return true;
+    }
+
+    const QList<QByteArray> lines = buffer->left(headerEnd).split('\n');
+    const QList<QByteArray> requestLine = lines.first().trimmed().split(' ');
+    if (requestLine.size() != 3) {
+        return false;
+    }
+
+    request->method = requestLine.at(0).toUpper();
+    const QUrl target = QUrl::fromEncoded("http://fixture" + requestLine.at(1));
+    request->path = target.path(QUrl::FullyEncoded).toUtf8();
+    for (const auto& item : QUrlQuery(target).queryItems()) {
+        request->query.insert(item.first.toUtf8(), item.second.toUtf8());
+    }
+    for (int i = 1; i < lines.size(); ++i) {
+        const int colon = lines.at(i).indexOf(':');
+        if (colon > 0) {
+            request->headers.insert(lines.at(i).left(colon).trimmed().toLower(), lines.at(i).mid(colon + 1).trimmed());
+        }
+    }
+
+    // 请求正文（如登录POST）需完整到达后一并丢弃
+    const int bodyLength = request->headers.value("content-length").toInt();
+    if (buffer->size() < headerEnd + 4 + bodyLength) {
+        return true;
+    }
+    buffer->remove(0, headerEnd + 4 + bodyLength);
+
+    const QByteArray connectionHeader = request->headers.value("connection").toLower();
+    request->keepAlive = requestLine.at(2) == "HTTP/1.1" ? connectionHeader != "close" : connectionHeader == "keep-alive";
+    *complete = true;
+    return true;
+}
+
+void ExamFixtureServer::dispatch(QTcpSocket* socket, const Request& request)
+{
+    QRandomGenerator* random = QRandomGenerator::global();
+
+    // 永不响应：模拟服务器挂死，由客户端超时
+    if (request.path == "/dead" || request.query.value("hang") == "1") {
+        logRequest(socket, "hang");
+        return;
+    }
+
+    // 丢弃：不响应直接断开
+    if (request.query.value("drop") == "1" || (m_options.dropRate > 0.0 && random->generateDouble() < m_options.dropRate)) {
+        logRequest(socket, "drop");
+        socket->abort();
+        return;
+    }
+
+    int delayMs = m_options.latencyMs;
+    if (m_options.jitterMs > 0) {
+        delayMs += random->bounded(m_options.jitterMs + 1);
+    }
+    if (request.query.contains("delay")) {
+        delayMs = request.query.value("delay").toInt();
+    }
+    if (request.path == "/slow") {
+        delayMs = request.query.value("ms", "3000").toInt();
+    }
+
+    QPointer<QTcpSocket> guard(socket);
+    QTimer::singleShot(qMax(0, delayMs), this, [this, guard, request]() {
+        if (!guard || !m_connections.contains(guard)) {
+            return;
+        }
+        sendResponse(guard, request, buildResponse(request));
+    });
+}
+
+ExamFixtureServer::Response ExamFixtureServer::buildResponse(const Request& request) const
+{
+    Response response;
+
+    if (request.method != "GET" && request.method != "HEAD" && request.method != "POST") {
+        response.status = 405;
+        response.contentType = "text/plain";
+        response.body = "method not allowed\n";
+        response.extraHeaders.insert("Allow", "GET, HEAD, POST");
+        return response;
+    }
+
+    // 错误注入：固定路径、查询参数或按比例随机
+    int injectedStatus = 0;
+    if (request.path.startsWith("/status/")) {
+        injectedStatus = request.path.mid(8).toInt();
+    } else if (request.query.contains("status")) {
+        injectedStatus = request.query.value("status").toInt();
+    } else if (m_options.errorRate > 0.0 && QRandomGenerator::global()->generateDouble() < m_options.errorRate) {
+        injectedStatus = 500;
+    }
+    if (injectedStatus >= 100 && injectedStatus <= 599) {
+        response.status = injectedStatus;
+        response.contentType = "text/plain";
+        response.body = QByteArray::number(injectedStatus) + " " + statusText(injectedStatus) + "\n";
+        return response;
+    }
+
+    QByteArray body;
+    if (readFromRoot(request.path, &body)) {
+        response.contentType = contentTypeFor(request.path);
+        response.body = body;
+    } else if (request.path == "/") {
+        response.status = 302;
+        response.extraHeaders.insert("Location", "/login");
+    } else if (request.path == "/login") {
+        response.body = request.method == "POST" ? questionListPage() : loginPage();
+    } else if (request.path == "/questions" || request.path == "/slow") {
+        response.body = questionListPage();
+    } else if (request.path.startsWith("/images/q") && request.path.endsWith(".bmp")) {
+        response.contentType = "image/bmp";
+        response.body = questionImage(request.path.mid(9, request.path.size() - 13).toInt());
+    } else if (request.path == "/static/app.js") {
+        response.contentType = "application/javascript";
+        response.body = scriptBundle();
+    } else if (request.path == "/favicon.ico") {
+        response.status = 204;
+    } else {
+        response.status = 404;
+        response.contentType = "text/plain";
+        response.body = "not found\n";
+    }
+
+    if (response.status == 200) {
+        response.extraHeaders.insert("Accept-Ranges", "bytes");
+        applyRange(request, &response);
+    }
+    return response;
+}
+
+bool ExamFixtureServer::applyRange(const Request& request, Response* response) const
+{
+    // 只支持单一区间 bytes=a-b / bytes=a-，足够覆盖NetworkChecker的Range探测
+    const QByteArray range = request.headers.value("range");
+    if (!range.startsWith("bytes=") || range.contains(',')) {
+        return false;
+    }
+    const QList<QByteArray> bounds = range.mid(6).split('-');
+    if (bounds.size() != 2 || bounds.at(0).isEmpty()) {
+        return false;
+    }
+
+    const qint64 total = response->body.size();
+    const qint64 first = bounds.at(0).toLongLong();
+    const qint64 last = bounds.at(1).isEmpty() ? total - 1 : qMin(bounds.at(1).toLongLong(), total - 1);
+    if (first >= total || first > last) {
+        response->status = 416;
+        response->extraHeaders.insert("Content-Range", "bytes */" + QByteArray::number(total));
+        response->body.clear();
+        return true;
+    }
+
+    response->status = 206;
+    response->extraHeaders.insert("Content-Range",
+        "bytes " + QByteArray::number(first) + "-" + QByteArray::number(last) + "/" + QByteArray::number(total));
+    response->body = response->body.mid(first, last - first + 1);
+    return true;
+}
+
+void ExamFixtureServer::sendResponse(QTcpSocket* socket, const Request& request, const Response& response)
+{
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end()) {
+        return;
+    }
+
+    QByteArray head = "HTTP/1.1 " + QByteArray::number(response.status) + " " + statusText(response.status) + "\r\n";
+    head += "Content-Type: " + response.contentType + "\r\n";
+    head += "Content-Length: " + QByteArray::number(response.body.size()) + "\r\n";
+    head += "Cache-Control: no-store\r\n";
+    head += it->closeAfterSend ? "Connection: close\r\n" : "Connection: keep-alive\r\n";
+    for (auto header = response.extraHeaders.constBegin(); header != response.extraHeaders.constEnd(); ++header) {
+        head += header.key() + ": " + header.value() + "\r\n";
+    }
+    head += "\r\n";
+
+    it->status = response.status;
+    it->bodyBytes = request.method == "HEAD" ? 0 : response.body.size();
+    socket->write(head);
+
+    if (request.method == "HEAD" || response.body.isEmpty()) {
+        if (socket->bytesToWrite() == 0) {
+            finishRequest(socket);
+        }
+        return;
+    }
+
+    if (m_options.bandwidthKBps <= 0) {
+        socket->write(response.body);
+        return;
+    }
+
+    // 限速：每kThrottleIntervalMs写出一份配额
+    it->pendingBody = response.body;
+    it->throttleTimer = new QTimer(this);
+    QPointer<QTcpSocket> guard(socket);
+    connect(it->throttleTimer, &QTimer::timeout, this, [this, guard]() {
+        if (guard) {
+            sendThrottledChunk(guard);
+        }
+    });
+    it->throttleTimer->start(kThrottleIntervalMs);
+    sendThrottledChunk(socket);
+}
+
+void ExamFixtureServer::sendThrottledChunk(QTcpSocket* socket)
+{
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end() || !it->throttleTimer) {
+        return;
+    }
+
+    const int quota = qMax(1, m_options.bandwidthKBps * 1024 * kThrottleIntervalMs / 1000);
+    socket->write(it->pendingBody.left(quota));
+    it->pendingBody.remove(0, quota);
+
+    if (it->pendingBody.isEmpty()) {
+        it->throttleTimer->stop();
+        it->throttleTimer->deleteLater();
+        it->throttleTimer = nullptr;
+        if (socket->bytesToWrite() == 0) {
+            finishRequest(socket);
+        }
+    }
+}
+
+void ExamFixtureServer::finishRequest(QTcpSocket* socket)
+{
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end() || !it->busy) {
+        return;
+    }
+
+    logRequest(socket);
+    it->busy = false;
+
+    if (it->closeAfterSend) {
+        socket->disconnectFromHost();
+        return;
+    }
+    // 同一连接上已到达的下一个请求（流水线）
+    QTimer::singleShot(0, this, [this, guard = QPointer<QTcpSocket>(socket)]() {
+        if (guard) {
+            processNextRequest(guard);
+        }
+    });
+}
+
+void ExamFixtureServer::logRequest(QTcpSocket* socket, const QByteArray& note)
+{
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end()) {
+        return;
+    }
+
+    // 日志行：时间 对端 请求 状态（或hang/drop） 正文字节 耗时
+    QString line = QString("%1 %2 %3 %4 %5B %6ms")
+        .arg(QDateTime::currentDateTime().toString("HH:mm:ss.zzz"))
+        .arg(QString::fromUtf8(it->logPrefix))
+        .arg(QString::fromUtf8(it->requestLine))
+        .arg(note.isEmpty() ? QString::number(it->status) : QString::fromUtf8(note))
+        .arg(it->bodyBytes)
+        .arg(it->elapsed.isValid() ? it->elapsed.elapsed() : 0);
+
+    if (m_options.logToStdout) {
+        QTextStream(stdout) << line << Qt::endl;
+    }
+    if (m_logFile) {
+        QTextStream(m_logFile) << line << Qt::endl;
+    }
+}
+
+void ExamFixtureServer::closeConnection(QTcpSocket* socket)
+{
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end()) {
+        return;
+    }
+    if (it->throttleTimer) {
+        it->throttleTimer->stop();
+        it->throttleTimer->deleteLater();
+    }
+    m_connections.erase(it);
+    socket->abort();
+    socket->deleteLater();
+}
+
+QByteArray ExamFixtureServer::loginPage() const
+{
+    return QByteArray(
+        "<!DOCTYPE html>\n<html><head><meta charset=\"utf-8\"><title>考试登录</title>\n"
+        "<script src=\"/static/app.js\"></script></head>\n"
+        "<body><form method=\"post\" action=\"/login\">\n"
+        "<label>准考证号 <input name=\"id\"></label>\n"
+        "<label>密码 <input name=\"password\" type=\"password\"></label>\n"
+        "<button type=\"submit\">登录</button></form></body></html>\n");
+}
+
+QByteArray ExamFixtureServer::questionListPage() const
+{
+    QByteArray page =
+        "<!DOCTYPE html>\n<html><head><meta charset=\"utf-8\"><title>题目列表</title>\n"
+        "<script src=\"/static/app.js\"></script></head>\n<body><ol>\n";
+    for (int i = 1; i <= m_options.questionCount; ++i) {
+        page += "<li><p>第" + QByteArray::number(i) + "题：请根据下图作答。</p>"
+                "<img src=\"/images/q" + QByteArray::number(i) + ".bmp\" width=\"320\" height=\"200\">"
+                "<label><input type=\"radio\" name=\"q" + QByteArray::number(i) + "\">A</label>"
+                "<label><input type=\"radio\" name=\"q" + QByteArray::number(i) + "\">B</label></li>\n";
+    }
+    page += "</ol></body></html>\n";
+    return page;
+}
+
+QByteArray ExamFixtureServer::questionImage(int index) const
+{
+    auto cached = m_imageCache.constFind(index);
+    if (cached != m_imageCache.constEnd()) {
+        return cached.value();
+    }
+
+    // 24位BMP：无需图像编码库即可精确控制大小，Chromium可直接解码
+    const int width = 256;
+    const int height = qMax(1, m_options.imageSizeKB * 1024 / (width * 3));
+    const int pixelBytes = width * 3 * height;
+    QByteArray image(54 + pixelBytes, '\0');
+    uchar* data = reinterpret_cast<uchar*>(image.data());
+    data[0] = 'B';
+    data[1] = 'M';
+    qToLittleEndian<quint32>(static_cast<quint32>(image.size()), data + 2);
+    qToLittleEndian<quint32>(54, data + 10);
+    qToLittleEndian<quint32>(40, data + 14);
+    qToLittleEndian<qint32>(width, data + 18);
+    qToLittleEndian<qint32>(height, data + 22);
+    qToLittleEndian<quint16>(1, data + 26);
+    qToLittleEndian<quint16>(24, data + 28);
+    qToLittleEndian<quint32>(static_cast<quint32>(pixelBytes), data + 34);
+
+    // 每张图颜色不同，避免被当作同一资源
+    for (int i = 0; i < pixelBytes; i += 3) {
+        data[54 + i] = static_cast<uchar>(index * 37);
+        data[54 + i + 1] = static_cast<uchar>((i / 3) % width);
+        data[54 + i + 2] = static_cast<uchar>((i / (width * 3)) % 256);
+    }
+
+    m_imageCache.insert(index, image);
+    return image;
+}
+
+QByteArray ExamFixtureServer::scriptBundle() const
+{
+    if (!m_bundleCache.isEmpty()) {
+        return m_bundleCache;
+    }
+
+    // 合法的JS，含大量函数定义，解析和编译开销与真实打包产物接近
+    const int targetBytes = m_options.bundleSizeKB * 1024;
+    QByteArray bundle = "(function(){\n\"use strict\";\nvar modules = {};\n";
+    for (int i = 0; bundle.size() < targetBytes; ++i) {
+        const QByteArray n = QByteArray::number(i);
+        bundle += "modules.m" + n + " = function(state){ var total = 0; "
+                  "for (var k = 0; k < state.items.length; k++) { total += state.items[k] * " + n + "; } "
+                  "return { id: 'module-" + n + "', total: total, label: '模块" + n + "' }; };\n";
+    }
+    bundle += "window.__fixtureModules = Object.keys(modules).length;\n})();\n";
+    m_bundleCache = bundle;
+    return bundle;
+}
+
+bool ExamFixtureServer::readFromRoot(const QByteArray& path, QByteArray* body) const
+{
+    if (m_options.rootDir.isEmpty() || path.contains("..")) {
+        return false;
+    }
+    QString relative = QUrl::fromPercentEncoding(path);
+    if (relative.endsWith('/')) {
+        relative += "index.html";
+    }
+    QFile file(QDir(m_options.rootDir).filePath(relative.mid(1)));
+    if (!QFileInfo(file).isFile() || !file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    *body = file.readAll();
+    return true;
+}
+
+QByteArray ExamFixtureServer::statusText(int status)
+{
+    switch (status) {
+        case 200: return "OK";
+        case 204: return "No Content";
+        case 206: return "Partial Content";
+        case 302: return "Found";
+        case 400: return "Bad Request";
+        case 403: return "Forbidden";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 416: return "Range Not Satisfiable";
+        case 429: return "Too Many Requests";
+        case 500: return "Internal Server Error";
+        case 502: return "Bad Gateway";
+        case 503: return "Service Unavailable";
+        case 504: return "Gateway Timeout";
+        default: return "Status";
+    }
+}
+
+QByteArray ExamFixtureServer::contentTypeFor(const QByteArray& path)
+{
+    if (path.endsWith(".html") || path.endsWith('/')) return "text/html; charset=utf-8";
+    if (path.endsWith(".js")) return "application/javascript";
+    if (path.endsWith(".css")) return "text/css";
+    if (path.endsWith(".png")) return "image/png";
+    if (path.endsWith(".jpg") || path.endsWith(".jpeg")) return "image/jpeg";
+    if (path.endsWith(".bmp")) return "image/bmp";
+    if (path.endsWith(".svg")) return "image/svg+xml";
+    if (path.endsWith(".json")) return "application/json";
+    return "application/octet-stream";
+}
@@ -0,0 +1,135 @@
+#ifndef EXAM_FIXTURE_SERVER_H
+#define EXAM_FIXTURE_SERVER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QHostAddress>
+#include <QString>
+
+class QTcpServer;
+class QTcpSocket;
+class QTimer;
+class QFile;
+
+/**
+ * @brief 本地考试站点替身（离线端到端测速用）
+ *
+ * 基于QTcpServer的最小HTTP/1.1服务器，提供与考试页面结构相近的固定内容：
+ * 登录页、题目列表、题目图片和较大的JS包，供NetworkChecker、SystemChecker网络检查、
+ * NetworkQualityMonitor以及完整的CEF页面加载在没有真实考试站点时重复测速。
+ *
+ * 可全局配置响应延迟、带宽、错误注入和丢弃比例；单个请求可用查询参数覆盖：
+ *   ?delay=毫秒  ?status=状态码  ?drop=1（不响应直接断开）  ?hang=1（永不响应）
+ * 另有固定路径：/status/NNN、/slow?ms=N、/dead（永不响应）。
+ * 支持HEAD、Range: bytes=a-b和keep-alive。每个请求一行日志写到标准输出（可另存文件）。
+ */
+class ExamFixtureServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Options {
+        QHostAddress address = QHostAddress::LocalHost;
+        quint16 port = 8765;
+        int latencyMs = 0;              // 每个响应在发送响应头前的固定延迟
+        int jitterMs = 0;               // 延迟上叠加的随机抖动（0~jitterMs）
+        int bandwidthKBps = 0;          // 正文发送带宽上限，0为不限
+        double errorRate = 0.0;         // 以此比例返回500
+        double dropRate = 0.0;          // 以此比例不响应直接断开
+        int questionCount = 40;         // 题目列表中的题目数
+        int bundleSizeKB = 2048;        // /static/app.js大小
+        int imageSizeKB = 64;           // 每张题目图片大小
+        QString rootDir;                // 非空时优先从此目录读取同名文件
+        QString logFile;                // 非空时请求日志同时追加到此文件
+        bool logToStdout = true;        // 嵌入其他工具时关闭，只写logFile
+    };
+
+    explicit ExamFixtureServer(const Options& options, QObject* parent = nullptr);
+    ~ExamFixtureServer() override;
+
+    /**
+     * @brief 开始监听
+     * @return 端口被占用等情况返回false，原因见errorString()
+     */
+    bool start();
+
+    QString errorString() const { return m_errorString; }
+    quint16 serverPort() const;
+
+private slots:
+    void onNewConnection();
+
+private:
+    /**
+     * @brief 一个已解析的请求
+     */
+    struct Request {
+        QByteArray method;
+        QByteArray path;                // 不含查询串
+        QHash<QByteArray, QByteArray> query;
+        QHash<QByteArray, QByteArray> headers;   // 键为小写
+        bool keepAlive = true;
+    };
+
+    /**
+     * @brief 待发送的响应
+     */
+    struct Response {
+        int status = 200;
+        QByteArray contentType = "text/html; charset=utf-8";
+        QByteArray body;
+        QHash<QByteArray, QByteArray> extraHeaders;
+    };
+
+    /**
+     * @brief 每个连接的状态
+     */
+    struct Connection {
+        QByteArray buffer;              // 尚未解析的输入
+        QByteArray pendingBody;         // 限速发送中的正文
+        QTimer* throttleTimer = nullptr;
+        bool busy = false;              // 正在处理请求（延迟或限速发送中）
+        bool closeAfterSend = false;
+        QElapsedTimer elapsed;
+        QByteArray logPrefix;           // 对端地址
+        QByteArray requestLine;         // 当前请求的方法和路径
+        int status = 0;
+        qint64 bodyBytes = 0;
+    };
+
+    void onReadyRead(QTcpSocket* socket);
+    void processNextRequest(QTcpSocket* socket);
+    bool parseRequest(QByteArray* buffer, Request* request, bool* complete) const;
+    void dispatch(QTcpSocket* socket, const Request& request);
+    Response buildResponse(const Request& request) const;
+    bool applyRange(const Request& request, Response* response) const;
+    void sendResponse(QTcpSocket* socket, const Request& request, const Response& response);
+    void sendThrottledChunk(QTcpSocket* socket);
+    void finishRequest(QTcpSocket* socket);
+    void logRequest(QTcpSocket* socket, const QByteArray& note = QByteArray());
+    void closeConnection(QTcpSocket* socket);
+
+    // 固定内容
+    QByteArray loginPage() const;
+    QByteArray questionListPage() const;
+    QByteArray questionImage(int index) const;
+    QByteArray scriptBundle() const;
+    bool readFromRoot(const QByteArray& path, QByteArray* body) const;
+
+    static QByteArray statusText(int status);
+    static QByteArray contentTypeFor(const QByteArray& path);
+
+    Options m_options;
+    QTcpServer* m_server;
+    QFile* m_logFile;
+    QString m_errorString;
+    QHash<QTcpSocket*, Connection> m_connections;
+
+    // 生成一次后复用
+    mutable QByteArray m_bundleCache;
+    mutable QHash<int, QByteArray> m_imageCache;
+};
+
+#endif // EXAM_FIXTURE_SERVER_H
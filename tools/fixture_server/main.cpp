@@ -0,0 +1,65 @@
+#include "exam_fixture_server.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
+
+/**
+ * 本地考试站点替身
+ *
+ * 用法示例：
+ *   exam-fixture-server --port 8765 --latency 120 --jitter 40 --bandwidth 512 --drop-rate 0.05
+ * 然后把config.json的url指向 http://127.0.0.1:8765/login 启动终端，
+ * 或把checkUrl指向 http://127.0.0.1:8765/slow?ms=8000、/dead、/status/503 观察网络检测的表现。
+ */
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("exam-fixture-server");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("本地考试站点替身，用于离线端到端测速");
+    parser.addHelpOption();
+
+    const QCommandLineOption bindOption("bind", "监听地址（默认127.0.0.1）", "address", "127.0.0.1");
+    const QCommandLineOption portOption("port", "监听端口（默认8765，0为自动分配）", "port", "8765");
+    const QCommandLineOption latencyOption("latency", "每个响应的固定延迟（毫秒）", "ms", "0");
+    const QCommandLineOption jitterOption("jitter", "延迟上叠加的随机抖动上限（毫秒）", "ms", "0");
+    const QCommandLineOption bandwidthOption("bandwidth", "正文发送带宽上限（KB/s，0为不限）", "kbps", "0");
+    const QCommandLineOption errorRateOption("error-rate", "返回500的比例（0~1）", "rate", "0");
+    const QCommandLineOption dropRateOption("drop-rate", "不响应直接断开的比例（0~1）", "rate", "0");
+    const QCommandLineOption questionsOption("questions", "题目列表中的题目数", "count", "40");
+    const QCommandLineOption bundleOption("bundle-kb", "/static/app.js大小（KB）", "kb", "2048");
+    const QCommandLineOption imageOption("image-kb", "每张题目图片大小（KB）", "kb", "64");
+    const QCommandLineOption rootOption("root", "优先从此目录提供同名文件", "dir");
+    const QCommandLineOption logOption("log", "请求日志另存到此文件", "file");
+    parser.addOptions({bindOption, portOption, latencyOption, jitterOption, bandwidthOption,
+                       errorRateOption, dropRateOption, questionsOption, bundleOption, imageOption,
+                       rootOption, logOption});
+    parser.process(app);
+
+    ExamFixtureServer::Options options;
+    options.address = QHostAddress(parser.value(bindOption));
+    options.port = static_cast<quint16>(parser.value(portOption).toUInt());
+    options.latencyMs = parser.value(latencyOption).toInt();
+    options.jitterMs = parser.value(jitterOption).toInt();
+    options.bandwidthKBps = parser.value(bandwidthOption).toInt();
+    options.errorRate = qBound(0.0, parser.value(errorRateOption).toDouble(), 1.0);
+    options.dropRate = qBound(0.0, parser.value(dropRateOption).toDouble(), 1.0);
+    options.questionCount = qMax(1, parser.value(questionsOption).toInt());
+    options.bundleSizeKB = qMax(1, parser.value(bundleOption).toInt());
+    options.imageSizeKB = qMax(1, parser.value(imageOption).toInt());
+    options.rootDir = parser.value(rootOption);
+    options.logFile = parser.value(logOption);
+
+    ExamFixtureServer server(options);
+    if (!server.start()) {
+        QTextStream(stderr) << "启动失败: " << server.errorString() << Qt::endl;
+        return 1;
+    }
+
+    QTextStream(stdout) << QString("考试站点替身已启动: http://%1:%2/login")
+                               .arg(options.address.toString()).arg(server.serverPort())
+                        << Qt::endl;
+    return app.exec();
+}
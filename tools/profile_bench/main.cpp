@@ -0,0 +1,68 @@
+#include "profile_bench.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
+
+/**
+ * 内存配置档A/B对比
+ *
+ * 用法示例：
+ *   profile-bench --app ./DesktopTerminal-CEF --runs 5 --latency 80 --bandwidth 2048 --csv bench.csv
+ * 对minimal/balanced/performance各运行5次（轮流执行），每次以空缓存加载替身站点的登录页和题目列表，
+ * 输出每次运行的结果和各配置档的中位数。CEFManager::runtimeProfileFor()中的参数按此结果调整。
+ */
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("profile-bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("对各内存配置档测量页面加载耗时、进程树CPU时间和峰值内存");
+    parser.addHelpOption();
+
+    const QCommandLineOption appOption("app", "终端可执行文件路径", "path");
+    const QCommandLineOption profilesOption("profiles", "逗号分隔的配置档（默认minimal,balanced,performance）",
+                                            "list", "minimal,balanced,performance");
+    const QCommandLineOption pathsOption("path", "要加载的替身页面路径，可重复（默认/login和/questions）", "path");
+    const QCommandLineOption runsOption("runs", "每个配置档的运行次数（默认3）", "count", "3");
+    const QCommandLineOption timeoutOption("timeout", "单次运行上限（秒，默认180）", "seconds", "180");
+    const QCommandLineOption intervalOption("sample-interval", "内存采样间隔（毫秒，默认100）", "ms", "100");
+    const QCommandLineOption latencyOption("latency", "替身每个响应的固定延迟（毫秒）", "ms", "0");
+    const QCommandLineOption jitterOption("jitter", "延迟上叠加的随机抖动上限（毫秒）", "ms", "0");
+    const QCommandLineOption bandwidthOption("bandwidth", "替身正文发送带宽上限（KB/s，0为不限）", "kbps", "0");
+    const QCommandLineOption csvOption("csv", "每次运行的结果写入此CSV文件", "file");
+    const QCommandLineOption argOption("app-arg", "追加给终端的参数，可重复", "arg");
+    parser.addOptions({appOption, profilesOption, pathsOption, runsOption, timeoutOption, intervalOption,
+                       latencyOption, jitterOption, bandwidthOption, csvOption, argOption});
+    parser.process(app);
+
+    if (!parser.isSet(appOption)) {
+        QTextStream(stderr) << "缺少--app" << Qt::endl;
+        parser.showHelp(1);
+    }
+
+    ProfileBench::Options options;
+    options.appPath = parser.value(appOption);
+    options.profiles = parser.value(profilesOption).split(',', QString::SkipEmptyParts);
+    options.paths = parser.values(pathsOption);
+    if (options.paths.isEmpty()) {
+        options.paths << "/login" << "/questions";
+    }
+    options.extraArguments = parser.values(argOption);
+    options.runs = qMax(1, parser.value(runsOption).toInt());
+    options.timeoutMs = qMax(10, parser.value(timeoutOption).toInt()) * 1000;
+    options.sampleIntervalMs = qMax(10, parser.value(intervalOption).toInt());
+    options.csvFile = parser.value(csvOption);
+    options.server.latencyMs = parser.value(latencyOption).toInt();
+    options.server.jitterMs = parser.value(jitterOption).toInt();
+    options.server.bandwidthKBps = parser.value(bandwidthOption).toInt();
+
+    ProfileBench bench(options);
+    QObject::connect(&bench, &ProfileBench::finished, &app, &QCoreApplication::exit);
+    if (!bench.start()) {
+        QTextStream(stderr) << "启动失败: " << bench.errorString() << Qt::endl;
+        return 1;
+    }
+    return app.exec();
+}
@@ -0,0 +1,216 @@
+#include "process_tree_meter.h"
+
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QProcess>
+#include <QSet>
+#include <QStringList>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_LINUX)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#if !defined(Q_OS_WIN)
+double childrenCpuMs()
+{
+#ifdef Q_OS_LINUX
+    struct rusage usage;
+    if (getrusage(RUSAGE_CHILDREN, &usage) != 0) {
+        return -1.0;
+    }
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000.0
+         + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000.0;
+#else
+    return -1.0;
+#endif
+}
+#endif
+
+} // namespace
+
+ProcessTreeMeter::ProcessTreeMeter()
+    : m_cpuTimeMs(-1.0)
+    , m_peakResidentMB(-1.0)
+    , m_peakProcessCount(0)
+#ifdef Q_OS_WIN
+    , m_job(nullptr)
+#else
+    , m_rootPid(0)
+    , m_childrenCpuBeforeMs(-1.0)
+#endif
+{
+}
+
+ProcessTreeMeter::~ProcessTreeMeter()
+{
+#ifdef Q_OS_WIN
+    // 作业设置了KILL_ON_JOB_CLOSE：测量工具异常退出时不留下孤立的CEF子进程
+    if (m_job) {
+        CloseHandle(m_job);
+    }
+#endif
+}
+
+void ProcessTreeMeter::prepare(QProcess* process)
+{
+#ifdef Q_OS_WIN
+    // 挂起启动，放入作业后再恢复，保证第一个子进程创建前已在作业内
+    process->setCreateProcessArgumentsModifier([](QProcess::CreateProcessArguments* args) {
+        args->flags |= CREATE_SUSPENDED;
+    });
+#else
+    Q_UNUSED(process);
+    m_childrenCpuBeforeMs = childrenCpuMs();
+#endif
+}
+
+bool ProcessTreeMeter::attach(QProcess* process)
+{
+#ifdef Q_OS_WIN
+QT_WARNING_PUSH
+QT_WARNING_DISABLE_DEPRECATED
+    // Qt5在Windows上只经pid()提供进程和主线程句柄
+    _PROCESS_INFORMATION* info = process->pid();
+QT_WARNING_POP
+    if (!info) {
+        return false;
+    }
+
+    m_job = CreateJobObjectW(nullptr, nullptr);
+    bool attached = false;
+    if (m_job) {
+        JOBOBJECT_EXTENDED_LIMIT_INFORMATION limits = {};
+        limits.BasicLimitInformation.LimitFlags = JOB_OBJECT_LIMIT_KILL_ON_JOB_CLOSE;
+        SetInformationJobObject(m_job, JobObjectExtendedLimitInformation, &limits, sizeof(limits));
+        attached = AssignProcessToJobObject(m_job, info->hProcess) != FALSE;
+    }
+    ResumeThread(info->hThread);
+    return attached;
+#else
+    m_rootPid = process->processId();
+    return m_rootPid > 0;
+#endif
+}
+
+void ProcessTreeMeter::sample()
+{
+    double residentBytes = 0.0;
+    int processCount = 0;
+
+#ifdef Q_OS_WIN
+    if (!m_job) {
+        return;
+    }
+
+    // 足够容纳一次考试页面加载的全部CEF进程
+    struct {
+        JOBOBJECT_BASIC_PROCESS_ID_LIST header;
+        ULONG_PTR more[63];
+    } list = {};
+    list.header.NumberOfAssignedProcesses = 64;
+    if (!QueryInformationJobObject(m_job, JobObjectBasicProcessIdList, &list, sizeof(list), nullptr)) {
+        return;
+    }
+
+    for (DWORD i = 0; i < list.header.NumberOfProcessIdsInList; ++i) {
+        HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION | PROCESS_VM_READ, FALSE,
+                                     static_cast<DWORD>(list.header.ProcessIdList[i]));
+        if (!process) {
+            continue;
+        }
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(process, &counters, sizeof(counters))) {
+            residentBytes += static_cast<double>(counters.WorkingSetSize);
+            ++processCount;
+        }
+        CloseHandle(process);
+    }
+#elif defined(Q_OS_LINUX)
+    if (m_rootPid <= 0) {
+        return;
+    }
+
+    // 先读出全部进程的父进程，再从被测进程开始收集后代
+    QHash<qint64, qint64> parents;
+    const QStringList entries = QDir("/proc").entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString& entry : entries) {
+        bool isPid = false;
+        const qint64 pid = entry.toLongLong(&isPid);
+        if (!isPid) {
+            continue;
+        }
+        QFile stat(QString("/proc/%1/stat").arg(pid));
+        if (!stat.open(QIODevice::ReadOnly)) {
+            continue;
+        }
+        // 进程名可能含空格，从最后一个')'之后（第3列）开始数
+        const QByteArray line = stat.readAll();
+        const QList<QByteArray> fields = line.mid(line.lastIndexOf(')') + 2).split(' ');
+        if (fields.size() > 1) {
+            parents.insert(pid, fields.at(1).toLongLong());
+        }
+    }
+
+    QSet<qint64> tree;
+    tree.insert(m_rootPid);
+    bool grown = true;
+    while (grown) {
+        grown = false;
+        for (auto it = parents.cbegin(); it != parents.cend(); ++it) {
+            if (!tree.contains(it.key()) && tree.contains(it.value())) {
+                tree.insert(it.key());
+                grown = true;
+            }
+        }
+    }
+
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    for (qint64 pid : tree) {
+        QFile statm(QString("/proc/%1/statm").arg(pid));
+        if (!statm.open(QIODevice::ReadOnly)) {
+            continue;
+        }
+        const QList<QByteArray> fields = statm.readAll().split(' ');
+        if (fields.size() > 1) {
+            residentBytes += fields.at(1).toDouble() * pageSize;
+            ++processCount;
+        }
+    }
+#else
+    return;
+#endif
+
+    if (processCount > 0) {
+        m_peakResidentMB = qMax(m_peakResidentMB, residentBytes / (1024.0 * 1024.0));
+        m_peakProcessCount = qMax(m_peakProcessCount, processCount);
+    }
+}
+
+void ProcessTreeMeter::finish()
+{
+#ifdef Q_OS_WIN
+    if (!m_job) {
+        return;
+    }
+    // 作业的累计值包含已经退出的进程
+    JOBOBJECT_BASIC_ACCOUNTING_INFORMATION accounting = {};
+    if (QueryInformationJobObject(m_job, JobObjectBasicAccountingInformation,
+                                  &accounting, sizeof(accounting), nullptr)) {
+        m_cpuTimeMs = static_cast<double>(accounting.TotalUserTime.QuadPart
+                                          + accounting.TotalKernelTime.QuadPart) / 10000.0;
+    }
+#else
+    // QProcess发出finished时已回收被测进程，其回收过的子进程的CPU时间一并计入
+    const double after = childrenCpuMs();
+    if (m_childrenCpuBeforeMs >= 0 && after >= 0) {
+        m_cpuTimeMs = after - m_childrenCpuBeforeMs;
+    }
+#endif
+}
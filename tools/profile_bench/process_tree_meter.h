@@ -0,0 +1,65 @@
+#ifndef PROCESS_TREE_METER_H
+#define PROCESS_TREE_METER_H
+
+#include <QtGlobal>
+
+class QProcess;
+
+/**
+ * @brief 统计一个被测进程及其全部子进程（CEF渲染、GPU、工具进程）的资源占用
+ *
+ * - Windows：以挂起方式启动被测进程，放入作业对象后再恢复，之后派生的子进程都在作业内；
+ *   CPU时间取作业累计值（含已退出的进程），内存按采样时作业内各进程工作集之和；
+ * - Linux：CPU时间取被测进程退出回收后RUSAGE_CHILDREN的增量（CEF会回收自己的子进程），
+ *   内存按采样时/proc中各后代进程的常驻页之和。
+ *
+ * 峰值内存依赖采样间隔，两次采样之间的短暂峰值可能漏掉。
+ */
+class ProcessTreeMeter
+{
+public:
+    ProcessTreeMeter();
+    ~ProcessTreeMeter();
+
+    /**
+     * @brief 启动前调用（Windows上设置挂起启动）
+     */
+    void prepare(QProcess* process);
+
+    /**
+     * @brief 进程启动后调用：开始跟踪进程树
+     * @return 无法跟踪时返回false（进程照常运行，只是没有CPU/内存数据）
+     */
+    bool attach(QProcess* process);
+
+    /**
+     * @brief 采样一次当前进程树的常驻内存
+     */
+    void sample();
+
+    /**
+     * @brief 被测进程结束后调用，读取累计CPU时间
+     */
+    void finish();
+
+    double cpuTimeMs() const { return m_cpuTimeMs; }
+    double peakResidentMB() const { return m_peakResidentMB; }
+    int peakProcessCount() const { return m_peakProcessCount; }
+
+private:
+    ProcessTreeMeter(const ProcessTreeMeter&) = delete;
+    ProcessTreeMeter& operator=(const ProcessTreeMeter&) = delete;
+
+    double m_cpuTimeMs;
+    double m_peakResidentMB;
+    int m_peakProcessCount;
+
+#ifdef Q_OS_WIN
+    void* m_job;
+#else
+    qint64 m_rootPid;
+    double m_childrenCpuBeforeMs;
+#endif
+};
+
+#endif // PROCESS_TREE_METER_H
@@ -0,0 +1,353 @@
+#include "profile_bench.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QTimer>
+
+#include <algorithm>
+
+ProfileBench::ProfileBench(const Options& options, QObject* parent)
+    : QObject(parent)
+    , m_options(options)
+    , m_server(nullptr)
+    , m_planIndex(0)
+    , m_process(nullptr)
+    , m_runDir(nullptr)
+    , m_meter(nullptr)
+    , m_sampleTimer(new QTimer(this))
+    , m_timeoutTimer(new QTimer(this))
+{
+    m_sampleTimer->setInterval(m_options.sampleIntervalMs);
+    connect(m_sampleTimer, &QTimer::timeout, this, &ProfileBench::onSample);
+
+    m_timeoutTimer->setSingleShot(true);
+    m_timeoutTimer->setInterval(m_options.timeoutMs);
+    connect(m_timeoutTimer, &QTimer::timeout, this, &ProfileBench::onRunTimeout);
+}
+
+ProfileBench::~ProfileBench()
+{
+    if (m_process) {
+        m_process->disconnect(this);
+        m_process->kill();
+        m_process->waitForFinished(3000);
+        delete m_process;
+    }
+    delete m_meter;
+    delete m_runDir;
+}
+
+bool ProfileBench::start()
+{
+    if (!QFile::exists(m_options.appPath)) {
+        m_errorString = QString("找不到终端程序: %1").arg(m_options.appPath);
+        return false;
+    }
+    if (m_options.profiles.isEmpty() || m_options.paths.isEmpty() || m_options.runs <= 0) {
+        m_errorString = "配置档、页面路径和运行次数都不能为空";
+        return false;
+    }
+
+    // 替身与测量在同一事件循环中运行，整个流程只靠信号推进，不做阻塞等待
+    ExamFixtureServer::Options serverOptions = m_options.server;
+    serverOptions.address = QHostAddress::LocalHost;
+    serverOptions.port = 0;
+    serverOptions.logToStdout = false;
+    m_server = new ExamFixtureServer(serverOptions, this);
+    if (!m_server->start()) {
+        m_errorString = QString("站点替身启动失败: %1").arg(m_server->errorString());
+        return false;
+    }
+
+    for (const QString& path : m_options.paths) {
+        m_urls.append(QString("http://127.0.0.1:%1%2")
+                          .arg(m_server->serverPort())
+                          .arg(path.startsWith('/') ? path : '/' + path));
+    }
+
+    // 配置档轮流执行，避免机器状态（温度、后台任务）随时间变化偏向某一配置档
+    for (int run = 1; run <= m_options.runs; ++run) {
+        for (const QString& profile : m_options.profiles) {
+            m_plan.append(qMakePair(profile, run));
+        }
+    }
+
+    QTextStream(stdout) << QString("站点替身: %1，共%2次运行").arg(m_urls.join(' ')).arg(m_plan.size())
+                        << Qt::endl;
+    QTimer::singleShot(0, this, &ProfileBench::startNextRun);
+    return true;
+}
+
+void ProfileBench::startNextRun()
+{
+    if (m_planIndex >= m_plan.size()) {
+        printSummary();
+        const bool csvOk = writeCsv();
+        bool allSucceeded = csvOk;
+        for (const RunResult& result : m_results) {
+            allSucceeded = allSucceeded && result.success;
+        }
+        emit finished(allSucceeded ? 0 : 1);
+        return;
+    }
+
+    // 每次运行使用新的空缓存目录，测的是冷缓存首次加载
+    m_runDir = new QTemporaryDir(QDir::tempPath() + "/profile-bench-XXXXXX");
+    if (!m_runDir->isValid()) {
+        completeRun("无法创建临时目录");
+        return;
+    }
+
+    const QString profile = m_plan.at(m_planIndex).first;
+    QStringList arguments;
+    arguments << "--warm-cache" << "--warm-cache-urls-only";
+    for (const QString& url : m_urls) {
+        arguments << QString("--warm-cache-url=%1").arg(url);
+    }
+    arguments << QString("--memory-profile=%1").arg(profile)
+              << QString("--cache-dir=%1").arg(m_runDir->filePath("cache"))
+              << QString("--warm-cache-report=%1").arg(m_runDir->filePath("report.json"));
+    arguments << m_options.extraArguments;
+
+    m_process = new QProcess(this);
+    m_process->setProgram(m_options.appPath);
+    m_process->setArguments(arguments);
+    m_process->setWorkingDirectory(QFileInfo(m_options.appPath).absolutePath());
+    m_process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    m_process->setStandardOutputFile(m_runDir->filePath("stdout.log"));
+
+    m_meter = new ProcessTreeMeter();
+    m_meter->prepare(m_process);
+
+    connect(m_process, &QProcess::started, this, [this]() {
+        if (!m_meter->attach(m_process)) {
+            QTextStream(stderr) << "无法跟踪进程树，本次运行没有CPU/内存数据" << Qt::endl;
+        }
+        m_sampleTimer->start();
+    });
+    connect(m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, &ProfileBench::onProcessFinished);
+    connect(m_process, &QProcess::errorOccurred, this, &ProfileBench::onProcessError);
+
+    m_wall.start();
+    m_timeoutTimer->start();
+    m_process->start();
+}
+
+void ProfileBench::onSample()
+{
+    if (m_meter) {
+        m_meter->sample();
+    }
+}
+
+void ProfileBench::onProcessFinished(int exitCode, QProcess::ExitStatus status)
+{
+    if (status == QProcess::CrashExit) {
+        completeRun("终端崩溃退出");
+    } else if (exitCode != 0) {
+        completeRun(QString("终端退出码%1").arg(exitCode));
+    } else {
+        completeRun(QString());
+    }
+}
+
+void ProfileBench::onProcessError(QProcess::ProcessError error)
+{
+    // 运行中的错误随后还会有finished，只处理无法启动的情况
+    if (error == QProcess::FailedToStart) {
+        completeRun(QString("终端无法启动: %1").arg(m_process->errorString()));
+    }
+}
+
+void ProfileBench::onRunTimeout()
+{
+    if (m_process && m_process->state() != QProcess::NotRunning) {
+        QTextStream(stderr) << QString("运行超过%1ms，终止").arg(m_options.timeoutMs) << Qt::endl;
+        // 只终止主进程；CEF子进程随之退出（Windows上由作业关闭兜底）
+        m_process->kill();
+    }
+}
+
+void ProfileBench::completeRun(const QString& error)
+{
+    m_sampleTimer->stop();
+    m_timeoutTimer->stop();
+
+    RunResult result;
+    result.profile = m_plan.at(m_planIndex).first;
+    result.run = m_plan.at(m_planIndex).second;
+    result.wallMs = m_wall.isValid() ? m_wall.elapsed() : -1;
+    result.error = error;
+
+    if (m_meter) {
+        m_meter->finish();
+        result.treeCpuMs = m_meter->cpuTimeMs();
+        result.treePeakRssMB = m_meter->peakResidentMB();
+        result.peakProcesses = m_meter->peakProcessCount();
+    }
+    if (m_runDir && m_runDir->isValid()) {
+        readReport(&result);
+    }
+    result.success = result.error.isEmpty();
+
+    m_results.append(result);
+    printRun(result);
+
+    if (m_process) {
+        m_process->disconnect(this);
+        m_process->deleteLater();
+        m_process = nullptr;
+    }
+    delete m_meter;
+    m_meter = nullptr;
+    delete m_runDir;
+    m_runDir = nullptr;
+
+    ++m_planIndex;
+    QTimer::singleShot(0, this, &ProfileBench::startNextRun);
+}
+
+void ProfileBench::readReport(RunResult* result) const
+{
+    QFile file(m_runDir->filePath("report.json"));
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (result->error.isEmpty()) {
+            result->error = "没有生成预热报告";
+        }
+        return;
+    }
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value("memoryProfile").toString() != result->profile && result->error.isEmpty()) {
+        // 终端不认识该配置档时会回落到配置文件中的设置，结果不能算作该配置档
+        result->error = QString("终端实际使用的配置档为%1").arg(root.value("memoryProfile").toString());
+    }
+    result->browserCreateMs = static_cast<qint64>(root.value("browserCreateMs").toDouble(-1));
+    result->browserCpuMs = root.value("browserProcessCpuMs").toDouble(-1);
+    result->browserPeakRssMB = root.value("browserProcessPeakRssMB").toDouble(-1);
+
+    qint64 firstLoad = 0;
+    qint64 reload = 0;
+    const QJsonArray pages = root.value("pages").toArray();
+    for (const QJsonValue& value : pages) {
+        const QJsonObject page = value.toObject();
+        if (!page.value("success").toBool() || page.value("firstLoadMs").toDouble(-1) < 0) {
+            if (result->error.isEmpty()) {
+                result->error = QString("页面加载失败: %1").arg(page.value("url").toString());
+            }
+            continue;
+        }
+        firstLoad += static_cast<qint64>(page.value("firstLoadMs").toDouble());
+        reload += static_cast<qint64>(qMax(0.0, page.value("reloadMs").toDouble()));
+    }
+    if (!pages.isEmpty()) {
+        result->firstLoadMs = firstLoad;
+        result->reloadMs = reload;
+    }
+}
+
+void ProfileBench::printRun(const RunResult& result) const
+{
+    QTextStream out(stdout);
+    out << QString("[%1 #%2] 首次加载 %3ms，重新加载 %4ms，进程树CPU %5ms，峰值内存 %6MB（%7个进程），"
+                   "主进程CPU %8ms/%9MB，总耗时 %10ms")
+               .arg(result.profile).arg(result.run)
+               .arg(result.firstLoadMs).arg(result.reloadMs)
+               .arg(result.treeCpuMs, 0, 'f', 0).arg(result.treePeakRssMB, 0, 'f', 1)
+               .arg(result.peakProcesses)
+               .arg(result.browserCpuMs, 0, 'f', 0).arg(result.browserPeakRssMB, 0, 'f', 1)
+               .arg(result.wallMs);
+    if (!result.success) {
+        out << "  失败: " << result.error;
+    }
+    out << Qt::endl;
+}
+
+void ProfileBench::printSummary() const
+{
+    QTextStream out(stdout);
+    out << Qt::endl << "配置档        成功  首次加载ms  重新加载ms  进程树CPUms  峰值内存MB  进程数  总耗时ms"
+        << Qt::endl;
+
+    for (const QString& profile : m_options.profiles) {
+        QList<double> firstLoad, reload, cpu, rss, processes, wall;
+        int succeeded = 0;
+        int total = 0;
+        for (const RunResult& result : m_results) {
+            if (result.profile != profile) {
+                continue;
+            }
+            ++total;
+            if (!result.success) {
+                continue;
+            }
+            ++succeeded;
+            firstLoad.append(result.firstLoadMs);
+            reload.append(result.reloadMs);
+            cpu.append(result.treeCpuMs);
+            rss.append(result.treePeakRssMB);
+            processes.append(result.peakProcesses);
+            wall.append(result.wallMs);
+        }
+
+        // 中位数，只统计成功的运行
+        out << QString("%1 %2/%3 %4 %5 %6 %7 %8 %9")
+                   .arg(profile, -12)
+                   .arg(succeeded, 4).arg(total, -3)
+                   .arg(median(firstLoad), 10, 'f', 0)
+                   .arg(median(reload), 10, 'f', 0)
+                   .arg(median(cpu), 11, 'f', 0)
+                   .arg(median(rss), 10, 'f', 1)
+                   .arg(median(processes), 6, 'f', 0)
+                   .arg(median(wall), 8, 'f', 0)
+            << Qt::endl;
+    }
+}
+
+bool ProfileBench::writeCsv() const
+{
+    if (m_options.csvFile.isEmpty()) {
+        return true;
+    }
+
+    QFile file(m_options.csvFile);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        QTextStream(stderr) << QString("CSV写入失败: %1").arg(file.errorString()) << Qt::endl;
+        return false;
+    }
+
+    QTextStream out(&file);
+    out << "profile,run,success,firstLoadMs,reloadMs,browserCreateMs,treeCpuMs,treePeakRssMB,"
+           "peakProcesses,browserCpuMs,browserPeakRssMB,wallMs,error\n";
+    for (const RunResult& result : m_results) {
+        QString error = result.error;
+        error.replace('"', "\"\"");
+        out << result.profile << ',' << result.run << ',' << (result.success ? 1 : 0) << ','
+            << result.firstLoadMs << ',' << result.reloadMs << ',' << result.browserCreateMs << ','
+            << QString::number(result.treeCpuMs, 'f', 1) << ','
+            << QString::number(result.treePeakRssMB, 'f', 1) << ','
+            << result.peakProcesses << ','
+            << QString::number(result.browserCpuMs, 'f', 1) << ','
+            << QString::number(result.browserPeakRssMB, 'f', 1) << ','
+            << result.wallMs << ",\"" << error << "\"\n";
+    }
+    return true;
+}
+
+double ProfileBench::median(QList<double> values)
+{
+    if (values.isEmpty()) {
+        return -1.0;
+    }
+    std::sort(values.begin(), values.end());
+    const int middle = values.size() / 2;
+    return values.size() % 2 ? values.at(middle) : (values.at(middle - 1) + values.at(middle)) / 2.0;
+}
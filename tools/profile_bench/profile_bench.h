@@ -0,0 +1,112 @@
+#ifndef PROFILE_BENCH_H
+#define PROFILE_BENCH_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QList>
+#include <QProcess>
+#include <QString>
+#include <QStringList>
+
+#include "../fixture_server/exam_fixture_server.h"
+#include "process_tree_meter.h"
+
+class QTemporaryDir;
+class QTimer;
+
+/**
+ * @brief 内存配置档A/B对比
+ *
+ * 进程内启动本地考试站点替身，对每个配置档依次以缓存预热模式（--warm-cache）启动终端：
+ *   --warm-cache-urls-only --warm-cache-url=<替身页面> --memory-profile=<配置档>
+ *   --cache-dir=<每次新建的空目录> --warm-cache-report=<报告文件>
+ * 每次运行都从空缓存开始，记录冷缓存首次加载与重新加载耗时（取自预热报告）、
+ * 整个进程树的CPU时间和峰值常驻内存（ProcessTreeMeter），多次运行取中位数。
+ */
+class ProfileBench : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Options {
+        QString appPath;                // DesktopTerminal-CEF可执行文件
+        QStringList profiles;           // minimal/balanced/performance
+        QStringList paths;              // 替身站点上要加载的页面路径
+        QStringList extraArguments;     // 追加给终端的参数
+        int runs = 3;
+        int timeoutMs = 180000;         // 单次运行上限
+        int sampleIntervalMs = 100;     // 内存采样间隔
+        QString csvFile;                // 非空时每次运行一行写入CSV
+        ExamFixtureServer::Options server;
+    };
+
+    /**
+     * @brief 单次运行的结果
+     */
+    struct RunResult {
+        QString profile;
+        int run = 0;
+        bool success = false;
+        QString error;
+        qint64 wallMs = -1;
+        qint64 browserCreateMs = -1;
+        qint64 firstLoadMs = -1;        // 各页面冷缓存首次加载耗时之和
+        qint64 reloadMs = -1;           // 各页面重新加载耗时之和
+        double treeCpuMs = -1.0;
+        double treePeakRssMB = -1.0;
+        int peakProcesses = 0;
+        double browserCpuMs = -1.0;     // 浏览器主进程（预热报告）
+        double browserPeakRssMB = -1.0;
+    };
+
+    explicit ProfileBench(const Options& options, QObject* parent = nullptr);
+    ~ProfileBench() override;
+
+    /**
+     * @brief 启动站点替身并开始第一轮运行
+     * @return 替身无法启动或参数无效时返回false
+     */
+    bool start();
+
+    QString errorString() const { return m_errorString; }
+
+signals:
+    /**
+     * @brief 全部运行结束
+     * @param exitCode 全部成功为0，否则为1
+     */
+    void finished(int exitCode);
+
+private slots:
+    void startNextRun();
+    void onProcessFinished(int exitCode, QProcess::ExitStatus status);
+    void onProcessError(QProcess::ProcessError error);
+    void onSample();
+    void onRunTimeout();
+
+private:
+    void completeRun(const QString& error);
+    void readReport(RunResult* result) const;
+    void printRun(const RunResult& result) const;
+    void printSummary() const;
+    bool writeCsv() const;
+
+    static double median(QList<double> values);
+
+    Options m_options;
+    ExamFixtureServer* m_server;
+    QStringList m_urls;
+    QString m_errorString;
+
+    QList<QPair<QString, int>> m_plan;  // 待执行的（配置档，第几次）
+    int m_planIndex;
+    QProcess* m_process;
+    QTemporaryDir* m_runDir;
+    ProcessTreeMeter* m_meter;
+    QTimer* m_sampleTimer;
+    QTimer* m_timeoutTimer;
+    QElapsedTimer m_wall;
+    QList<RunResult> m_results;
+};
+
+#endif // PROFILE_BENCH_H